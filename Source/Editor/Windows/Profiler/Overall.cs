@@ -18,6 +18,7 @@ internal sealed class Overall : ProfilerMode
         private readonly SingleChart _drawTimeGPUChart;
         private readonly SingleChart _cpuMemChart;
         private readonly SingleChart _gpuMemChart;
+        private readonly SingleChart _jobsChart;
 
         public Overall()
         : base("Overall")
@@ -80,6 +81,13 @@ public Overall()
                 Parent = layout,
             };
             _gpuMemChart.SelectedSampleChanged += OnSelectedSampleChanged;
+            _jobsChart = new SingleChart
+            {
+                Title = "Jobs In Flight (peak)",
+                FormatSample = v => ((int)v).ToString(),
+                Parent = layout,
+            };
+            _jobsChart.SelectedSampleChanged += OnSelectedSampleChanged;
         }
 
         /// <inheritdoc />
@@ -91,6 +99,7 @@ public override void Clear()
             _drawTimeGPUChart.Clear();
             _cpuMemChart.Clear();
             _gpuMemChart.Clear();
+            _jobsChart.Clear();
         }
 
         /// <inheritdoc />
@@ -102,6 +111,7 @@ public override void Update(ref SharedUpdateData sharedData)
             _drawTimeGPUChart.AddSample(sharedData.Stats.DrawGPUTimeMs);
             _cpuMemChart.AddSample(sharedData.Stats.ProcessMemory.UsedPhysicalMemory / 1024 / 1024);
             _gpuMemChart.AddSample(sharedData.Stats.MemoryGPU.Used / 1024 / 1024);
+            _jobsChart.AddSample(sharedData.Stats.Jobs.ContextsPeak);
         }
 
         /// <inheritdoc />
@@ -113,6 +123,7 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
             _drawTimeGPUChart.SelectedSampleIndex = selectedFrame;
             _cpuMemChart.SelectedSampleIndex = selectedFrame;
             _gpuMemChart.SelectedSampleIndex = selectedFrame;
+            _jobsChart.SelectedSampleIndex = selectedFrame;
         }
     }
 }
@@ -0,0 +1,447 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "AnimationData.h"
+#include "AnimationUtils.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// The minimum distance (in units) at which the rotation and scale errors are measured (eg. for the leaf nodes)
+#define ANIMATION_COMPRESSION_MIN_NODE_LENGTH 10.0f
+// The maximum amount of quantized encoding attempts (with lowered keyframes reduction threshold) before storing the track as raw data
+#define ANIMATION_COMPRESSION_MAX_ATTEMPTS 4
+
+namespace
+{
+    constexpr float QuantizeRange = 65535.0f;
+    constexpr float QuantizeRotationRange = 32767.0f;
+    constexpr float Sqrt2 = 1.41421356f;
+
+    float GetError(const Float3& a, const Float3& b)
+    {
+        return Float3::Distance(a, b);
+    }
+
+    float GetError(const Quaternion& a, const Quaternion& b)
+    {
+        // Angle between rotations (in radians)
+        return 2.0f * Math::Acos(Math::Min(Math::Abs(Quaternion::Dot(a, b)), 1.0f));
+    }
+
+    uint16 Quantize(float value, float min, float scale)
+    {
+        return scale > 0.0f ? (uint16)Math::Clamp(Math::RoundToInt((value - min) / scale), 0, 65535) : 0;
+    }
+
+    void Encode(const Float3& value, const AnimationCompressedTrack& track, uint16* data)
+    {
+        data[0] = Quantize(value.X, track.ValueMin.X, track.ValueScale.X);
+        data[1] = Quantize(value.Y, track.ValueMin.Y, track.ValueScale.Y);
+        data[2] = Quantize(value.Z, track.ValueMin.Z, track.ValueScale.Z);
+    }
+
+    void Encode(const Quaternion& value, const AnimationCompressedTrack& track, uint16* data)
+    {
+        // Smallest three components encoding (the largest component is skipped and restored from the unit length, its index is stored in 2 top bits)
+        Quaternion q = value;
+        q.Normalize();
+        const float* raw = q.Raw;
+        int32 largest = 0;
+        for (int32 i = 1; i < 4; i++)
+        {
+            if (Math::Abs(raw[i]) > Math::Abs(raw[largest]))
+                largest = i;
+        }
+        const float sign = raw[largest] < 0.0f ? -1.0f : 1.0f;
+        for (int32 i = 0, j = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+            const float component = Math::Clamp(raw[i] * sign * Sqrt2 * 0.5f + 0.5f, 0.0f, 1.0f);
+            data[j++] = (uint16)Math::RoundToInt(component * QuantizeRotationRange);
+        }
+        data[0] |= (uint16)((largest & 1) << 15);
+        data[1] |= (uint16)((largest >> 1) << 15);
+    }
+
+    FORCE_INLINE void Decode(const uint16* data, const AnimationCompressedTrack& track, Float3& result)
+    {
+        result.X = track.ValueMin.X + (float)data[0] * track.ValueScale.X;
+        result.Y = track.ValueMin.Y + (float)data[1] * track.ValueScale.Y;
+        result.Z = track.ValueMin.Z + (float)data[2] * track.ValueScale.Z;
+    }
+
+    FORCE_INLINE void Decode(const uint16* data, const AnimationCompressedTrack& track, Quaternion& result)
+    {
+        const int32 largest = (data[0] >> 15) | ((data[1] >> 15) << 1);
+        const float a = ((float)(data[0] & 0x7fff) / QuantizeRotationRange * 2.0f - 1.0f) * (1.0f / Sqrt2);
+        const float b = ((float)(data[1] & 0x7fff) / QuantizeRotationRange * 2.0f - 1.0f) * (1.0f / Sqrt2);
+        const float c = ((float)(data[2] & 0x7fff) / QuantizeRotationRange * 2.0f - 1.0f) * (1.0f / Sqrt2);
+        const float d = Math::Sqrt(Math::Max(1.0f - a * a - b * b - c * c, 0.0f));
+        switch (largest)
+        {
+        case 0:
+            result = Quaternion(d, a, b, c);
+            break;
+        case 1:
+            result = Quaternion(a, d, b, c);
+            break;
+        case 2:
+            result = Quaternion(a, b, d, c);
+            break;
+        default:
+            result = Quaternion(a, b, c, d);
+            break;
+        }
+        result.Normalize();
+    }
+
+    template<typename T>
+    FORCE_INLINE void DecodeKey(const uint16* values, int32 index, const AnimationCompressedTrack& track, T& result)
+    {
+        if (track.Raw)
+            Platform::MemoryCopy(&result, values + index * (int32)(sizeof(T) / sizeof(uint16)), sizeof(T));
+        else
+            Decode(values + index * 3, track, result);
+    }
+
+    // Gets the keyframe time (quantized time for the quantized tracks)
+    FORCE_INLINE float GetKeyTime(const uint16* times, int32 index, const AnimationCompressedTrack& track)
+    {
+        if (track.Raw)
+        {
+            float time;
+            Platform::MemoryCopy(&time, times + index * 2, sizeof(float));
+            return time;
+        }
+        return (float)times[index];
+    }
+
+    template<typename T>
+    void EvaluateTrack(const AnimationCompressedTrack& track, const uint16* data, float time, T& result, int32* cursor = nullptr)
+    {
+        data += track.Offset;
+        if (track.Count == 1)
+        {
+            DecodeKey(data, 0, track, result);
+            return;
+        }
+
+        // Find keyframes (in quantized time)
+        const int32 count = track.Count;
+        const uint16* times = data;
+        const uint16* values = data + (track.Raw ? count * 2 : count);
+        const float t = track.Raw ? time : (time - track.TimeStart) / track.TimeScale;
+        if (t <= GetKeyTime(times, 0, track))
+        {
+            DecodeKey(values, 0, track, result);
+            return;
+        }
+        if (t >= GetKeyTime(times, count - 1, track))
+        {
+            DecodeKey(values, count - 1, track, result);
+            return;
+        }
+        int32 left = 0, right = count - 1;
+        if (cursor && *cursor >= 0 && *cursor < count - 1 && GetKeyTime(times, *cursor, track) <= t)
+        {
+            // Move forward from the last key
+            left = *cursor;
+            const int32 end = Math::Min(left + 4, count - 1);
+            while (left < end && GetKeyTime(times, left + 1, track) <= t)
+                left++;
+            right = left + 1;
+            if (GetKeyTime(times, right, track) <= t)
+            {
+                // Too far, use binary search
+                left = 0;
+                right = count - 1;
+            }
+        }
+        while (right - left > 1)
+        {
+            const int32 middle = (left + right) >> 1;
+            if (GetKeyTime(times, middle, track) <= t)
+                left = middle;
+            else
+                right = middle;
+        }
+        if (cursor)
+            *cursor = left;
+
+        // Interpolate keyframes
+        T a, b;
+        DecodeKey(values, left, track, a);
+        DecodeKey(values, right, track, b);
+        const float leftTime = GetKeyTime(times, left, track);
+        const float length = GetKeyTime(times, right, track) - leftTime;
+        const float alpha = length > 0.0f ? (t - leftTime) / length : 0.0f;
+        AnimationUtils::Interpolate(a, b, alpha, result);
+    }
+
+    template<typename T>
+    void DecompressTrack(const AnimationCompressedTrack& track, const uint16* data, LinearCurve<T>& result)
+    {
+        result.Resize(track.Count);
+        auto& keyframes = result.GetKeyframes();
+        const uint16* times = data + track.Offset;
+        const uint16* values = track.Count > 1 ? times + (track.Raw ? track.Count * 2 : track.Count) : times;
+        for (int32 i = 0; i < track.Count; i++)
+        {
+            auto& k = keyframes[i];
+            if (track.Count == 1)
+                k.Time = track.TimeStart;
+            else if (track.Raw)
+                k.Time = GetKeyTime(times, i, track);
+            else
+                k.Time = track.TimeStart + (float)times[i] * track.TimeScale;
+            DecodeKey(values, i, track, k.Value);
+        }
+    }
+
+    // Picks the keyframes that are needed to represent the curve with linear interpolation within the error threshold
+    template<typename T>
+    void ReduceKeyframes(const Array<LinearCurveKeyframe<T>>& keyframes, float maxError, Array<int32>& result)
+    {
+        const int32 count = keyframes.Count();
+        result.Clear();
+        result.Add(0);
+        int32 start = 0;
+        for (int32 end = 2; end < count; end++)
+        {
+            const auto& a = keyframes[start];
+            const auto& b = keyframes[end];
+            const float length = b.Time - a.Time;
+            bool valid = length > ZeroTolerance;
+            for (int32 i = start + 1; i < end && valid; i++)
+            {
+                T value;
+                AnimationUtils::Interpolate(a.Value, b.Value, (keyframes[i].Time - a.Time) / length, value);
+                valid = GetError(value, keyframes[i].Value) <= maxError;
+            }
+            if (!valid)
+            {
+                start = end - 1;
+                result.Add(start);
+            }
+        }
+        if (count > 1)
+            result.Add(count - 1);
+    }
+
+    void SetupRange(AnimationCompressedTrack& track, const Array<LinearCurveKeyframe<Float3>>& keyframes, const Array<int32>& keys)
+    {
+        Float3 min = Float3::Maximum, max = Float3::Minimum;
+        for (const int32 key : keys)
+        {
+            Float3::Min(min, keyframes[key].Value, min);
+            Float3::Max(max, keyframes[key].Value, max);
+        }
+        track.ValueMin = min;
+        track.ValueScale = (max - min) / QuantizeRange;
+    }
+
+    void SetupRange(AnimationCompressedTrack& track, const Array<LinearCurveKeyframe<Quaternion>>& keyframes, const Array<int32>& keys)
+    {
+    }
+
+    template<typename T>
+    float GetTrackError(const LinearCurve<T>& curve, const T& defaultValue, const AnimationCompressedTrack& track, const uint16* data)
+    {
+        float result = 0.0f;
+        for (const auto& k : curve.GetKeyframes())
+        {
+            T value = defaultValue;
+            if (track.Count != 0)
+                EvaluateTrack(track, data, k.Time, value);
+            result = Math::Max(result, GetError(value, k.Value));
+        }
+        return result;
+    }
+
+    template<typename T>
+    void GetKeys(const Array<LinearCurveKeyframe<T>>& keyframes, bool constant, float maxError, Array<int32>& keys)
+    {
+        if (constant)
+        {
+            keys.Clear();
+            keys.Add(0);
+        }
+        else
+        {
+            ReduceKeyframes(keyframes, maxError, keys);
+            if (keyframes[keys.Last()].Time - keyframes[keys[0]].Time <= ZeroTolerance)
+                keys.Resize(1);
+        }
+    }
+
+    template<typename T>
+    void EncodeTrack(const Array<LinearCurveKeyframe<T>>& keyframes, const Array<int32>& keys, bool raw, Array<uint16>& data, AnimationCompressedTrack& track)
+    {
+        track.Count = keys.Count();
+        track.Offset = data.Count();
+        track.TimeStart = keyframes[keys[0]].Time;
+        track.Raw = raw;
+        if (raw)
+        {
+            // Copy exact times and values
+            constexpr int32 valueSize = sizeof(T) / sizeof(uint16);
+            if (track.Count > 1)
+            {
+                for (const int32 key : keys)
+                {
+                    uint16 time[2];
+                    Platform::MemoryCopy(time, &keyframes[key].Time, sizeof(float));
+                    data.Add(time, 2);
+                }
+            }
+            for (const int32 key : keys)
+                data.Add((const uint16*)&keyframes[key].Value, valueSize);
+            return;
+        }
+
+        // Quantize keyframes within the track range
+        SetupRange(track, keyframes, keys);
+        if (track.Count > 1)
+        {
+            track.TimeScale = (keyframes[keys.Last()].Time - track.TimeStart) / QuantizeRange;
+            for (const int32 key : keys)
+                data.Add(Quantize(keyframes[key].Time, track.TimeStart, track.TimeScale));
+        }
+        const int32 valuesStart = data.Count();
+        data.AddUninitialized(track.Count * 3);
+        for (int32 i = 0; i < track.Count; i++)
+            Encode(keyframes[keys[i]].Value, track, data.Get() + valuesStart + i * 3);
+    }
+
+    template<typename T>
+    void CompressTrack(LinearCurve<T>& curve, const T& defaultValue, float maxError, Array<uint16>& data, AnimationCompressedTrack& track, AnimationCompressionStats& stats)
+    {
+        track = AnimationCompressedTrack();
+        const auto& keyframes = curve.GetKeyframes();
+        if (keyframes.IsEmpty())
+            return;
+
+        // Strip constant tracks that match the default value (node default pose)
+        bool constant = true;
+        for (int32 i = 1; i < keyframes.Count() && constant; i++)
+            constant = GetError(keyframes[i].Value, keyframes[0].Value) <= maxError;
+        if (constant && GetError(keyframes[0].Value, defaultValue) <= maxError)
+        {
+            stats.StrippedTracks++;
+            return;
+        }
+
+        // Remove redundant keyframes and quantize them (quantization adds own error so lower the reduction threshold until track fits within the error bound)
+        if (constant)
+            stats.ConstantTracks++;
+        Array<int32> keys;
+        const int32 offset = data.Count();
+        float reduceError = maxError;
+        for (int32 attempt = 0; attempt < ANIMATION_COMPRESSION_MAX_ATTEMPTS; attempt++)
+        {
+            data.Resize(offset);
+            GetKeys(keyframes, constant, reduceError, keys);
+            EncodeTrack(keyframes, keys, false, data, track);
+            if (GetTrackError(curve, defaultValue, track, data.Get()) <= maxError)
+                return;
+            reduceError *= 0.5f;
+        }
+
+        // Quantization cannot represent the track within the error bound (eg. root motion over a large distance) so store raw keyframes
+        stats.RawTracks++;
+        data.Resize(offset);
+        GetKeys(keyframes, constant, maxError, keys);
+        EncodeTrack(keyframes, keys, true, data, track);
+    }
+}
+
+void CompressedAnimationData::Evaluate(int32 channelIndex, float time, Transform* result, int32* cursors) const
+{
+    const Channel& channel = Channels.Get()[channelIndex];
+    const uint16* data = Data.Get();
+    if (channel.Position.Count != 0)
+    {
+        Float3 position;
+        EvaluateTrack(channel.Position, data, time, position, cursors);
+        result->Translation = position;
+    }
+    if (channel.Rotation.Count != 0)
+        EvaluateTrack(channel.Rotation, data, time, result->Orientation, cursors ? cursors + 1 : nullptr);
+    if (channel.Scale.Count != 0)
+        EvaluateTrack(channel.Scale, data, time, result->Scale, cursors ? cursors + 2 : nullptr);
+}
+
+void CompressedAnimationData::Decompress(int32 channelIndex, NodeAnimationData& result) const
+{
+    const Channel& channel = Channels[channelIndex];
+    DecompressTrack(channel.Position, Data.Get(), result.Position);
+    DecompressTrack(channel.Rotation, Data.Get(), result.Rotation);
+    DecompressTrack(channel.Scale, Data.Get(), result.Scale);
+}
+
+int32 CompressedAnimationData::GetKeyframesCount() const
+{
+    int32 result = 0;
+    for (const Channel& channel : Channels)
+        result += channel.Position.Count + channel.Rotation.Count + channel.Scale.Count;
+    return result;
+}
+
+uint64 CompressedAnimationData::GetMemoryUsage() const
+{
+    return Channels.Capacity() * sizeof(Channel) + Data.Capacity() * sizeof(uint16);
+}
+
+void AnimationData::Compress(float maxError, const Span<AnimationCompressionNode>& nodes, AnimationCompressionStats& stats)
+{
+    PROFILE_CPU();
+    if (IsCompressed())
+        Decompress();
+    stats = AnimationCompressionStats();
+    stats.MemoryBefore = GetMemoryUsage();
+    stats.KeyframesBefore = GetKeyframesCount();
+
+    // Compress tracks
+    Compressed.Channels.Resize(Channels.Count());
+    Compressed.Data.Clear();
+    const AnimationCompressionNode defaultNode;
+    for (int32 i = 0; i < Channels.Count(); i++)
+    {
+        NodeAnimationData& channel = Channels[i];
+        const AnimationCompressionNode& node = i < nodes.Length() && nodes[i].IsValid ? nodes[i] : defaultNode;
+        const float nodeError = maxError / Math::Max(node.Length, ANIMATION_COMPRESSION_MIN_NODE_LENGTH);
+        CompressedAnimationData::Channel& compressed = Compressed.Channels[i];
+        CompressTrack(channel.Position, node.IsValid ? (Float3)node.DefaultPose.Translation : channel.Position.GetDefaultValue(), maxError, Compressed.Data, compressed.Position, stats);
+        CompressTrack(channel.Rotation, node.IsValid ? node.DefaultPose.Orientation : channel.Rotation.GetDefaultValue(), nodeError, Compressed.Data, compressed.Rotation, stats);
+        CompressTrack(channel.Scale, node.IsValid ? node.DefaultPose.Scale : channel.Scale.GetDefaultValue(), nodeError, Compressed.Data, compressed.Scale, stats);
+    }
+    Compressed.Data.SetCapacity(Compressed.Data.Count());
+
+    // Measure the compression error and release the curves
+    for (int32 i = 0; i < Channels.Count(); i++)
+    {
+        NodeAnimationData& channel = Channels[i];
+        const AnimationCompressionNode& node = i < nodes.Length() && nodes[i].IsValid ? nodes[i] : defaultNode;
+        const CompressedAnimationData::Channel& compressed = Compressed.Channels[i];
+        const uint16* data = Compressed.Data.Get();
+        stats.MaxPositionError = Math::Max(stats.MaxPositionError, GetTrackError(channel.Position, node.IsValid ? (Float3)node.DefaultPose.Translation : channel.Position.GetDefaultValue(), compressed.Position, data));
+        stats.MaxRotationError = Math::Max(stats.MaxRotationError, GetTrackError(channel.Rotation, node.IsValid ? node.DefaultPose.Orientation : channel.Rotation.GetDefaultValue(), compressed.Rotation, data) * RadiansToDegrees);
+        stats.MaxScaleError = Math::Max(stats.MaxScaleError, GetTrackError(channel.Scale, node.IsValid ? node.DefaultPose.Scale : channel.Scale.GetDefaultValue(), compressed.Scale, data));
+        channel.Position.GetKeyframes().SetCapacity(0, false);
+        channel.Rotation.GetKeyframes().SetCapacity(0, false);
+        channel.Scale.GetKeyframes().SetCapacity(0, false);
+    }
+
+    stats.MemoryAfter = GetMemoryUsage();
+    stats.KeyframesAfter = GetKeyframesCount();
+}
+
+void AnimationData::Decompress()
+{
+    if (!IsCompressed())
+        return;
+    PROFILE_CPU();
+    for (int32 i = 0; i < Channels.Count(); i++)
+        Compressed.Decompress(i, Channels[i]);
+    Compressed.Channels.SetCapacity(0, false);
+    Compressed.Data.SetCapacity(0, false);
+}
@@ -2,22 +2,22 @@
 
 #include "AnimationData.h"
 
-void NodeAnimationData::Evaluate(float time, Transform* result, bool loop) const
+void NodeAnimationData::Evaluate(float time, Transform* result, bool loop, int32* cursors) const
 {
     if (Position.GetKeyframes().HasItems())
 #if USE_LARGE_WORLDS
     {
         Float3 position;
-        Position.Evaluate(position, time, loop);
+        Position.Evaluate(position, time, loop, cursors);
         result->Translation = position;
     }
 #else
-        Position.Evaluate(result->Translation, time, loop);
+        Position.Evaluate(result->Translation, time, loop, cursors);
 #endif
     if (Rotation.GetKeyframes().HasItems())
-        Rotation.Evaluate(result->Orientation, time, loop);
+        Rotation.Evaluate(result->Orientation, time, loop, cursors ? cursors + 1 : nullptr);
     if (Scale.GetKeyframes().HasItems())
-        Scale.Evaluate(result->Scale, time, loop);
+        Scale.Evaluate(result->Scale, time, loop, cursors ? cursors + 2 : nullptr);
 }
 
 void NodeAnimationData::EvaluateAll(float time, Transform* result, bool loop) const
@@ -44,12 +44,13 @@ uint64 AnimationData::GetMemoryUsage() const
     uint64 result = (Name.Length() + RootNodeName.Length()) * sizeof(Char) + Channels.Capacity() * sizeof(NodeAnimationData);
     for (const auto& e : Channels)
         result += e.GetMemoryUsage();
+    result += Compressed.GetMemoryUsage();
     return result;
 }
 
 int32 AnimationData::GetKeyframesCount() const
 {
-    int32 result = 0;
+    int32 result = Compressed.GetKeyframesCount();
     for (int32 i = 0; i < Channels.Count(); i++)
         result += Channels[i].GetKeyframesCount();
     return result;
@@ -71,6 +72,8 @@ void AnimationData::Swap(AnimationData& other)
     ::Swap(Name, other.Name);
     ::Swap(RootNodeName, other.RootNodeName);
     Channels.Swap(other.Channels);
+    Compressed.Channels.Swap(other.Compressed.Channels);
+    Compressed.Data.Swap(other.Compressed.Data);
 }
 
 void AnimationData::Release()
@@ -81,4 +84,6 @@ void AnimationData::Release()
     RootNodeName.Clear();
     RootMotionFlags = AnimationRootMotionFlags::None;
     Channels.Resize(0);
+    Compressed.Channels.Resize(0);
+    Compressed.Data.Resize(0);
 }
@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Core/Math/Transform.h"
 #include "Engine/Animations/Curve.h"
 
@@ -51,7 +52,8 @@ struct NodeAnimationData
     /// <param name="time">The time to evaluate the curves at.</param>
     /// <param name="result">The interpolated value from the curve at provided time.</param>
     /// <param name="loop">If true the curve will loop when it goes past the end or beginning. Otherwise the curve value will be clamped.</param>
-    void Evaluate(float time, Transform* result, bool loop = true) const;
+    /// <param name="cursors">The optional keyframe cursors for the position, rotation and scale curves (3 items). Used as search hints and updated for the next evaluation.</param>
+    void Evaluate(float time, Transform* result, bool loop = true, int32* cursors = nullptr) const;
 
     /// <summary>
     /// Evaluates the animation transformation at the specified time.
@@ -69,6 +71,174 @@ struct NodeAnimationData
     uint64 GetMemoryUsage() const;
 };
 
+/// <summary>
+/// Compressed animation channel track. Keyframes use 16-bit times and values quantized within the track range.
+/// </summary>
+struct FLAXENGINE_API AnimationCompressedTrack
+{
+    /// <summary>
+    /// The keyframes count. Zero if track has been stripped (node uses its default pose), one if track has a constant value.
+    /// </summary>
+    int32 Count = 0;
+
+    /// <summary>
+    /// The offset of the track in the compressed data (keyframe times if track has more than one keyframe, then 3 values per keyframe). Raw tracks use 2 items per time and 2 items per value component.
+    /// </summary>
+    int32 Offset = 0;
+
+    /// <summary>
+    /// The time of the first keyframe.
+    /// </summary>
+    float TimeStart = 0.0f;
+
+    /// <summary>
+    /// The scale of the quantized keyframe times.
+    /// </summary>
+    float TimeScale = 0.0f;
+
+    /// <summary>
+    /// The minimum of the track values range. Unused by rotation tracks (quaternions use smallest three components encoding).
+    /// </summary>
+    Float3 ValueMin = Float3::Zero;
+
+    /// <summary>
+    /// The scale of the quantized track values. Unused by rotation tracks.
+    /// </summary>
+    Float3 ValueScale = Float3::Zero;
+
+    /// <summary>
+    /// True if the keyframe times and values are stored as raw floats (not quantized). Used when quantization cannot represent the track within the error threshold (eg. root motion over a large distance).
+    /// </summary>
+    bool Raw = false;
+};
+
+/// <summary>
+/// Compressed skeleton node animation channels. Stores range-reduced and quantized keyframes (constant and default tracks are stripped).
+/// </summary>
+struct FLAXENGINE_API CompressedAnimationData
+{
+    /// <summary>
+    /// Compressed channel tracks.
+    /// </summary>
+    struct Channel
+    {
+        AnimationCompressedTrack Position;
+        AnimationCompressedTrack Rotation;
+        AnimationCompressedTrack Scale;
+    };
+
+    /// <summary>
+    /// The compressed node animation channels (the same order as in the animation data).
+    /// </summary>
+    Array<Channel> Channels;
+
+    /// <summary>
+    /// The quantized keyframes data of all tracks.
+    /// </summary>
+    Array<uint16> Data;
+
+public:
+    /// <summary>
+    /// Evaluates the node animation transformation at the specified time (only for the non-stripped tracks). Time is clamped to the tracks range.
+    /// </summary>
+    /// <param name="channelIndex">The channel index.</param>
+    /// <param name="time">The time to evaluate the tracks at.</param>
+    /// <param name="result">The interpolated value from the tracks at provided time.</param>
+    /// <param name="cursors">The optional keyframe cursors for the position, rotation and scale tracks (3 items). Used as search hints and updated for the next evaluation.</param>
+    void Evaluate(int32 channelIndex, float time, Transform* result, int32* cursors = nullptr) const;
+
+    /// <summary>
+    /// Decompresses the channel tracks into the animation curves (stripped tracks result in empty curves).
+    /// </summary>
+    /// <param name="channelIndex">The channel index.</param>
+    /// <param name="result">The output channel curves.</param>
+    void Decompress(int32 channelIndex, struct NodeAnimationData& result) const;
+
+    /// <summary>
+    /// Gets the total amount of keyframes in the compressed tracks.
+    /// </summary>
+    int32 GetKeyframesCount() const;
+
+    uint64 GetMemoryUsage() const;
+};
+
+/// <summary>
+/// The skeleton node information used by the animation compression to measure the error of the animated node.
+/// </summary>
+struct AnimationCompressionNode
+{
+    /// <summary>
+    /// The node default pose (local-space). Tracks that match it are stripped.
+    /// </summary>
+    Transform DefaultPose = Transform::Identity;
+
+    /// <summary>
+    /// The distance from the node to its farthest child node (in the default pose). Rotation and scale errors are scaled by it (they move the whole sub-tree of nodes).
+    /// </summary>
+    float Length = 0.0f;
+
+    /// <summary>
+    /// True if node info is valid, otherwise default values are used.
+    /// </summary>
+    bool IsValid = false;
+};
+
+/// <summary>
+/// The animation compression results.
+/// </summary>
+struct AnimationCompressionStats
+{
+    /// <summary>
+    /// The animation data memory usage before the compression (in bytes).
+    /// </summary>
+    uint64 MemoryBefore = 0;
+
+    /// <summary>
+    /// The animation data memory usage after the compression (in bytes).
+    /// </summary>
+    uint64 MemoryAfter = 0;
+
+    /// <summary>
+    /// The total amount of keyframes before the compression.
+    /// </summary>
+    int32 KeyframesBefore = 0;
+
+    /// <summary>
+    /// The total amount of keyframes after the compression.
+    /// </summary>
+    int32 KeyframesAfter = 0;
+
+    /// <summary>
+    /// The amount of tracks removed because they were constant and matched the node default pose.
+    /// </summary>
+    int32 StrippedTracks = 0;
+
+    /// <summary>
+    /// The amount of constant tracks reduced to a single keyframe.
+    /// </summary>
+    int32 ConstantTracks = 0;
+
+    /// <summary>
+    /// The amount of tracks stored without quantization because it would exceed the error threshold.
+    /// </summary>
+    int32 RawTracks = 0;
+
+    /// <summary>
+    /// The largest position difference between the source keyframes and the compressed track (in units).
+    /// </summary>
+    float MaxPositionError = 0.0f;
+
+    /// <summary>
+    /// The largest rotation difference between the source keyframes and the compressed track (in degrees).
+    /// </summary>
+    float MaxRotationError = 0.0f;
+
+    /// <summary>
+    /// The largest scale difference between the source keyframes and the compressed track.
+    /// </summary>
+    float MaxScaleError = 0.0f;
+};
+
 /// <summary>
 /// Single track with events.
 /// </summary>
@@ -140,6 +310,11 @@ struct AnimationData
     /// </summary>
     Array<Pair<String, StepCurve<EventAnimationData>>> Events;
 
+    /// <summary>
+    /// The compressed animation channels. Used instead of the channel curves (which are empty) if animation is compressed.
+    /// </summary>
+    CompressedAnimationData Compressed;
+
 public:
     /// <summary>
     /// Gets the length of the animation (in seconds).
@@ -152,6 +327,29 @@ struct AnimationData
         return static_cast<float>(Duration / FramesPerSecond);
     }
 
+    /// <summary>
+    /// Returns true if animation channels are compressed.
+    /// </summary>
+    FORCE_INLINE bool IsCompressed() const
+    {
+        return Compressed.Channels.HasItems();
+    }
+
+    /// <summary>
+    /// Evaluates the node animation channel transformation at the specified time (only for the non-empty tracks). Time is clamped to the animation range. Supports compressed animations.
+    /// </summary>
+    /// <param name="channelIndex">The channel index.</param>
+    /// <param name="time">The time to evaluate the channel at.</param>
+    /// <param name="result">The interpolated value from the channel at provided time.</param>
+    /// <param name="cursors">The optional keyframe cursors for the channel tracks (3 items). Used as search hints and updated for the next evaluation. Speeds up sampling when time changes monotonically (eg. animation playback).</param>
+    FORCE_INLINE void EvaluateChannel(int32 channelIndex, float time, Transform* result, int32* cursors = nullptr) const
+    {
+        if (Compressed.Channels.HasItems())
+            Compressed.Evaluate(channelIndex, time, result, cursors);
+        else
+            Channels.Get()[channelIndex].Evaluate(time, result, false, cursors);
+    }
+
     uint64 GetMemoryUsage() const;
 
     /// <summary>
@@ -161,6 +359,19 @@ struct AnimationData
 
     NodeAnimationData* GetChannel(const StringView& name);
 
+    /// <summary>
+    /// Compresses the animation channels. Removes redundant keyframes (within the error threshold), strips constant and default tracks and quantizes keyframes. Channel curves are released after compression.
+    /// </summary>
+    /// <param name="maxError">The maximum allowed error (in units). Measured at the distance of the node length (rotation and scale error) to respect nodes hierarchy.</param>
+    /// <param name="nodes">The skeleton nodes information for each animation channel (optional, default values are used if empty).</param>
+    /// <param name="stats">The compression results.</param>
+    void Compress(float maxError, const Span<AnimationCompressionNode>& nodes, AnimationCompressionStats& stats);
+
+    /// <summary>
+    /// Decompresses the animation channels back into the curves (keyframes reduced by the compression are not restored).
+    /// </summary>
+    void Decompress();
+
     /// <summary>
     /// Swaps the contents of object with the other object without copy operation. Performs fast internal data exchange.
     /// </summary>
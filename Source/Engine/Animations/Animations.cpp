@@ -3,6 +3,7 @@
 #include "Animations.h"
 #include "AnimEvent.h"
 #include "Engine/Engine/Engine.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Level/Actors/AnimatedModel.h"
@@ -14,6 +15,9 @@ class AnimationsService : public EngineService
 {
 public:
     Array<AnimatedModel*> UpdateList;
+    Array<AnimatedModel*> InterpolationList;
+    Array<Animations::BudgetItem> BudgetList;
+    Animations::UpdateStats Stats;
 
     AnimationsService()
         : EngineService(TEXT("Animations"), -10)
@@ -30,6 +34,7 @@ class AnimationsSystem : public TaskGraphSystem
     float DeltaTime, UnscaledDeltaTime, Time, UnscaledTime;
     bool Active;
 
+    void ApplyBudget();
     void Job(int32 index);
     void Execute(TaskGraph* graph) override;
     void PostExecute(TaskGraph* graph) override;
@@ -49,11 +54,21 @@ namespace
 #endif
                 && animGraph->Graph.IsReady();
     }
+
+    bool SortByPriority(const Animations::BudgetItem& a, const Animations::BudgetItem& b)
+    {
+        // Update higher quality LODs first, then the models that wait longer for the update
+        if (a.LOD != b.LOD)
+            return a.LOD < b.LOD;
+        return a.Delay > b.Delay;
+    }
 }
 
 AnimationsService AnimationManagerInstance;
 TaskGraphSystem* Animations::System = nullptr;
 ReadWriteLock Animations::SystemLocker;
+float Animations::UpdateBudget = 0.0f;
+int32 Animations::LODMaxNodesDepth = 8;
 #if USE_EDITOR
 Delegate<Animations::DebugFlowInfo> Animations::DebugFlow;
 #endif
@@ -79,16 +94,62 @@ bool AnimationsService::Init()
 void AnimationsService::Dispose()
 {
     UpdateList.Resize(0);
+    InterpolationList.Resize(0);
+    BudgetList.Resize(0);
     SAFE_DELETE(Animations::System);
 }
 
+void AnimationsSystem::ApplyBudget()
+{
+    PROFILE_CPU();
+    auto& updateList = AnimationManagerInstance.UpdateList;
+    auto& budgetList = AnimationManagerInstance.BudgetList;
+    budgetList.Resize(updateList.Count(), false);
+    for (int32 index = 0; index < updateList.Count(); index++)
+    {
+        auto animatedModel = updateList[index];
+        auto& item = budgetList[index];
+        item.Model = animatedModel;
+        item.LOD = animatedModel->_animationLOD;
+        item.Cost = animatedModel->_updateCost;
+        item.Delay = animatedModel->_updateDelay;
+    }
+    const int32 count = Animations::ApplyBudget(budgetList, Animations::UpdateBudget, AnimationManagerInstance.Stats);
+    updateList.Resize(count, false);
+    for (int32 index = 0; index < count; index++)
+        updateList[index] = budgetList[index].Model;
+    for (int32 index = count; index < budgetList.Count(); index++)
+        budgetList[index].Model->_updateDelay = (uint8)budgetList[index].Delay;
+}
+
 void AnimationsSystem::Job(int32 index)
 {
     PROFILE_CPU_NAMED("Animations.Job");
     PROFILE_MEM(Animations);
+    const int32 updateCount = AnimationManagerInstance.UpdateList.Count();
+    if (index >= updateCount)
+    {
+        // Interpolate pose between the updates
+        auto animatedModel = AnimationManagerInstance.InterpolationList[index - updateCount];
+        if (CanUpdateModel(animatedModel))
+        {
+            auto& instance = animatedModel->GraphInstance;
+            animatedModel->_interpolationFrame++;
+            if (AnimGraphExecutor::Interpolate(instance, (float)animatedModel->_interpolationFrame / animatedModel->_updateRate))
+            {
+                animatedModel->SetupSkinningData();
+                animatedModel->OnAnimationUpdated_Async();
+            }
+
+            // Root motion is applied only by the graph update
+            instance.RootMotion = Transform::Identity;
+        }
+        return;
+    }
     auto animatedModel = AnimationManagerInstance.UpdateList[index];
     if (CanUpdateModel(animatedModel))
     {
+        const double startTime = Platform::GetTimeSeconds();
         auto graph = animatedModel->AnimationGraph.Get();
 #if COMPILE_WITH_PROFILER && TRACY_ENABLE
         const StringView graphName(graph->GetPath());
@@ -111,21 +172,31 @@ void AnimationsSystem::Job(int32 index)
 
         // Evaluate animated nodes pose
         graph->GraphExecutor.Update(animatedModel->GraphInstance, dt);
+        animatedModel->_updateDelay = 0;
+        animatedModel->_interpolationFrame = 1;
+        if (animatedModel->GraphInstance.EnablePoseInterpolation)
+            AnimGraphExecutor::Interpolate(animatedModel->GraphInstance, 1.0f / animatedModel->_updateRate);
 
         // Update gameplay
         animatedModel->OnAnimationUpdated_Async();
+        animatedModel->_updateTime = (float)((Platform::GetTimeSeconds() - startTime) * 1000.0);
     }
 }
 
 void AnimationsSystem::Execute(TaskGraph* graph)
 {
-    if (AnimationManagerInstance.UpdateList.Count() == 0)
+    AnimationManagerInstance.Stats = Animations::UpdateStats();
+    if (AnimationManagerInstance.UpdateList.Count() == 0 && AnimationManagerInstance.InterpolationList.Count() == 0)
         return;
     Active = true;
 
     // Ensure no animation assets can be reloaded/modified during async update
     Animations::SystemLocker.ReadLock();
 
+    // Stagger updates across frames to fit into the time budget
+    if (Animations::UpdateBudget > 0.0f && AnimationManagerInstance.UpdateList.Count() > 1)
+        ApplyBudget();
+
     // Setup data for async update
     const auto& tickData = Time::Update;
     DeltaTime = tickData.DeltaTime.GetTotalSeconds();
@@ -142,7 +213,7 @@ void AnimationsSystem::Execute(TaskGraph* graph)
     // Schedule work to update all animated models in async
     Function<void(int32)> job;
     job.Bind<AnimationsSystem, &AnimationsSystem::Job>(this);
-    graph->DispatchJob(job, AnimationManagerInstance.UpdateList.Count());
+    graph->DispatchJob(job, AnimationManagerInstance.UpdateList.Count() + AnimationManagerInstance.InterpolationList.Count(), JobPriority::FrameCritical);
 }
 
 void AnimationsSystem::PostExecute(TaskGraph* graph)
@@ -153,6 +224,7 @@ void AnimationsSystem::PostExecute(TaskGraph* graph)
     PROFILE_MEM(Animations);
 
     // Update gameplay
+    auto& stats = AnimationManagerInstance.Stats;
     for (int32 index = 0; index < AnimationManagerInstance.UpdateList.Count(); index++)
     {
         auto animatedModel = AnimationManagerInstance.UpdateList[index];
@@ -160,11 +232,27 @@ void AnimationsSystem::PostExecute(TaskGraph* graph)
         {
             animatedModel->GraphInstance.InvokeAnimEvents();
             animatedModel->OnAnimationUpdated_Sync();
+
+            // Track the update time of the model (smoothed) for the update budget
+            const float updateTime = animatedModel->_updateTime;
+            animatedModel->_updateCost = animatedModel->_updateCost > 0.0f ? Math::Lerp(animatedModel->_updateCost, updateTime, 0.2f) : updateTime;
+            stats.EvaluationTime += updateTime;
+            stats.Evaluated++;
+        }
+    }
+    for (int32 index = 0; index < AnimationManagerInstance.InterpolationList.Count(); index++)
+    {
+        auto animatedModel = AnimationManagerInstance.InterpolationList[index];
+        if (CanUpdateModel(animatedModel))
+        {
+            animatedModel->OnAnimationUpdated_Sync();
+            stats.Interpolated++;
         }
     }
 
     // Cleanup
     AnimationManagerInstance.UpdateList.Clear();
+    AnimationManagerInstance.InterpolationList.Clear();
     Animations::SystemLocker.ReadUnlock();
     Active = false;
 }
@@ -175,8 +263,41 @@ void Animations::AddToUpdate(AnimatedModel* obj)
     AnimationManagerInstance.UpdateList.Add(obj);
 }
 
+void Animations::AddToInterpolation(AnimatedModel* obj)
+{
+    ScopeWriteLock lock(SystemLocker);
+    AnimationManagerInstance.InterpolationList.Add(obj);
+}
+
 void Animations::RemoveFromUpdate(AnimatedModel* obj)
 {
     ScopeWriteLock lock(SystemLocker);
     AnimationManagerInstance.UpdateList.Remove(obj);
+    AnimationManagerInstance.InterpolationList.Remove(obj);
+}
+
+int32 Animations::ApplyBudget(Array<BudgetItem>& items, float budget, UpdateStats& stats)
+{
+    Sorting::QuickSort(items.Get(), items.Count(), &SortByPriority);
+
+    // Postpone the models that don't fit into the budget (based on the last update time of each model)
+    int32 count = 0;
+    for (int32 index = 0; index < items.Count(); index++)
+    {
+        auto& item = items[index];
+        if (count != 0 && item.Cost > budget && item.Delay < ANIMATIONS_MAX_UPDATE_DELAY)
+        {
+            item.Delay++;
+            stats.Skipped++;
+            continue;
+        }
+        budget -= item.Cost;
+        Swap(items[count++], item);
+    }
+    return count;
+}
+
+Animations::UpdateStats Animations::GetStats()
+{
+    return AnimationManagerInstance.Stats;
 }
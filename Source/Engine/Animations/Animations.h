@@ -4,6 +4,10 @@
 
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Core/Delegate.h"
+#include "Engine/Core/Collections/Array.h"
+
+// The maximum amount of frames the animated model update can be postponed due to the update budget
+#define ANIMATIONS_MAX_UPDATE_DELAY 4
 
 class TaskGraphSystem;
 class AnimatedModel;
@@ -24,6 +28,47 @@ API_CLASS(Static) class FLAXENGINE_API Animations
     // Data access locker for animations data.
     static ReadWriteLock SystemLocker;
 
+    /// <summary>
+    /// The animations update statistics.
+    /// </summary>
+    API_STRUCT(NoDefault) struct UpdateStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(UpdateStats);
+
+        // The amount of animated models with the Anim Graph evaluated.
+        API_FIELD() int32 Evaluated = 0;
+        // The amount of animated models with the pose interpolated between the updates.
+        API_FIELD() int32 Interpolated = 0;
+        // The amount of animated models with the update skipped (postponed to the next frame) due to the update time budget.
+        API_FIELD() int32 Skipped = 0;
+        // The total time (in milliseconds) of the Anim Graph evaluation (sum from all threads).
+        API_FIELD() float EvaluationTime = 0.0f;
+    };
+
+    /// <summary>
+    /// The animated model update used when applying the update time budget.
+    /// </summary>
+    struct BudgetItem
+    {
+        AnimatedModel* Model;
+        // The animation LOD (higher quality LODs are updated first).
+        int32 LOD;
+        // The model update time (in milliseconds, smoothed over the last updates).
+        float Cost;
+        // The amount of frames the model update was already postponed.
+        int32 Delay;
+    };
+
+    /// <summary>
+    /// The animations update time budget (in milliseconds, as a sum from all threads). Animated models that don't fit into the budget are updated in the next frames (lower LODs first). Use 0 to disable it.
+    /// </summary>
+    API_FIELD() static float UpdateBudget;
+
+    /// <summary>
+    /// The maximum depth of the skeleton nodes that are animated at far animation LOD (deeper nodes, such as fingers or face bones, use the bind pose). Used by animated models with the automatic update mode.
+    /// </summary>
+    API_FIELD() static int32 LODMaxNodesDepth;
+
 #if USE_EDITOR
     // Data wrapper for the debug flow information.
     API_STRUCT(NoDefault) struct DebugFlowInfo
@@ -52,9 +97,29 @@ API_CLASS(Static) class FLAXENGINE_API Animations
     /// <param name="obj">The object.</param>
     static void AddToUpdate(AnimatedModel* obj);
 
+    /// <summary>
+    /// Adds an animated model to interpolate its pose between the updates.
+    /// </summary>
+    /// <param name="obj">The object.</param>
+    static void AddToInterpolation(AnimatedModel* obj);
+
     /// <summary>
     /// Removes the animated model from update.
     /// </summary>
     /// <param name="obj">The object.</param>
     static void RemoveFromUpdate(AnimatedModel* obj);
+
+    /// <summary>
+    /// Postpones the updates that don't fit into the time budget. Items are sorted by priority (LOD, then delay) and the postponed items are moved to the end of the list with their delay incremented. The first item is always updated and updates are postponed for at most ANIMATIONS_MAX_UPDATE_DELAY frames.
+    /// </summary>
+    /// <param name="items">The updates to limit.</param>
+    /// <param name="budget">The time budget (in milliseconds).</param>
+    /// <param name="stats">The update statistics to count the skipped models.</param>
+    /// <returns>The amount of items to update (at the beginning of the list).</returns>
+    static int32 ApplyBudget(Array<BudgetItem>& items, float budget, UpdateStats& stats);
+
+    /// <summary>
+    /// Gets the animations update statistics from the last frame.
+    /// </summary>
+    API_PROPERTY() static UpdateStats GetStats();
 };
@@ -344,7 +344,8 @@ class CurveBase
     /// <param name="result">The interpolated value from the curve at provided time.</param>
     /// <param name="time">The time to evaluate the curve at.</param>
     /// <param name="loop">If true the curve will loop when it goes past the end or beginning. Otherwise the curve value will be clamped.</param>
-    void Evaluate(const KeyFrameData& data, T& result, float time, bool loop = true) const
+    /// <param name="cursor">The optional keyframe cursor (index of the last sampled keyframe). Used as a search hint and updated for the next evaluation. Speeds up sampling when time changes monotonically (eg. animation playback).</param>
+    void Evaluate(const KeyFrameData& data, T& result, float time, bool loop = true, int32* cursor = nullptr) const
     {
         const int32 count = data.Length();
         if (count == 0)
@@ -359,7 +360,10 @@ class CurveBase
 
         int32 leftKeyIdx;
         int32 rightKeyIdx;
-        FindKeys(data, time, leftKeyIdx, rightKeyIdx);
+        if (cursor)
+            FindKeys(data, time, leftKeyIdx, rightKeyIdx, *cursor);
+        else
+            FindKeys(data, time, leftKeyIdx, rightKeyIdx);
 
         const KeyFrame& leftKey = data[leftKeyIdx];
         const KeyFrame& rightKey = data[rightKeyIdx];
@@ -495,6 +499,35 @@ class CurveBase
         leftKey = Math::Max(0, start - 1);
         rightKey = Math::Min(start, data.Length() - 1);
     }
+
+    /// <summary>
+    /// Returns a pair of keys that can be used for interpolating to field the value at the provided time. Uses the cursor from the previous search to find keys in constant time if time moved forward by a few keyframes, otherwise fallbacks to the binary search.
+    /// </summary>
+    /// <param name="data">The keyframes data container.</param>
+    /// <param name="time">The time for which to find the relevant keys from. It is expected to be clamped to a valid range within the curve.</param>
+    /// <param name="leftKey">The index of the key to interpolate from.</param>
+    /// <param name="rightKey">The index of the key to interpolate to.</param>
+    /// <param name="cursor">The index of the key found by the previous search. Updated with the left key index.</param>
+    void FindKeys(const KeyFrameData& data, float time, int32& leftKey, int32& rightKey, int32& cursor) const
+    {
+        const int32 count = data.Length();
+        int32 key = cursor;
+        if (key >= 0 && key < count && data[key].Time <= time)
+        {
+            // Move forward from the last key
+            const int32 end = Math::Min(key + 4, count - 1);
+            while (key < end && data[key + 1].Time <= time)
+                key++;
+            if (key == count - 1 || time < data[key + 1].Time)
+            {
+                leftKey = cursor = key;
+                rightKey = Math::Min(key + 1, count - 1);
+                return;
+            }
+        }
+        FindKeys(data, time, leftKey, rightKey);
+        cursor = leftKey;
+    }
 };
 
 /// <summary>
@@ -626,10 +659,11 @@ API_CLASS(InBuild, Template, MarshalAs=Span<byte>) class Curve : public CurveBas
     /// <param name="result">The interpolated value from the curve at provided time.</param>
     /// <param name="time">The time to evaluate the curve at.</param>
     /// <param name="loop">If true the curve will loop when it goes past the end or beginning. Otherwise the curve value will be clamped.</param>
-    void Evaluate(T& result, float time, bool loop = true) const
+    /// <param name="cursor">The optional keyframe cursor (index of the last sampled keyframe). Used as a search hint and updated for the next evaluation.</param>
+    void Evaluate(T& result, float time, bool loop = true, int32* cursor = nullptr) const
     {
         typename Base::KeyFrameData data(_keyframes.Get(), _keyframes.Count());
-        Base::Evaluate(data, result, time, loop);
+        Base::Evaluate(data, result, time, loop, cursor);
     }
 
     /// <summary>
@@ -76,6 +76,10 @@ void AnimGraphInstanceData::ClearState()
     DynamicState.Resize(0);
     NodesPose.Resize(0);
     TraceEvents.Clear();
+    InterpolationPoseFrom.Resize(0);
+    InterpolationPoseTo.Resize(0);
+    KeyframeCursors.Resize(0);
+    KeyframeCursorsRanges.Clear();
 }
 
 void AnimGraphInstanceData::Invalidate()
@@ -116,6 +120,27 @@ Transform AnimGraphInstanceData::GetObjectTransform() const
     return Transform::Identity;
 }
 
+int32* AnimGraphInstanceData::GetKeyframeCursors(const AnimGraphNode* node, const Animation* anim, int32 count)
+{
+    const Pair<const AnimGraphNode*, const Animation*> key(node, anim);
+    Int2* range = KeyframeCursorsRanges.TryGet(key);
+    if (range && range->Y == count)
+        return KeyframeCursors.Get() + range->X;
+
+    // Allocate cursors for a new animation (cursors are only the search hints so reset all when too many animations were sampled)
+    if (KeyframeCursors.Count() + count > ANIM_GRAPH_MAX_KEYFRAME_CURSORS)
+    {
+        KeyframeCursors.Clear();
+        KeyframeCursorsRanges.Clear();
+        if (count > ANIM_GRAPH_MAX_KEYFRAME_CURSORS)
+            return nullptr;
+    }
+    const int32 start = KeyframeCursors.Count();
+    KeyframeCursors.AddZeroed(count);
+    KeyframeCursorsRanges[key] = Int2(start, count);
+    return KeyframeCursors.Get() + start;
+}
+
 AnimGraphInstanceData::OutgoingEvent AnimGraphInstanceData::ActiveEvent::End(AnimatedModel* actor) const
 {
     OutgoingEvent out;
@@ -298,6 +323,7 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         context.CallStack.Clear();
         context.Functions.Clear();
         context.PoseCacheSize = 0;
+        context.PoseANodes = nullptr;
         context.ValueCache.Clear();
 
         // Prepare instance data
@@ -326,6 +352,24 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         context.EmptyNodes.Nodes.Resize(_skeletonNodesCount, false);
         for (int32 i = 0; i < _skeletonNodesCount; i++)
             context.EmptyNodes.Nodes.Get()[i] = skeleton.Nodes.Get()[i].LocalTransform;
+
+        // Init poses used for sampling and blending
+        context.EmptyPose.Resize(_skeletonNodesCount);
+        context.EmptyPose.Load(context.EmptyNodes.Nodes.Get());
+        context.PoseA.Resize(_skeletonNodesCount);
+        context.PoseB.Resize(_skeletonNodesCount);
+        context.PoseWeights.Resize(context.EmptyPose.Stride, false);
+
+        // Init nodes depth used to reduce the sampled nodes count
+        if (data.MaxNodesDepth < MAX_int32)
+        {
+            context.NodesDepth.Resize(_skeletonNodesCount, false);
+            for (int32 i = 0; i < _skeletonNodesCount; i++)
+            {
+                const int32 parentIndex = skeleton.Nodes.Get()[i].ParentIndex;
+                context.NodesDepth.Get()[i] = parentIndex != -1 ? context.NodesDepth.Get()[parentIndex] + 1 : 0;
+            }
+        }
     }
 
     // Update the animation graph and gather skeleton nodes transformations in nodes local space
@@ -437,6 +481,25 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         data.RootMotion = animResult->RootMotion;
     }
 
+    // Cache the pose for the interpolation between the updates
+    if (data.EnablePoseInterpolation)
+    {
+        const int32 nodesCount = animResultSkeleton->Nodes.Count();
+        Swap(data.InterpolationPoseFrom, data.InterpolationPoseTo);
+        data.InterpolationPoseTo.Resize(nodesCount);
+        data.InterpolationPoseTo.Load(animResult->Nodes.Get());
+        if (data.InterpolationPoseFrom.Count != nodesCount)
+        {
+            data.InterpolationPoseFrom.Resize(nodesCount);
+            data.InterpolationPoseFrom.Copy(data.InterpolationPoseTo);
+        }
+    }
+    else if (data.InterpolationPoseTo.Count != 0)
+    {
+        data.InterpolationPoseFrom.Resize(0);
+        data.InterpolationPoseTo.Resize(0);
+    }
+
     // Invoke any async anim events
     context.Data->InvokeAnimEvents();
 
@@ -444,6 +507,26 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
     context.Data = nullptr;
 }
 
+bool AnimGraphExecutor::Interpolate(AnimGraphInstanceData& data, float alpha)
+{
+    const AnimGraphPose& from = data.InterpolationPoseFrom;
+    const AnimGraphPose& to = data.InterpolationPoseTo;
+    if (to.Count == 0 || from.Count != to.Count || to.Count != data.NodesPose.Count())
+        return false;
+    ANIM_GRAPH_PROFILE_EVENT("Interpolate");
+    auto& contextPtr = Context.Get();
+    if (!contextPtr)
+        contextPtr = New<AnimGraphContext>();
+    AnimGraphPose& pose = contextPtr->PoseA;
+    contextPtr->PoseANodes = nullptr;
+    pose.Resize(to.Count);
+    AnimGraphPose::Lerp(from, to, Math::Saturate(alpha), nullptr, pose);
+    for (int32 nodeIndex = 0; nodeIndex < pose.Count; nodeIndex++)
+        pose.GetTransform(nodeIndex).GetWorld(data.NodesPose.Get()[nodeIndex]);
+    data.RootTransform = pose.GetTransform(0);
+    return true;
+}
+
 void AnimGraphExecutor::GetInputValue(Box* box, Value& result)
 {
     result = eatBox(box->GetParent<Node>(), box->FirstConnection());
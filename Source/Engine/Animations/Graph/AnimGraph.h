@@ -8,6 +8,7 @@
 #include "Engine/Core/Collections/BitArray.h"
 #include "Engine/Animations/AlphaBlend.h"
 #include "Engine/Core/Math/Matrix.h"
+#include "AnimGraphPose.h"
 #include "../Config.h"
 
 #define ANIM_GRAPH_PARAM_BASE_MODEL_ID Guid(1000, 0, 0, 0)
@@ -17,6 +18,7 @@
 #define ANIM_GRAPH_MULTI_BLEND_INVALID 0xff
 #define ANIM_GRAPH_MAX_CALL_STACK 100
 #define ANIM_GRAPH_MAX_EVENTS 64
+#define ANIM_GRAPH_MAX_KEYFRAME_CURSORS 16384
 
 class AnimGraph;
 class AnimSubGraph;
@@ -368,6 +370,41 @@ class FLAXENGINE_API AnimGraphInstanceData
     /// </summary>
     Array<AnimGraphSlot, InlinedAllocation<4>> Slots;
 
+    /// <summary>
+    /// The maximum depth of the skeleton nodes to sample (deeper nodes, such as fingers or face bones, use the bind pose). Used by the animation LOD to reduce the bones count for the distant models.
+    /// </summary>
+    int32 MaxNodesDepth = MAX_int32;
+
+    /// <summary>
+    /// True if Inverse Kinematics nodes are evaluated, otherwise they are skipped (eg. at far animation LOD).
+    /// </summary>
+    bool EnableIK = true;
+
+    /// <summary>
+    /// True if animation events are collected, otherwise they are skipped (eg. at far animation LOD).
+    /// </summary>
+    bool EnableEvents = true;
+
+    /// <summary>
+    /// True if the graph update caches the nodes pose to interpolate it between the updates (when animation is not updated every frame).
+    /// </summary>
+    bool EnablePoseInterpolation = false;
+
+    /// <summary>
+    /// The nodes poses (in actor local-space) of the last two graph updates. Used by the pose interpolation.
+    /// </summary>
+    AnimGraphPose InterpolationPoseFrom, InterpolationPoseTo;
+
+    /// <summary>
+    /// The keyframe cursors of the sampled animations (per channel track). Used as search hints when sampling animations because playback time changes nearly monotonically between updates.
+    /// </summary>
+    Array<int32> KeyframeCursors;
+
+    /// <summary>
+    /// The ranges of the keyframe cursors for each animation sampled by the graph node (start index and count).
+    /// </summary>
+    Dictionary<Pair<const AnimGraphNode*, const Animation*>, Int2> KeyframeCursorsRanges;
+
 public:
     /// <summary>
     /// Clears this container data.
@@ -395,6 +432,15 @@ class FLAXENGINE_API AnimGraphInstanceData
     /// <returns>Transformation from model/local space to world space.</returns>
     Transform GetObjectTransform() const;
 
+    /// <summary>
+    /// Gets the keyframe cursors for the animation sampled by the graph node.
+    /// </summary>
+    /// <param name="node">The graph node.</param>
+    /// <param name="anim">The sampled animation.</param>
+    /// <param name="count">The cursors count (3 per animation channel).</param>
+    /// <returns>The cursors data.</returns>
+    int32* GetKeyframeCursors(const AnimGraphNode* node, const Animation* anim, int32 count);
+
 public:
     // Anim Graph logic tracing feature that allows to collect insights of animations sampling and skeleton poses operations.
     bool EnableTracing = false;
@@ -785,6 +831,12 @@ struct AnimGraphContext
     uint64 CurrentFrameIndex;
     AnimGraphInstanceData* Data;
     AnimGraphImpulse EmptyNodes;
+    AnimGraphPose EmptyPose;
+    AnimGraphPose PoseA, PoseB;
+    // The nodes that were stored from PoseA by the last sampling or blend node (PoseA still holds them). Lets the next blend node skip loading the pose again.
+    const AnimGraphImpulse* PoseANodes;
+    Array<float> PoseWeights;
+    Array<int32> NodesDepth;
     AnimGraphTransitionData TransitionData;
     bool StackOverFlow;
     Array<VisjectExecutor::Node*, FixedAllocation<ANIM_GRAPH_MAX_CALL_STACK>> CallStack;
@@ -832,6 +884,14 @@ class AnimGraphExecutor : public VisjectExecutor
     /// <param name="dt">The delta time (in seconds).</param>
     void Update(AnimGraphInstanceData& data, float dt);
 
+    /// <summary>
+    /// Interpolates the nodes pose between the last two graph updates (requires pose interpolation to be enabled in the instance data).
+    /// </summary>
+    /// <param name="data">The instance data.</param>
+    /// <param name="alpha">The interpolation alpha (0 for the pose before the last update, 1 for the last update pose).</param>
+    /// <returns>True if the pose was interpolated, otherwise false (eg. graph was not updated yet).</returns>
+    static bool Interpolate(AnimGraphInstanceData& data, float alpha);
+
     void GetInputValue(Box* box, Value& result);
 
     /// <summary>
@@ -874,16 +934,11 @@ class AnimGraphExecutor : public VisjectExecutor
     void ProcessGroupCustom(Box* boxBase, Node* nodeBase, Value& value);
     void ProcessGroupFunction(Box* boxBase, Node* node, Value& value);
 
-    enum class ProcessAnimationMode
-    {
-        Override,
-        Add,
-        BlendAdditive,
-    };
+    using ProcessAnimationMode = AnimGraphPose::BlendMode;
 
     int32 GetRootNodeIndex(Animation* anim);
     void ProcessAnimEvents(AnimGraphNode* node, bool loop, float length, float animPos, float animPrevPos, Animation* anim, float speed);
-    void ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode* node, bool loop, float length, float pos, float prevPos, Animation* anim, float speed, float weight = 1.0f, ProcessAnimationMode mode = ProcessAnimationMode::Override, BitArray<InlinedAllocation<8>>* usedNodes = nullptr);
+    void ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphPose& pose, AnimGraphNode* node, bool loop, float length, float pos, float prevPos, Animation* anim, float speed, float weight = 1.0f, ProcessAnimationMode mode = ProcessAnimationMode::Override, BitArray<InlinedAllocation<8>>* usedNodes = nullptr);
     Variant SampleAnimation(AnimGraphNode* node, bool loop, float length, float startTimePos, float prevTimePos, float& newTimePos, Animation* anim, float speed);
     Variant SampleAnimation(AnimGraphNode* node, bool loop, float startTimePos, struct AnimSampleData& sample);
     Variant SampleAnimationsWithBlend(AnimGraphNode* node, bool loop, float startTimePos, AnimSampleData& a, AnimSampleData& b, float alpha);
@@ -0,0 +1,256 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "AnimGraphPose.h"
+#include "Engine/Core/SIMD.h"
+
+namespace
+{
+    struct SimdQuaternion
+    {
+        SimdVector4 X, Y, Z, W;
+
+        FORCE_INLINE static SimdQuaternion Load(const AnimGraphPose& pose, int32 index)
+        {
+            return { SIMD::Load(pose.Get(AnimGraphPose::RotationX) + index), SIMD::Load(pose.Get(AnimGraphPose::RotationY) + index), SIMD::Load(pose.Get(AnimGraphPose::RotationZ) + index), SIMD::Load(pose.Get(AnimGraphPose::RotationW) + index) };
+        }
+
+        FORCE_INLINE void Store(AnimGraphPose& pose, int32 index) const
+        {
+            SIMD::Store(pose.Get(AnimGraphPose::RotationX) + index, X);
+            SIMD::Store(pose.Get(AnimGraphPose::RotationY) + index, Y);
+            SIMD::Store(pose.Get(AnimGraphPose::RotationZ) + index, Z);
+            SIMD::Store(pose.Get(AnimGraphPose::RotationW) + index, W);
+        }
+
+        FORCE_INLINE static SimdVector4 Dot(const SimdQuaternion& a, const SimdQuaternion& b)
+        {
+            return SIMD::Add(SIMD::Add(SIMD::Mul(a.X, b.X), SIMD::Mul(a.Y, b.Y)), SIMD::Add(SIMD::Mul(a.Z, b.Z), SIMD::Mul(a.W, b.W)));
+        }
+
+        FORCE_INLINE static SimdQuaternion Multiply(const SimdQuaternion& left, const SimdQuaternion& right)
+        {
+            // Matches Quaternion::Multiply
+            const SimdVector4 a = SIMD::Sub(SIMD::Mul(left.Y, right.Z), SIMD::Mul(left.Z, right.Y));
+            const SimdVector4 b = SIMD::Sub(SIMD::Mul(left.Z, right.X), SIMD::Mul(left.X, right.Z));
+            const SimdVector4 c = SIMD::Sub(SIMD::Mul(left.X, right.Y), SIMD::Mul(left.Y, right.X));
+            const SimdVector4 d = SIMD::Add(SIMD::Add(SIMD::Mul(left.X, right.X), SIMD::Mul(left.Y, right.Y)), SIMD::Mul(left.Z, right.Z));
+            return
+            {
+                SIMD::Add(SIMD::Add(SIMD::Mul(left.X, right.W), SIMD::Mul(right.X, left.W)), a),
+                SIMD::Add(SIMD::Add(SIMD::Mul(left.Y, right.W), SIMD::Mul(right.Y, left.W)), b),
+                SIMD::Add(SIMD::Add(SIMD::Mul(left.Z, right.W), SIMD::Mul(right.Z, left.W)), c),
+                SIMD::Sub(SIMD::Mul(left.W, right.W), d),
+            };
+        }
+
+        FORCE_INLINE SimdQuaternion Conjugated() const
+        {
+            const SimdVector4 zero = SIMD::Splat(0.0f);
+            return { SIMD::Sub(zero, X), SIMD::Sub(zero, Y), SIMD::Sub(zero, Z), W };
+        }
+
+        FORCE_INLINE void Normalize()
+        {
+            // Skip zero-length rotations (matches Quaternion::Normalize)
+            const SimdVector4 lengthSq = Dot(*this, *this);
+            const SimdVector4 one = SIMD::Splat(1.0f);
+            const SimdVector4 invLength = SIMD::Select(SIMD::Less(SIMD::Splat(ZeroTolerance * ZeroTolerance), lengthSq), SIMD::Div(one, SIMD::Sqrt(lengthSq)), one);
+            X = SIMD::Mul(X, invLength);
+            Y = SIMD::Mul(Y, invLength);
+            Z = SIMD::Mul(Z, invLength);
+            W = SIMD::Mul(W, invLength);
+        }
+
+        // Normalized linear interpolation along the shortest path
+        FORCE_INLINE static SimdQuaternion Nlerp(const SimdQuaternion& a, const SimdQuaternion& b, SimdVector4 alpha)
+        {
+            const SimdVector4 zero = SIMD::Splat(0.0f);
+            const SimdVector4 alphaA = SIMD::Sub(SIMD::Splat(1.0f), alpha);
+            const SimdVector4 alphaB = SIMD::Select(SIMD::Less(Dot(a, b), zero), SIMD::Sub(zero, alpha), alpha);
+            SimdQuaternion result =
+            {
+                SIMD::Add(SIMD::Mul(a.X, alphaA), SIMD::Mul(b.X, alphaB)),
+                SIMD::Add(SIMD::Mul(a.Y, alphaA), SIMD::Mul(b.Y, alphaB)),
+                SIMD::Add(SIMD::Mul(a.Z, alphaA), SIMD::Mul(b.Z, alphaB)),
+                SIMD::Add(SIMD::Mul(a.W, alphaA), SIMD::Mul(b.W, alphaB)),
+            };
+            result.Normalize();
+            return result;
+        }
+    };
+
+    FORCE_INLINE void Lerp(const float* a, const float* b, SimdVector4 alpha, float* result, int32 index)
+    {
+        const SimdVector4 valueA = SIMD::Load(a + index);
+        SIMD::Store(result + index, SIMD::Add(valueA, SIMD::Mul(SIMD::Sub(SIMD::Load(b + index), valueA), alpha)));
+    }
+
+    template<AnimGraphPose::BlendMode Mode>
+    void Blend(AnimGraphPose& dst, const AnimGraphPose& src, const float* weights)
+    {
+        const SimdVector4 zero = SIMD::Splat(0.0f);
+        for (int32 i = 0; i < dst.Stride; i += 4)
+        {
+            const SimdVector4 weight = SIMD::Load(weights + i);
+            const SimdVector4 skip = SIMD::Less(weight, zero);
+            const SimdVector4 w = SIMD::Max(weight, zero);
+            SimdVector4 rotationWeight = w;
+            if (Mode == AnimGraphPose::BlendMode::BlendAdditive)
+            {
+                // Pick a shortest path between rotation to fix blending artifacts
+                const SimdVector4 dot = SimdQuaternion::Dot(SimdQuaternion::Load(dst, i), SimdQuaternion::Load(src, i));
+                rotationWeight = SIMD::Select(SIMD::Less(dot, zero), SIMD::Sub(zero, w), w);
+            }
+            for (int32 c = 0; c < AnimGraphPose::ComponentsCount; c++)
+            {
+                float* dstPtr = dst.Get(c) + i;
+                const SimdVector4 value = SIMD::Mul(SIMD::Load(src.Get(c) + i), c >= AnimGraphPose::RotationX && c <= AnimGraphPose::RotationW ? rotationWeight : w);
+                if (Mode == AnimGraphPose::BlendMode::Override)
+                    SIMD::Store(dstPtr, SIMD::Select(skip, SIMD::Load(dstPtr), value));
+                else
+                    SIMD::Store(dstPtr, SIMD::Add(SIMD::Load(dstPtr), value));
+            }
+        }
+    }
+}
+
+void AnimGraphPose::Resize(int32 count)
+{
+    Count = count;
+    Stride = (count + 3) & ~3;
+    Data.Resize(Stride * ComponentsCount, false);
+    for (int32 c = 0; c < ComponentsCount; c++)
+    {
+        float* data = Get(c);
+        for (int32 i = count; i < Stride; i++)
+            data[i] = 0.0f;
+    }
+}
+
+void AnimGraphPose::Copy(const AnimGraphPose& other)
+{
+    ASSERT_LOW_LAYER(other.Stride == Stride);
+    Platform::MemoryCopy(Data.Get(), other.Data.Get(), Data.Count() * sizeof(float));
+}
+
+Transform AnimGraphPose::GetTransform(int32 index) const
+{
+    Transform result;
+    result.Translation = Vector3(Get(PositionX)[index], Get(PositionY)[index], Get(PositionZ)[index]);
+    result.Orientation = Quaternion(Get(RotationX)[index], Get(RotationY)[index], Get(RotationZ)[index], Get(RotationW)[index]);
+    result.Scale = Float3(Get(ScaleX)[index], Get(ScaleY)[index], Get(ScaleZ)[index]);
+    return result;
+}
+
+void AnimGraphPose::SetTransform(int32 index, const Transform& value)
+{
+    Get(PositionX)[index] = (float)value.Translation.X;
+    Get(PositionY)[index] = (float)value.Translation.Y;
+    Get(PositionZ)[index] = (float)value.Translation.Z;
+    Get(RotationX)[index] = value.Orientation.X;
+    Get(RotationY)[index] = value.Orientation.Y;
+    Get(RotationZ)[index] = value.Orientation.Z;
+    Get(RotationW)[index] = value.Orientation.W;
+    Get(ScaleX)[index] = value.Scale.X;
+    Get(ScaleY)[index] = value.Scale.Y;
+    Get(ScaleZ)[index] = value.Scale.Z;
+}
+
+void AnimGraphPose::Load(const Transform* nodes)
+{
+    float* px = Get(PositionX), * py = Get(PositionY), * pz = Get(PositionZ);
+    float* rx = Get(RotationX), * ry = Get(RotationY), * rz = Get(RotationZ), * rw = Get(RotationW);
+    float* sx = Get(ScaleX), * sy = Get(ScaleY), * sz = Get(ScaleZ);
+    for (int32 i = 0; i < Count; i++)
+    {
+        const Transform& node = nodes[i];
+        px[i] = (float)node.Translation.X;
+        py[i] = (float)node.Translation.Y;
+        pz[i] = (float)node.Translation.Z;
+        rx[i] = node.Orientation.X;
+        ry[i] = node.Orientation.Y;
+        rz[i] = node.Orientation.Z;
+        rw[i] = node.Orientation.W;
+        sx[i] = node.Scale.X;
+        sy[i] = node.Scale.Y;
+        sz[i] = node.Scale.Z;
+    }
+}
+
+void AnimGraphPose::Store(Transform* nodes) const
+{
+    const float* px = Get(PositionX), * py = Get(PositionY), * pz = Get(PositionZ);
+    const float* rx = Get(RotationX), * ry = Get(RotationY), * rz = Get(RotationZ), * rw = Get(RotationW);
+    const float* sx = Get(ScaleX), * sy = Get(ScaleY), * sz = Get(ScaleZ);
+    for (int32 i = 0; i < Count; i++)
+    {
+        Transform& node = nodes[i];
+        node.Translation = Vector3(px[i], py[i], pz[i]);
+        node.Orientation = Quaternion(rx[i], ry[i], rz[i], rw[i]);
+        node.Scale = Float3(sx[i], sy[i], sz[i]);
+    }
+}
+
+void AnimGraphPose::NormalizeRotations()
+{
+    for (int32 i = 0; i < Stride; i += 4)
+    {
+        SimdQuaternion rotation = SimdQuaternion::Load(*this, i);
+        rotation.Normalize();
+        rotation.Store(*this, i);
+    }
+}
+
+void AnimGraphPose::Blend(const AnimGraphPose& src, const float* weights, BlendMode mode)
+{
+    ASSERT_LOW_LAYER(src.Stride == Stride);
+    switch (mode)
+    {
+    case BlendMode::Override:
+        ::Blend<BlendMode::Override>(*this, src, weights);
+        break;
+    case BlendMode::Add:
+        ::Blend<BlendMode::Add>(*this, src, weights);
+        break;
+    case BlendMode::BlendAdditive:
+        ::Blend<BlendMode::BlendAdditive>(*this, src, weights);
+        break;
+    }
+}
+
+void AnimGraphPose::Lerp(const AnimGraphPose& a, const AnimGraphPose& b, float alpha, const float* mask, AnimGraphPose& result)
+{
+    ASSERT_LOW_LAYER(a.Stride == b.Stride && a.Stride == result.Stride);
+    const SimdVector4 alphaSplat = SIMD::Splat(alpha);
+    for (int32 i = 0; i < a.Stride; i += 4)
+    {
+        const SimdVector4 w = mask ? SIMD::Mul(SIMD::Load(mask + i), alphaSplat) : alphaSplat;
+        ::Lerp(a.Get(PositionX), b.Get(PositionX), w, result.Get(PositionX), i);
+        ::Lerp(a.Get(PositionY), b.Get(PositionY), w, result.Get(PositionY), i);
+        ::Lerp(a.Get(PositionZ), b.Get(PositionZ), w, result.Get(PositionZ), i);
+        SimdQuaternion::Nlerp(SimdQuaternion::Load(a, i), SimdQuaternion::Load(b, i), w).Store(result, i);
+        ::Lerp(a.Get(ScaleX), b.Get(ScaleX), w, result.Get(ScaleX), i);
+        ::Lerp(a.Get(ScaleY), b.Get(ScaleY), w, result.Get(ScaleY), i);
+        ::Lerp(a.Get(ScaleZ), b.Get(ScaleZ), w, result.Get(ScaleZ), i);
+    }
+}
+
+void AnimGraphPose::BlendAdditive(const AnimGraphPose& base, const AnimGraphPose& additive, const AnimGraphPose& reference, float alpha, AnimGraphPose& result)
+{
+    ASSERT_LOW_LAYER(base.Stride == additive.Stride && base.Stride == reference.Stride && base.Stride == result.Stride);
+    const SimdVector4 w = SIMD::Splat(alpha);
+    for (int32 i = 0; i < base.Stride; i += 4)
+    {
+        // base + (additive - reference) * alpha
+        for (int32 c : { PositionX, PositionY, PositionZ, ScaleX, ScaleY, ScaleZ })
+        {
+            const SimdVector4 diff = SIMD::Sub(SIMD::Load(additive.Get(c) + i), SIMD::Load(reference.Get(c) + i));
+            SIMD::Store(result.Get(c) + i, SIMD::Add(SIMD::Load(base.Get(c) + i), SIMD::Mul(diff, w)));
+        }
+
+        // Lerp base and (base * (reference^-1 * additive))
+        const SimdQuaternion baseRotation = SimdQuaternion::Load(base, i);
+        const SimdQuaternion diff = SimdQuaternion::Multiply(SimdQuaternion::Load(reference, i).Conjugated(), SimdQuaternion::Load(additive, i));
+        SimdQuaternion::Nlerp(baseRotation, SimdQuaternion::Multiply(baseRotation, diff), w).Store(result, i);
+    }
+}
@@ -0,0 +1,136 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Transform.h"
+
+/// <summary>
+/// The skeleton nodes pose stored as structure-of-arrays (separate array for each component of the nodes positions, rotations and scales). Used by the Anim Graph to sample and blend poses with vectorized loops over all nodes.
+/// </summary>
+struct FLAXENGINE_API AnimGraphPose
+{
+    /// <summary>
+    /// The pose components (each stored as a separate array).
+    /// </summary>
+    enum Components
+    {
+        PositionX,
+        PositionY,
+        PositionZ,
+        RotationX,
+        RotationY,
+        RotationZ,
+        RotationW,
+        ScaleX,
+        ScaleY,
+        ScaleZ,
+        ComponentsCount,
+    };
+
+    /// <summary>
+    /// The pose blending modes.
+    /// </summary>
+    enum class BlendMode
+    {
+        // Replaces the destination pose with the weighted source pose.
+        Override,
+        // Adds the weighted source pose to the destination pose.
+        Add,
+        // Adds the weighted source pose to the destination pose (rotations use the shortest path to the destination rotation).
+        BlendAdditive,
+    };
+
+    /// <summary>
+    /// The amount of nodes in the pose.
+    /// </summary>
+    int32 Count = 0;
+
+    /// <summary>
+    /// The size of the single component array (nodes count aligned to the vector size).
+    /// </summary>
+    int32 Stride = 0;
+
+    /// <summary>
+    /// The pose components data (arrays of Stride size, in order of Components).
+    /// </summary>
+    Array<float> Data;
+
+public:
+    FORCE_INLINE float* Get(int32 component)
+    {
+        return Data.Get() + component * Stride;
+    }
+
+    FORCE_INLINE const float* Get(int32 component) const
+    {
+        return Data.Get() + component * Stride;
+    }
+
+    /// <summary>
+    /// Resizes the pose for the given amount of nodes (data is not initialized, except the alignment padding).
+    /// </summary>
+    /// <param name="count">The nodes count.</param>
+    void Resize(int32 count);
+
+    /// <summary>
+    /// Copies the pose from the other pose (of the same size).
+    /// </summary>
+    /// <param name="other">The source pose.</param>
+    void Copy(const AnimGraphPose& other);
+
+    /// <summary>
+    /// Gets the node transformation.
+    /// </summary>
+    Transform GetTransform(int32 index) const;
+
+    /// <summary>
+    /// Sets the node transformation.
+    /// </summary>
+    void SetTransform(int32 index, const Transform& value);
+
+    /// <summary>
+    /// Loads the pose from the nodes transformations (the pose size has to match the nodes count).
+    /// </summary>
+    /// <param name="nodes">The source nodes transformations.</param>
+    void Load(const Transform* nodes);
+
+    /// <summary>
+    /// Stores the pose into the nodes transformations.
+    /// </summary>
+    /// <param name="nodes">The destination nodes transformations.</param>
+    void Store(Transform* nodes) const;
+
+    /// <summary>
+    /// Normalizes the nodes rotations.
+    /// </summary>
+    void NormalizeRotations();
+
+    /// <summary>
+    /// Blends the source pose into this pose. Nodes with the negative weight are skipped.
+    /// </summary>
+    /// <param name="src">The source pose.</param>
+    /// <param name="weights">The per-node blend weights (of Stride size).</param>
+    /// <param name="mode">The blending mode.</param>
+    void Blend(const AnimGraphPose& src, const float* weights, BlendMode mode);
+
+    /// <summary>
+    /// Interpolates between two poses (rotations use the normalized linear interpolation along the shortest path).
+    /// </summary>
+    /// <param name="a">The first pose.</param>
+    /// <param name="b">The second pose.</param>
+    /// <param name="alpha">The blend alpha.</param>
+    /// <param name="mask">The optional per-node blend mask (of Stride size) that scales alpha. Can be null.</param>
+    /// <param name="result">The result pose. Can be one of the input poses.</param>
+    static void Lerp(const AnimGraphPose& a, const AnimGraphPose& b, float alpha, const float* mask, AnimGraphPose& result);
+
+    /// <summary>
+    /// Applies the additive pose (difference between the additive pose and the reference pose) on top of the base pose and interpolates to it.
+    /// </summary>
+    /// <param name="base">The base pose.</param>
+    /// <param name="additive">The additive pose.</param>
+    /// <param name="reference">The reference pose (eg. skeleton bind pose).</param>
+    /// <param name="alpha">The blend alpha.</param>
+    /// <param name="result">The result pose. Can be one of the input poses.</param>
+    static void BlendAdditive(const AnimGraphPose& base, const AnimGraphPose& additive, const AnimGraphPose& reference, float alpha, AnimGraphPose& result);
+};
@@ -99,17 +99,39 @@ namespace
         base += additive;
     }
 
-    FORCE_INLINE void NormalizeRotations(AnimGraphImpulse* nodes, RootMotionExtraction rootMotionMode)
+    FORCE_INLINE void StorePose(AnimGraphContext& context, AnimGraphImpulse* nodes, RootMotionExtraction rootMotionMode)
     {
-        for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-        {
-            nodes->Nodes.Get()[i].Orientation.Normalize();
-        }
+        AnimGraphPose& pose = context.PoseA;
+        pose.NormalizeRotations();
+        pose.Store(nodes->Nodes.Get());
+        context.PoseANodes = nodes;
         if (rootMotionMode != RootMotionExtraction::NoExtraction)
         {
             nodes->RootMotion.Orientation.Normalize();
         }
     }
+
+    void LoadPoses(AnimGraphContext& context, const AnimGraphImpulse* nodesA, const AnimGraphImpulse* nodesB)
+    {
+        // Reuse the pose left by the previous sampling or blend node to skip converting it again (nodes are not modified in-place by other nodes)
+        if (context.PoseANodes == nodesB && nodesA != nodesB)
+        {
+            context.PoseA.Data.Swap(context.PoseB.Data);
+            context.PoseA.Load(nodesA->Nodes.Get());
+        }
+        else
+        {
+            if (context.PoseANodes != nodesA)
+                context.PoseA.Load(nodesA->Nodes.Get());
+            context.PoseB.Load(nodesB->Nodes.Get());
+        }
+    }
+
+    FORCE_INLINE void StoreBlendPose(AnimGraphContext& context, AnimGraphImpulse* nodes)
+    {
+        context.PoseA.Store(nodes->Nodes.Get());
+        context.PoseANodes = nodes;
+    }
 }
 
 // Utility for retargeting animation poses between skeletons.
@@ -368,7 +390,7 @@ FORCE_INLINE void GetAnimPos(bool loop, float length, float speed, float startTi
     prevPos = GetAnimPos(prevTimePos, startTimePos, speed, loop, length);
 }
 
-void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode* node, bool loop, float length, float pos, float prevPos, Animation* anim, float speed, float weight, ProcessAnimationMode mode, BitArray<InlinedAllocation<8>>* usedNodes)
+void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphPose& pose, AnimGraphNode* node, bool loop, float length, float pos, float prevPos, Animation* anim, float speed, float weight, ProcessAnimationMode mode, BitArray<InlinedAllocation<8>>* usedNodes)
 {
     PROFILE_CPU_ASSET(anim);
 
@@ -416,7 +438,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
                 nestedAnimPrevPos = nestedAnimPrevPos * frameRateMatchScale;
                 GetAnimPos(nestedAnim.Loop, nestedAnimLength, speed, nestedAnim.StartTime, nestedAnimPrevPos, nestedAnimPos, nestedAnimPos, nestedAnimPrevPos);
 
-                ProcessAnimation(nodes, node, true, nestedAnimLength, nestedAnimPos, nestedAnimPrevPos, nestedAnim.Anim, 1.0f, weight, mode, usedNodes);
+                ProcessAnimation(nodes, pose, node, true, nestedAnimLength, nestedAnimPos, nestedAnimPrevPos, nestedAnim.Anim, 1.0f, weight, mode, usedNodes);
             }
         }
     }
@@ -426,8 +448,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
     if (mapping.NodesMapping.IsInvalid())
         return;
 
-    // Evaluate nodes animations
-    const bool weighted = weight < 1.0f;
+    // Evaluate nodes animations (into the temporary pose)
     const bool retarget = mapping.SourceSkeleton && mapping.SourceSkeleton != mapping.TargetSkeleton;
     const auto emptyNodes = GetEmptyNodes();
     Retargeting retargeting;
@@ -437,15 +458,21 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         sourceMapping = _graph.BaseModel->GetSkeletonMapping(mapping.SourceSkeleton);
         retargeting.Init(mapping.SourceSkeleton->Skeleton, mapping.TargetSkeleton->Skeleton, mapping);
     }
-    for (int32 nodeIndex = 0; nodeIndex < nodes->Nodes.Count(); nodeIndex++)
+    AnimGraphPose& srcPose = context.PoseB;
+    srcPose.Copy(context.EmptyPose);
+    float* weights = context.PoseWeights.Get();
+    int32* cursors = context.Data->GetKeyframeCursors(node, anim, anim->Data.Channels.Count() * 3);
+    const int32 maxNodesDepth = context.Data->MaxNodesDepth;
+    const int32* nodesDepth = maxNodesDepth < MAX_int32 ? context.NodesDepth.Get() : nullptr;
+    for (int32 nodeIndex = 0; nodeIndex < pose.Count; nodeIndex++)
     {
-        const int32 nodeToChannel = mapping.NodesMapping[nodeIndex];
-        Transform& dstNode = nodes->Nodes[nodeIndex];
-        Transform srcNode = emptyNodes->Nodes[nodeIndex];
+        const int32 nodeToChannel = nodesDepth && nodesDepth[nodeIndex] > maxNodesDepth ? -1 : mapping.NodesMapping[nodeIndex];
+        weights[nodeIndex] = weight;
         if (nodeToChannel != -1)
         {
             // Calculate the animated node transformation
-            anim->Data.Channels[nodeToChannel].Evaluate(animPos, &srcNode, false);
+            Transform srcNode = emptyNodes->Nodes[nodeIndex];
+            anim->Data.EvaluateChannel(nodeToChannel, animPos, &srcNode, cursors ? cursors + nodeToChannel * 3 : nullptr);
 
             // Optionally retarget animation into the skeleton used by the Anim Graph
             if (retarget)
@@ -453,6 +480,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
                 const int32 sourceIndex = sourceMapping.NodesMapping[nodeIndex];
                 retargeting.RetargetNode(srcNode, srcNode, sourceIndex, nodeIndex);
             }
+            srcPose.SetTransform(nodeIndex, srcNode);
 
             // Mark node as used
             if (usedNodes)
@@ -461,33 +489,14 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         else if (usedNodes && (usedNodes != &usedNodesThis || usedNodes->Get(nodeIndex)))
         {
             // Skip for nested animations so other one or top-level anim will update remaining nodes
-            continue;
-        }
-
-        // Blend node
-        if (mode == ProcessAnimationMode::BlendAdditive)
-        {
-            dstNode.Translation += srcNode.Translation * weight;
-            dstNode.Scale += srcNode.Scale * weight;
-            BlendAdditiveWeightedRotation(dstNode.Orientation, srcNode.Orientation, weight);
-        }
-        else if (mode == ProcessAnimationMode::Add)
-        {
-            dstNode.Translation += srcNode.Translation * weight;
-            dstNode.Scale += srcNode.Scale * weight;
-            dstNode.Orientation += srcNode.Orientation * weight;
-        }
-        else if (weighted)
-        {
-            dstNode.Translation = srcNode.Translation * weight;
-            dstNode.Scale = srcNode.Scale * weight;
-            dstNode.Orientation = srcNode.Orientation * weight;
-        }
-        else
-        {
-            dstNode = srcNode;
+            weights[nodeIndex] = -1.0f;
         }
     }
+    for (int32 nodeIndex = pose.Count; nodeIndex < pose.Stride; nodeIndex++)
+        weights[nodeIndex] = -1.0f;
+
+    // Blend nodes
+    pose.Blend(srcPose, weights, mode);
 
     // Handle root motion
     if (_rootMotionMode != RootMotionExtraction::NoExtraction && anim->Data.RootMotionFlags != AnimationRootMotionFlags::None)
@@ -500,7 +509,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         const bool motionPosition = motionPositionXZ | motionPositionY;
         const int32 rootNodeIndex = GetRootNodeIndex(anim);
         const Transform& refPose = emptyNodes->Nodes[rootNodeIndex];
-        Transform& rootNode = nodes->Nodes[rootNodeIndex];
+        Transform rootNode = pose.GetTransform(rootNodeIndex);
         Transform& dstNode = nodes->RootMotion;
         Transform srcNode = Transform::Identity;
         const int32 nodeToChannel = mapping.NodesMapping[rootNodeIndex];
@@ -508,9 +517,8 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         {
             // Get the root bone transformation
             Transform rootBefore = refPose, rootNow = refPose;
-            const NodeAnimationData& rootChannel = anim->Data.Channels[nodeToChannel];
-            rootChannel.Evaluate(animPrevPos, &rootBefore, false);
-            rootChannel.Evaluate(animPos, &rootNow, false);
+            anim->Data.EvaluateChannel(nodeToChannel, animPrevPos, &rootBefore);
+            anim->Data.EvaluateChannel(nodeToChannel, animPos, &rootNow);
 
             // Check if animation looped
             if (animPos < animPrevPos)
@@ -518,10 +526,10 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
                 const float endPos = (float)(anim->GetLength() * anim->Data.FramesPerSecond);
 
                 Transform rootBegin = refPose;
-                rootChannel.Evaluate(0, &rootBegin, false);
+                anim->Data.EvaluateChannel(nodeToChannel, 0, &rootBegin);
 
                 Transform rootEnd = refPose;
-                rootChannel.Evaluate(endPos, &rootEnd, false);
+                anim->Data.EvaluateChannel(nodeToChannel, endPos, &rootEnd);
 
                 // Complex motion calculation to preserve the looped movement
                 // (end - before + now - begin)
@@ -546,7 +554,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
             int32 parentIndex = skeleton.Nodes[rootNodeIndex].ParentIndex;
             while (parentIndex != -1)
             {
-                const Transform& parentNode = nodes->Nodes[parentIndex];
+                const Transform parentNode = pose.GetTransform(parentIndex);
                 srcNode.Translation = parentNode.LocalToWorld(srcNode.Translation);
                 parentIndex = skeleton.Nodes[parentIndex].ParentIndex;
             }
@@ -557,6 +565,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
             rootNode.Translation = refPose.Translation * motionPositionMask + rootNode.Translation * (Vector3::One - motionPositionMask);
         if (motionRotation)
             rootNode.Orientation = refPose.Orientation;
+        pose.SetTransform(rootNodeIndex, rootNode);
 
         // Blend root motion
         if (mode == ProcessAnimationMode::BlendAdditive)
@@ -573,7 +582,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
             if (motionRotation)
                 dstNode.Orientation += srcNode.Orientation * weight;
         }
-        else if (weighted)
+        else if (weight < 1.0f)
         {
             if (motionPosition)
                 dstNode.Translation = srcNode.Translation * weight * motionPositionMask;
@@ -590,7 +599,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
     }
 
     // Collect events
-    if (weight > 0.5f)
+    if (weight > 0.5f && context.Data->EnableEvents)
     {
         ProcessAnimEvents(node, loop, length, animPos, animPrevPos, anim, speed);
     }
@@ -605,11 +614,14 @@ Variant AnimGraphExecutor::SampleAnimation(AnimGraphNode* node, bool loop, float
     GetAnimPos(loop, length, speed, startTimePos, prevTimePos, newTimePos, pos, prevPos);
 
     const auto nodes = node->GetNodes(this);
-    InitNodes(nodes);
+    auto& context = *Context.Get();
+    AnimGraphPose& pose = context.PoseA;
+    pose.Copy(context.EmptyPose);
+    nodes->RootMotion = Transform::Identity;
     nodes->Position = pos;
     nodes->Length = length;
-    ProcessAnimation(nodes, node, loop, length, pos, prevPos, anim, speed);
-    NormalizeRotations(nodes, _rootMotionMode);
+    ProcessAnimation(nodes, pose, node, loop, length, pos, prevPos, anim, speed);
+    StorePose(context, nodes, _rootMotionMode);
 
     return nodes;
 }
@@ -633,12 +645,15 @@ Variant AnimGraphExecutor::SampleAnimationsWithBlend(AnimGraphNode* node, bool l
 
     // Sample the animations with blending
     const auto nodes = node->GetNodes(this);
-    InitNodes(nodes);
+    auto& context = *Context.Get();
+    AnimGraphPose& pose = context.PoseA;
+    pose.Copy(context.EmptyPose);
+    nodes->RootMotion = Transform::Identity;
     nodes->Position = (a.TimePos + b.TimePos) / 2.0f;
     nodes->Length = Math::Max(a.Length, b.Length);
-    ProcessAnimation(nodes, node, loop, a.Length, posA, prevPosA, a.Anim, a.Speed, 1.0f - alpha, ProcessAnimationMode::Override);
-    ProcessAnimation(nodes, node, loop, b.Length, posB, prevPosB, b.Anim, b.Speed, alpha, ProcessAnimationMode::BlendAdditive);
-    NormalizeRotations(nodes, _rootMotionMode);
+    ProcessAnimation(nodes, pose, node, loop, a.Length, posA, prevPosA, a.Anim, a.Speed, 1.0f - alpha, ProcessAnimationMode::Override);
+    ProcessAnimation(nodes, pose, node, loop, b.Length, posB, prevPosB, b.Anim, b.Speed, alpha, ProcessAnimationMode::BlendAdditive);
+    StorePose(context, nodes, _rootMotionMode);
 
     return nodes;
 }
@@ -659,14 +674,17 @@ Variant AnimGraphExecutor::SampleAnimationsWithBlend(AnimGraphNode* node, bool l
 
     // Sample the animations with blending
     const auto nodes = node->GetNodes(this);
-    InitNodes(nodes);
+    auto& context = *Context.Get();
+    AnimGraphPose& pose = context.PoseA;
+    pose.Copy(context.EmptyPose);
+    nodes->RootMotion = Transform::Identity;
     nodes->Position = (a.TimePos + b.TimePos + c.TimePos) / 3.0f;
     nodes->Length = Math::Max(a.Length, b.Length, c.Length);
     ASSERT(Math::Abs(alphaA + alphaB + alphaC - 1.0f) <= ANIM_GRAPH_BLEND_THRESHOLD); // Assumes weights are normalized
-    ProcessAnimation(nodes, node, loop, a.Length, posA, prevPosA, a.Anim, a.Speed, alphaA, ProcessAnimationMode::Override);
-    ProcessAnimation(nodes, node, loop, b.Length, posB, prevPosB, b.Anim, b.Speed, alphaB, ProcessAnimationMode::BlendAdditive);
-    ProcessAnimation(nodes, node, loop, c.Length, posC, prevPosC, c.Anim, c.Speed, alphaC, ProcessAnimationMode::BlendAdditive);
-    NormalizeRotations(nodes, _rootMotionMode);
+    ProcessAnimation(nodes, pose, node, loop, a.Length, posA, prevPosA, a.Anim, a.Speed, alphaA, ProcessAnimationMode::Override);
+    ProcessAnimation(nodes, pose, node, loop, b.Length, posB, prevPosB, b.Anim, b.Speed, alphaB, ProcessAnimationMode::BlendAdditive);
+    ProcessAnimation(nodes, pose, node, loop, c.Length, posC, prevPosC, c.Anim, c.Speed, alphaC, ProcessAnimationMode::BlendAdditive);
+    StorePose(context, nodes, _rootMotionMode);
 
     return nodes;
 }
@@ -688,13 +706,10 @@ Variant AnimGraphExecutor::Blend(AnimGraphNode* node, const Value& poseA, const
     if (!ANIM_GRAPH_IS_VALID_PTR(poseB))
         nodesB = GetEmptyNodes();
 
-    const Transform* srcA = nodesA->Nodes.Get();
-    const Transform* srcB = nodesB->Nodes.Get();
-    Transform* dst = nodes->Nodes.Get();
-    for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-    {
-        Transform::Lerp(srcA[i], srcB[i], alpha, dst[i]);
-    }
+    auto& context = *Context.Get();
+    LoadPoses(context, nodesA, nodesB);
+    AnimGraphPose::Lerp(context.PoseA, context.PoseB, alpha, nullptr, context.PoseA);
+    StoreBlendPose(context, nodes);
     Transform::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
     nodes->Position = Math::Lerp(nodesA->Position, nodesB->Position, alpha);
     nodes->Length = Math::Lerp(nodesA->Length, nodesB->Length, alpha);
@@ -1292,23 +1307,11 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
                 const auto nodes = node->GetNodes(this);
                 const auto basePoseNodes = static_cast<AnimGraphImpulse*>(valueA.AsPointer);
                 const auto blendPoseNodes = static_cast<AnimGraphImpulse*>(valueB.AsPointer);
-                const auto& refNodes = _graph.BaseModel.Get()->GetNodes();
-                Transform t, basePoseTransform, blendPoseTransform, refTransform;
-                for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-                {
-                    basePoseTransform = basePoseNodes->Nodes[i];
-                    blendPoseTransform = blendPoseNodes->Nodes[i];
-                    refTransform = refNodes[i].LocalTransform;
-
-                    // base + (blend - reference)
-                    t.Translation = basePoseTransform.Translation + (blendPoseTransform.Translation - refTransform.Translation);
-                    auto diff = Quaternion::Invert(refTransform.Orientation) * blendPoseTransform.Orientation;
-                    t.Orientation = basePoseTransform.Orientation * diff;
-                    t.Scale = basePoseTransform.Scale + (blendPoseTransform.Scale - refTransform.Scale);
-
-                    // Lerp base and transform
-                    Transform::Lerp(basePoseTransform, t, alpha, nodes->Nodes[i]);
-                }
+                // Lerp base and (base + (blend - reference))
+                auto& context = *Context.Get();
+                LoadPoses(context, basePoseNodes, blendPoseNodes);
+                AnimGraphPose::BlendAdditive(context.PoseA, context.PoseB, context.EmptyPose, alpha, context.PoseA);
+                StoreBlendPose(context, nodes);
                 Transform::Lerp(basePoseNodes->RootMotion, basePoseNodes->RootMotion + blendPoseNodes->RootMotion, alpha, nodes->RootMotion);
                 value = nodes;
             }
@@ -1351,21 +1354,14 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
             const auto nodesB = static_cast<AnimGraphImpulse*>(valueB.AsPointer);
 
             // Blend all nodes masked by the user
-            Transform tA, tB;
+            auto& context = *Context.Get();
             auto& nodesMask = mask->GetNodesMask();
-            for (int32 nodeIndex = 0; nodeIndex < nodes->Nodes.Count(); nodeIndex++)
-            {
-                tA = nodesA->Nodes[nodeIndex];
-                if (nodesMask[nodeIndex])
-                {
-                    tB = nodesB->Nodes[nodeIndex];
-                    Transform::Lerp(tA, tB, alpha, nodes->Nodes[nodeIndex]);
-                }
-                else
-                {
-                    nodes->Nodes[nodeIndex] = tA;
-                }
-            }
+            float* weights = context.PoseWeights.Get();
+            for (int32 nodeIndex = 0; nodeIndex < context.PoseA.Stride; nodeIndex++)
+                weights[nodeIndex] = nodeIndex < nodesMask.Count() && nodesMask[nodeIndex] ? 1.0f : 0.0f;
+            LoadPoses(context, nodesA, nodesB);
+            AnimGraphPose::Lerp(context.PoseA, context.PoseB, alpha, weights, context.PoseA);
+            StoreBlendPose(context, nodes);
             Transform::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
 
             value = nodes;
@@ -2238,7 +2234,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         float weight = (float)tryGetValue(node->GetBox(3), node->Values[1]);
-        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
+        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD || !context.Data->EnableIK)
         {
             value = input;
             break;
@@ -2283,7 +2279,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         float weight = (float)tryGetValue(node->GetBox(4), node->Values[1]);
-        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
+        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD || !context.Data->EnableIK)
         {
             value = input;
             break;
@@ -60,6 +60,7 @@ Animation::InfoData Animation::GetInfo() const
             info.MemoryUsage += e.Rotation.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Quaternion>);
             info.MemoryUsage += e.Scale.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Float3>);
         }
+        info.MemoryUsage += Data.Compressed.GetMemoryUsage();
     }
     else
     {
@@ -92,8 +93,21 @@ void Animation::LoadTimeline(BytesContainer& result) const
     const float fpsInv = 1.0f / fps;
     stream.Write(fps);
     stream.Write((int32)Data.Duration);
-    int32 tracksCount = Data.Channels.Count() + NestedAnims.Count() + Events.Count();
-    for (auto& channel : Data.Channels)
+
+    // Compressed animation gets decompressed for editing
+    Array<NodeAnimationData> decompressed;
+    if (Data.IsCompressed())
+    {
+        decompressed.Resize(Data.Channels.Count());
+        for (int32 i = 0; i < decompressed.Count(); i++)
+        {
+            decompressed[i].NodeName = Data.Channels[i].NodeName;
+            Data.Compressed.Decompress(i, decompressed[i]);
+        }
+    }
+    const Array<NodeAnimationData>& channels = Data.IsCompressed() ? decompressed : Data.Channels;
+    int32 tracksCount = channels.Count() + NestedAnims.Count() + Events.Count();
+    for (auto& channel : channels)
     {
         tracksCount +=
                 (channel.Position.GetKeyframes().HasItems() ? 1 : 0) +
@@ -104,9 +118,9 @@ void Animation::LoadTimeline(BytesContainer& result) const
 
     // Tracks
     int32 trackIndex = 0;
-    for (int32 i = 0; i < Data.Channels.Count(); i++)
+    for (int32 i = 0; i < channels.Count(); i++)
     {
-        auto& channel = Data.Channels[i];
+        auto& channel = channels[i];
         const int32 childrenCount =
                 (channel.Position.GetKeyframes().HasItems() ? 1 : 0) +
                 (channel.Rotation.GetKeyframes().HasItems() ? 1 : 0) +
@@ -253,6 +267,8 @@ bool Animation::SaveTimeline(BytesContainer& data)
 
         // Tracks
         Data.Channels.Clear();
+        Data.Compressed.Channels.Clear();
+        Data.Compressed.Data.Clear();
         Events.Clear();
         NestedAnims.Clear();
         Dictionary<int32, int32> animationChannelTrackIndexToChannelIndex;
@@ -393,6 +409,38 @@ bool Animation::SaveTimeline(BytesContainer& data)
     return Save();
 }
 
+void SaveAnimationData(WriteStream& stream, const AnimationData& data)
+{
+    // Info
+    stream.Write(104); // Header version (for fast version upgrades without serialization format change)
+    stream.Write(data.Duration);
+    stream.Write(data.FramesPerSecond);
+    stream.Write((byte)data.RootMotionFlags);
+    stream.Write(data.RootNodeName, 13);
+    const bool compressed = data.IsCompressed();
+    stream.WriteBool(compressed);
+
+    // Animation channels
+    stream.WriteInt32(data.Channels.Count());
+    for (int32 i = 0; i < data.Channels.Count(); i++)
+    {
+        auto& anim = data.Channels[i];
+        stream.Write(anim.NodeName, 172);
+        if (compressed)
+        {
+            stream.WriteBytes(&data.Compressed.Channels[i], sizeof(CompressedAnimationData::Channel));
+        }
+        else
+        {
+            Serialization::Serialize(stream, anim.Position);
+            Serialization::Serialize(stream, anim.Rotation);
+            Serialization::Serialize(stream, anim.Scale);
+        }
+    }
+    if (compressed)
+        stream.Write(data.Compressed.Data);
+}
+
 bool Animation::Save(const StringView& path)
 {
     if (OnCheckSave(path))
@@ -403,23 +451,8 @@ bool Animation::Save(const StringView& path)
     {
         MemoryWriteStream stream(4096);
 
-        // Info
-        stream.Write(103);
-        stream.Write(Data.Duration);
-        stream.Write(Data.FramesPerSecond);
-        stream.Write((byte)Data.RootMotionFlags);
-        stream.Write(Data.RootNodeName, 13);
-
-        // Animation channels
-        stream.WriteInt32(Data.Channels.Count());
-        for (int32 i = 0; i < Data.Channels.Count(); i++)
-        {
-            auto& anim = Data.Channels[i];
-            stream.Write(anim.NodeName, 172);
-            Serialization::Serialize(stream, anim.Position);
-            Serialization::Serialize(stream, anim.Rotation);
-            Serialization::Serialize(stream, anim.Scale);
-        }
+        // Info and animation channels
+        SaveAnimationData(stream, Data);
 
         // Animation events
         stream.WriteInt32(Events.Count());
@@ -497,22 +530,8 @@ bool Animation::SaveHeader(const ModelData& modelData, WriteStream& stream, int3
         return true;
     }
 
-    // Info
-    stream.Write(103); // Header version (for fast version upgrades without serialization format change)
-    stream.Write(anim.Duration);
-    stream.Write(anim.FramesPerSecond);
-    stream.Write((byte)anim.RootMotionFlags);
-    stream.Write(anim.RootNodeName, 13);
-
-    // Animation channels
-    stream.WriteInt32(anim.Channels.Count());
-    for (const auto& channel : anim.Channels)
-    {
-        stream.Write(channel.NodeName, 172);
-        Serialization::Serialize(stream, channel.Position);
-        Serialization::Serialize(stream, channel.Rotation);
-        Serialization::Serialize(stream, channel.Scale);
-    }
+    // Info and animation channels
+    SaveAnimationData(stream, anim);
 
     // Animation events
     stream.WriteInt32(anim.Events.Count());
@@ -609,8 +628,17 @@ Asset::LoadResult Animation::load()
 
     // Info
     int32 headerVersion = *(int32*)stream.GetPositionHandle();
+    bool compressed = false;
     switch (headerVersion)
     {
+    case 104:
+        stream.Read(headerVersion);
+        stream.Read(Data.Duration);
+        stream.Read(Data.FramesPerSecond);
+        stream.Read((byte&)Data.RootMotionFlags);
+        stream.Read(Data.RootNodeName, 13);
+        compressed = stream.ReadBool();
+        break;
     case 103:
         stream.Read(headerVersion);
         stream.Read(Data.Duration);
@@ -642,11 +670,17 @@ Asset::LoadResult Animation::load()
     int32 animationsCount;
     stream.ReadInt32(&animationsCount);
     Data.Channels.Resize(animationsCount, false);
+    Data.Compressed.Channels.Resize(compressed ? animationsCount : 0, false);
     for (int32 i = 0; i < animationsCount; i++)
     {
         auto& anim = Data.Channels[i];
 
         stream.Read(anim.NodeName, 172);
+        if (compressed)
+        {
+            stream.ReadBytes(&Data.Compressed.Channels[i], sizeof(CompressedAnimationData::Channel));
+            continue;
+        }
         bool failed = Serialization::Deserialize(stream, anim.Position);
         failed |= Serialization::Deserialize(stream, anim.Rotation);
         failed |= Serialization::Deserialize(stream, anim.Scale);
@@ -657,6 +691,8 @@ Asset::LoadResult Animation::load()
             return LoadResult::Failed;
         }
     }
+    if (compressed)
+        stream.Read(Data.Compressed.Data);
 
     // Animation events
     if (headerVersion >= 101)
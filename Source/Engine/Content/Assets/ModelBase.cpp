@@ -944,6 +944,23 @@ int32 ModelBase::GetCurrentResidency() const
     return _loadedLODs;
 }
 
+uint64 ModelBase::GetResidencyMemoryUsage(int32 residency) const
+{
+    // Estimate from the size of the LODs data (resident LODs are the last ones)
+    uint64 result = 0;
+    const int32 lodsCount = GetLODsCount();
+    for (int32 lodIndex = Math::Max(lodsCount - residency, 0); lodIndex < lodsCount; lodIndex++)
+    {
+        const int32 chunkIndex = MODEL_LOD_TO_CHUNK_INDEX(lodIndex);
+        if (chunkIndex >= ASSET_FILE_DATA_CHUNKS)
+            break;
+        const FlaxChunk* chunk = _header.Chunks[chunkIndex];
+        if (chunk)
+            result += Math::Max<uint64>(chunk->LocationInFile.Size, chunk->Size());
+    }
+    return result;
+}
+
 bool ModelBase::CanBeUpdated() const
 {
     // Check if is ready and has no streaming tasks running
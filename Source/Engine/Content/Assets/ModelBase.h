@@ -349,6 +349,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API ModelBase : public BinaryAsset
 
     // [StreamableResource]
     int32 GetCurrentResidency() const override;
+    uint64 GetResidencyMemoryUsage(int32 residency) const override;
     bool CanBeUpdated() const override;
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
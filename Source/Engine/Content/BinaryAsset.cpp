@@ -288,6 +288,8 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks) const
     if (chunks == 0)
         return false;
     ASSERT(Storage);
+    FlaxChunk* toLoad[ASSET_FILE_DATA_CHUNKS];
+    int32 toLoadCount = 0;
     for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
     {
         auto chunk = _header.Chunks[i];
@@ -296,11 +298,10 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks) const
             && chunk->IsMissing()
             && chunk->ExistsInFile())
         {
-            if (Storage->LoadAssetChunk(chunk))
-                return true;
+            toLoad[toLoadCount++] = chunk;
         }
     }
-    return false;
+    return Storage->LoadAssetChunks(ToSpan(toLoad, toLoadCount));
 }
 
 #if USE_EDITOR
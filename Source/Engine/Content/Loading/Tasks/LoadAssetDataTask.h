@@ -59,6 +59,8 @@ class LoadAssetDataTask : public ContentLoadTask
 #endif
 
         // Load chunks
+        FlaxChunk* toLoad[ASSET_FILE_DATA_CHUNKS];
+        int32 toLoadCount = 0;
         for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
         {
             if (GET_CHUNK_FLAG(i) & _chunks)
@@ -66,21 +68,25 @@ class LoadAssetDataTask : public ContentLoadTask
                 const auto chunk = ref->GetChunk(i);
                 if (chunk != nullptr)
                 {
-                    if (IsCancelRequested())
-                        return Result::Ok;
-#if TRACY_ENABLE
-                    ZoneScoped;
-                    ZoneName(*name, name.Length());
-                    ZoneValue(chunk->LocationInFile.Size / 1024); // Size in kB
-#endif
-                    if (ref->Storage->LoadAssetChunk(chunk))
-                    {
-                        LOG(Warning, "Cannot load asset \'{0}\' chunk {1}.", ref->ToString(), i);
-                        return Result::LoadDataError;
-                    }
+                    toLoad[toLoadCount++] = chunk;
                 }
             }
         }
+        if (IsCancelRequested())
+            return Result::Ok;
+#if TRACY_ENABLE
+        ZoneScoped;
+        ZoneName(*name, name.Length());
+        uint32 toLoadSize = 0;
+        for (int32 i = 0; i < toLoadCount; i++)
+            toLoadSize += toLoad[i]->LocationInFile.Size;
+        ZoneValue(toLoadSize / 1024); // Size in kB
+#endif
+        if (ref->Storage->LoadAssetChunks(ToSpan(toLoad, toLoadCount)))
+        {
+            LOG(Warning, "Cannot load asset \'{0}\' chunks.", ref->ToString());
+            return Result::LoadDataError;
+        }
 
         return Result::Ok;
     }
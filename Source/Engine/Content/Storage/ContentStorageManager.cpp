@@ -48,6 +48,7 @@ ContentStorageService ContentStorageServiceInstance;
 
 TimeSpan ContentStorageManager::UnusedStorageLifetime = TimeSpan::FromSeconds(0.5f);
 TimeSpan ContentStorageManager::UnusedDataChunksLifetime = TimeSpan::FromSeconds(10);
+bool ContentStorageManager::UseMemoryMapping = true;
 
 FlaxStorageReference ContentStorageManager::GetStorage(const StringView& path, bool loadIt)
 {
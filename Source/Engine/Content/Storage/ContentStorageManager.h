@@ -24,6 +24,11 @@ class FLAXENGINE_API ContentStorageManager
     /// </summary>
     static TimeSpan UnusedDataChunksLifetime;
 
+    /// <summary>
+    /// Enables using memory-mapped files for the read-only packages. Chunks are loaded from the mapped file memory and the uncompressed chunks that allow it (see FlaxChunk::AllowMappedData) use it directly (without copying it into the process heap).
+    /// </summary>
+    static bool UseMemoryMapping;
+
 public:
     /// <summary>
     /// Gets the assets data storage container.
@@ -97,6 +97,11 @@ class FLAXENGINE_API FlaxChunk
     /// </summary>
     BytesContainer Data;
 
+    /// <summary>
+    /// True if the uncompressed chunk data can be linked directly to the memory-mapped file (read-only packages) instead of being copied into the heap. Enable it only for the chunks which data is accessed under the storage lock (see FlaxStorage::LockData) and never moved out of the chunk (eg. swapped with or linked by the container that outlives the lock).
+    /// </summary>
+    bool AllowMappedData = false;
+
 public:
     /// <summary>
     /// Initializes a new instance of the <see cref="FlaxChunk"/> class.
@@ -7,6 +7,7 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/ScopeExit.h"
 #include "Engine/Core/Types/TimeSpan.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Platform/File.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
@@ -14,6 +15,7 @@
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Engine/Serialization/JsonWriter.h"
 #include "Engine/Serialization/JsonWriters.h"
@@ -73,6 +75,107 @@ FlaxChunk* FlaxChunk::Clone() const
     return chunk;
 }
 
+// The maximum size of the coalesced chunks read (in bytes).
+#define CHUNKS_READ_MAX_SIZE (8 * 1024 * 1024)
+// The maximum gap between the chunks in file that can be read within a single coalesced read (in bytes).
+#define CHUNKS_READ_MAX_GAP (64 * 1024)
+// The maximum amount of the pooled temporary buffers used for the chunks reading and decompression.
+#define CHUNKS_BUFFERS_POOL_SIZE 8
+
+namespace
+{
+    CriticalSection ChunkBuffersLocker;
+    Array<Array<byte>*> ChunkBuffers;
+
+    Array<byte>* AcquireChunkBuffer(int32 size)
+    {
+        Array<byte>* buffer = nullptr;
+        ChunkBuffersLocker.Lock();
+        if (ChunkBuffers.HasItems())
+            buffer = ChunkBuffers.Pop();
+        ChunkBuffersLocker.Unlock();
+        if (buffer == nullptr)
+            buffer = New<Array<byte>>();
+        buffer->Resize(size, false);
+        return buffer;
+    }
+
+    void ReleaseChunkBuffer(Array<byte>* buffer)
+    {
+        // Don't keep the huge buffers around
+        if (buffer->Capacity() > CHUNKS_READ_MAX_SIZE)
+        {
+            Delete(buffer);
+            return;
+        }
+        ChunkBuffersLocker.Lock();
+        if (ChunkBuffers.Count() < CHUNKS_BUFFERS_POOL_SIZE)
+        {
+            ChunkBuffers.Add(buffer);
+            buffer = nullptr;
+        }
+        ChunkBuffersLocker.Unlock();
+        if (buffer)
+            Delete(buffer);
+    }
+
+    struct ChunksRead
+    {
+        uint32 Address;
+        uint32 Size;
+        int32 FirstChunk;
+        int32 ChunksCount;
+    };
+
+    struct ChunkDecompress
+    {
+        FlaxChunk* Chunk;
+        const byte* Data;
+    };
+
+    bool SortChunksByAddress(FlaxChunk* const& a, FlaxChunk* const& b)
+    {
+        return a->LocationInFile.Address < b->LocationInFile.Address;
+    }
+
+    bool DecompressChunk(FlaxChunk* chunk, const byte* data)
+    {
+        const int32 size = (int32)chunk->LocationInFile.Size - sizeof(int32); // Don't count original size int
+        const int32 originalSize = *(const int32*)data;
+        PROFILE_CPU_NAMED("DecompressLZ4");
+        chunk->Data.Allocate(originalSize);
+        const int32 res = LZ4_decompress_safe((const char*)data + sizeof(int32), chunk->Data.Get<char>(), size, originalSize);
+        if (res <= 0)
+        {
+            chunk->Data.Release();
+            LOG(Warning, "Failed to decompress chunk data. Result: {0}.", res);
+            return true;
+        }
+        chunk->Data.SetLength(res);
+        return false;
+    }
+
+    bool LoadMappedChunk(FlaxChunk* chunk, const byte* view, uint32 viewSize)
+    {
+        const auto& location = chunk->LocationInFile;
+        if ((uint64)location.Address + location.Size > viewSize)
+        {
+            LOG(Warning, "Invalid chunk location.");
+            return true;
+        }
+        const byte* data = view + location.Address;
+        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+            return DecompressChunk(chunk, data);
+
+        // Use raw data directly from the mapped file memory only if chunk data doesn't escape the chunk (otherwise it could outlive the mapping)
+        if (chunk->AllowMappedData)
+            chunk->Data.Link(data, (int32)location.Size);
+        else
+            chunk->Data.Copy(data, (int32)location.Size);
+        return false;
+    }
+}
+
 const int32 FlaxStorage::MagicCode = 1180124739;
 
 struct Header
@@ -247,6 +350,7 @@ FlaxStorage::~FlaxStorage()
     CHECK_NO_RETURN(_refCount == 0);
     CHECK_NO_RETURN(_isUnloadingData == 0);
     ASSERT(_chunks.IsEmpty());
+    UnmapFile();
 
 #if USE_EDITOR
     // Ensure to close any outstanding file handles to prevent file locking in case it failed to load
@@ -300,7 +404,11 @@ uint32 FlaxStorage::GetMemoryUsage() const
 {
     uint32 result = sizeof(FlaxStorage);
     for (int32 i = 0; i < _chunks.Count(); i++)
-        result += _chunks[i]->Data.Length();
+    {
+        // Skip memory-mapped file data (not counted to the process heap)
+        if (!IsChunkMapped(_chunks[i]))
+            result += _chunks[i]->Data.Length();
+    }
     return result;
 }
 
@@ -732,77 +840,216 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
 
     LockChunks();
 
+    // Use memory-mapped file if possible
+    if (const byte* view = MapFile())
+    {
+        const bool failed = LoadMappedChunk(chunk, view, _mapSize);
+        if (failed)
+            LOG(Warning, "Cannot load chunk from {0}.", ToString());
+        else
+            chunk->RegisterUsage();
+        UnlockChunks();
+        return failed;
+    }
+
     // Open file
-    auto stream = OpenFile();
+    auto stream = OpenFile(chunk->LocationInFile.Address);
     bool failed = stream == nullptr;
     if (!failed)
     {
-        // Seek
-        stream->SetPosition(chunk->LocationInFile.Address);
-
-        if (stream->HasError())
-        {
-            // Sometimes stream->HasError() from setposition. result in a crash or missing media in release (stream _file._handle = nullptr).
-            // When retrying, it looks like it works and we can continue. We need this to success.
-
-            for (int retry = 0; retry < 5; retry++)
-            {
-                Platform::Sleep(50);
-                stream = OpenFile();
-                failed = stream == nullptr;
-                if (!failed)
-                {
-                    stream->SetPosition(chunk->LocationInFile.Address);
-                    if (!stream->HasError())
-                        break;
-                }
-            }
-        }
-
-        if (!stream || stream->HasError())
-        {
-            failed = true;
-            UnlockChunks();
-            LOG(Warning, "SetPosition failed on chunk {0}.", ToString());
-            return failed;
-        }
-
         // Load data
-        auto size = chunk->LocationInFile.Size;
+        const uint32 size = chunk->LocationInFile.Size;
         if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
         {
             // Compressed
-            size -= sizeof(int32); // Don't count original size int
-            int32 originalSize;
-            stream->ReadInt32(&originalSize);
-            Array<byte> tmpBuf;
-            tmpBuf.Resize(size); // TODO: maybe use thread local or content loading pool with sharable temp buffers for the decompression?
-            stream->ReadBytes(tmpBuf.Get(), size);
-
-            // Decompress data
-            PROFILE_CPU_NAMED("DecompressLZ4");
-            chunk->Data.Allocate(originalSize);
-            const int32 res = LZ4_decompress_safe((const char*)tmpBuf.Get(), chunk->Data.Get<char>(), size, originalSize);
-            if (res <= 0)
-            {
-                UnlockChunks();
-                LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), res);
-                return true;
-            }
-            chunk->Data.SetLength(res);
+            Array<byte>* buffer = AcquireChunkBuffer(size);
+            stream->ReadBytes(buffer->Get(), size);
+            failed = stream->HasError() || DecompressChunk(chunk, buffer->Get());
+            ReleaseChunkBuffer(buffer);
+            if (failed)
+                LOG(Warning, "Cannot load chunk from {0}.", ToString());
         }
         else
         {
             // Raw data
             chunk->Data.Read(stream, size);
         }
-        chunk->RegisterUsage();
+        if (!failed)
+            chunk->RegisterUsage();
     }
 
     UnlockChunks();
     return failed;
 }
 
+bool FlaxStorage::LoadAssetChunks(Span<FlaxChunk*> chunks)
+{
+    PROFILE_CPU();
+    PROFILE_MEM(ContentFiles);
+    ASSERT(IsLoaded());
+
+    // Gather chunks to load (sorted by location in file so the reads are sequential)
+    Array<FlaxChunk*, InlinedAllocation<32>> toLoad;
+    for (FlaxChunk* chunk : chunks)
+    {
+        if (chunk && chunk->IsMissing() && chunk->ExistsInFile())
+        {
+            ASSERT(_chunks.Contains(chunk));
+            toLoad.Add(chunk);
+        }
+    }
+    if (toLoad.IsEmpty())
+        return false;
+    if (toLoad.Count() == 1)
+        return LoadAssetChunk(toLoad[0]);
+    Sorting::QuickSort(toLoad.Get(), toLoad.Count(), &SortChunksByAddress);
+    for (int32 i = toLoad.Count() - 1; i > 0; i--)
+    {
+        if (toLoad[i] == toLoad[i - 1])
+            toLoad.RemoveAtKeepOrder(i);
+    }
+
+#if PLATFORM_THREADS_LIMIT > 1
+    // Protect against loading the same chunks from multiple threads at once (lock them in the file order to prevent deadlocks)
+    for (FlaxChunk* chunk : toLoad)
+    {
+        while (Platform::InterlockedCompareExchange(&chunk->IsLoading, 1, 0) != 0)
+            Platform::Sleep(1);
+    }
+    SCOPE_EXIT
+    {
+        for (FlaxChunk* chunk : toLoad)
+            Platform::AtomicStore(&chunk->IsLoading, 0);
+    };
+#endif
+    for (int32 i = toLoad.Count() - 1; i >= 0; i--)
+    {
+        // Skip chunks loaded by other thread in the meantime
+        if (toLoad[i]->Data.IsValid())
+        {
+#if PLATFORM_THREADS_LIMIT > 1
+            Platform::AtomicStore(&toLoad[i]->IsLoading, 0);
+#endif
+            toLoad.RemoveAtKeepOrder(i);
+        }
+    }
+    if (toLoad.IsEmpty())
+        return false;
+    LockChunks();
+    int64 failed = 0;
+
+    // Use memory-mapped file if possible (decompress chunks in parallel)
+    if (const byte* view = MapFile())
+    {
+        Function<void(int32)> job = [this, view, &toLoad, &failed](int32 index)
+        {
+            PROFILE_MEM(ContentFiles);
+            if (LoadMappedChunk(toLoad[index], view, _mapSize))
+                Platform::InterlockedExchange(&failed, 1);
+        };
+        JobSystem::Execute(job, toLoad.Count());
+    }
+    else
+    {
+        LoadChunksFromFile(ToSpan(toLoad), failed);
+    }
+    for (FlaxChunk* chunk : toLoad)
+    {
+        if (chunk->Data.IsValid())
+            chunk->RegisterUsage();
+    }
+    UnlockChunks();
+
+    if (failed)
+        LOG(Warning, "Cannot load {0} chunks from {1}.", toLoad.Count(), ToString());
+    return failed != 0;
+}
+
+void FlaxStorage::LoadChunksFromFile(Span<FlaxChunk*> toLoad, int64& failed)
+{
+    // Coalesce adjacent chunks into larger reads
+    Array<ChunksRead, InlinedAllocation<32>> reads;
+    for (int32 i = 0; i < toLoad.Length(); i++)
+    {
+        const auto& location = toLoad[i]->LocationInFile;
+        if (reads.HasItems())
+        {
+            auto& read = reads.Last();
+            const uint32 end = read.Address + read.Size;
+            const uint32 chunkEnd = location.Address + location.Size;
+            if (location.Address >= end && location.Address - end <= CHUNKS_READ_MAX_GAP && chunkEnd - read.Address <= CHUNKS_READ_MAX_SIZE)
+            {
+                read.Size = chunkEnd - read.Address;
+                read.ChunksCount++;
+                continue;
+            }
+        }
+        reads.Add({ location.Address, location.Size, i, 1 });
+    }
+
+    // Read data on the calling thread (blocking IO doesn't occupy the job system threads) and decompress chunks via jobs (overlaps IO with decompression)
+    PROFILE_CPU_NAMED("LoadAssetChunks");
+    PROFILE_MEM(ContentFiles);
+    Array<ChunkDecompress, InlinedAllocation<32>> decompress;
+    decompress.EnsureCapacity(toLoad.Length()); // Jobs access items so array cannot be reallocated
+    Array<Array<byte>*, InlinedAllocation<32>> buffers;
+    Array<int64, InlinedAllocation<32>> jobs;
+    for (const ChunksRead& read : reads)
+    {
+        FileReadStream* stream = OpenFile(read.Address);
+        if (stream == nullptr)
+        {
+            Platform::InterlockedExchange(&failed, 1);
+            break;
+        }
+        FlaxChunk* first = toLoad[read.FirstChunk];
+        if (read.ChunksCount == 1 && EnumHasNoneFlags(first->Flags, FlaxChunkFlags::CompressedLZ4))
+        {
+            // Read raw data directly into the chunk
+            first->Data.Read(stream, read.Size);
+            if (stream->HasError())
+                Platform::InterlockedExchange(&failed, 1);
+            continue;
+        }
+        Array<byte>* buffer = AcquireChunkBuffer(read.Size);
+        buffers.Add(buffer);
+        stream->ReadBytes(buffer->Get(), read.Size);
+        if (stream->HasError())
+        {
+            Platform::InterlockedExchange(&failed, 1);
+            continue;
+        }
+        const int32 decompressStart = decompress.Count();
+        for (int32 i = 0; i < read.ChunksCount; i++)
+        {
+            FlaxChunk* chunk = toLoad[read.FirstChunk + i];
+            const byte* data = buffer->Get() + (chunk->LocationInFile.Address - read.Address);
+            if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+                decompress.Add({ chunk, data });
+            else
+                chunk->Data.Copy(data, (int32)chunk->LocationInFile.Size);
+        }
+        const int32 decompressCount = decompress.Count() - decompressStart;
+        if (decompressCount != 0)
+        {
+            const ChunkDecompress* items = decompress.Get() + decompressStart;
+            Function<void(int32)> job = [items, &failed](int32 index)
+            {
+                PROFILE_CPU_NAMED("DecompressAssetChunk");
+                PROFILE_MEM(ContentFiles);
+                const ChunkDecompress& e = items[index];
+                if (DecompressChunk(e.Chunk, e.Data))
+                    Platform::InterlockedExchange(&failed, 1);
+            };
+            jobs.Add(JobSystem::Dispatch(job, decompressCount));
+        }
+    }
+    for (const int64 label : jobs)
+        JobSystem::Wait(label);
+    for (Array<byte>* buffer : buffers)
+        ReleaseChunkBuffer(buffer);
+}
+
 #if USE_EDITOR
 
 bool FlaxStorage::ChangeAssetID(Entry& e, const Guid& newId)
@@ -1436,6 +1683,94 @@ FileReadStream* FlaxStorage::OpenFile()
     return stream;
 }
 
+const byte* FlaxStorage::MapFile()
+{
+    if (!IsReadOnly() || !ContentStorageManager::UseMemoryMapping)
+        return nullptr;
+    ScopeLock lock(_mapLocker);
+    if (_mapView == nullptr && !_mapFailed)
+    {
+        PROFILE_CPU();
+        PROFILE_MEM(ContentFiles);
+        auto file = File::Open(_path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+        if (file)
+        {
+            _mapSize = file->GetSize();
+            _mapView = file->MapView(_mapSize);
+        }
+        if (_mapView)
+        {
+            _mapFile = file;
+            Platform::InterlockedIncrement(&_files);
+        }
+        else
+        {
+            // Fallback to the file streams
+            LOG(Warning, "Cannot map file '{0}' into memory.", _path);
+            _mapFailed = true;
+            _mapSize = 0;
+            if (file)
+                Delete(file);
+        }
+    }
+    return _mapView;
+}
+
+void FlaxStorage::UnmapFile()
+{
+    ScopeLock lock(_mapLocker);
+    if (_mapView == nullptr)
+        return;
+
+    // Chunks that still use the mapped memory (eg. kept in memory) get a copy of it
+    for (FlaxChunk* chunk : _chunks)
+    {
+        if (IsChunkMapped(chunk))
+            chunk->Data.Copy(chunk->Data.Get(), chunk->Data.Length());
+    }
+
+    _mapFile->UnmapView(_mapView, _mapSize);
+    Delete(_mapFile);
+    _mapFile = nullptr;
+    _mapView = nullptr;
+    _mapSize = 0;
+}
+
+FileReadStream* FlaxStorage::OpenFile(uint32 position)
+{
+    auto stream = OpenFile();
+    if (stream)
+    {
+        // Seek
+        stream->SetPosition(position);
+
+        if (stream->HasError())
+        {
+            // Sometimes stream->HasError() from setposition. result in a crash or missing media in release (stream _file._handle = nullptr).
+            // When retrying, it looks like it works and we can continue. We need this to success.
+
+            for (int retry = 0; retry < 5; retry++)
+            {
+                Platform::Sleep(50);
+                stream = OpenFile();
+                if (stream)
+                {
+                    stream->SetPosition(position);
+                    if (!stream->HasError())
+                        break;
+                }
+            }
+        }
+
+        if (!stream || stream->HasError())
+        {
+            LOG(Warning, "SetPosition failed on chunk {0}.", ToString());
+            return nullptr;
+        }
+    }
+    return stream;
+}
+
 bool FlaxStorage::CloseFileHandles()
 {
     // Guard the whole process so if new thread wants to lock the chunks will need to wait for this to end
@@ -1476,6 +1811,7 @@ bool FlaxStorage::CloseFileHandles()
         return true; // Failed, someone is still accessing the file
 
     // Close file handles (from all threads)
+    UnmapFile();
     Array<FileReadStream*, InlinedAllocation<8>> streams;
     _file.GetValues(streams);
     for (FileReadStream* stream : streams)
@@ -1532,7 +1868,7 @@ void FlaxStorage::Tick(double time)
             chunk->Unload();
             Platform::InterlockedDecrement(&_isUnloadingData);
         }
-        wasAnyUsed |= wasUsed;
+        wasAnyUsed |= wasUsed || IsChunkMapped(chunk); // Keep the file mapped while any chunk uses its memory
     }
 
     // Release file handles in none of chunks is in use
@@ -98,6 +98,13 @@ class FLAXENGINE_API FlaxStorage : public Object
     ThreadLocal<FileReadStream*> _file;
     Array<FlaxChunk*> _chunks;
 
+    // Memory-mapped file (read-only storages only)
+    CriticalSection _mapLocker;
+    File* _mapFile = nullptr;
+    const byte* _mapView = nullptr;
+    uint32 _mapSize = 0;
+    bool _mapFailed = false;
+
     // Metadata
     uint32 _version = 0;
     String _path;
@@ -395,6 +402,13 @@ class FLAXENGINE_API FlaxStorage : public Object
     /// <returns>True if cannot load data, otherwise false</returns>
     bool LoadAssetChunk(FlaxChunk* chunk);
 
+    /// <summary>
+    /// Loads the batch of the asset chunks. Sorts chunks by the location in file and coalesces the adjacent ones into larger reads that are performed in parallel via Job System (including data decompression).
+    /// </summary>
+    /// <param name="chunks">The chunks to load. Can contain null or already loaded chunks (skipped).</param>
+    /// <returns>True if cannot load data, otherwise false</returns>
+    bool LoadAssetChunks(Span<FlaxChunk*> chunks);
+
 #if USE_EDITOR
 
     /// <summary>
@@ -494,6 +508,14 @@ class FLAXENGINE_API FlaxStorage : public Object
     void AddChunk(FlaxChunk* chunk);
     virtual void AddEntry(Entry& e) = 0;
     FileReadStream* OpenFile();
+    FileReadStream* OpenFile(uint32 position);
+    const byte* MapFile();
+    void UnmapFile();
+    void LoadChunksFromFile(Span<FlaxChunk*> toLoad, int64& failed);
+    FORCE_INLINE bool IsChunkMapped(const FlaxChunk* chunk) const
+    {
+        return _mapView && !chunk->Data.IsAllocated() && chunk->Data.Get() >= _mapView && chunk->Data.Get() < _mapView + _mapSize;
+    }
     virtual bool GetEntry(const Guid& id, Entry& e) = 0;
     bool ReloadSilent();
 };
@@ -0,0 +1,122 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "FrustumCulling.h"
+#include "Engine/Core/SIMD.h"
+
+void FrustumCulling::Spheres::Resize(int32 count)
+{
+    count = Math::AlignUp(count, ChunkSize);
+    const int32 prevCount = Count();
+    if (count <= prevCount)
+        return;
+    CenterX.Resize(count);
+    CenterY.Resize(count);
+    CenterZ.Resize(count);
+    Radius.Resize(count);
+    LayerMask.Resize(count);
+    const int32 newCount = count - prevCount;
+    Platform::MemoryClear(CenterX.Get() + prevCount, newCount * sizeof(Real));
+    Platform::MemoryClear(CenterY.Get() + prevCount, newCount * sizeof(Real));
+    Platform::MemoryClear(CenterZ.Get() + prevCount, newCount * sizeof(Real));
+    Platform::MemoryClear(Radius.Get() + prevCount, newCount * sizeof(float));
+    Platform::MemoryClear(LayerMask.Get() + prevCount, newCount * sizeof(uint32));
+}
+
+void FrustumCulling::Spheres::Clear()
+{
+    CenterX.Clear();
+    CenterY.Clear();
+    CenterZ.Clear();
+    Radius.Clear();
+    LayerMask.Clear();
+}
+
+void FrustumCulling::Spheres::Set(int32 index, const BoundingSphere& bounds, uint32 layerMask, bool noCulling)
+{
+    CenterX.Get()[index] = bounds.Center.X;
+    CenterY.Get()[index] = bounds.Center.Y;
+    CenterZ.Get()[index] = bounds.Center.Z;
+    Radius.Get()[index] = noCulling ? MAX_float : (float)bounds.Radius;
+    LayerMask.Get()[index] = layerMask;
+}
+
+void FrustumCulling::GetPlanes(const BoundingFrustum* frustums, int32 frustumsCount, Float4* planes)
+{
+    for (int32 i = 0; i < frustumsCount; i++)
+    {
+        for (int32 j = 0; j < 6; j++)
+        {
+            const Plane plane = frustums[i].GetPlane(j);
+            planes[i * 6 + j] = Float4((float)plane.Normal.X, (float)plane.Normal.Y, (float)plane.Normal.Z, (float)plane.D);
+        }
+    }
+}
+
+uint64 FrustumCulling::Cull(const float* centerX, const float* centerY, const float* centerZ, const float* radius, int32 count, const Float4* planes, int32 frustumsCount, uint64 testMask)
+{
+    ASSERT_LOW_LAYER(count <= ChunkSize);
+    if (count < ChunkSize)
+        testMask &= (1ull << count) - 1;
+    uint64 result = 0;
+    for (int32 i = 0; i < count; i += 8)
+    {
+        const uint32 groupMask = (uint32)(testMask >> i) & 0xff;
+        if (groupMask == 0)
+            continue;
+        const SimdVector4 x0 = SIMD::Load(centerX + i), x1 = SIMD::Load(centerX + i + 4);
+        const SimdVector4 y0 = SIMD::Load(centerY + i), y1 = SIMD::Load(centerY + i + 4);
+        const SimdVector4 z0 = SIMD::Load(centerZ + i), z1 = SIMD::Load(centerZ + i + 4);
+        const SimdVector4 r0 = SIMD::Load(radius + i), r1 = SIMD::Load(radius + i + 4);
+        uint32 visible = 0;
+        for (int32 frustumIndex = 0; frustumIndex < frustumsCount && visible != groupMask; frustumIndex++)
+        {
+            // Sphere is outside the frustum if dot(normal, center) + d < -radius for any plane, so find the minimum of the signed distances and test the sign bit
+            const Float4* frustumPlanes = planes + frustumIndex * 6;
+            SimdVector4 min0 = SIMD::Splat(MAX_float), min1 = min0;
+            for (int32 planeIndex = 0; planeIndex < 6; planeIndex++)
+            {
+                const Float4& plane = frustumPlanes[planeIndex];
+                const SimdVector4 nx = SIMD::Splat(plane.X);
+                const SimdVector4 ny = SIMD::Splat(plane.Y);
+                const SimdVector4 nz = SIMD::Splat(plane.Z);
+                const SimdVector4 d = SIMD::Splat(plane.W);
+                const SimdVector4 dist0 = SIMD::Add(SIMD::Add(SIMD::Mul(nx, x0), SIMD::Mul(ny, y0)), SIMD::Add(SIMD::Mul(nz, z0), SIMD::Add(d, r0)));
+                const SimdVector4 dist1 = SIMD::Add(SIMD::Add(SIMD::Mul(nx, x1), SIMD::Mul(ny, y1)), SIMD::Add(SIMD::Mul(nz, z1), SIMD::Add(d, r1)));
+                min0 = SIMD::Min(min0, dist0);
+                min1 = SIMD::Min(min1, dist1);
+            }
+            const uint32 outside = (uint32)SIMD::MoveMask(min0) | ((uint32)SIMD::MoveMask(min1) << 4);
+            visible |= ~outside & groupMask;
+        }
+        result |= (uint64)visible << i;
+    }
+    return result;
+}
+
+uint64 FrustumCulling::Cull(const Spheres& spheres, int32 start, const Vector3& origin, const Float4* planes, int32 frustumsCount, uint32 layerMask)
+{
+    ASSERT_LOW_LAYER(start % ChunkSize == 0 && start + ChunkSize <= spheres.Count());
+    const uint32* layers = spheres.LayerMask.Get() + start;
+    uint64 testMask = 0;
+    for (int32 i = 0; i < ChunkSize; i++)
+        testMask |= (uint64)((layers[i] & layerMask) != 0) << i;
+    if (testMask == 0)
+        return 0;
+#if !USE_LARGE_WORLDS
+    if (origin.IsZero())
+        return Cull(spheres.CenterX.Get() + start, spheres.CenterY.Get() + start, spheres.CenterZ.Get() + start, spheres.Radius.Get() + start, ChunkSize, planes, frustumsCount, testMask);
+#endif
+
+    // Move the centers relative to the origin before the conversion to float to keep the precision far from the world origin
+    alignas(16) float x[ChunkSize], y[ChunkSize], z[ChunkSize];
+    const Real* centerX = spheres.CenterX.Get() + start;
+    const Real* centerY = spheres.CenterY.Get() + start;
+    const Real* centerZ = spheres.CenterZ.Get() + start;
+    for (int32 i = 0; i < ChunkSize; i++)
+    {
+        x[i] = (float)(centerX[i] - origin.X);
+        y[i] = (float)(centerY[i] - origin.Y);
+        z[i] = (float)(centerZ[i] - origin.Z);
+    }
+    return Cull(x, y, z, spheres.Radius.Get() + start, ChunkSize, planes, frustumsCount, testMask);
+}
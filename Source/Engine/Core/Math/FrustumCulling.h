@@ -0,0 +1,89 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+
+/// <summary>
+/// Vectorized culling of bounding spheres against a list of frustums. Spheres are stored as a structure-of-arrays and tested in groups of 8, results are returned as a bitmask (64 spheres per word).
+/// </summary>
+class FLAXENGINE_API FrustumCulling
+{
+public:
+    /// <summary>
+    /// The amount of spheres culled by a single call (size of the visibility mask).
+    /// </summary>
+    static constexpr int32 ChunkSize = 64;
+
+    /// <summary>
+    /// The list of bounding spheres (in world space) with layer masks stored as a structure-of-arrays. Capacity is padded to the chunk size so culling can always read the full chunk.
+    /// </summary>
+    /// <remarks>Centers are kept in Real precision and converted to float relative to the view origin when culling (precise for large worlds).</remarks>
+    struct FLAXENGINE_API Spheres
+    {
+        Array<Real> CenterX;
+        Array<Real> CenterY;
+        Array<Real> CenterZ;
+        Array<float> Radius;
+        // The objects layer masks. Unused slots have zero mask so they are never visible.
+        Array<uint32> LayerMask;
+
+        FORCE_INLINE int32 Count() const
+        {
+            return LayerMask.Count();
+        }
+
+        // Resizes the list to hold at least the given amount of spheres. New slots are cleared.
+        void Resize(int32 count);
+
+        // Clears the list.
+        void Clear();
+
+        // Sets the sphere data. Spheres with infinite radius (object without culling) are always visible.
+        void Set(int32 index, const BoundingSphere& bounds, uint32 layerMask, bool noCulling = false);
+
+        // Sets the sphere layer mask.
+        FORCE_INLINE void SetLayerMask(int32 index, uint32 layerMask)
+        {
+            LayerMask.Get()[index] = layerMask;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Gets the frustum planes for the culling. Spheres tested against the planes need to be in the same space as the frustums (eg. relative to the view origin for large worlds).
+    /// </summary>
+    /// <param name="frustums">The frustums.</param>
+    /// <param name="frustumsCount">The frustums count.</param>
+    /// <param name="planes">The output planes (6 per frustum, packed as normal and distance).</param>
+    static void GetPlanes(const BoundingFrustum* frustums, int32 frustumsCount, Float4* planes);
+
+    /// <summary>
+    /// Tests the spheres against the frustums and returns the visibility mask (bit per sphere). Sphere is visible if it intersects any of the frustums.
+    /// </summary>
+    /// <param name="centerX">The spheres center X components.</param>
+    /// <param name="centerY">The spheres center Y components.</param>
+    /// <param name="centerZ">The spheres center Z components.</param>
+    /// <param name="radius">The spheres radius.</param>
+    /// <param name="count">The spheres count (up to 64). Arrays need to be readable up to the count aligned to 8.</param>
+    /// <param name="planes">The frustum planes (from GetPlanes).</param>
+    /// <param name="frustumsCount">The frustums count.</param>
+    /// <param name="testMask">The mask of the spheres to test (other spheres are not visible).</param>
+    /// <returns>The mask of the visible spheres.</returns>
+    static uint64 Cull(const float* centerX, const float* centerY, const float* centerZ, const float* radius, int32 count, const Float4* planes, int32 frustumsCount, uint64 testMask = MAX_uint64);
+
+    /// <summary>
+    /// Tests the chunk of spheres against the frustums and returns the visibility mask (bit per sphere). Spheres that don't match the layer mask are not visible.
+    /// </summary>
+    /// <param name="spheres">The spheres list.</param>
+    /// <param name="start">The first sphere index (multiple of the chunk size).</param>
+    /// <param name="origin">The frustums origin (eg. view origin for large worlds). Sphere centers are moved relative to it before the conversion to float.</param>
+    /// <param name="planes">The frustum planes (from GetPlanes).</param>
+    /// <param name="frustumsCount">The frustums count.</param>
+    /// <param name="layerMask">The layers mask to filter the spheres.</param>
+    /// <returns>The mask of the visible spheres from the chunk.</returns>
+    static uint64 Cull(const Spheres& spheres, int32 start, const Vector3& origin, const Float4* planes, int32 frustumsCount, uint32 layerMask);
+};
@@ -4,9 +4,7 @@
 
 #include "Engine/Platform/Platform.h"
 #if PLATFORM_SIMD_SSE2
-#ifdef _WIN32
 #include <xmmintrin.h>
-#endif
 #else
 #include <math.h>
 #endif
@@ -104,6 +102,18 @@ namespace SIMD
     {
         return _mm_max_ps(a, b);
     }
+
+    // Returns the per-component mask of a < b.
+    FORCE_INLINE SimdVector4 Less(SimdVector4 a, SimdVector4 b)
+    {
+        return _mm_cmplt_ps(a, b);
+    }
+
+    // Returns the per-component selection of a (where mask is set) or b.
+    FORCE_INLINE SimdVector4 Select(SimdVector4 mask, SimdVector4 a, SimdVector4 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
 }
 
 #else
@@ -256,6 +266,28 @@ namespace SIMD
 			a.W > b.W ? a.W : b.W
 		};
 	}
+
+	FORCE_INLINE SimdVector4 Less(SimdVector4 a, SimdVector4 b)
+	{
+		return
+		{
+			a.X < b.X ? -1.0f : 0.0f,
+			a.Y < b.Y ? -1.0f : 0.0f,
+			a.Z < b.Z ? -1.0f : 0.0f,
+			a.W < b.W ? -1.0f : 0.0f
+		};
+	}
+
+	FORCE_INLINE SimdVector4 Select(SimdVector4 mask, SimdVector4 a, SimdVector4 b)
+	{
+		return
+		{
+			mask.X < 0 ? a.X : b.X,
+			mask.Y < 0 ? a.Y : b.Y,
+			mask.Z < 0 ? a.Z : b.Z,
+			mask.W < 0 ? a.W : b.W
+		};
+	}
 }
 
 #endif
@@ -150,6 +150,21 @@ namespace Utilities
 #endif
     }
 
+    // Returns the index of the lowest set bit in 64-bit integer. Assumes input is non-zero.
+    inline uint32 LowestSetBit64(uint64 v)
+    {
+#if _MSC_VER && PLATFORM_64BITS
+        unsigned long result;
+        _BitScanForward64(&result, v);
+        return result;
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        const uint32 low = (uint32)v;
+        return low != 0 ? LowestSetBit(low) : 32 + LowestSetBit((uint32)(v >> 32));
+#endif
+    }
+
     // Copy memory region but ignoring address sanatizer checks for memory regions.
     NO_SANITIZE_ADDRESS static void UnsafeMemoryCopy(void* dst, const void* src, uint64 size)
     {
@@ -17,6 +17,7 @@
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Physics/Physics.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/MainThreadTask.h"
 #include "Engine/Threading/ThreadRegistry.h"
 #include "Engine/Graphics/GPUDevice.h"
@@ -201,6 +202,10 @@ void Engine::OnLoop()
     // Use the same time for all ticks to improve synchronization
     const double time = Platform::GetTimeSeconds();
 
+    // Setup frame deadline so background jobs won't delay the frame work
+    const float frameFPS = Time::DrawFPS > ZeroTolerance ? Time::DrawFPS : Time::UpdateFPS;
+    JobSystem::SetFrameDeadline(frameFPS > ZeroTolerance ? time + 1.0 / frameFPS : 0.0);
+
     // Update application (will gather data and other platform related events)
     {
         PROFILE_CPU_NAMED("Platform.Tick");
@@ -5,6 +5,8 @@
 #include "FoliageCluster.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Random.h"
+#include "Engine/Core/Utilities.h"
+#include "Engine/Core/Math/FrustumCulling.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -25,6 +27,47 @@
 #define FOLIAGE_GET_DRAW_MODES(renderContext, type) (type._drawModes & renderContext.View.Pass & renderContext.View.GetShadowsDrawPassMask(type.ShadowsMode))
 #define FOLIAGE_CAN_DRAW(renderContext, type) (type.IsReady() && FOLIAGE_GET_DRAW_MODES(renderContext, type) != DrawPass::None && type.Model->CanBeRendered())
 
+static_assert(FOLIAGE_CLUSTER_CAPACITY <= FrustumCulling::ChunkSize, "Foliage cluster instances are culled as a single chunk.");
+
+namespace
+{
+    // Culls the total bounds of the cluster children with the view frustum. Returns the mask of the visible children.
+    uint32 CullClusterChildren(const FoliageCluster* cluster, const Vector3& origin, const Float4* planes)
+    {
+        alignas(16) float x[8] = {}, y[8] = {}, z[8] = {}, r[8] = {};
+        for (int32 i = 0; i < 4; i++)
+        {
+            const BoundingSphere& sphere = cluster->Children[i]->TotalBoundsSphere;
+            x[i] = (float)(sphere.Center.X - origin.X);
+            y[i] = (float)(sphere.Center.Y - origin.Y);
+            z[i] = (float)(sphere.Center.Z - origin.Z);
+            r[i] = (float)sphere.Radius;
+        }
+        return (uint32)FrustumCulling::Cull(x, y, z, r, 4, planes, 1);
+    }
+
+    // Culls the bounds of the cluster instances with the view frustum. Returns the mask of the visible instances.
+    uint64 CullClusterInstances(const FoliageCluster* cluster, const Vector3& origin, const Float4* planes)
+    {
+        const int32 count = cluster->Instances.Count();
+        if (count == 0)
+            return 0;
+        alignas(16) float x[FOLIAGE_CLUSTER_CAPACITY + 8], y[FOLIAGE_CLUSTER_CAPACITY + 8], z[FOLIAGE_CLUSTER_CAPACITY + 8], r[FOLIAGE_CLUSTER_CAPACITY + 8];
+        FoliageInstance* const* instances = cluster->Instances.Get();
+        for (int32 i = 0; i < count; i++)
+        {
+            const BoundingSphere& sphere = instances[i]->Bounds;
+            x[i] = (float)(sphere.Center.X - origin.X);
+            y[i] = (float)(sphere.Center.Y - origin.Y);
+            z[i] = (float)(sphere.Center.Z - origin.Z);
+            r[i] = (float)sphere.Radius;
+        }
+        for (int32 i = count; i < Math::AlignUp(count, 8); i++)
+            x[i] = y[i] = z[i] = r[i] = 0.0f;
+        return FrustumCulling::Cull(x, y, z, r, count, planes, 1);
+    }
+}
+
 Foliage::Foliage(const SpawnParams& params)
     : Actor(params)
 {
@@ -169,11 +212,12 @@ void Foliage::DrawCluster(DrawContext& context, FoliageCluster* cluster, DrawCal
     if (cluster->Children[0])
     {
         BoundingBox box;
+        const uint32 visibleChildren = CullClusterChildren(cluster, context.ViewOrigin, context.CullingPlanes);
 #define DRAW_CLUSTER(idx) \
         box = cluster->Children[idx]->TotalBounds; \
         box.Minimum -= context.ViewOrigin; \
         box.Maximum -= context.ViewOrigin; \
-		if (context.RenderContext.View.CullingFrustum.Intersects(box)) \
+		if ((visibleChildren & (1 << idx)) && context.RenderContext.View.CullingFrustum.Intersects(box)) \
 			DrawCluster(context, cluster->Children[idx], drawCallsLists, result)
         DRAW_CLUSTER(0);
         DRAW_CLUSTER(1);
@@ -188,13 +232,15 @@ void Foliage::DrawCluster(DrawContext& context, FoliageCluster* cluster, DrawCal
         const auto model = context.FoliageType.Model.Get();
         const auto transitionLOD = context.RenderContext.View.Pass != DrawPass::Depth; // Let the main view pass update LOD transitions
         // TODO: move DrawState to be stored per-view (so shadows can fade objects on their own)
-        for (int32 i = 0; i < cluster->Instances.Count(); i++)
+        uint64 visibleInstances = CullClusterInstances(cluster, context.ViewOrigin, context.CullingPlanes);
+        while (visibleInstances != 0)
         {
+            const int32 i = (int32)Utilities::LowestSetBit64(visibleInstances);
+            visibleInstances &= visibleInstances - 1;
             auto& instance = *cluster->Instances.Get()[i];
             BoundingSphere sphere = instance.Bounds;
             sphere.Center -= context.ViewOrigin;
             if (Float3::Distance(context.LodView.Position, sphere.Center) - (float)sphere.Radius < instance.CullDistance &&
-                context.RenderContext.View.CullingFrustum.Intersects(sphere) &&
                 RenderTools::ComputeBoundsScreenRadiusSquared(sphere.Center, (float)sphere.Radius, context.RenderContext.View) * context.ViewScreenSizeSq >= context.MinObjectPixelSizeSq)
             {
                 const auto modelFrame = instance.DrawState.PrevFrame + 1;
@@ -309,11 +355,12 @@ void Foliage::DrawCluster(DrawContext& context, FoliageCluster* cluster, Mesh::D
     if (cluster->Children[0])
     {
         BoundingBox box;
+        const uint32 visibleChildren = CullClusterChildren(cluster, context.ViewOrigin, context.CullingPlanes);
 #define DRAW_CLUSTER(idx) \
         box = cluster->Children[idx]->TotalBounds; \
         box.Minimum -= context.ViewOrigin; \
         box.Maximum -= context.ViewOrigin; \
-		if (context.RenderContext.View.CullingFrustum.Intersects(box)) \
+		if ((visibleChildren & (1 << idx)) && context.RenderContext.View.CullingFrustum.Intersects(box)) \
 			DrawCluster(context, cluster->Children[idx], draw)
         DRAW_CLUSTER(0);
         DRAW_CLUSTER(1);
@@ -325,8 +372,11 @@ void Foliage::DrawCluster(DrawContext& context, FoliageCluster* cluster, Mesh::D
     {
         // Draw visible instances
         const auto frame = Engine::FrameCount;
-        for (int32 i = 0; i < cluster->Instances.Count(); i++)
+        uint64 visibleInstances = CullClusterInstances(cluster, context.ViewOrigin, context.CullingPlanes);
+        while (visibleInstances != 0)
         {
+            const int32 i = (int32)Utilities::LowestSetBit64(visibleInstances);
+            visibleInstances &= visibleInstances - 1;
             auto& instance = *cluster->Instances[i];
             auto& type = FoliageTypes[instance.Type];
             BoundingSphere sphere = instance.Bounds;
@@ -335,7 +385,6 @@ void Foliage::DrawCluster(DrawContext& context, FoliageCluster* cluster, Mesh::D
             // Check if can draw this instance
             if (type._canDraw &&
                 Float3::Distance(context.LodView.Position, sphere.Center) - (float)sphere.Radius < instance.CullDistance &&
-                context.RenderContext.View.CullingFrustum.Intersects(sphere) &&
                 RenderTools::ComputeBoundsScreenRadiusSquared(sphere.Center, sphere.Radius, context.RenderContext.View) * context.ViewScreenSizeSq >= context.MinObjectPixelSizeSq)
             {
                 Matrix world;
@@ -479,6 +528,7 @@ void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, Me
     };
     if (context.RenderContext.View.Pass != DrawPass::Depth)
         context.MinObjectPixelSizeSq = 0.0f; // Don't use it in main view
+    FrustumCulling::GetPlanes(&renderContext.View.CullingFrustum, 1, context.CullingPlanes);
 #if FOLIAGE_USE_DRAW_CALLS_BATCHING
     // Initialize draw calls for foliage type all LODs meshes
     for (int32 lod = 0; lod < type.Model->LODs.Count(); lod++)
@@ -1299,7 +1349,7 @@ void Foliage::Draw(RenderContextBatch& renderContextBatch)
         _renderContextBatch = &renderContextBatch;
         Function<void(int32)> func;
         func.Bind<Foliage, &Foliage::DrawFoliageJob>(this);
-        const int64 waitLabel = JobSystem::Dispatch(func, FoliageTypes.Count());
+        const int64 waitLabel = JobSystem::Dispatch(func, FoliageTypes.Count(), JobPriority::FrameCritical);
         renderContextBatch.WaitLabels.Add(waitLabel);
         return;
     }
@@ -6,6 +6,7 @@
 #include "FoliageInstance.h"
 #include "FoliageCluster.h"
 #include "FoliageType.h"
+#include "Engine/Core/Math/Vector4.h"
 #include "Engine/Core/Memory/ArenaAllocation.h"
 #include "Engine/Level/Actor.h"
 
@@ -166,6 +167,7 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
         Vector3 ViewOrigin;
         float MinObjectPixelSizeSq;
         float ViewScreenSizeSq;
+        Float4 CullingPlanes[6];
     };
 #if !FOLIAGE_USE_SINGLE_QUAD_TREE && FOLIAGE_USE_DRAW_CALLS_BATCHING
     struct DrawKey
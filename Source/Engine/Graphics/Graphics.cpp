@@ -33,6 +33,9 @@ bool Graphics::SpreadWorkload = true;
 float Graphics::TestValue = 0.0f;
 #endif
 float Graphics::Shadows::MinObjectPixelSize = 2.0f;
+bool Graphics::OcclusionCulling::Enabled = false;
+int32 Graphics::OcclusionCulling::MaxOccluders = 32;
+float Graphics::OcclusionCulling::MinOccluderScreenSize = 0.2f;
 bool Graphics::PostProcessing::ColorGradingVolumeLUT = true;
 
 #if GRAPHICS_API_NULL
@@ -110,6 +110,21 @@ API_CLASS(Static, Attributes="DebugCommand") class FLAXENGINE_API Graphics
         API_FIELD() static float MinObjectPixelSize;
     };
 
+    // CPU occlusion culling configuration.
+    API_CLASS(Static, Attributes="DebugCommand") class FLAXENGINE_API OcclusionCulling
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(OcclusionCulling);
+
+        // Enables the CPU software occlusion culling of the scene objects. The biggest occluders on the screen are rasterized into a low-resolution depth buffer which is used to skip drawing of the objects hidden behind them. Models geometry used by occluders is prepared on load so enable it before loading the level.
+        API_FIELD() static bool Enabled;
+
+        // The maximum amount of occluders to rasterize per view.
+        API_FIELD() static int32 MaxOccluders;
+
+        // The minimum screen size of the object (bounds diameter relative to the screen size) to be automatically picked as occluder.
+        API_FIELD() static float MinOccluderScreenSize;
+    };
+
     // Post Processing effects rendering configuration.
     API_CLASS(Static, Attributes="DebugCommand") class FLAXENGINE_API PostProcessing
     {
@@ -26,6 +26,9 @@
 // [Deprecated in v1.10] Use MODEL_USE_PRECISE_MESH_INTERSECTS
 #define USE_PRECISE_MESH_INTERSECTS MODEL_USE_PRECISE_MESH_INTERSECTS
 
+// Maximum amount of triangles of the lowest model LOD mesh to cache its geometry on a CPU for the occlusion culling (0 to disable)
+#define MODEL_OCCLUDER_MAX_TRIANGLES 1024
+
 // Defines the maximum amount of bones affecting every vertex of the skinned mesh
 #define MODEL_MAX_BONES_PER_VERTEX 4
 // [Deprecated in v1.10] Use MODEL_MAX_BONES_PER_VERTEX
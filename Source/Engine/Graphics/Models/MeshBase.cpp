@@ -2,12 +2,14 @@
 
 #include "MeshBase.h"
 #include "MeshAccessor.h"
+#include "SkinnedMesh.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Content/Assets/ModelBase.h"
 #include "Engine/Core/Math/Transform.h"
 #include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Graphics/Shaders/GPUVertexLayout.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -456,6 +458,32 @@ void MeshBase::SetBounds(const BoundingBox& box, const BoundingSphere& sphere)
     }
 }
 
+#if MODEL_OCCLUDER_MAX_TRIANGLES
+
+bool MeshBase::CanBeOccluder(uint32 triangles) const
+{
+    // Skinned meshes deform so their bind pose cannot occlude anything
+    return _lodIndex == _model->GetLODsCount() - 1 && triangles <= MODEL_OCCLUDER_MAX_TRIANGLES && !Is<SkinnedMesh>();
+}
+
+const CollisionProxy* MeshBase::GetOccluderProxy() const
+{
+#if MODEL_USE_PRECISE_MESH_INTERSECTS
+    // Reuse the collision proxy (cached for all meshes in Editor)
+    if (!CanBeOccluder(_triangles))
+        return nullptr;
+    const CollisionProxy& proxy = _collisionProxy;
+#else
+    // Use the geometry built on load (skip mesh until it's ready)
+    if (Platform::AtomicRead(&_occluderProxyReady) == 0)
+        return nullptr;
+    const CollisionProxy& proxy = _occluderProxy;
+#endif
+    return proxy.HasData() ? &proxy : nullptr;
+}
+
+#endif
+
 GPUVertexLayout* MeshBase::GetVertexLayout() const
 {
     return GPUVertexLayout::Get(Span<GPUBuffer*>(_vertexBuffers, MODEL_MAX_VB));
@@ -513,6 +541,19 @@ bool MeshBase::Init(uint32 vertices, uint32 triangles, const Array<const void*,
         _collisionProxy.Init<uint16>(vertices, triangles, (const Float3*)vbData[0], (const uint16*)ibData, vertexBuffer0->GetStride(), positionsElement.Format);
     else
         _collisionProxy.Init<uint32>(vertices, triangles, (const Float3*)vbData[0], (const uint32*)ibData, vertexBuffer0->GetStride(), positionsElement.Format);
+#elif MODEL_OCCLUDER_MAX_TRIANGLES
+    // Build the occluder geometry on load as it cannot be read back from GPU during rendering (skipped when occlusion culling is not used to save memory)
+    Platform::AtomicStore(&_occluderProxyReady, 0);
+    _occluderProxy.Clear();
+    if (Graphics::OcclusionCulling::Enabled && CanBeOccluder(triangles))
+    {
+        const VertexElement positionsElement = vbLayout[0]->FindElement(VertexElement::Types::Position);
+        if (use16BitIndexBuffer)
+            _occluderProxy.Init<uint16>(vertices, triangles, (const Float3*)vbData[0], (const uint16*)ibData, vertexBuffer0->GetStride(), positionsElement.Format);
+        else
+            _occluderProxy.Init<uint32>(vertices, triangles, (const Float3*)vbData[0], (const uint32*)ibData, vertexBuffer0->GetStride(), positionsElement.Format);
+        Platform::AtomicStore(&_occluderProxyReady, 1);
+    }
 #endif
 
     // Free old buffers
@@ -554,6 +595,9 @@ void MeshBase::Release()
     SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
 #if MODEL_USE_PRECISE_MESH_INTERSECTS
     _collisionProxy.Clear();
+#elif MODEL_OCCLUDER_MAX_TRIANGLES
+    Platform::AtomicStore(&_occluderProxyReady, 0);
+    _occluderProxy.Clear();
 #endif
     _triangles = 0;
     _vertices = 0;
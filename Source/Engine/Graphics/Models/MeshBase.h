@@ -10,7 +10,7 @@
 #include "Engine/Level/Types.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Config.h"
-#if MODEL_USE_PRECISE_MESH_INTERSECTS
+#if MODEL_USE_PRECISE_MESH_INTERSECTS || MODEL_OCCLUDER_MAX_TRIANGLES
 #include "CollisionProxy.h"
 #endif
 
@@ -56,6 +56,9 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
 
 #if MODEL_USE_PRECISE_MESH_INTERSECTS
     CollisionProxy _collisionProxy;
+#elif MODEL_OCCLUDER_MAX_TRIANGLES
+    CollisionProxy _occluderProxy;
+    volatile int64 _occluderProxyReady = 0;
 #endif
 
     void Link(ModelBase* model, int32 lodIndex, int32 index)
@@ -147,6 +150,15 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
     }
 #endif
 
+#if MODEL_OCCLUDER_MAX_TRIANGLES
+    /// <summary>
+    /// Gets the mesh geometry used as occluder by the CPU occlusion culling. Available only for the lowest LOD static meshes with low triangles count.
+    /// </summary>
+    /// <remarks>In game builds, the geometry is prepared when the mesh gets loaded but only if the occlusion culling is enabled.</remarks>
+    /// <returns>The occluder geometry or null if mesh cannot be used as occluder.</returns>
+    const CollisionProxy* GetOccluderProxy() const;
+#endif
+
     /// <summary>
     /// Determines whether this mesh is initialized (has vertex and index buffers initialized).
     /// </summary>
@@ -448,6 +460,10 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
     void Render(GPUContext* context) const;
 
 private:
+#if MODEL_OCCLUDER_MAX_TRIANGLES
+    bool CanBeOccluder(uint32 triangles) const;
+#endif
+
     // Internal bindings
     API_FUNCTION(NoProxy) ScriptingObject* GetParentModel() const;
 #if !COMPILE_WITHOUT_CSHARP
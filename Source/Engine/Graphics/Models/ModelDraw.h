@@ -39,6 +39,7 @@ FORCE_INLINE void ModelDraw(ModelType* model, const RenderContext& renderContext
     if (info.ForcedLOD != -1)
     {
         lodIndex = info.ForcedLOD;
+        RenderTools::ReportModelLOD(model, lodIndex + info.LODBias + renderContext.View.ModelLODBias);
     }
     else
     {
@@ -440,6 +440,7 @@ int32 RenderTools::ComputeModelLOD(const Model* model, const Float3& origin, flo
 {
     const auto lodView = (renderContext.LodProxyView ? renderContext.LodProxyView : &renderContext.View);
     const float screenRadiusSquared = ComputeBoundsScreenRadiusSquared(origin, radius, *lodView) * renderContext.View.ModelLODDistanceFactorSqrt;
+    model->ReportScreenSize(screenRadiusSquared);
 
     // Check if model is being culled
     if (Math::Square(model->MinScreenSize * 0.5f) > screenRadiusSquared)
@@ -465,6 +466,7 @@ int32 RenderTools::ComputeModelLOD(const SkinnedModel* model, const Float3& orig
 {
     const auto lodView = (renderContext.LodProxyView ? renderContext.LodProxyView : &renderContext.View);
     const float screenRadiusSquared = ComputeBoundsScreenRadiusSquared(origin, radius, *lodView) * renderContext.View.ModelLODDistanceFactorSqrt;
+    model->ReportScreenSize(screenRadiusSquared);
 
     // Check if model is being culled
     if (Math::Square(model->MinScreenSize * 0.5f) > screenRadiusSquared)
@@ -486,6 +488,26 @@ int32 RenderTools::ComputeModelLOD(const SkinnedModel* model, const Float3& orig
     return 0;
 }
 
+template<typename ModelType>
+FORCE_INLINE void ReportModelLODScreenSize(const ModelType* model, int32 lodIndex)
+{
+    // Report the screen size that selects this LOD (the same way as ComputeModelLOD picks it)
+    if (model->LODs.Count() == 0)
+        return;
+    lodIndex = Math::Clamp(lodIndex, 0, model->LODs.Count() - 1);
+    model->ReportScreenSize(Math::Max(Math::Square(model->LODs[lodIndex].ScreenSize * 0.5f), ZeroTolerance));
+}
+
+void RenderTools::ReportModelLOD(const Model* model, int32 lodIndex)
+{
+    ReportModelLODScreenSize(model, lodIndex);
+}
+
+void RenderTools::ReportModelLOD(const SkinnedModel* model, int32 lodIndex)
+{
+    ReportModelLODScreenSize(model, lodIndex);
+}
+
 int32 RenderTools::ComputeSkinnedModelLOD(const SkinnedModel* model, const Float3& origin, float radius, const RenderContext& renderContext)
 {
     return ComputeModelLOD(model, origin, radius, renderContext);
@@ -119,6 +119,20 @@ API_CLASS(Static) class FLAXENGINE_API RenderTools
     /// <returns>The zero-based LOD index. Returns -1 if model should not be rendered.</returns>
     API_FUNCTION() static int32 ComputeModelLOD(const SkinnedModel* model, API_PARAM(Ref) const Float3& origin, float radius, API_PARAM(Ref) const RenderContext& renderContext);
 
+    /// <summary>
+    /// Reports the usage of the model LOD picked without ComputeModelLOD (eg. forced LOD) so the streaming keeps that LOD loaded.
+    /// </summary>
+    /// <param name="model">The model.</param>
+    /// <param name="lodIndex">The zero-based LOD index (before clamping to the resident LODs).</param>
+    static void ReportModelLOD(const Model* model, int32 lodIndex);
+
+    /// <summary>
+    /// Reports the usage of the model LOD picked without ComputeModelLOD (eg. forced LOD) so the streaming keeps that LOD loaded.
+    /// </summary>
+    /// <param name="model">The model.</param>
+    /// <param name="lodIndex">The zero-based LOD index (before clamping to the resident LODs).</param>
+    static void ReportModelLOD(const SkinnedModel* model, int32 lodIndex);
+
     /// <summary>
     /// Computes the skinned model LOD index to use during rendering.
     /// [Deprecated in v1.12]
@@ -171,6 +171,21 @@ int32 StreamingTexture::GetAllocatedResidency() const
     return _texture->MipLevels();
 }
 
+uint64 StreamingTexture::GetResidencyMemoryUsage(int32 residency) const
+{
+    residency = Math::Min(residency, (int32)_header.MipLevels);
+    if (residency <= 0)
+        return 0;
+    const uint64 arraySize = _header.IsCubeMap ? 6 : 1;
+    PixelFormat format = _header.Format;
+    if (_texture && _texture->IsAllocated())
+        format = _texture->Format();
+    const int32 mipIndex = _header.MipLevels - residency;
+    const int32 width = Math::Max(_header.Width >> mipIndex, 1);
+    const int32 height = Math::Max(_header.Height >> mipIndex, 1);
+    return RenderTools::CalculateTextureMemoryUsage(format, width, height, residency) * arraySize;
+}
+
 bool StreamingTexture::CanBeUpdated() const
 {
     // Streaming Texture cannot be updated if:
@@ -841,8 +841,16 @@ bool TextureBase::init(AssetInitData& initData)
         LOG(Error, "Missing texture header.");
         return true;
     }
+    if (_texture.Create(textureHeader))
+        return true;
 
-    return _texture.Create(textureHeader);
+    // Mips data is accessed only under the data lock so it can use the memory-mapped file
+    for (int32 mipIndex = 0; mipIndex < _texture.TotalMipLevels(); mipIndex++)
+    {
+        if (FlaxChunk* chunk = _parent->GetChunk(CalculateChunkIndex(mipIndex)))
+            chunk->AllowMappedData = true;
+    }
+    return false;
 }
 
 Asset::LoadResult TextureBase::load()
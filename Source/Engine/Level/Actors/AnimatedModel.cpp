@@ -16,6 +16,7 @@
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPUPass.h"
 #include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/Models/MeshAccessor.h"
 #include "Engine/Graphics/Models/MeshDeformation.h"
 #include "Engine/Renderer/RenderList.h"
@@ -24,6 +25,12 @@
 #include "Engine/Profiler/Profiler.h"
 #include "Engine/Serialization/Serialization.h"
 
+namespace
+{
+    // The minimum model screen sizes for the animation LODs (models large on the screen use the higher quality than the distance-based LOD)
+    constexpr float AnimationLODScreenSizes[] = { 0.5f, 0.25f, 0.1f };
+}
+
 // Implements efficient skinning data update within a shared GPUMemoryPass with manual resource transitions batched for all animated models.
 class AnimatedModelRenderListExtension : public RenderList::IExtension
 {
@@ -97,12 +104,20 @@ AnimatedModel::AnimatedModel(const SpawnParams& params)
     , _actualMode(AnimationUpdateMode::Never)
     , _counter(0)
     , _lastMinDstSqr(MAX_Real)
+    , _lastMaxScreenRadiusSqr(0.0f)
+    , _updateTime(0.0f)
+    , _updateCost(0.0f)
+    , _animationLOD(0)
+    , _updateRate(1)
+    , _updateDelay(0)
+    , _interpolationFrame(0)
     , _lastUpdateFrame(0)
     , SkinnedModel(this)
     , AnimationGraph(this)
 {
     _drawCategory = SceneRendering::SceneDrawAsync;
     GraphInstance.Object = this;
+    _counter = _id.C; // Stagger updates of the animated models that are not updated every frame
     _box = BoundingBox(Vector3::Zero);
     _sphere = BoundingSphere(Vector3::Zero, 0.0f);
 }
@@ -137,6 +152,25 @@ void AnimatedModel::UpdateAnimation()
     }
 }
 
+void AnimatedModel::InterpolateAnimation()
+{
+    // Skip if need to (pose interpolation requires the animation to be updated before)
+    if (!IsActiveInHierarchy()
+        || SkinnedModel == nullptr
+        || !SkinnedModel->IsLoaded()
+        || _lastUpdateFrame == Engine::UpdateCount
+        || _interpolationFrame == 0
+        || _masterPose)
+        return;
+    _lastUpdateFrame = Engine::UpdateCount;
+
+    if (AnimationGraph && AnimationGraph->IsLoaded() && AnimationGraph->Graph.IsReady())
+    {
+        // Request a pose interpolation
+        Animations::AddToInterpolation(this);
+    }
+}
+
 void AnimatedModel::SetupSkinningData()
 {
     ASSERT(SkinnedModel && SkinnedModel->IsLoaded());
@@ -1025,44 +1059,76 @@ bool AnimatedModel::HasContentLoaded() const
     return (SkinnedModel == nullptr || SkinnedModel->IsLoaded()) && Entries.HasContentLoaded();
 }
 
+int32 AnimatedModel::CalculateAnimationLOD(Real minDistanceSqr, float maxScreenRadiusSqr)
+{
+    int32 lod;
+    if (minDistanceSqr < 3000.0f * 3000.0f)
+        lod = 0;
+    else if (minDistanceSqr < 6000.0f * 6000.0f)
+        lod = 1;
+    else if (minDistanceSqr < 10000.0f * 10000.0f)
+        lod = 2;
+    else
+        lod = 3;
+    while (lod > 0 && maxScreenRadiusSqr >= Math::Square(AnimationLODScreenSizes[lod - 1] * 0.5f))
+        lod--;
+    return lod;
+}
+
 void AnimatedModel::Update()
 {
     // Update the mode
     _actualMode = UpdateMode;
+    _animationLOD = 0;
     if (_actualMode == AnimationUpdateMode::Auto)
     {
         // TODO: handle low performance platforms
-
-        if (_lastMinDstSqr < 3000.0f * 3000.0f)
-            _actualMode = AnimationUpdateMode::EveryUpdate;
-        else if (_lastMinDstSqr < 6000.0f * 6000.0f)
-            _actualMode = AnimationUpdateMode::EverySecondUpdate;
-        else if (_lastMinDstSqr < 10000.0f * 10000.0f)
-            _actualMode = AnimationUpdateMode::EveryFourthUpdate;
-        else
-            _actualMode = AnimationUpdateMode::Manual;
+        _animationLOD = (int8)CalculateAnimationLOD(_lastMinDstSqr, _lastMaxScreenRadiusSqr);
+        _actualMode = (AnimationUpdateMode)((int32)AnimationUpdateMode::EveryUpdate + _animationLOD);
     }
 
+    // Reduce the animation quality at far LODs
+    const bool farLOD = _animationLOD >= 2;
+    GraphInstance.MaxNodesDepth = farLOD ? Animations::LODMaxNodesDepth : MAX_int32;
+    GraphInstance.EnableIK = !farLOD;
+    GraphInstance.EnableEvents = !farLOD;
+
     // Check if update during this tick
     bool updateAnim = false;
     switch (_actualMode)
     {
     case AnimationUpdateMode::EveryFourthUpdate:
+        _updateRate = 4;
         updateAnim = _counter++ % 4 == 0;
         break;
     case AnimationUpdateMode::EverySecondUpdate:
+        _updateRate = 2;
         updateAnim = _counter++ % 2 == 0;
         break;
     case AnimationUpdateMode::EveryUpdate:
+        _updateRate = 1;
         updateAnim = true;
         break;
     default:
+        _updateRate = 1;
         break;
     }
-    if (updateAnim && (UpdateWhenOffscreen || _lastMinDstSqr < MAX_Real))
-        UpdateAnimation();
+    GraphInstance.EnablePoseInterpolation = InterpolateUpdates && _updateRate > 1;
+    if (_updateDelay != 0)
+    {
+        // Update postponed by the animations update budget
+        updateAnim = true;
+    }
+    if (UpdateWhenOffscreen || _lastMinDstSqr < MAX_Real)
+    {
+        if (updateAnim)
+            UpdateAnimation();
+        else if (GraphInstance.EnablePoseInterpolation && _interpolationFrame < _updateRate)
+            InterpolateAnimation();
+    }
 
     _lastMinDstSqr = MAX_Real;
+    _lastMaxScreenRadiusSqr = 0.0f;
 }
 
 void AnimatedModel::Draw(RenderContext& renderContext)
@@ -1077,6 +1143,7 @@ void AnimatedModel::Draw(RenderContext& renderContext)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.WorldPosition));
+    _lastMaxScreenRadiusSqr = Math::Max(_lastMaxScreenRadiusSqr, RenderTools::ComputeBoundsScreenRadiusSquared(_sphere.Center - renderContext.View.Origin, (float)_sphere.Radius, renderContext.View));
     if (_skinningData.IsReady())
     {
         // Flush skinning data with GPU
@@ -1120,6 +1187,7 @@ void AnimatedModel::Draw(RenderContextBatch& renderContextBatch)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.WorldPosition));
+    _lastMaxScreenRadiusSqr = Math::Max(_lastMaxScreenRadiusSqr, RenderTools::ComputeBoundsScreenRadiusSquared(_sphere.Center - renderContext.View.Origin, (float)_sphere.Radius, renderContext.View));
     if (_skinningData.IsReady())
     {
         // Flush skinning data with GPU
@@ -1252,6 +1320,7 @@ void AnimatedModel::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(UpdateWhenOffscreen);
     SERIALIZE(UpdateSpeed);
     SERIALIZE(UpdateMode);
+    SERIALIZE(InterpolateUpdates);
     SERIALIZE(BoundsScale);
     SERIALIZE(CustomBounds);
     SERIALIZE(LODBias);
@@ -1277,6 +1346,7 @@ void AnimatedModel::Deserialize(DeserializeStream& stream, ISerializeModifier* m
     DESERIALIZE(UpdateWhenOffscreen);
     DESERIALIZE(UpdateSpeed);
     DESERIALIZE(UpdateMode);
+    DESERIALIZE(InterpolateUpdates);
     DESERIALIZE(BoundsScale);
     DESERIALIZE(CustomBounds);
     DESERIALIZE(LODBias);
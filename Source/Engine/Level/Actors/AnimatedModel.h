@@ -85,6 +85,13 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor, IAssetReference
     AnimationUpdateMode _actualMode;
     uint32 _counter;
     Real _lastMinDstSqr;
+    float _lastMaxScreenRadiusSqr;
+    float _updateTime;
+    float _updateCost;
+    int8 _animationLOD;
+    uint8 _updateRate;
+    uint8 _updateDelay;
+    uint8 _interpolationFrame;
     bool _isDuringUpdateEvent = false;
     uint64 _lastUpdateFrame;
     mutable MeshDeformation* _deformation = nullptr;
@@ -137,6 +144,12 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor, IAssetReference
     API_FIELD(Attributes="EditorOrder(50), DefaultValue(AnimationUpdateMode.Auto), EditorDisplay(\"Updating\")")
     AnimationUpdateMode UpdateMode = AnimationUpdateMode::Auto;
 
+    /// <summary>
+    /// If true, the skeleton pose will be interpolated between the animation updates when animation is not updated every game update (eg. when model is far from the camera). Smooths the motion at the cost of the single update latency.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(55), DefaultValue(true), EditorDisplay(\"Updating\")")
+    bool InterpolateUpdates = true;
+
     /// <summary>
     /// The master scale parameter for the actor bounding box. Helps to reduce mesh flickering effect on screen edges.
     /// </summary>
@@ -209,6 +222,22 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor, IAssetReference
     /// </summary>
     API_FUNCTION() void UpdateAnimation();
 
+    /// <summary>
+    /// Gets the current animation LOD (0 is the highest quality). Computed from the distance to the camera and the model screen size when using the automatic update mode. Far LODs update animation less frequently, skip IK and animation events and reduce the animated bones count.
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE int32 GetAnimationLOD() const
+    {
+        return _animationLOD;
+    }
+
+    /// <summary>
+    /// Calculates the animation LOD used by the automatic update mode.
+    /// </summary>
+    /// <param name="minDistanceSqr">The squared distance to the closest view that rendered the model.</param>
+    /// <param name="maxScreenRadiusSqr">The squared largest screen radius of the model bounds (in screen height units).</param>
+    /// <returns>The animation LOD (0 is the highest quality, 3 is not updated).</returns>
+    static int32 CalculateAnimationLOD(Real minDistanceSqr, float maxScreenRadiusSqr);
+
     /// <summary>
     /// Called after animation gets updated (new skeleton pose).
     /// </summary>
@@ -455,6 +484,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor, IAssetReference
     void RunBlendShapeDeformer(const MeshBase* mesh, struct MeshDeformationData& deformation);
 
     void Update();
+    void InterpolateAnimation();
     void UpdateSockets();
     void OnAnimationUpdated_Async();
     void OnAnimationUpdated_Sync();
@@ -431,6 +431,7 @@ void SplineModel::Draw(RenderContext& renderContext)
         if (_forcedLod != -1)
         {
             lodIndex = _forcedLod;
+            RenderTools::ReportModelLOD(model, lodIndex + _lodBias + renderContext.View.ModelLODBias);
         }
         else
         {
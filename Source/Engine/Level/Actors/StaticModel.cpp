@@ -110,6 +110,27 @@ void StaticModel::SetSortOrder(int32 value)
     _sortOrder = (int8)Math::Clamp<int32>(value, MIN_int8, MAX_int8);
 }
 
+OccluderMode StaticModel::GetOccluderMode() const
+{
+    return _occluderMode;
+}
+
+void StaticModel::SetOccluderMode(OccluderMode value)
+{
+    if (_occluderMode == value)
+        return;
+    const bool wasOccluder = _occluderMode != OccluderMode::None;
+    _occluderMode = value;
+    const bool isOccluder = _occluderMode != OccluderMode::None;
+    if (wasOccluder != isOccluder && _scene && IsDuringPlay() && _isActiveInHierarchy && _isEnabled)
+    {
+        if (isOccluder)
+            GetSceneRendering()->AddOccluder(this, _occluderKey);
+        else
+            GetSceneRendering()->RemoveOccluder(this, _occluderKey);
+    }
+}
+
 bool StaticModel::HasLightmap() const
 {
     return Lightmap.TextureIndex != INVALID_INDEX;
@@ -450,6 +471,7 @@ void StaticModel::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(ForcedLOD, _forcedLod);
     SERIALIZE_MEMBER(SortOrder, _sortOrder);
     SERIALIZE_MEMBER(DrawModes, _drawModes);
+    SERIALIZE_MEMBER(OccluderMode, _occluderMode);
 
     if (HasLightmap()
 #if USE_EDITOR
@@ -501,6 +523,7 @@ void StaticModel::Deserialize(DeserializeStream& stream, ISerializeModifier* mod
     DESERIALIZE_MEMBER(ForcedLOD, _forcedLod);
     DESERIALIZE_MEMBER(SortOrder, _sortOrder);
     DESERIALIZE_MEMBER(DrawModes, _drawModes);
+    DESERIALIZE_MEMBER(OccluderMode, _occluderMode);
     DESERIALIZE_MEMBER(LightmapIndex, Lightmap.TextureIndex);
     DESERIALIZE_MEMBER(LightmapArea, Lightmap.UVsArea);
     DESERIALIZE_MEMBER(Buffer, Entries);
@@ -685,6 +708,37 @@ MeshDeformation* StaticModel::GetMeshDeformation() const
     return _deformation;
 }
 
+bool StaticModel::GetOccluderBounds(BoundingSphere& bounds, bool& forced) const
+{
+#if MODEL_OCCLUDER_MAX_TRIANGLES
+    if (_occluderMode == OccluderMode::None || (_occluderMode == OccluderMode::Auto && !HasStaticFlag(StaticFlags::Transform)))
+        return false;
+    if (!Model || !Model->IsLoaded() || Model->GetLoadedLODs() == 0 || _deformation)
+        return false;
+    bounds = _sphere;
+    forced = _occluderMode == OccluderMode::Always;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void StaticModel::DrawOccluder(OcclusionBuffer& buffer) const
+{
+#if MODEL_OCCLUDER_MAX_TRIANGLES
+    // Use the lowest LOD geometry (always resident when model has any LOD loaded)
+    Transform transform = _transform;
+    transform.Translation -= buffer.GetOrigin();
+    Matrix world;
+    transform.GetWorld(world);
+    for (const Mesh& mesh : Model->LODs.Last().Meshes)
+    {
+        if (const CollisionProxy* proxy = mesh.GetOccluderProxy())
+            buffer.AddOccluder(*proxy, world);
+    }
+#endif
+}
+
 void StaticModel::OnEnable()
 {
     // If model is set and loaded but we still don't have residency registered do it here (eg. model is streaming LODs right now)
@@ -702,6 +756,9 @@ void StaticModel::OnEnable()
         }
     }
 
+    if (_scene && _occluderMode != OccluderMode::None)
+        GetSceneRendering()->AddOccluder(this, _occluderKey);
+
     // Skip ModelInstanceActor (add to SceneRendering manually)
     Actor::OnEnable();
 }
@@ -715,6 +772,8 @@ void StaticModel::OnDisable()
     {
         GetSceneRendering()->RemoveActor(this, _sceneRenderingKey);
     }
+    if (_occluderKey != -1)
+        GetSceneRendering()->RemoveOccluder(this, _occluderKey);
     if (_residencyChangedModel)
     {
         _residencyChangedModel->ResidencyChanged.Unbind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
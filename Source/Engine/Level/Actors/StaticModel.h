@@ -6,12 +6,13 @@
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/Lightmaps.h"
+#include "Engine/Renderer/OcclusionCulling.h"
 
 /// <summary>
 /// Renders model on the screen.
 /// </summary>
 API_CLASS(Attributes="ActorContextMenu(\"New/Model\"), ActorToolbox(\"Visuals\")")
-class FLAXENGINE_API StaticModel : public ModelInstanceActor, IAssetReference
+class FLAXENGINE_API StaticModel : public ModelInstanceActor, IAssetReference, IOccluder
 {
     DECLARE_SCENE_OBJECT(StaticModel);
 private:
@@ -24,6 +25,8 @@ class FLAXENGINE_API StaticModel : public ModelInstanceActor, IAssetReference
     byte _vertexColorsCount;
     int8 _sortOrder;
     DrawPass _drawModes = DrawPass::Default;
+    OccluderMode _occluderMode = OccluderMode::None;
+    int32 _occluderKey = -1;
     Array<Color32> _vertexColorsData[MODEL_MAX_LODS];
     GPUBuffer* _vertexColorsBuffer[MODEL_MAX_LODS];
     Model* _residencyChangedModel = nullptr;
@@ -113,6 +116,17 @@ class FLAXENGINE_API StaticModel : public ModelInstanceActor, IAssetReference
     /// </summary>
     API_PROPERTY() void SetSortOrder(int32 value);
 
+    /// <summary>
+    /// Gets the model usage mode for the CPU occlusion culling. Only the lowest LOD meshes with low triangles count can occlude other objects.
+    /// </summary>
+    API_PROPERTY(Attributes="EditorOrder(70), DefaultValue(OccluderMode.None), EditorDisplay(\"Model\")")
+    OccluderMode GetOccluderMode() const;
+
+    /// <summary>
+    /// Sets the model usage mode for the CPU occlusion culling. Only the lowest LOD meshes with low triangles count can occlude other objects.
+    /// </summary>
+    API_PROPERTY() void SetOccluderMode(OccluderMode value);
+
     /// <summary>
     /// Determines whether this model has valid lightmap data.
     /// </summary>
@@ -188,6 +202,10 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS;
     MeshDeformation* GetMeshDeformation() const override;
     void UpdateBounds() override;
 
+    // [IOccluder]
+    bool GetOccluderBounds(BoundingSphere& bounds, bool& forced) const override;
+    void DrawOccluder(OcclusionBuffer& buffer) const override;
+
 protected:
     // [ModelInstanceActor]
     void OnEnable() override;
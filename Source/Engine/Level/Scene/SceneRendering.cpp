@@ -2,14 +2,21 @@
 
 #define SCENE_RENDERING_USE_PROFILER_PER_ACTOR 0
 
+// The minimum amount of actors in the draw category to use the culling tree instead of the linear scan
+#define SCENE_RENDERING_TREE_MIN_ACTORS 1024
+
 #include "SceneRendering.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderView.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/OcclusionCulling.h"
+#include "Engine/Core/Utilities.h"
 #include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/Threading.h"
 #include "Engine/Physics/Actors/IPhysicsDebug.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
+#include "Engine/Profiler/RenderStats.h"
 #if !BUILD_RELEASE
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Core/Log.h"
@@ -43,16 +50,15 @@ void ISceneRenderingListener::ListenSceneRendering(SceneRendering* scene)
     }
 }
 
-FORCE_INLINE bool FrustumsListCull(const BoundingSphere& bounds, const Array<BoundingFrustum>& frustums)
+// Checks if the actor is hidden behind the occluders in the main view and it's not visible in other views of the batch (eg. shadow projections)
+FORCE_INLINE bool IsOccluded(const OcclusionBuffer* occlusion, const BoundingSphere& bounds, const BoundingFrustum* frustums, int32 frustumsCount)
 {
-    const int32 count = frustums.Count();
-    const BoundingFrustum* data = frustums.Get();
-    for (int32 i = 0; i < count; i++)
+    for (int32 i = 1; i < frustumsCount; i++)
     {
-        if (data[i].Intersects(bounds))
-            return true;
+        if (frustums[i].Intersects(bounds))
+            return false;
     }
-    return false;
+    return occlusion->IsOccluded(bounds);
 }
 
 void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory category)
@@ -78,13 +84,29 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     auto& list = Actors[(int32)category];
     _drawListData = list.Get();
     _drawListSize = list.Count();
+    _drawListBounds = &ActorsBounds[(int32)category];
     _drawBatch = &renderContextBatch;
+    const OcclusionBuffer& occlusion = renderContextBatch.GetMainContext().List->Occlusion;
+    _drawOcclusion = occlusion.IsValid() && (category == SceneDraw || category == SceneDrawAsync) ? &occlusion : nullptr;
 
     // Setup frustum data
     const int32 frustumsCount = renderContextBatch.Contexts.Count();
     _drawFrustumsData.Resize(frustumsCount);
     for (int32 i = 0; i < frustumsCount; i++)
         _drawFrustumsData.Get()[i] = renderContextBatch.Contexts.Get()[i].View.CullingFrustum;
+    _drawFrustumsPlanes.Resize(frustumsCount * 6);
+    FrustumCulling::GetPlanes(_drawFrustumsData.Get(), frustumsCount, _drawFrustumsPlanes.Get());
+
+    // Cull the top levels of the actors tree to split the visible subtrees into jobs (big scenes only)
+    _drawTree = nullptr;
+    if (_drawListSize >= SCENE_RENDERING_TREE_MIN_ACTORS && frustumsCount <= SceneRenderingBVH::MaxFrustums)
+    {
+        PROFILE_CPU_NAMED("Cull Tree");
+        FlushTree((int32)category);
+        _drawTree = &ActorsTree[(int32)category];
+        _drawNoCulling = &_noCullingActors[(int32)category];
+        _drawTree->CullSubtrees(_drawFrustumsData.Get(), frustumsCount, view.Origin, Math::Max(JobSystem::GetThreadsCount(), 1) * 8, _drawSubtrees);
+    }
 
     // Draw all visual components
     _drawListIndex = -1;
@@ -93,12 +115,20 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     {
         // Run in async via Job System
         Function<void(int32)> func;
-        func.Bind<SceneRendering, &SceneRendering::DrawActorsJob>(this);
-        const int64 waitLabel = JobSystem::Dispatch(func, JobSystem::GetThreadsCount());
+        if (_drawTree)
+            func.Bind<SceneRendering, &SceneRendering::DrawActorsTreeJob>(this);
+        else
+            func.Bind<SceneRendering, &SceneRendering::DrawActorsJob>(this);
+        const int64 waitLabel = JobSystem::Dispatch(func, JobSystem::GetThreadsCount(), JobPriority::FrameCritical);
         renderContextBatch.WaitLabels.Add(waitLabel);
     }
     else
 #endif
+    if (_drawTree)
+    {
+        DrawActorsTreeJob(0);
+    }
+    else
     {
         // Scene is small so draw on a main-thread
         DrawActorsJob(0);
@@ -156,6 +186,18 @@ void SceneRendering::Clear()
         e.Clear();
     for (auto& e : FreeActors)
         e.Clear();
+    for (auto& e : ActorsBounds)
+        e.Clear();
+    Occluders.Clear();
+    FreeOccluders.Clear();
+    _treeLocker.Lock();
+    for (auto& e : ActorsTree)
+        e.Clear();
+    for (auto& e : _treeDirty)
+        e.Clear();
+    for (auto& e : _noCullingActors)
+        e.Clear();
+    _treeLocker.Unlock();
 #if USE_EDITOR
     PhysicsDebug.Clear();
 #endif
@@ -186,6 +228,19 @@ void SceneRendering::AddActor(Actor* a, int32& key)
     e.LayerMask = a->GetLayerMask();
     e.Bounds = a->GetSphere();
     e.NoCulling = a->_drawNoCulling;
+    auto& bounds = ActorsBounds[category];
+    bounds.Resize(list.Count());
+    bounds.Set(key, e.Bounds, e.LayerMask, e.NoCulling);
+    _treeLocker.Lock();
+    e.TreeDirty = false;
+    if (e.NoCulling)
+    {
+        e.TreeLeaf = -1;
+        _noCullingActors[category].Add(key);
+    }
+    else
+        e.TreeLeaf = ActorsTree[category].Add(e.Bounds, key);
+    _treeLocker.Unlock();
     for (auto* listener : _listeners)
         listener->OnSceneRenderingAddActor(a);
 }
@@ -205,9 +260,26 @@ void SceneRendering::UpdateActor(Actor* a, int32& key, ISceneRenderingListener::
             for (auto* listener : _listeners)
                 listener->OnSceneRenderingUpdateActor(a, e.Bounds, flags);
             if (flags & ISceneRenderingListener::Layer)
+            {
                 e.LayerMask = a->GetLayerMask();
+                ActorsBounds[category].SetLayerMask(key, e.LayerMask);
+            }
             if (flags & ISceneRenderingListener::Bounds)
+            {
                 e.Bounds = a->GetSphere();
+                ActorsBounds[category].Set(key, e.Bounds, e.LayerMask, e.NoCulling);
+                if (e.TreeLeaf != -1)
+                {
+                    // Refit culling tree before the next draw
+                    _treeLocker.Lock();
+                    if (!e.TreeDirty)
+                    {
+                        e.TreeDirty = true;
+                        _treeDirty[category].Add(key);
+                    }
+                    _treeLocker.Unlock();
+                }
+            }
         }
     }
     if (lock)
@@ -227,17 +299,75 @@ void SceneRendering::RemoveActor(Actor* a, int32& key)
         {
             for (auto* listener : _listeners)
                 listener->OnSceneRenderingRemoveActor(a);
+            _treeLocker.Lock();
+            if (e.TreeLeaf != -1)
+                ActorsTree[category].Remove(e.TreeLeaf);
+            else
+                _noCullingActors[category].Remove(key);
+            _treeLocker.Unlock();
+            e.TreeLeaf = -1;
             e.Actor = nullptr;
             e.LayerMask = 0;
+            ActorsBounds[category].SetLayerMask(key, 0);
             FreeActors[category].Add(key);
         }
     }
     key = -1;
 }
 
-#define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; auto e = _drawListData[index];
-#define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, _drawFrustumsData)))
-#define CHECK_ACTOR_SINGLE_FRUSTUM ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || view.CullingFrustum.Intersects(e.Bounds)))
+void SceneRendering::AddOccluder(IOccluder* obj, int32& key)
+{
+    if (key != -1)
+        return;
+    PROFILE_MEM(Graphics);
+    ScopeWriteLock lock(Locker);
+    if (FreeOccluders.HasItems())
+    {
+        // Use existing item
+        key = FreeOccluders.Pop();
+        Occluders[key] = obj;
+    }
+    else
+    {
+        // Add a new item
+        key = Occluders.Count();
+        Occluders.Add(obj);
+    }
+}
+
+void SceneRendering::RemoveOccluder(IOccluder* obj, int32& key)
+{
+    ScopeWriteLock lock(Locker);
+    if (key >= 0 && key < Occluders.Count() && Occluders[key] == obj) // Ignore invalid key softly (eg. list after clear during scene unload)
+    {
+        Occluders[key] = nullptr;
+        FreeOccluders.Add(key);
+    }
+    key = -1;
+}
+
+void SceneRendering::FlushTree(int32 category)
+{
+    ScopeLock lock(_treeLocker);
+    auto& dirty = _treeDirty[category];
+    if (dirty.IsEmpty())
+        return;
+    PROFILE_CPU();
+    DrawActor* actors = Actors[category].Get();
+    auto& tree = ActorsTree[category];
+    for (const int32 key : dirty)
+    {
+        auto& e = actors[key];
+        if (e.TreeDirty)
+        {
+            e.TreeDirty = false;
+            if (e.TreeLeaf != -1)
+                tree.Update(e.TreeLeaf, e.Bounds);
+        }
+    }
+    dirty.Clear();
+}
+
 #if SCENE_RENDERING_USE_PROFILER_PER_ACTOR
 #define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(e.Actor); e.Actor->Draw(mode)
 #else
@@ -250,50 +380,122 @@ void SceneRendering::DrawActorsJob(int32)
     PROFILE_MEM(Graphics);
     auto& mainContext = _drawBatch->GetMainContext();
     const auto& view = mainContext.View;
-    if (view.StaticFlagsMask != StaticFlags::None)
+    const Float4* planes = _drawFrustumsPlanes.Get();
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const bool useMainContext = view.StaticFlagsMask == StaticFlags::None && view.Origin.IsZero() && frustumsCount == 1;
+    const OcclusionBuffer* occlusion = _drawOcclusion;
+    int32 occlusionVisible = 0, occlusionCulled = 0;
+
+    // Cull actors in chunks (vectorized test of bounds against all frustums) and draw the visible ones
+    const int64 chunksCount = (_drawListSize + FrustumCulling::ChunkSize - 1) / FrustumCulling::ChunkSize;
+    while (true)
     {
-        // Static-flags culling
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) == view.StaticFlagsCompare)
+        const int64 chunk = Platform::InterlockedIncrement(&_drawListIndex);
+        if (chunk >= chunksCount)
+            break;
+        const int32 start = (int32)chunk * FrustumCulling::ChunkSize;
+        uint64 visible = FrustumCulling::Cull(*_drawListBounds, start, view.Origin, planes, frustumsCount, view.RenderLayersMask.Mask);
+        while (visible != 0)
+        {
+            const int32 index = start + (int32)Utilities::LowestSetBit64(visible);
+            visible &= visible - 1;
+            const DrawActor& e = _drawListData[index];
+            if (view.StaticFlagsMask != StaticFlags::None && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) != view.StaticFlagsCompare)
+                continue;
+            if (occlusion && !e.NoCulling)
             {
-                DRAW_ACTOR(*_drawBatch);
+                BoundingSphere bounds = e.Bounds;
+                bounds.Center -= view.Origin;
+                if (IsOccluded(occlusion, bounds, _drawFrustumsData.Get(), frustumsCount))
+                {
+                    occlusionCulled++;
+                    continue;
+                }
+                occlusionVisible++;
             }
-        }
-    }
-    else if (view.Origin.IsZero() && _drawFrustumsData.Count() == 1)
-    {
-        // Fast path for no origin shifting with a single context
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR_SINGLE_FRUSTUM)
+            if (useMainContext)
             {
                 DRAW_ACTOR(mainContext);
             }
-        }
-    }
-    else if (view.Origin.IsZero())
-    {
-        // Fast path for no origin shifting
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR)
+            else
             {
                 DRAW_ACTOR(*_drawBatch);
             }
         }
     }
-    else
+    if (occlusion)
     {
-        // Generic case
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR)
+        RENDER_STAT_OCCLUSION(occlusionVisible, occlusionCulled);
+    }
+}
+
+void SceneRendering::DrawActorsTreeJob(int32 jobIndex)
+{
+    PROFILE_CPU();
+    PROFILE_MEM(Graphics);
+    auto& mainContext = _drawBatch->GetMainContext();
+    const auto& view = mainContext.View;
+    const BoundingFrustum* frustums = _drawFrustumsData.Get();
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const bool useMainContext = view.StaticFlagsMask == StaticFlags::None && view.Origin.IsZero() && frustumsCount == 1;
+    const OcclusionBuffer* occlusion = _drawOcclusion;
+    int32 occlusionVisible = 0, occlusionCulled = 0;
+    auto drawActor = [&](int32 key, uint64 frustumsMask)
+    {
+        auto e = _drawListData[key];
+        if ((view.RenderLayersMask.Mask & e.LayerMask) == 0)
+            return;
+        e.Bounds.Center -= view.Origin;
+        if (frustumsMask != 0)
+        {
+            // Leaf bounds cross the frustums edges so test the actual actor bounds
+            bool visible = false;
+            for (int32 i = 0; i < frustumsCount && !visible; i++)
+                visible = (frustumsMask & (1ull << i)) != 0 && frustums[i].Intersects(e.Bounds);
+            if (!visible)
+                return;
+        }
+        if (view.StaticFlagsMask != StaticFlags::None && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) != view.StaticFlagsCompare)
+            return;
+        if (occlusion && !e.NoCulling)
+        {
+            if (IsOccluded(occlusion, e.Bounds, frustums, frustumsCount))
             {
-                DRAW_ACTOR(*_drawBatch);
+                occlusionCulled++;
+                return;
             }
+            occlusionVisible++;
+        }
+        if (useMainContext)
+        {
+            DRAW_ACTOR(mainContext);
+        }
+        else
+        {
+            DRAW_ACTOR(*_drawBatch);
         }
+    };
+
+    // Actors without culling are drawn by the first job
+    if (jobIndex == 0)
+    {
+        for (const int32 key : *_drawNoCulling)
+            drawActor(key, 0);
+    }
+
+    // Cull and draw visible subtrees
+    const int64 count = _drawSubtrees.Count();
+    while (true)
+    {
+        const int64 index = Platform::InterlockedIncrement(&_drawListIndex);
+        if (index >= count)
+            break;
+        _drawTree->Cull(_drawSubtrees.Get()[index], frustums, frustumsCount, view.Origin, drawActor);
+    }
+    if (occlusion)
+    {
+        RENDER_STAT_OCCLUSION(occlusionVisible, occlusionCulled);
     }
 }
 
-#undef FOR_EACH_BATCH_ACTOR
-#undef CHECK_ACTOR
 #undef DRAW_ACTOR
@@ -6,11 +6,15 @@
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Math/BoundingSphere.h"
 #include "Engine/Core/Math/BoundingFrustum.h"
+#include "Engine/Core/Math/FrustumCulling.h"
 #include "Engine/Level/Actor.h"
+#include "SceneRenderingBVH.h"
 
 class SceneRenderTask;
 class SceneRendering;
 class IPhysicsDebug;
+class IOccluder;
+class OcclusionBuffer;
 struct PostProcessSettings;
 struct RenderContext;
 struct RenderContextBatch;
@@ -87,6 +91,10 @@ class FLAXENGINE_API SceneRendering
         Actor* Actor;
         uint32 LayerMask;
         int8 NoCulling : 1;
+        // True if the culling tree leaf needs to be refit (accessed only under _treeLocker as actors can be updated from different threads at once).
+        bool TreeDirty;
+        // The leaf of the culling tree (-1 if actor is not in the tree).
+        int32 TreeLeaf;
         BoundingSphere Bounds;
     };
 
@@ -104,7 +112,13 @@ class FLAXENGINE_API SceneRendering
 
     Array<DrawActor> Actors[MAX];
     Array<int32> FreeActors[MAX];
+    SceneRenderingBVH ActorsTree[MAX];
+    // The actors bounds and layer masks (indexed by the actor key) stored as a structure-of-arrays for the vectorized culling.
+    FrustumCulling::Spheres ActorsBounds[MAX];
     Array<IPostFxSettingsProvider*> PostFxProviders;
+    // The objects that can be used as occluders in the CPU occlusion culling (indexed by the occluder key, removed items are null).
+    Array<IOccluder*> Occluders;
+    Array<int32> FreeOccluders;
     ReadWriteLock Locker;
 
 private:
@@ -119,6 +133,11 @@ class FLAXENGINE_API SceneRendering
     friend ISceneRenderingListener;
     Array<ISceneRenderingListener*, InlinedAllocation<8>> _listeners;
 
+    // Culling tree updates are deferred to the drawing as actors can be updated from multiple threads at once
+    CriticalSection _treeLocker;
+    Array<int32> _treeDirty[MAX];
+    Array<int32> _noCullingActors[MAX];
+
 public:
     /// <summary>
     /// Draws the scene. Performs the optimized actors culling and draw calls submission for the current render pass (defined by the render view).
@@ -138,6 +157,14 @@ class FLAXENGINE_API SceneRendering
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Checks if scene is during rendering (actors lists are locked for reading until the end of the drawing).
+    /// </summary>
+    FORCE_INLINE bool IsRendering() const
+    {
+        return _isRendering;
+    }
+
 public:
     void AddActor(Actor* a, int32& key);
     void UpdateActor(Actor* a, int32& key, ISceneRenderingListener::UpdateFlags flags = ISceneRenderingListener::Auto);
@@ -153,6 +180,9 @@ class FLAXENGINE_API SceneRendering
         PostFxProviders.Remove(obj);
     }
 
+    void AddOccluder(IOccluder* obj, int32& key);
+    void RemoveOccluder(IOccluder* obj, int32& key);
+
 #if USE_EDITOR
     FORCE_INLINE void AddPhysicsDebug(IPhysicsDebug* obj)
     {
@@ -193,10 +223,18 @@ class FLAXENGINE_API SceneRendering
 
 private:
     Array<BoundingFrustum> _drawFrustumsData;
+    Array<Float4> _drawFrustumsPlanes;
     DrawActor* _drawListData;
+    const FrustumCulling::Spheres* _drawListBounds;
     int64 _drawListSize;
     volatile int64 _drawListIndex;
     RenderContextBatch* _drawBatch;
+    const OcclusionBuffer* _drawOcclusion;
+    const SceneRenderingBVH* _drawTree;
+    Array<SceneRenderingBVH::CullNode> _drawSubtrees;
+    Array<int32>* _drawNoCulling;
 
+    void FlushTree(int32 category);
     void DrawActorsJob(int32);
+    void DrawActorsTreeJob(int32);
 };
@@ -0,0 +1,370 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "SceneRenderingBVH.h"
+#include "Engine/Core/Math/Math.h"
+
+// The leaf bounds enlargement (relative to the object radius) to skip tree updates on small movement
+#define SCENE_RENDERING_BVH_MARGIN 0.2f
+
+namespace
+{
+    FORCE_INLINE Real GetSurfaceArea(const BoundingBox& box)
+    {
+        const Vector3 size = box.Maximum - box.Minimum;
+        return size.X * size.Y + size.Y * size.Z + size.Z * size.X;
+    }
+
+    FORCE_INLINE BoundingBox GetLeafBounds(const BoundingSphere& sphere)
+    {
+        const Real radius = sphere.Radius * (1.0f + SCENE_RENDERING_BVH_MARGIN) + 1.0f;
+        return BoundingBox(sphere.Center - radius, sphere.Center + radius);
+    }
+}
+
+int32 SceneRenderingBVH::Add(const BoundingSphere& bounds, int32 item)
+{
+    const int32 leaf = AllocateNode();
+    Node& node = _nodes.Get()[leaf];
+    node.Bounds = GetLeafBounds(bounds);
+    node.Height = 0;
+    node.Item = item;
+    InsertLeaf(leaf);
+    _leavesCount++;
+    return leaf;
+}
+
+bool SceneRenderingBVH::Update(int32 leaf, const BoundingSphere& bounds)
+{
+    Node& node = _nodes.Get()[leaf];
+    ASSERT_LOW_LAYER(node.IsLeaf() && node.Height == 0);
+    BoundingBox box;
+    BoundingBox::FromSphere(bounds, box);
+    if (node.Bounds.Contains(box) == ContainmentType::Contains)
+        return false;
+    RemoveLeaf(leaf);
+    _nodes.Get()[leaf].Bounds = GetLeafBounds(bounds);
+    InsertLeaf(leaf);
+    return true;
+}
+
+void SceneRenderingBVH::Remove(int32 leaf)
+{
+    ASSERT_LOW_LAYER(_nodes[leaf].IsLeaf() && _nodes[leaf].Height == 0);
+    RemoveLeaf(leaf);
+    FreeNode(leaf);
+    _leavesCount--;
+}
+
+void SceneRenderingBVH::Clear()
+{
+    _nodes.Clear();
+    _root = -1;
+    _freeList = -1;
+    _leavesCount = 0;
+}
+
+void SceneRenderingBVH::CullSubtrees(const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, int32 minSubtrees, Array<CullNode>& result) const
+{
+    ASSERT_LOW_LAYER(frustumsCount <= MaxFrustums);
+    result.Clear();
+    if (_root == -1)
+        return;
+    const Node* nodes = _nodes.Get();
+    CullNode root = { _root, frustumsCount >= MaxFrustums ? MAX_uint64 : (1ull << frustumsCount) - 1 };
+    if (!CullBounds(nodes[_root].Bounds, frustums, frustumsCount, origin, root.FrustumsMask))
+        return;
+    result.Add(root);
+
+    // Go down the tree level by level (culling nodes on the way) until there are enough subtrees
+    Array<CullNode> level;
+    bool anyNode = !nodes[_root].IsLeaf();
+    while (anyNode && result.Count() < minSubtrees)
+    {
+        anyNode = false;
+        level.Clear();
+        for (const CullNode& e : result)
+        {
+            const Node& node = nodes[e.Node];
+            if (node.IsLeaf())
+            {
+                level.Add(e);
+                continue;
+            }
+            for (const int32 child : node.Children)
+            {
+                CullNode childNode = { child, e.FrustumsMask };
+                if (childNode.FrustumsMask == 0 || CullBounds(nodes[child].Bounds, frustums, frustumsCount, origin, childNode.FrustumsMask))
+                {
+                    level.Add(childNode);
+                    anyNode |= !nodes[child].IsLeaf();
+                }
+            }
+        }
+        result.Swap(level);
+    }
+}
+
+bool SceneRenderingBVH::CullBounds(const BoundingBox& bounds, const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, uint64& frustumsMask)
+{
+    const BoundingBox box(bounds.Minimum - origin, bounds.Maximum - origin);
+    uint64 result = 0;
+    for (int32 i = 0; i < frustumsCount; i++)
+    {
+        const uint64 bit = 1ull << i;
+        if ((frustumsMask & bit) == 0)
+            continue;
+        const ContainmentType containment = frustums[i].Contains(box);
+        if (containment == ContainmentType::Contains)
+        {
+            // Whole subtree is visible
+            frustumsMask = 0;
+            return true;
+        }
+        if (containment == ContainmentType::Intersects)
+            result |= bit;
+    }
+    frustumsMask = result;
+    return result != 0;
+}
+
+int32 SceneRenderingBVH::AllocateNode()
+{
+    int32 index;
+    if (_freeList != -1)
+    {
+        index = _freeList;
+        _freeList = _nodes.Get()[index].Parent;
+    }
+    else
+    {
+        index = _nodes.Count();
+        _nodes.AddUninitialized(1);
+    }
+    Node& node = _nodes.Get()[index];
+    node.Parent = -1;
+    node.Children[0] = -1;
+    node.Children[1] = -1;
+    node.Height = 0;
+    node.Item = -1;
+    return index;
+}
+
+void SceneRenderingBVH::FreeNode(int32 index)
+{
+    Node& node = _nodes.Get()[index];
+    node.Parent = _freeList;
+    node.Height = -1;
+    _freeList = index;
+}
+
+void SceneRenderingBVH::InsertLeaf(int32 leaf)
+{
+    if (_root == -1)
+    {
+        _root = leaf;
+        _nodes.Get()[leaf].Parent = -1;
+        return;
+    }
+
+    // Find the best sibling for the new leaf (using surface area heuristic)
+    const BoundingBox leafBounds = _nodes.Get()[leaf].Bounds;
+    int32 index = _root;
+    while (!_nodes.Get()[index].IsLeaf())
+    {
+        const Node& node = _nodes.Get()[index];
+        BoundingBox combined;
+        BoundingBox::Merge(node.Bounds, leafBounds, combined);
+        const Real combinedArea = GetSurfaceArea(combined);
+
+        // Cost of creating a new parent for this node and the new leaf
+        const Real cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        const Real inheritanceCost = 2.0f * (combinedArea - GetSurfaceArea(node.Bounds));
+        Real childCosts[2];
+        for (int32 i = 0; i < 2; i++)
+        {
+            const Node& child = _nodes.Get()[node.Children[i]];
+            BoundingBox::Merge(child.Bounds, leafBounds, combined);
+            childCosts[i] = GetSurfaceArea(combined) + inheritanceCost;
+            if (!child.IsLeaf())
+                childCosts[i] -= GetSurfaceArea(child.Bounds);
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        index = childCosts[0] < childCosts[1] ? node.Children[0] : node.Children[1];
+    }
+    const int32 sibling = index;
+
+    // Create a new parent
+    const int32 newParent = AllocateNode();
+    Node* nodes = _nodes.Get();
+    const int32 oldParent = nodes[sibling].Parent;
+    nodes[newParent].Parent = oldParent;
+    BoundingBox::Merge(leafBounds, nodes[sibling].Bounds, nodes[newParent].Bounds);
+    nodes[newParent].Height = nodes[sibling].Height + 1;
+    nodes[newParent].Children[0] = sibling;
+    nodes[newParent].Children[1] = leaf;
+    nodes[sibling].Parent = newParent;
+    nodes[leaf].Parent = newParent;
+    if (oldParent != -1)
+        SetChild(oldParent, sibling, newParent);
+    else
+        _root = newParent;
+
+    // Walk back up the tree fixing heights and bounds
+    index = nodes[leaf].Parent;
+    while (index != -1)
+    {
+        index = Balance(index);
+        Node& node = nodes[index];
+        const Node& child0 = nodes[node.Children[0]];
+        const Node& child1 = nodes[node.Children[1]];
+        node.Height = 1 + Math::Max(child0.Height, child1.Height);
+        BoundingBox::Merge(child0.Bounds, child1.Bounds, node.Bounds);
+        index = node.Parent;
+    }
+}
+
+void SceneRenderingBVH::RemoveLeaf(int32 leaf)
+{
+    if (leaf == _root)
+    {
+        _root = -1;
+        return;
+    }
+
+    Node* nodes = _nodes.Get();
+    const int32 parent = nodes[leaf].Parent;
+    const int32 grandParent = nodes[parent].Parent;
+    const int32 sibling = nodes[parent].Children[0] == leaf ? nodes[parent].Children[1] : nodes[parent].Children[0];
+    FreeNode(parent);
+    if (grandParent == -1)
+    {
+        _root = sibling;
+        nodes[sibling].Parent = -1;
+        return;
+    }
+
+    // Replace parent with the sibling and fix the ancestors
+    SetChild(grandParent, parent, sibling);
+    nodes[sibling].Parent = grandParent;
+    int32 index = grandParent;
+    while (index != -1)
+    {
+        index = Balance(index);
+        Node& node = nodes[index];
+        const Node& child0 = nodes[node.Children[0]];
+        const Node& child1 = nodes[node.Children[1]];
+        node.Height = 1 + Math::Max(child0.Height, child1.Height);
+        BoundingBox::Merge(child0.Bounds, child1.Bounds, node.Bounds);
+        index = node.Parent;
+    }
+}
+
+int32 SceneRenderingBVH::Balance(int32 iA)
+{
+    Node* nodes = _nodes.Get();
+    Node& a = nodes[iA];
+    if (a.IsLeaf() || a.Height < 2)
+        return iA;
+    const int32 iB = a.Children[0];
+    const int32 iC = a.Children[1];
+    Node& b = nodes[iB];
+    Node& c = nodes[iC];
+    const int32 balance = c.Height - b.Height;
+
+    // Rotate C up
+    if (balance > 1)
+    {
+        const int32 iF = c.Children[0];
+        const int32 iG = c.Children[1];
+        Node& f = nodes[iF];
+        Node& g = nodes[iG];
+
+        // Swap A and C
+        c.Children[0] = iA;
+        c.Parent = a.Parent;
+        a.Parent = iC;
+        if (c.Parent != -1)
+            SetChild(c.Parent, iA, iC);
+        else
+            _root = iC;
+
+        // Rotate
+        if (f.Height > g.Height)
+        {
+            c.Children[1] = iF;
+            a.Children[1] = iG;
+            g.Parent = iA;
+            BoundingBox::Merge(b.Bounds, g.Bounds, a.Bounds);
+            BoundingBox::Merge(a.Bounds, f.Bounds, c.Bounds);
+            a.Height = 1 + Math::Max(b.Height, g.Height);
+            c.Height = 1 + Math::Max(a.Height, f.Height);
+        }
+        else
+        {
+            c.Children[1] = iG;
+            a.Children[1] = iF;
+            f.Parent = iA;
+            BoundingBox::Merge(b.Bounds, f.Bounds, a.Bounds);
+            BoundingBox::Merge(a.Bounds, g.Bounds, c.Bounds);
+            a.Height = 1 + Math::Max(b.Height, f.Height);
+            c.Height = 1 + Math::Max(a.Height, g.Height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1)
+    {
+        const int32 iD = b.Children[0];
+        const int32 iE = b.Children[1];
+        Node& d = nodes[iD];
+        Node& e = nodes[iE];
+
+        // Swap A and B
+        b.Children[0] = iA;
+        b.Parent = a.Parent;
+        a.Parent = iB;
+        if (b.Parent != -1)
+            SetChild(b.Parent, iA, iB);
+        else
+            _root = iB;
+
+        // Rotate
+        if (d.Height > e.Height)
+        {
+            b.Children[1] = iD;
+            a.Children[0] = iE;
+            e.Parent = iA;
+            BoundingBox::Merge(c.Bounds, e.Bounds, a.Bounds);
+            BoundingBox::Merge(a.Bounds, d.Bounds, b.Bounds);
+            a.Height = 1 + Math::Max(c.Height, e.Height);
+            b.Height = 1 + Math::Max(a.Height, d.Height);
+        }
+        else
+        {
+            b.Children[1] = iE;
+            a.Children[0] = iD;
+            d.Parent = iA;
+            BoundingBox::Merge(c.Bounds, d.Bounds, a.Bounds);
+            BoundingBox::Merge(a.Bounds, e.Bounds, b.Bounds);
+            a.Height = 1 + Math::Max(c.Height, d.Height);
+            b.Height = 1 + Math::Max(a.Height, e.Height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void SceneRenderingBVH::SetChild(int32 parent, int32 oldChild, int32 newChild)
+{
+    Node& node = _nodes.Get()[parent];
+    if (node.Children[0] == oldChild)
+        node.Children[0] = newChild;
+    else
+        node.Children[1] = newChild;
+}
@@ -0,0 +1,127 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+
+/// <summary>
+/// Dynamic bounding volume hierarchy (self-balancing binary tree of boxes) used for the scene objects culling. Leaves use enlarged bounds so small movement of the objects doesn't need to modify the tree.
+/// </summary>
+class FLAXENGINE_API SceneRenderingBVH
+{
+public:
+    /// <summary>
+    /// The maximum amount of frustums that can be culled at once (limited by the frustums mask size).
+    /// </summary>
+    static constexpr int32 MaxFrustums = 64;
+
+    struct Node
+    {
+        // The node bounds (enlarged object bounds for leaves).
+        BoundingBox Bounds;
+        // The parent node index (or next free node if node is unused).
+        int32 Parent;
+        // The child nodes indices (-1 for leaves).
+        int32 Children[2];
+        // The height of the node in the tree (0 for leaves, -1 for unused nodes).
+        int32 Height;
+        // The user item (for leaves).
+        int32 Item;
+
+        FORCE_INLINE bool IsLeaf() const
+        {
+            return Children[0] == -1;
+        }
+    };
+
+    struct CullNode
+    {
+        // The node index.
+        int32 Node;
+        // The mask of frustums that intersect the node bounds (but don't contain it). Zero if node is fully visible.
+        uint64 FrustumsMask;
+    };
+
+private:
+    Array<Node> _nodes;
+    int32 _root = -1;
+    int32 _freeList = -1;
+    int32 _leavesCount = 0;
+
+public:
+    FORCE_INLINE int32 GetRoot() const
+    {
+        return _root;
+    }
+
+    FORCE_INLINE const Node* GetNodes() const
+    {
+        return _nodes.Get();
+    }
+
+    FORCE_INLINE int32 GetLeavesCount() const
+    {
+        return _leavesCount;
+    }
+
+    FORCE_INLINE int32 GetHeight() const
+    {
+        return _root != -1 ? _nodes.Get()[_root].Height : 0;
+    }
+
+public:
+    // Adds the item to the tree. Returns the leaf node index.
+    int32 Add(const BoundingSphere& bounds, int32 item);
+
+    // Updates the leaf bounds. Returns true if leaf has been moved within the tree, otherwise false if bounds still fit into the leaf bounds.
+    bool Update(int32 leaf, const BoundingSphere& bounds);
+
+    // Removes the leaf from the tree.
+    void Remove(int32 leaf);
+
+    // Removes all items from the tree.
+    void Clear();
+
+    // Culls the top levels of the tree to split the visible part into subtrees (at least minSubtrees, if tree is big enough) that can be culled in parallel. Bounds are offset by -origin before testing with frustums.
+    void CullSubtrees(const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, int32 minSubtrees, Array<CullNode>& result) const;
+
+    // Culls the subtree (returned by CullSubtrees) and calls the visitor for each potentially visible leaf with item and the mask of the frustums to test the item against (zero if item is fully visible).
+    template<typename Visitor>
+    void Cull(const CullNode& subtree, const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, Visitor& visitor) const
+    {
+        const Node* nodes = _nodes.Get();
+        Array<CullNode, InlinedAllocation<64>> stack;
+        stack.Add(subtree);
+        while (stack.HasItems())
+        {
+            const CullNode e = stack.Pop();
+            const Node& node = nodes[e.Node];
+            if (node.IsLeaf())
+            {
+                visitor(node.Item, e.FrustumsMask);
+                continue;
+            }
+            for (const int32 child : node.Children)
+            {
+                // Leaves are not tested as visitor needs to check the actual object bounds anyway
+                CullNode childNode = { child, e.FrustumsMask };
+                if (childNode.FrustumsMask == 0 || nodes[child].IsLeaf() || CullBounds(nodes[child].Bounds, frustums, frustumsCount, origin, childNode.FrustumsMask))
+                    stack.Add(childNode);
+            }
+        }
+    }
+
+    // Tests the bounds against the frustums from the mask. Returns false if bounds are not visible, otherwise updates the mask (clears it if bounds are fully inside any frustum).
+    static bool CullBounds(const BoundingBox& bounds, const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, uint64& frustumsMask);
+
+private:
+    int32 AllocateNode();
+    void FreeNode(int32 index);
+    void InsertLeaf(int32 leaf);
+    void RemoveLeaf(int32 leaf);
+    int32 Balance(int32 index);
+    void SetChild(int32 parent, int32 oldChild, int32 newChild);
+};
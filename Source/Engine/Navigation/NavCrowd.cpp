@@ -8,9 +8,25 @@
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/recastnavigation/DetourCrowd.h>
 
+// Limit of the crowd proximity grid that uses 16-bit indices for the items pool (4 items per agent)
+#define NAV_CROWD_MAX_AGENTS 16383
+
+namespace
+{
+    void CrowdParallelFor(void (*job)(void* data, int index), void* data, int count, void* userData)
+    {
+        JobSystem::Execute([job, data](int32 index)
+        {
+            PROFILE_CPU_NAMED("NavCrowd.Job");
+            job(data, index);
+        }, count);
+    }
+}
+
 NavCrowd::NavCrowd(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -89,6 +105,15 @@ bool NavCrowd::Init(float maxAgentRadius, int32 maxAgents, NavMeshRuntime* navMe
         }
     }
 
+    if (maxAgents > NAV_CROWD_MAX_AGENTS)
+    {
+        LOG(Warning, "Crowd agents limit {0} is too big. Using {1}.", maxAgents, NAV_CROWD_MAX_AGENTS);
+        maxAgents = NAV_CROWD_MAX_AGENTS;
+    }
+
+    ScopeReadLock lock(navMesh->QueryLocker);
+    _navMesh = navMesh;
+    _useJobSystem = false;
     return !_crowd->init(maxAgents, maxAgentRadius, navMesh->GetNavMesh());
 }
 
@@ -179,6 +204,20 @@ void NavCrowd::Update(float dt)
 {
     PROFILE_CPU();
     PROFILE_MEM(Navigation);
+    if (!_navMesh)
+        return;
+
+    // Setup parallel update of the agents
+    const int32 threadsCount = JobSystem::GetThreadsCount();
+    const bool useJobSystem = UseJobSystem && threadsCount > 1;
+    if (_useJobSystem != useJobSystem)
+    {
+        _useJobSystem = useJobSystem;
+        _crowd->setParallelFor(useJobSystem ? CrowdParallelFor : nullptr, nullptr, threadsCount);
+    }
+
+    // Prevent navmesh tiles modification during crowd update
+    ScopeReadLock lock(_navMesh->QueryLocker);
     _crowd->update(Math::Max(dt, ZeroTolerance), nullptr);
 }
 
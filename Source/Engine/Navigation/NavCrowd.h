@@ -18,15 +18,22 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     DECLARE_SCRIPTING_TYPE(NavCrowd);
 private:
     dtCrowd* _crowd;
+    NavMeshRuntime* _navMesh = nullptr;
+    bool _useJobSystem = false;
 
 public:
     ~NavCrowd();
 
+    /// <summary>
+    /// True if the crowd update should run in parallel via Job System (neighbours gathering, steering, obstacle avoidance and integration). The simulation results are the same as for a single-threaded update.
+    /// </summary>
+    API_FIELD() bool UseJobSystem = true;
+
     /// <summary>
     /// Initializes the crowd.
     /// </summary>
     /// <param name="maxAgentRadius">The maximum radius of any agent that will be added to the crowd.</param>
-    /// <param name="maxAgents"> maximum number of agents the crowd can manage.</param>
+    /// <param name="maxAgents"> maximum number of agents the crowd can manage (up to 16383).</param>
     /// <param name="navMesh">The navigation mesh to use for crowd movement planning. Use null to pick the first navmesh.</param>
     /// <returns>True if failed, otherwise false.</returns>
     API_FUNCTION() bool Init(float maxAgentRadius = 100.0f, int32 maxAgents = 25, NavMesh* navMesh = nullptr);
@@ -35,7 +42,7 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     /// Initializes the crowd.
     /// </summary>
     /// <param name="agentProperties">The properties of the agents that will be added to the crowd.</param>
-    /// <param name="maxAgents"> maximum number of agents the crowd can manage.</param>
+    /// <param name="maxAgents"> maximum number of agents the crowd can manage (up to 16383).</param>
     /// <returns>True if failed, otherwise false.</returns>
     API_FUNCTION() bool Init(const NavAgentProperties& agentProperties, int32 maxAgents = 25);
 
@@ -43,7 +50,7 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     /// Initializes the crowd.
     /// </summary>
     /// <param name="maxAgentRadius">The maximum radius of any agent that will be added to the crowd.</param>
-    /// <param name="maxAgents"> maximum number of agents the crowd can manage.</param>
+    /// <param name="maxAgents"> maximum number of agents the crowd can manage (up to 16383).</param>
     /// <param name="navMesh">The navigation mesh to use for crowd movement planning.</param>
     /// <returns>True if failed, otherwise false.</returns>
     bool Init(float maxAgentRadius, int32 maxAgents, NavMeshRuntime* navMesh);
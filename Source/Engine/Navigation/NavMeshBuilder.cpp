@@ -10,10 +10,13 @@
 #include "NavLink.h"
 #include "NavModifierVolume.h"
 #include "NavMeshRuntime.h"
+#include "NavMeshGeometryCache.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/ScopeExit.h"
 #include "Engine/Core/Math/BoundingBox.h"
 #include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Physics/Colliders/BoxCollider.h"
 #include "Engine/Physics/Colliders/SphereCollider.h"
 #include "Engine/Physics/Colliders/CapsuleCollider.h"
@@ -21,6 +24,7 @@
 #include "Engine/Physics/Colliders/SplineCollider.h"
 #include "Engine/Threading/ThreadPoolTask.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Platform/ReadWriteLock.h"
 #include "Engine/Terrain/TerrainPatch.h"
 #include "Engine/Terrain/Terrain.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -51,6 +55,7 @@ int32 BoxTrianglesIndicesCache[] =
 
 #define NAV_MESH_TILE_MAX_EXTENT 100000000
 #define NAV_MESH_BUILD_DEBUG_DRAW_GEOMETRY 0
+#define NAV_MESH_BUILD_GEOMETRY_CACHE_MAX_SIZE (64 * 1024 * 1024)
 
 #if NAV_MESH_BUILD_DEBUG_DRAW_GEOMETRY
 #include "Engine/Debug/DebugDraw.h"
@@ -76,6 +81,130 @@ struct TileId
     int32 X, Y, Layer;
 };
 
+struct NavGeometryKey
+{
+    Guid ActorId;
+    Quaternion Rotation;
+
+    bool operator==(const NavGeometryKey& other) const
+    {
+        return ActorId == other.ActorId && Rotation == other.Rotation;
+    }
+};
+
+inline uint32 GetHash(const NavGeometryKey& key)
+{
+    uint32 hash = GetHash(key.ActorId);
+    CombineHash(hash, GetHash(Float4(key.Rotation.X, key.Rotation.Y, key.Rotation.Z, key.Rotation.W)));
+    return hash;
+}
+
+void NavGeometry::Build(const Array<Float3>& vb, const Array<int32>& ib)
+{
+    PROFILE_CPU();
+    Tiles.Clear();
+
+    // Add triangles to all tiles that overlap with them (including tiles border)
+    const Float3* vbData = vb.Get();
+    const int32* ibData = ib.Get();
+    Float3 v[3];
+    for (int32 i0 = 0; i0 < ib.Count();)
+    {
+        Float3::Transform(vbData[ibData[i0++]], WorldToNavMesh, v[0]);
+        Float3::Transform(vbData[ibData[i0++]], WorldToNavMesh, v[1]);
+        Float3::Transform(vbData[ibData[i0++]], WorldToNavMesh, v[2]);
+        const float minX = Math::Min(v[0].X, v[1].X, v[2].X) - TileBorderSize;
+        const float minZ = Math::Min(v[0].Z, v[1].Z, v[2].Z) - TileBorderSize;
+        const float maxX = Math::Max(v[0].X, v[1].X, v[2].X) + TileBorderSize;
+        const float maxZ = Math::Max(v[0].Z, v[1].Z, v[2].Z) + TileBorderSize;
+        const Int2 tilesMin((int32)Math::Floor(minX / TileSize), (int32)Math::Floor(minZ / TileSize));
+        const Int2 tilesMax((int32)Math::Floor(maxX / TileSize), (int32)Math::Floor(maxZ / TileSize));
+        for (int32 y = tilesMin.Y; y <= tilesMax.Y; y++)
+        {
+            for (int32 x = tilesMin.X; x <= tilesMax.X; x++)
+                Tiles[Int2(x, y)].Add(v, 3);
+        }
+    }
+
+    Size = 0;
+    for (const auto& e : Tiles)
+        Size += e.Value.Capacity() * sizeof(Float3);
+}
+
+CriticalSection NavGeometryCacheLocker;
+Dictionary<NavGeometryKey, NavGeometry*> NavGeometryCache;
+HashSet<Guid> NavGeometryCacheEvicted;
+int64 NavGeometryCacheVersion = 1;
+int64 NavGeometryCacheSize = 0;
+int64 NavGeometryCacheDirty = 0;
+
+NavGeometry* NavMeshGeometryCache::Get(const Guid& actorId, const Quaternion& rotation)
+{
+    ScopeLock lock(NavGeometryCacheLocker);
+    const NavGeometryKey key = { actorId, rotation };
+    NavGeometry*& geometry = NavGeometryCache[key];
+    if (!geometry)
+        geometry = New<NavGeometry>();
+    return geometry;
+}
+
+int64 NavMeshGeometryCache::GetVersion()
+{
+    return Platform::AtomicRead(&NavGeometryCacheVersion);
+}
+
+int64 NavMeshGeometryCache::GetSize()
+{
+    return Platform::AtomicRead(&NavGeometryCacheSize);
+}
+
+int32 NavMeshGeometryCache::GetCount()
+{
+    ScopeLock lock(NavGeometryCacheLocker);
+    return NavGeometryCache.Count();
+}
+
+void NavMeshGeometryCache::AddSize(int64 delta)
+{
+    Platform::InterlockedAdd(&NavGeometryCacheSize, delta);
+}
+
+void NavMeshGeometryCache::Invalidate()
+{
+    Platform::InterlockedIncrement(&NavGeometryCacheVersion);
+    Platform::AtomicStore(&NavGeometryCacheDirty, 1);
+}
+
+void NavMeshGeometryCache::Evict(const Guid& actorId)
+{
+    ScopeLock lock(NavGeometryCacheLocker);
+    NavGeometryCacheEvicted.Add(actorId);
+    Platform::AtomicStore(&NavGeometryCacheDirty, 1);
+}
+
+void NavMeshGeometryCache::Update()
+{
+    // Remove outdated geometry and free memory when it gets too big (called when there are no build tasks that could use it)
+    if (Platform::AtomicRead(&NavGeometryCacheDirty) == 0 && Platform::AtomicRead(&NavGeometryCacheSize) <= NAV_MESH_BUILD_GEOMETRY_CACHE_MAX_SIZE)
+        return;
+    PROFILE_CPU();
+    ScopeLock lock(NavGeometryCacheLocker);
+    Platform::AtomicStore(&NavGeometryCacheDirty, 0);
+    const int64 version = Platform::AtomicRead(&NavGeometryCacheVersion);
+    const bool clear = Platform::AtomicRead(&NavGeometryCacheSize) > NAV_MESH_BUILD_GEOMETRY_CACHE_MAX_SIZE;
+    for (auto it = NavGeometryCache.Begin(); it.IsNotEnd(); ++it)
+    {
+        NavGeometry* geometry = it->Value;
+        if (clear || geometry->Version != version || NavGeometryCacheEvicted.Contains(it->Key.ActorId))
+        {
+            Platform::InterlockedAdd(&NavGeometryCacheSize, -geometry->Size);
+            Delete(geometry);
+            NavGeometryCache.Remove(it);
+        }
+    }
+    NavGeometryCacheEvicted.Clear();
+}
+
 struct NavSceneRasterizer
 {
     NavMesh* NavMesh;
@@ -89,6 +218,9 @@ struct NavSceneRasterizer
     Array<int32> IndexBuffer;
     Array<OffMeshLink>* OffMeshLinks;
     Array<Modifier>* Modifiers;
+    Int2 Tile;
+    float TileSize;
+    float TileBorderSize;
     const bool IsWorldToNavMeshIdentity;
 
     NavSceneRasterizer(::NavMesh* navMesh, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, rcContext* context, rcConfig* config, rcHeightfield* heightfield, Array<OffMeshLink>* offMeshLinks, Array<Modifier>* modifiers)
@@ -160,6 +292,63 @@ struct NavSceneRasterizer
         ib.Clear();
     }
 
+    void RasterizeTriangles(const Array<Float3>& triangles)
+    {
+        PROFILE_CPU();
+
+        // Rasterize triangles (already in the navmesh space)
+        for (int32 i = 0; i < triangles.Count(); i += 3)
+        {
+            const Float3& v0 = triangles.Get()[i];
+            const Float3& v1 = triangles.Get()[i + 1];
+            const Float3& v2 = triangles.Get()[i + 2];
+#if NAV_MESH_BUILD_DEBUG_DRAW_GEOMETRY
+            DEBUG_DRAW_TRIANGLE(v0, v1, v2, Color::Orange.AlphaMultiplied(0.3f), 1.0f, true);
+#endif
+
+            auto n = Float3::Cross(v0 - v1, v0 - v2);
+            n.Normalize();
+            const char area = n.Y > WalkableThreshold ? RC_WALKABLE_AREA : RC_NULL_AREA;
+            rcRasterizeTriangle(Context, &v0.X, &v1.X, &v2.X, area, *Heightfield);
+        }
+    }
+
+    template<typename ExtractGeometryFunc>
+    void RasterizeCached(const Actor* actor, void* source, const Matrix& localToWorld, ExtractGeometryFunc extractGeometry)
+    {
+        // Get the actor geometry from cache (or build it once for all tiles)
+        const int64 version = NavMeshGeometryCache::GetVersion();
+        NavGeometry* geometry = NavMeshGeometryCache::Get(actor->GetID(), NavMesh->Properties.Rotation);
+        geometry->Locker.ReadLock();
+        while (!geometry->IsValid(version, source, localToWorld, WorldToNavMesh, TileSize, TileBorderSize))
+        {
+            geometry->Locker.ReadUnlock();
+            geometry->Locker.WriteLock();
+            if (!geometry->IsValid(version, source, localToWorld, WorldToNavMesh, TileSize, TileBorderSize))
+            {
+                extractGeometry();
+                const int64 prevSize = geometry->Size;
+                geometry->TileBorderSize = geometry->IsValid(version, source, localToWorld, WorldToNavMesh, TileSize, 0.0f) ? Math::Max(geometry->TileBorderSize, TileBorderSize) : TileBorderSize;
+                geometry->Version = version;
+                geometry->Source = source;
+                geometry->LocalToWorld = localToWorld;
+                geometry->WorldToNavMesh = WorldToNavMesh;
+                geometry->TileSize = TileSize;
+                geometry->Build(VertexBuffer, IndexBuffer);
+                NavMeshGeometryCache::AddSize(geometry->Size - prevSize);
+                VertexBuffer.Clear();
+                IndexBuffer.Clear();
+            }
+            geometry->Locker.WriteUnlock();
+            geometry->Locker.ReadLock();
+        }
+
+        // Rasterize only triangles that overlap with this tile
+        if (const Array<Float3>* triangles = geometry->Tiles.TryGet(Tile))
+            RasterizeTriangles(*triangles);
+        geometry->Locker.ReadUnlock();
+    }
+
     static void TriangulateBox(Array<Float3>& vb, Array<int32>& ib, const OrientedBoundingBox& box)
     {
         vb.Resize(8);
@@ -275,12 +464,15 @@ struct NavSceneRasterizer
             if (!collisionData || collisionData->WaitForLoaded())
                 return;
 
-            collisionData->ExtractGeometry(VertexBuffer, IndexBuffer);
             Matrix meshColliderToWorld;
             meshCollider->GetLocalToWorldMatrix(meshColliderToWorld);
-            for (auto& v : VertexBuffer)
-                Float3::Transform(v, meshColliderToWorld, v);
-            RasterizeTriangles();
+            void* source = collisionData->GetTriangle() ? collisionData->GetTriangle() : collisionData->GetConvex();
+            RasterizeCached(meshCollider, source, meshColliderToWorld, [&]
+            {
+                collisionData->ExtractGeometry(VertexBuffer, IndexBuffer);
+                for (auto& v : VertexBuffer)
+                    Float3::Transform(v, meshColliderToWorld, v);
+            });
         }
         else if (const auto* splineCollider = dynamic_cast<SplineCollider*>(actor))
         {
@@ -299,6 +491,10 @@ struct NavSceneRasterizer
         {
             PROFILE_CPU_NAMED("Terrain");
 
+            Matrix navMeshToWorld;
+            Matrix::Invert(WorldToNavMesh, navMeshToWorld);
+            BoundingBox tileBounds;
+            BoundingBox::Transform(TileBoundsNavMesh, navMeshToWorld, tileBounds);
             for (int32 patchIndex = 0; patchIndex < terrain->GetPatchesCount(); patchIndex++)
             {
                 const auto patch = terrain->GetPatch(patchIndex);
@@ -307,8 +503,8 @@ struct NavSceneRasterizer
                 if (!patchBoundsNavMesh.Intersects(TileBoundsNavMesh))
                     continue;
 
-                // TODO: get collision only from tile area
-                patch->ExtractCollisionGeometry(VertexBuffer, IndexBuffer);
+                // Extract only the heightfield area under the tile
+                patch->ExtractCollisionGeometry(tileBounds, VertexBuffer, IndexBuffer);
                 RasterizeTriangles();
             }
         }
@@ -400,6 +596,9 @@ bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, B
     {
         PROFILE_CPU_NAMED("RasterizeGeometry");
         NavSceneRasterizer rasterizer(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, heightfield, &offMeshLinks, &modifiers);
+        rasterizer.Tile = Int2(x, y);
+        rasterizer.TileSize = tileSize;
+        rasterizer.TileBorderSize = tileBorderSize;
 
         // Collect actors to rasterize
         Array<Actor*> actors;
@@ -801,6 +1000,17 @@ void CancelNavMeshTileBuildTasks(NavMeshRuntime* runtime, int32 x, int32 y, NavM
     NavBuildTasksLocker.Unlock();
 }
 
+void EvictNavGeometry(Actor* root)
+{
+    Function<bool(Actor*)> function = [](Actor* actor)
+    {
+        if (dynamic_cast<MeshCollider*>(actor))
+            NavMeshGeometryCache::Evict(actor->GetID());
+        return true;
+    };
+    root->TreeExecute(function);
+}
+
 void OnSceneUnloading(Scene* scene, const Guid& sceneId)
 {
     // Cancel pending build requests
@@ -834,11 +1044,21 @@ void OnSceneUnloading(Scene* scene, const Guid& sceneId)
         }
     }
     NavBuildTasksLocker.Unlock();
+
+    // Release cached geometry of the scene actors
+    EvictNavGeometry(scene);
+}
+
+void OnActorDeleted(Actor* actor)
+{
+    // Release cached geometry of the deleted actors (event is called only for the root of the removed tree)
+    EvictNavGeometry(actor);
 }
 
 void NavMeshBuilder::Init()
 {
     Level::SceneUnloading.Bind<OnSceneUnloading>();
+    Level::ActorDeleted.Bind<OnActorDeleted>();
 }
 
 bool Navigation::IsBuildingNavMesh()
@@ -891,6 +1111,7 @@ void BuildTileAsync(NavMesh* navMesh, const int32 x, const int32 y, const rcConf
     task->WorldToNavMesh = worldToNavMesh;
     task->TileSize = tileSize;
     task->Config = config;
+    task->Priority = JobPriority::Background;
     NavBuildTasks.Add(task);
     NavBuildTasksMaxCount++;
 
@@ -928,6 +1149,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
         {
             runtime->Locker.Unlock();
             CancelNavMeshTileBuildTasks(runtime);
+            NavMeshGeometryCache::Invalidate();
             runtime->Locker.Lock();
 
             // Remove all tiles from navmesh runtime
@@ -1194,6 +1416,12 @@ void NavMeshBuilder::Update()
         }
     }
 
+    // Cleanup cached geometry (when all active tasks are done)
+    NavBuildTasksLocker.Lock();
+    if (NavBuildTasks.IsEmpty())
+        NavMeshGeometryCache::Update();
+    NavBuildTasksLocker.Unlock();
+
     // Remove unused navmeshes (when all active tasks are done)
     // TODO: ignore AutoRemoveMissingNavMeshes in game and make it editor-only?
     if (NavBuildCheckMissingNavMeshes && NavBuildTasksMaxCount == 0 && NavigationSettings::Get()->AutoRemoveMissingNavMeshes)
@@ -0,0 +1,100 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if COMPILE_WITH_NAV_MESH_BUILDER
+
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/Int2.h"
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Types/Guid.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Platform/ReadWriteLock.h"
+
+/// <summary>
+/// Collision geometry of the actor transformed into the navmesh space and split into the tiles. Reused by the tiles and rebuilds until actor or its collision changes.
+/// </summary>
+struct FLAXENGINE_API NavGeometry
+{
+    ReadWriteLock Locker;
+    int64 Version = 0;
+    void* Source = nullptr;
+    Matrix LocalToWorld;
+    Matrix WorldToNavMesh;
+    float TileSize = 0.0f;
+    float TileBorderSize = 0.0f;
+    int64 Size = 0;
+    Dictionary<Int2, Array<Float3>> Tiles;
+
+    bool IsValid(int64 version, void* source, const Matrix& localToWorld, const Matrix& worldToNavMesh, float tileSize, float tileBorderSize) const
+    {
+        return Version == version &&
+            Source == source &&
+            LocalToWorld == localToWorld &&
+            WorldToNavMesh == worldToNavMesh &&
+            TileSize == tileSize &&
+            TileBorderSize >= tileBorderSize;
+    }
+
+    /// <summary>
+    /// Splits the triangles (in world space) into the tiles (including tiles border). Uses WorldToNavMesh, TileSize and TileBorderSize.
+    /// </summary>
+    /// <param name="vb">The vertex buffer.</param>
+    /// <param name="ib">The index buffer.</param>
+    void Build(const Array<Float3>& vb, const Array<int32>& ib);
+};
+
+/// <summary>
+/// The navmesh building geometry cache. Entries are shared by all build tasks, so they are released only by Update which has to be called when there are no active build tasks.
+/// </summary>
+class FLAXENGINE_API NavMeshGeometryCache
+{
+public:
+    /// <summary>
+    /// Gets the cached geometry of the actor (creates an empty entry if missing). Entry is valid until the next Update.
+    /// </summary>
+    /// <param name="actorId">The actor identifier.</param>
+    /// <param name="rotation">The navmesh orientation.</param>
+    /// <returns>The cache entry.</returns>
+    static NavGeometry* Get(const Guid& actorId, const Quaternion& rotation);
+
+    /// <summary>
+    /// Gets the current cache version. Entries built with an older version are outdated.
+    /// </summary>
+    static int64 GetVersion();
+
+    /// <summary>
+    /// Gets the total memory used by the cached geometry (in bytes).
+    /// </summary>
+    static int64 GetSize();
+
+    /// <summary>
+    /// Gets the amount of cached entries.
+    /// </summary>
+    static int32 GetCount();
+
+    /// <summary>
+    /// Adds to the total memory used by the cached geometry (in bytes). Called after the entry gets rebuilt.
+    /// </summary>
+    /// <param name="delta">The size change.</param>
+    static void AddSize(int64 delta);
+
+    /// <summary>
+    /// Invalidates all cached geometry (eg. on full navmesh rebuild).
+    /// </summary>
+    static void Invalidate();
+
+    /// <summary>
+    /// Marks all cached geometry of the actor to be released (eg. when the actor gets deleted).
+    /// </summary>
+    /// <param name="actorId">The actor identifier.</param>
+    static void Evict(const Guid& actorId);
+
+    /// <summary>
+    /// Releases outdated and evicted geometry, or everything if the cache is too big. Must be called when there are no active build tasks.
+    /// </summary>
+    static void Update();
+};
+
+#endif
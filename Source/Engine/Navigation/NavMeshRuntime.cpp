@@ -10,12 +10,16 @@
 #endif
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
 #include <ThirdParty/recastnavigation/DetourNavMeshQuery.h>
 #include <ThirdParty/recastnavigation/RecastAlloc.h>
 
 #define MAX_NODES 2048
+// Maximum amount of the unused navmesh queries kept for reuse (more can be allocated when many threads use the navmesh at once)
+#define MAX_POOLED_QUERIES 8
+#define PATHS_PER_JOB 8
 #define USE_DATA_LINK 0
 #define USE_NAV_MESH_ALLOC 0
 
@@ -39,6 +43,46 @@ namespace
         Platform::MemoryCopy(filter.m_areaCost, NavMeshRuntime::NavAreasCosts, sizeof(NavMeshRuntime::NavAreasCosts));
         static_assert(sizeof(dtQueryFilter::m_areaCost) == sizeof(NavMeshRuntime::NavAreasCosts), "Invalid navmesh area cost list.");
     }
+
+    // Navmesh query taken from the pool for the scope duration.
+    struct NavMeshQueryScope
+    {
+        const NavMeshRuntime* NavMesh;
+        dtNavMeshQuery* Query;
+
+        NavMeshQueryScope(const NavMeshRuntime* navMesh)
+            : NavMesh(navMesh)
+            , Query(navMesh->GetNavMeshQuery())
+        {
+        }
+
+        ~NavMeshQueryScope()
+        {
+            NavMesh->ReleaseNavMeshQuery(Query);
+        }
+
+        FORCE_INLINE dtNavMeshQuery* operator->() const
+        {
+            return Query;
+        }
+
+        FORCE_INLINE bool operator!() const
+        {
+            return Query == nullptr;
+        }
+    };
+
+    void FindPathsJob(const NavMeshRuntime* navMesh, Span<NavMeshPathRequest> requests, int32 jobIndex)
+    {
+        PROFILE_CPU_NAMED("NavMeshRuntime.FindPaths");
+        const int32 start = jobIndex * PATHS_PER_JOB;
+        const int32 end = Math::Min(start + PATHS_PER_JOB, requests.Length());
+        for (int32 i = start; i < end; i++)
+        {
+            NavMeshPathRequest& request = requests[i];
+            request.Result = navMesh->FindPath(request.StartPosition, request.EndPosition, request.ResultPath, request.ResultFlags);
+        }
+    }
 }
 
 NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
@@ -46,14 +90,63 @@ NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
     , Properties(properties)
 {
     _navMesh = nullptr;
-    _navMeshQuery = dtAllocNavMeshQuery();
+    _navMeshVersion = 0;
     _tileSize = 0;
 }
 
 NavMeshRuntime::~NavMeshRuntime()
 {
+    WaitForPaths();
     Dispose();
-    dtFreeNavMeshQuery(_navMeshQuery);
+    for (const PooledQuery& query : _queriesPool)
+        dtFreeNavMeshQuery(query.Query);
+}
+
+dtNavMeshQuery* NavMeshRuntime::GetNavMeshQuery() const
+{
+    if (!_navMesh)
+        return nullptr;
+    PooledQuery query;
+    _queriesLocker.Lock();
+    if (_queriesPool.HasItems())
+    {
+        query = _queriesPool.Last();
+        _queriesPool.RemoveLast();
+        _queriesLocker.Unlock();
+    }
+    else
+    {
+        _queriesLocker.Unlock();
+        PROFILE_MEM(NavigationMesh);
+        query.Query = dtAllocNavMeshQuery();
+        query.Version = 0;
+    }
+    if (query.Version != _navMeshVersion)
+    {
+        // Navmesh has been recreated so reinitialize the query for it
+        if (dtStatusFailed(query.Query->init(_navMesh, MAX_NODES)))
+        {
+            LOG(Error, "Navmesh query {0} init failed", Properties.Name);
+            dtFreeNavMeshQuery(query.Query);
+            return nullptr;
+        }
+    }
+    return query.Query;
+}
+
+void NavMeshRuntime::ReleaseNavMeshQuery(dtNavMeshQuery* query) const
+{
+    if (!query)
+        return;
+    _queriesLocker.Lock();
+    if (_queriesPool.Count() < MAX_POOLED_QUERIES)
+    {
+        _queriesPool.Add({ query, _navMeshVersion });
+        query = nullptr;
+    }
+    _queriesLocker.Unlock();
+    if (query)
+        dtFreeNavMeshQuery(query);
 }
 
 int32 NavMeshRuntime::GetTilesCapacity() const
@@ -63,8 +156,8 @@ int32 NavMeshRuntime::GetTilesCapacity() const
 
 bool NavMeshRuntime::FindDistanceToWall(const Vector3& startPosition, NavMeshHit& hitInfo, float maxDistance) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -95,8 +188,8 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
 {
     resultPath.Clear();
     resultFlags = NavMeshPathFlags::None;
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -157,8 +250,8 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
 
 bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPosition) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -190,8 +283,8 @@ bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPo
 
 bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -216,8 +309,8 @@ bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) con
 
 bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -238,8 +331,8 @@ bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 
 bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float radius, Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -268,8 +361,8 @@ bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float ra
 
 bool NavMeshRuntime::RayCast(const Vector3& startPosition, const Vector3& endPosition, NavMeshHit& hitInfo) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
+    ScopeReadLock lock(QueryLocker);
+    const NavMeshQueryScope query(this);
     if (!query || !_navMesh)
         return false;
 
@@ -304,9 +397,52 @@ bool NavMeshRuntime::RayCast(const Vector3& startPosition, const Vector3& endPos
     return result;
 }
 
+void NavMeshRuntime::FindPaths(Span<NavMeshPathRequest> requests) const
+{
+    if (requests.Length() == 0)
+        return;
+    PROFILE_CPU();
+    const int32 jobCount = (requests.Length() + PATHS_PER_JOB - 1) / PATHS_PER_JOB;
+    JobSystem::Execute([this, requests](int32 jobIndex)
+    {
+        FindPathsJob(this, requests, jobIndex);
+    }, jobCount);
+}
+
+int64 NavMeshRuntime::FindPathsAsync(Span<NavMeshPathRequest> requests) const
+{
+    if (requests.Length() == 0)
+        return 0;
+    PROFILE_CPU();
+    const int32 jobCount = (requests.Length() + PATHS_PER_JOB - 1) / PATHS_PER_JOB;
+    const int64 label = JobSystem::Dispatch([this, requests](int32 jobIndex)
+    {
+        FindPathsJob(this, requests, jobIndex);
+    }, jobCount);
+    ScopeLock lock(_pathsLocker);
+    _pathsLabels.Add(label);
+    return label;
+}
+
+void NavMeshRuntime::WaitForPaths() const
+{
+    _pathsLocker.Lock();
+    if (_pathsLabels.IsEmpty())
+    {
+        _pathsLocker.Unlock();
+        return;
+    }
+    PROFILE_CPU();
+    const Array<int64> labels = MoveTemp(_pathsLabels);
+    _pathsLocker.Unlock();
+    for (const int64 label : labels)
+        JobSystem::Wait(label);
+}
+
 void NavMeshRuntime::SetTileSize(float tileSize)
 {
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
 
     // Skip if the same or invalid
     if (_tileSize == tileSize || tileSize < 1)
@@ -315,7 +451,7 @@ void NavMeshRuntime::SetTileSize(float tileSize)
     // Dispose the existing mesh (its invalid)
     if (_navMesh)
     {
-        Dispose();
+        DisposeInternal();
     }
 
     _tileSize = tileSize;
@@ -324,6 +460,12 @@ void NavMeshRuntime::SetTileSize(float tileSize)
 void NavMeshRuntime::EnsureCapacity(int32 tilesToAddCount)
 {
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
+    EnsureCapacityInternal(tilesToAddCount);
+}
+
+void NavMeshRuntime::EnsureCapacityInternal(int32 tilesToAddCount)
+{
     const int32 newTilesCount = _tiles.Count() + tilesToAddCount;
     const int32 capacity = GetTilesCapacity();
     if (newTilesCount <= capacity)
@@ -355,15 +497,12 @@ void NavMeshRuntime::EnsureCapacity(int32 tilesToAddCount)
     // Initialize nav mesh
     if (!_navMesh)
         _navMesh = dtAllocNavMesh();
+    _navMeshVersion++;
     if (dtStatusFailed(_navMesh->init(&params)))
     {
         LOG(Error, "Navmesh {0} init failed", Properties.Name);
         return;
     }
-    if (dtStatusFailed(_navMeshQuery->init(_navMesh, MAX_NODES)))
-    {
-        LOG(Error, "Navmesh query {0} init failed", Properties.Name);
-    }
 
     // Prepare tiles container
     _tiles.EnsureCapacity(newCapacity);
@@ -392,6 +531,7 @@ void NavMeshRuntime::AddTiles(NavMesh* navMesh)
     PROFILE_CPU_NAMED("NavMeshRuntime.AddTiles");
     PROFILE_MEM(NavigationMesh);
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
 
     // Validate data (must match navmesh) or init navmesh to match the tiles options
     if (_navMesh)
@@ -408,7 +548,7 @@ void NavMeshRuntime::AddTiles(NavMesh* navMesh)
     }
 
     // Ensure to have space for new tiles
-    EnsureCapacity(data.Tiles.Count());
+    EnsureCapacityInternal(data.Tiles.Count());
 
     // Add new tiles
     for (auto& tileData : data.Tiles)
@@ -424,6 +564,7 @@ void NavMeshRuntime::AddTile(NavMesh* navMesh, NavMeshTileData& tileData)
     PROFILE_CPU_NAMED("NavMeshRuntime.AddTile");
     PROFILE_MEM(NavigationMesh);
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
 
     // Validate data (must match navmesh) or init navmesh to match the tiles options
     if (_navMesh)
@@ -440,7 +581,7 @@ void NavMeshRuntime::AddTile(NavMesh* navMesh, NavMeshTileData& tileData)
     }
 
     // Ensure to have space for new tile
-    EnsureCapacity(1);
+    EnsureCapacityInternal(1);
 
     // Add new tile
     AddTileInternal(navMesh, tileData);
@@ -459,6 +600,7 @@ void NavMeshRuntime::RemoveTiles(NavMesh* navMesh)
 void NavMeshRuntime::RemoveTile(int32 x, int32 y, int32 layer)
 {
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
     if (!_navMesh)
         return;
     PROFILE_CPU_NAMED("NavMeshRuntime.RemoveTile");
@@ -486,6 +628,7 @@ void NavMeshRuntime::RemoveTile(int32 x, int32 y, int32 layer)
 void NavMeshRuntime::RemoveTiles(bool (*prediction)(const NavMeshRuntime* navMesh, const NavMeshTile& tile, void* customData), void* userData)
 {
     ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
     ASSERT(prediction);
     if (!_navMesh)
         return;
@@ -591,7 +734,7 @@ void DrawPoly(NavMeshRuntime* navMesh, const Matrix& navMeshToWorld, const dtMes
 
 void NavMeshRuntime::DebugDraw()
 {
-    ScopeLock lock(Locker);
+    ScopeReadLock lock(QueryLocker);
     const dtNavMesh* dtNavMesh = GetNavMesh();
     const int tilesCount = dtNavMesh ? dtNavMesh->getMaxTiles() : 0;
     if (tilesCount == 0)
@@ -636,11 +779,19 @@ void NavMeshRuntime::DebugDraw()
 #endif
 
 void NavMeshRuntime::Dispose()
+{
+    ScopeLock lock(Locker);
+    ScopeWriteLock writeLock(QueryLocker);
+    DisposeInternal();
+}
+
+void NavMeshRuntime::DisposeInternal()
 {
     if (_navMesh)
     {
         dtFreeNavMesh(_navMesh);
         _navMesh = nullptr;
+        _navMeshVersion++;
     }
     _tiles.Resize(0);
 }
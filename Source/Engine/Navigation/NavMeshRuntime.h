@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ReadWriteLock.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "NavMeshData.h"
 #include "NavigationTypes.h"
@@ -38,6 +40,23 @@ enum class NavMeshPathFlags
 
 DECLARE_ENUM_OPERATORS(NavMeshPathFlags);
 
+/// <summary>
+/// The navigation mesh path finding request used by the batched path queries.
+/// </summary>
+struct NavMeshPathRequest
+{
+    // The path start position.
+    Vector3 StartPosition;
+    // The path end position.
+    Vector3 EndPosition;
+    // The result path (list of waypoints).
+    Array<Vector3, HeapAllocation> ResultPath;
+    // The result path flags.
+    NavMeshPathFlags ResultFlags = NavMeshPathFlags::None;
+    // True if found valid path between given two points (it may be partial), otherwise false if failed.
+    bool Result = false;
+};
+
 /// <summary>
 /// The navigation mesh runtime object that builds the navmesh from all loaded scenes.
 /// </summary>
@@ -64,8 +83,18 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
 #endif
 
 private:
+    struct PooledQuery
+    {
+        dtNavMeshQuery* Query;
+        uint32 Version;
+    };
+
     dtNavMesh* _navMesh;
-    dtNavMeshQuery* _navMeshQuery;
+    uint32 _navMeshVersion;
+    mutable CriticalSection _queriesLocker;
+    mutable Array<PooledQuery> _queriesPool;
+    mutable CriticalSection _pathsLocker;
+    mutable Array<int64> _pathsLabels;
     float _tileSize;
     Array<NavMeshTile> _tiles;
 
@@ -79,6 +108,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     /// </summary>
     CriticalSection Locker;
 
+    /// <summary>
+    /// The navmesh data locker. Queries take the read lock (can run concurrently on many threads), tiles modification takes the write lock.
+    /// </summary>
+    ReadWriteLock QueryLocker;
+
     /// <summary>
     /// The navigation mesh properties.
     /// </summary>
@@ -97,10 +131,15 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
         return _navMesh;
     }
 
-    dtNavMeshQuery* GetNavMeshQuery() const
-    {
-        return _navMeshQuery;
-    }
+    /// <summary>
+    /// Gets the navmesh query object from the pool (each caller gets a separate query). Call it within the QueryLocker read lock and return it via ReleaseNavMeshQuery when done.
+    /// </summary>
+    dtNavMeshQuery* GetNavMeshQuery() const;
+
+    /// <summary>
+    /// Returns the navmesh query object to the pool (or frees it if the pool is full). Call it within the same QueryLocker read lock as GetNavMeshQuery.
+    /// </summary>
+    void ReleaseNavMeshQuery(dtNavMeshQuery* query) const;
 
     int32 GetTilesCapacity() const;
 
@@ -190,6 +229,24 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     /// <returns>True if ray hits a matching object, otherwise false.</returns>
     API_FUNCTION() bool RayCast(const Vector3& startPosition, const Vector3& endPosition, API_PARAM(Out) NavMeshHit& hitInfo) const;
 
+    /// <summary>
+    /// Finds the paths for the batch of requests (in parallel via Job System). Waits for all results.
+    /// </summary>
+    /// <param name="requests">The path finding requests.</param>
+    void FindPaths(Span<NavMeshPathRequest> requests) const;
+
+    /// <summary>
+    /// Starts finding the paths for the batch of requests (in parallel via Job System) without waiting for the results. The requests memory has to be valid until the results are ready. Results are ready on the next frame (Navigation service waits for all pending path queries during its update) or after JobSystem::Wait called with the returned label.
+    /// </summary>
+    /// <param name="requests">The path finding requests.</param>
+    /// <returns>The Job System label of the queries dispatch, or 0 if there was nothing to do.</returns>
+    int64 FindPathsAsync(Span<NavMeshPathRequest> requests) const;
+
+    /// <summary>
+    /// Waits for all pending path queries started via FindPathsAsync.
+    /// </summary>
+    void WaitForPaths() const;
+
 public:
     /// <summary>
     /// Sets the size of the tile (if not assigned). Disposes the mesh if added tiles have different size.
@@ -247,5 +304,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     void Dispose();
 
 private:
+    void EnsureCapacityInternal(int32 tilesToAddCount);
     void AddTileInternal(NavMesh* navMesh, NavMeshTileData& tileData);
+    void DisposeInternal();
 };
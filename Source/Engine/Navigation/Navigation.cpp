@@ -167,9 +167,7 @@ class NavigationService : public EngineService
     }
 
     bool Init() override;
-#if COMPILE_WITH_NAV_MESH_BUILDER
     void Update() override;
-#endif
     void Dispose() override;
 };
 
@@ -314,14 +312,16 @@ bool NavigationService::Init()
     return false;
 }
 
-#if COMPILE_WITH_NAV_MESH_BUILDER
-
 void NavigationService::Update()
 {
-    NavMeshBuilder::Update();
-}
+    // Finish path queries started during the previous frame
+    for (auto navMesh : NavMeshes)
+        navMesh->WaitForPaths();
 
+#if COMPILE_WITH_NAV_MESH_BUILDER
+    NavMeshBuilder::Update();
 #endif
+}
 
 void NavigationService::Dispose()
 {
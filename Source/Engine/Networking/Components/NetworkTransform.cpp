@@ -18,6 +18,7 @@ PACK_STRUCT(struct Data
     {
     uint8 LocalSpace : 1;
     uint8 HasSequenceIndex : 1;
+    uint8 Quantized : 1;
     NetworkTransform::ReplicationComponents Components : 9;
     });
 
@@ -34,6 +35,82 @@ namespace
         const T targetDeltaMax = targetDelta.GetAbsolute().MaxValue();
         return targetDeltaMax > (T)ZeroTolerance && currentDelta.GetAbsolute().MaxValue() < targetDeltaMax * (T)Precision;
     }
+
+    // Bits count for rotation components in a quantized mode (smallest-three quaternion takes 47 bits, euler angle has 0.0055 degree precision)
+    constexpr int32 RotationBits = 15;
+    constexpr int32 EulerBits = 16;
+
+    FORCE_INLINE void WritePosition(NetworkStream* stream, Real value, float precision)
+    {
+        if (precision > 0.0f)
+        {
+            const double scaled = (double)value / precision;
+            stream->WriteVarInt((int64)(scaled + (scaled < 0.0 ? -0.5 : 0.5)));
+        }
+        else
+            stream->Write(value);
+    }
+
+    FORCE_INLINE void ReadPosition(NetworkStream* stream, Real& value, float precision)
+    {
+        if (precision > 0.0f)
+            value = (Real)((double)stream->ReadVarInt() * precision);
+        else
+            stream->Read(value);
+    }
+
+    FORCE_INLINE void WriteScale(NetworkStream* stream, const Float3& value, bool quantized)
+    {
+        // Skip the most common unit scale
+        if (quantized)
+        {
+            const bool isOne = value == Float3::One;
+            stream->WriteBits(isOne ? 1 : 0, 1);
+            if (isOne)
+                return;
+        }
+        stream->Write(value);
+    }
+
+    FORCE_INLINE void ReadScale(NetworkStream* stream, Float3& value, bool quantized)
+    {
+        if (quantized && stream->ReadBits(1))
+            value = Float3::One;
+        else
+            stream->Read(value);
+    }
+
+    FORCE_INLINE void WriteRotation(NetworkStream* stream, const Quaternion& value, bool quantized)
+    {
+        if (quantized)
+            stream->WriteQuantizedQuaternion(value, RotationBits);
+        else
+            stream->Write(value);
+    }
+
+    FORCE_INLINE void ReadRotation(NetworkStream* stream, Quaternion& value, bool quantized)
+    {
+        if (quantized)
+            value = stream->ReadQuantizedQuaternion(RotationBits);
+        else
+            stream->Read(value);
+    }
+
+    FORCE_INLINE void WriteEuler(NetworkStream* stream, float value, bool quantized)
+    {
+        if (quantized)
+            stream->WriteQuantizedFloat(Math::UnwindDegrees(value), -180.0f, 180.0f, EulerBits);
+        else
+            stream->Write(value);
+    }
+
+    FORCE_INLINE void ReadEuler(NetworkStream* stream, float& value, bool quantized)
+    {
+        if (quantized)
+            value = stream->ReadQuantizedFloat(-180.0f, 180.0f, EulerBits);
+        else
+            stream->Read(value);
+    }
 }
 
 NetworkTransform::NetworkTransform(const SpawnParams& params)
@@ -161,29 +238,34 @@ void NetworkTransform::Serialize(NetworkStream* stream)
     data.LocalSpace = LocalSpace;
     data.HasSequenceIndex = Mode == ReplicationModes::Prediction;
     data.Components = Components;
+    data.Quantized = PositionPrecision > 0.0f;
     stream->Write(data);
-    if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
+    const bool quantized = data.Quantized;
+    const float precision = quantized ? PositionPrecision : 0.0f;
+    if (quantized && EnumHasAnyFlags(data.Components, ReplicationComponents::Position))
+        stream->Write(precision); // Receiver decodes positions with the sender precision
+    if (EnumHasAllFlags(data.Components, ReplicationComponents::All) && !quantized)
     {
         stream->Write(transform);
     }
     else
     {
-        if (EnumHasAllFlags(data.Components, ReplicationComponents::Position))
+        if (EnumHasAllFlags(data.Components, ReplicationComponents::Position) && !quantized)
         {
             stream->Write(transform.Translation);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Position))
         {
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
-                stream->Write(transform.Translation.X);
+                WritePosition(stream, transform.Translation.X, precision);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
-                stream->Write(transform.Translation.Y);
+                WritePosition(stream, transform.Translation.Y, precision);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
-                stream->Write(transform.Translation.Z);
+                WritePosition(stream, transform.Translation.Z, precision);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Scale))
         {
-            stream->Write(transform.Scale);
+            WriteScale(stream, transform.Scale, quantized);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Scale))
         {
@@ -196,17 +278,17 @@ void NetworkTransform::Serialize(NetworkStream* stream)
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
         {
-            stream->Write(transform.Orientation);
+            WriteRotation(stream, transform.Orientation, quantized);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Rotation))
         {
             const Float3 rotation = transform.Orientation.GetEuler();
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationX))
-                stream->Write(rotation.X);
+                WriteEuler(stream, rotation.X, quantized);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationY))
-                stream->Write(rotation.Y);
+                WriteEuler(stream, rotation.Y, quantized);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationZ))
-                stream->Write(rotation.Z);
+                WriteEuler(stream, rotation.Z, quantized);
         }
     }
     if (data.HasSequenceIndex)
@@ -226,28 +308,32 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
     // Decode data
     Data data;
     stream->Read(data);
-    if (EnumHasAllFlags(data.Components, ReplicationComponents::All))
+    const bool quantized = data.Quantized;
+    float precision = 0.0f;
+    if (quantized && EnumHasAnyFlags(data.Components, ReplicationComponents::Position))
+        stream->Read(precision);
+    if (EnumHasAllFlags(data.Components, ReplicationComponents::All) && !quantized)
     {
         stream->Read(transform);
     }
     else
     {
-        if (EnumHasAllFlags(data.Components, ReplicationComponents::Position))
+        if (EnumHasAllFlags(data.Components, ReplicationComponents::Position) && !quantized)
         {
             stream->Read(transform.Translation);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Position))
         {
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionX))
-                stream->Read(transform.Translation.X);
+                ReadPosition(stream, transform.Translation.X, precision);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionY))
-                stream->Read(transform.Translation.Y);
+                ReadPosition(stream, transform.Translation.Y, precision);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::PositionZ))
-                stream->Read(transform.Translation.Z);
+                ReadPosition(stream, transform.Translation.Z, precision);
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Scale))
         {
-            stream->Read(transform.Scale);
+            ReadScale(stream, transform.Scale, quantized);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Scale))
         {
@@ -260,17 +346,17 @@ void NetworkTransform::Deserialize(NetworkStream* stream)
         }
         if (EnumHasAllFlags(data.Components, ReplicationComponents::Rotation))
         {
-            stream->Read(transform.Orientation);
+            ReadRotation(stream, transform.Orientation, quantized);
         }
         else if (EnumHasAnyFlags(data.Components, ReplicationComponents::Rotation))
         {
             Float3 rotation = transform.Orientation.GetEuler();
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationX))
-                stream->Read(rotation.X);
+                ReadEuler(stream, rotation.X, quantized);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationY))
-                stream->Read(rotation.Y);
+                ReadEuler(stream, rotation.Y, quantized);
             if (EnumHasAnyFlags(data.Components, ReplicationComponents::RotationZ))
-                stream->Read(rotation.Z);
+                ReadEuler(stream, rotation.Z, quantized);
             transform.Orientation = Quaternion::Euler(rotation);
         }
     }
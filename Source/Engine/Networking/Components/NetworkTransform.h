@@ -99,6 +99,12 @@ API_CLASS(Namespace="FlaxEngine.Networking", Attributes="Category(\"Flax Engine\
     API_FIELD(Attributes="EditorOrder(30)")
     ReplicationModes Mode = ReplicationModes::Default;
 
+    /// <summary>
+    /// Actor position replication precision (in world units). If above zero, transform is sent bit-packed to reduce network data size (position as fixed-point integers, rotation in a quantized form). Use 0 to replicate full-precision values.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0)")
+    float PositionPrecision = 0.0f;
+
 private:
     API_FUNCTION(Hidden, NetworkRpc=Server) void SetSequenceIndex(uint16 value);
     
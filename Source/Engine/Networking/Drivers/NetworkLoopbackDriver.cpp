@@ -0,0 +1,273 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "NetworkLoopbackDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Networking/NetworkPeer.h"
+#include "Engine/Networking/NetworkChannelType.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    CriticalSection ServersLocker;
+    Dictionary<uint16, NetworkLoopbackDriver*> Servers;
+}
+
+NetworkLoopbackDriver::NetworkLoopbackDriver(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+NetworkLoopbackDriver::~NetworkLoopbackDriver()
+{
+    Dispose();
+}
+
+String NetworkLoopbackDriver::DriverName()
+{
+    return String(TEXT("Loopback"));
+}
+
+bool NetworkLoopbackDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
+{
+    _networkHost = host;
+    _config = config;
+    return false;
+}
+
+void NetworkLoopbackDriver::Dispose()
+{
+    Disconnect();
+    {
+        ScopeLock lock(ServersLocker);
+        if (_isServer)
+        {
+            // Stop listening and disconnect all clients
+            NetworkLoopbackDriver* server;
+            if (Servers.TryGet(_config.Port, server) && server == this)
+                Servers.Remove(_config.Port);
+            const double now = Platform::GetTimeSeconds();
+            for (auto& e : _connections)
+            {
+                e.Value->_server = nullptr;
+                e.Value->Push(NetworkEventType::Disconnected, 0, now);
+            }
+            _connections.Clear();
+            _isServer = false;
+        }
+    }
+    ScopeLock lock(_locker);
+    _packets.Clear();
+    _packetsData.Clear();
+    _packetsStart = 0;
+}
+
+bool NetworkLoopbackDriver::Listen()
+{
+    ScopeLock lock(ServersLocker);
+    if (Servers.ContainsKey(_config.Port))
+    {
+        LOG(Error, "Port {0} is already used by other loopback network driver.", _config.Port);
+        return false;
+    }
+    Servers.Add(_config.Port, this);
+    _isServer = true;
+    return true;
+}
+
+bool NetworkLoopbackDriver::Connect()
+{
+    ScopeLock lock(ServersLocker);
+    NetworkLoopbackDriver* server;
+    if (_server || !Servers.TryGet(_config.Port, server))
+    {
+        LOG(Error, "Failed to connect to the loopback network driver at port {0}.", _config.Port);
+        return false;
+    }
+    if (server->_connections.Count() >= server->_config.ConnectionsLimit)
+        return false;
+    _server = server;
+    _connectionId = server->_nextConnectionId++;
+    _uplink = _downlink = Link();
+    server->_connections.Add(_connectionId, this);
+    const double now = Platform::GetTimeSeconds();
+    server->Push(NetworkEventType::Connected, _connectionId, now + Latency * 0.001);
+    Push(NetworkEventType::Connected, 0, now + server->Latency * 0.001);
+    return true;
+}
+
+void NetworkLoopbackDriver::Disconnect()
+{
+    ScopeLock lock(ServersLocker);
+    if (!_server)
+        return;
+    _server->_connections.Remove(_connectionId);
+    _server->Push(NetworkEventType::Disconnected, _connectionId, Platform::GetTimeSeconds() + Latency * 0.001);
+    _server = nullptr;
+}
+
+void NetworkLoopbackDriver::Disconnect(const NetworkConnection& connection)
+{
+    ScopeLock lock(ServersLocker);
+    NetworkLoopbackDriver* client;
+    if (!_connections.TryGet(connection.ConnectionId, client))
+        return;
+    _connections.Remove(connection.ConnectionId);
+    client->_server = nullptr;
+    const double now = Platform::GetTimeSeconds();
+    client->Push(NetworkEventType::Disconnected, 0, now + Latency * 0.001);
+    Push(NetworkEventType::Disconnected, connection.ConnectionId, now);
+}
+
+bool NetworkLoopbackDriver::PopEvent(NetworkEvent& eventPtr)
+{
+    ScopeLock lock(_locker);
+    if (_packetsStart == _packets.Count())
+        return false;
+    const Packet& packet = _packets.Get()[_packetsStart];
+    if (packet.DeliveryTime > Platform::GetTimeSeconds())
+        return false;
+
+    // Copy event data
+    eventPtr.EventType = packet.EventType;
+    eventPtr.Sender.ConnectionId = packet.ConnectionId;
+    if (packet.EventType == NetworkEventType::Message)
+    {
+        eventPtr.Message = _networkHost->CreateMessage();
+        eventPtr.Message.Length = packet.DataLength;
+        Platform::MemoryCopy(eventPtr.Message.Buffer, _packetsData.Get() + packet.DataStart, packet.DataLength);
+        _stats.TotalDataReceived += packet.DataLength;
+    }
+    else
+    {
+        eventPtr.Message = NetworkMessage();
+    }
+    _packetsStart++;
+
+    // Release the consumed packets
+    const int32 packetsLeft = _packets.Count() - _packetsStart;
+    if (packetsLeft == 0)
+    {
+        _packets.Clear();
+        _packetsData.Clear();
+        _packetsStart = 0;
+    }
+    else if (_packetsStart >= 256 && _packetsStart >= packetsLeft)
+    {
+        // Compact the queue if the consumed part is larger than the remaining one (memory regions don't overlap)
+        const uint32 dataStart = _packets.Get()[_packetsStart].DataStart;
+        const uint32 dataLeft = _packetsData.Count() - dataStart;
+        if (dataStart >= dataLeft)
+        {
+            Platform::MemoryCopy(_packets.Get(), _packets.Get() + _packetsStart, packetsLeft * sizeof(Packet));
+            Platform::MemoryCopy(_packetsData.Get(), _packetsData.Get() + dataStart, dataLeft);
+            _packets.Resize(packetsLeft);
+            _packetsData.Resize(dataLeft);
+            for (Packet& e : _packets)
+                e.DataStart -= dataStart;
+            _packetsStart = 0;
+        }
+    }
+    return true;
+}
+
+void NetworkLoopbackDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
+{
+    ASSERT(!_isServer);
+    ScopeLock lock(ServersLocker);
+    if (_server)
+        Send(_server, _connectionId, _uplink, channelType, message);
+}
+
+void NetworkLoopbackDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
+{
+    ASSERT(_isServer);
+    ScopeLock lock(ServersLocker);
+    NetworkLoopbackDriver* client;
+    if (_connections.TryGet(target.ConnectionId, client))
+        Send(client, 0, client->_downlink, channelType, message);
+}
+
+void NetworkLoopbackDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets)
+{
+    ASSERT(_isServer);
+    ScopeLock lock(ServersLocker);
+    NetworkLoopbackDriver* client;
+    for (const NetworkConnection& target : targets)
+    {
+        if (_connections.TryGet(target.ConnectionId, client))
+            Send(client, 0, client->_downlink, channelType, message);
+    }
+}
+
+NetworkDriverStats NetworkLoopbackDriver::GetStats()
+{
+    NetworkDriverStats stats = _stats;
+    stats.RTT = (_server ? _server->Latency : 0.0f) + Latency;
+    return stats;
+}
+
+NetworkDriverStats NetworkLoopbackDriver::GetStats(NetworkConnection target)
+{
+    NetworkDriverStats stats = _stats;
+    NetworkLoopbackDriver* client;
+    ScopeLock lock(ServersLocker);
+    stats.RTT = (_connections.TryGet(target.ConnectionId, client) ? client->Latency : 0.0f) + Latency;
+    return stats;
+}
+
+void NetworkLoopbackDriver::Send(NetworkLoopbackDriver* receiver, uint32 connectionId, Link& link, NetworkChannelType channelType, const NetworkMessage& message)
+{
+    _messagesSent++;
+    _stats.TotalDataSent += message.Length;
+    const bool reliable = channelType == NetworkChannelType::Reliable || channelType == NetworkChannelType::ReliableOrdered;
+    const double now = Platform::GetTimeSeconds();
+    double deliveryTime = now + Latency * 0.001;
+
+    // Simulate packet loss (deterministic random sequence)
+    if (!reliable && PacketLoss > 0.0f)
+    {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+        if ((float)(_random & 0xffffff) < PacketLoss * (float)0x1000000)
+        {
+            _messagesDropped++;
+            return;
+        }
+    }
+
+    // Simulate bandwidth limit (tokens are refilled over time with up to a second of burst, reliable messages go into debt and get delayed)
+    if (Bandwidth != 0)
+    {
+        link.Tokens = Math::Min(link.Tokens + (now - link.LastTime) * Bandwidth, (double)Bandwidth);
+        link.LastTime = now;
+        if (link.Tokens < message.Length)
+        {
+            if (!reliable)
+            {
+                _messagesDropped++;
+                return;
+            }
+            deliveryTime += (message.Length - link.Tokens) / Bandwidth;
+        }
+        link.Tokens -= message.Length;
+    }
+
+    receiver->Push(NetworkEventType::Message, connectionId, deliveryTime, message.Buffer, message.Length);
+}
+
+void NetworkLoopbackDriver::Push(NetworkEventType eventType, uint32 connectionId, double deliveryTime, const byte* data, uint32 length)
+{
+    // Copy message data as sender recycles its message after sending (queued packets can't hold messages from the receiver peer pool as it has a fixed size and isn't thread-safe, so PopEvent copies data again)
+    ScopeLock lock(_locker);
+    auto& packet = _packets.AddOne();
+    packet.DeliveryTime = deliveryTime;
+    packet.EventType = eventType;
+    packet.ConnectionId = connectionId;
+    packet.DataStart = _packetsData.Count();
+    packet.DataLength = length;
+    if (length != 0)
+        _packetsData.Add(data, length);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Networking/INetworkDriver.h"
+#include "Engine/Networking/NetworkConfig.h"
+#include "Engine/Networking/NetworkConnection.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Platform/CriticalSection.h"
+
+/// <summary>
+/// Low-level network transport interface implementation that connects peers within the same process via memory (without sockets). Supports packet loss, latency and bandwidth simulation. Can be used to test and benchmark networking without the actual network.
+/// </summary>
+/// <remarks>Clients connect to the server driver listening at the same port (address is ignored). Reliable messages are never lost. Message data is copied into the receiver queue on send and into the receiver peer message when popped.</remarks>
+API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API NetworkLoopbackDriver : public ScriptingObject, public INetworkDriver
+{
+    DECLARE_SCRIPTING_TYPE(NetworkLoopbackDriver);
+
+private:
+    struct Packet
+    {
+        double DeliveryTime;
+        NetworkEventType EventType;
+        uint32 ConnectionId;
+        uint32 DataStart;
+        uint32 DataLength;
+    };
+
+    struct Link
+    {
+        double LastTime = 0.0;
+        double Tokens = 0.0;
+    };
+
+    NetworkPeer* _networkHost = nullptr;
+    NetworkConfig _config;
+    bool _isServer = false;
+    CriticalSection _locker;
+    Array<Packet> _packets;
+    Array<byte> _packetsData;
+    int32 _packetsStart = 0;
+    uint32 _random = 0x9E3779B9;
+    NetworkDriverStats _stats;
+    uint32 _messagesSent = 0;
+    uint32 _messagesDropped = 0;
+
+    // Server
+    uint32 _nextConnectionId = 1;
+    Dictionary<uint32, NetworkLoopbackDriver*> _connections;
+
+    // Client
+    NetworkLoopbackDriver* _server = nullptr;
+    uint32 _connectionId = 0;
+    Link _uplink, _downlink;
+
+public:
+    ~NetworkLoopbackDriver();
+
+    /// <summary>
+    /// The one-way latency of the sent messages (in milliseconds).
+    /// </summary>
+    API_FIELD() float Latency = 0.0f;
+
+    /// <summary>
+    /// The probability of losing the sent unreliable message (in range 0-1).
+    /// </summary>
+    API_FIELD() float PacketLoss = 0.0f;
+
+    /// <summary>
+    /// The limit of the sent data per connection (in bytes per second). Unreliable messages over the limit are dropped, reliable messages are delayed. Use 0 to disable limit.
+    /// </summary>
+    API_FIELD() uint32 Bandwidth = 0;
+
+    /// <summary>
+    /// Gets the total amount of messages sent by this driver (per target connection, including dropped messages).
+    /// </summary>
+    API_PROPERTY() uint32 GetMessagesSent() const
+    {
+        return _messagesSent;
+    }
+
+    /// <summary>
+    /// Gets the total amount of messages dropped due to the packet loss or bandwidth limit.
+    /// </summary>
+    API_PROPERTY() uint32 GetMessagesDropped() const
+    {
+        return _messagesDropped;
+    }
+
+public:
+    // [INetworkDriver]
+    String DriverName() override;
+    bool Initialize(NetworkPeer* host, const NetworkConfig& config) override;
+    void Dispose() override;
+    bool Listen() override;
+    bool Connect() override;
+    void Disconnect() override;
+    void Disconnect(const NetworkConnection& connection) override;
+    bool PopEvent(NetworkEvent& eventPtr) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
+    NetworkDriverStats GetStats() override;
+    NetworkDriverStats GetStats(NetworkConnection target) override;
+
+private:
+    void Send(NetworkLoopbackDriver* receiver, uint32 connectionId, Link& link, NetworkChannelType channelType, const NetworkMessage& message);
+    void Push(NetworkEventType eventType, uint32 connectionId, double deliveryTime, const byte* data = nullptr, uint32 length = 0);
+};
@@ -3,12 +3,15 @@
 #pragma once
 
 #include "Types.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Types/DataContainer.h"
 #if COMPILE_WITH_PROFILER
 #include "Engine/Core/Collections/Dictionary.h"
 #endif
 
 // Internal version number of networking implementation. Updated once engine changes serialization or connection rules.
-#define NETWORK_PROTOCOL_VERSION 5
+#define NETWORK_PROTOCOL_VERSION 6
 
 // Enables encoding object ids and typenames via uint32 keys rather than full data send.
 #define USE_NETWORK_KEYS 1
@@ -16,6 +19,15 @@
 // Cached replication messages if contents didn't change
 #define USE_NETWORK_REPLICATOR_CACHE 1
 
+// Replicates objects from server to clients over unreliable channel with delta-encoding against the last state acknowledged by each client
+#define USE_NETWORK_REPLICATOR_DELTA 1
+
+// The amount of recent states kept per object for the replication delta-encoding
+#define NETWORK_REPLICATOR_DELTA_BASELINES 8
+
+// The amount of replicated objects serialized by a single job (batches are serialized in parallel via Job System)
+#define NETWORK_REPLICATOR_JOB_BATCH_SIZE 64
+
 enum class NetworkMessageIDs : uint8
 {
     None = 0,
@@ -30,13 +42,83 @@ enum class NetworkMessageIDs : uint8
     ObjectRole,
     ObjectRpc,
     ObjectRpcPart,
+    ObjectReplicateAck,
 
     MAX,
 };
 
+struct NetworkClientConnectionData;
+
+// Selection of the replicated objects sent to a single client within the data budget (see NetworkReplicationHierarchy::ClientBytesBudget).
+struct NetworkReplicationBudget
+{
+    struct Item
+    {
+        // The priority accumulated over the updates.
+        float Priority;
+        // The index of the replicated object.
+        int32 Index;
+        // The size of the object data to send (in bytes).
+        uint32 Size;
+        // True if object fits into the budget, otherwise it has to wait for the next update.
+        bool Send;
+    };
+
+    // Sorts items by the priority and picks the ones that fit into the budget (at least one item is sent to not block the big ones). Returns the amount of bytes to send.
+    static uint32 Apply(Array<Item>& items, uint32 budget);
+};
+
+#if USE_NETWORK_REPLICATOR_DELTA
+
+// History of the replicated object states used for the delta-encoding (recently sent or received states and the last state acknowledged by each client).
+struct NetworkReplicatorDeltaCache
+{
+    struct Baseline
+    {
+        uint32 Frame = 0;
+        BytesContainer Data;
+    };
+
+    struct Ack
+    {
+        uint32 ClientId;
+        uint32 Frame;
+    };
+
+    // Ring buffer with the recently sent (or received) object states.
+    Baseline Baselines[NETWORK_REPLICATOR_DELTA_BASELINES];
+    int32 Latest = 0;
+    // The last state acknowledged by each client (indexed by client index, validated with client id).
+    Array<Ack> Acks;
+
+    const Baseline& GetLatest() const
+    {
+        return Baselines[Latest];
+    }
+
+    // Finds the state with the given frame. Returns null if it's not in the history (eg. state is too old).
+    const Baseline* Find(uint32 frame) const;
+    void Add(uint32 frame, const byte* data, uint32 size);
+    uint32 GetAck(int32 clientIndex, uint32 clientId) const;
+    void SetAck(int32 clientIndex, uint32 clientId, uint32 frame);
+    // Gets the frame of the state to delta-encode against for the given client. Returns 0 if client has no acknowledged state in the history (full state has to be sent).
+    uint32 GetBaseline(int32 clientIndex, uint32 clientId) const;
+
+    // Encodes the object state as a delta against the baseline state: size followed by the runs of unchanged bytes count, changed bytes count and changed bytes (XOR-ed with the baseline).
+    static void Encode(Array<byte>& output, const byte* data, uint32 size, const byte* baseline, uint32 baselineSize);
+    // Decodes the object state from a delta against the baseline state. Returns true if failed.
+    static bool Decode(Array<byte>& output, const byte* delta, uint32 deltaSize, const byte* baseline, uint32 baselineSize);
+};
+
+#endif
+
 class NetworkInternal
 {
 public:
+    // Sends the connection handshake message from client to server.
+    static void SendHandshake(NetworkPeer* peer, const NetworkClientConnectionData& connectionData);
+    // Updates the network manager (processes incoming messages and replication). Can be used to tick networking manually (eg. in tests that block the engine loop).
+    static void NetworkManagerUpdate();
     static void NetworkReplicatorClientConnected(NetworkClient* client);
     static void NetworkReplicatorClientDisconnected(NetworkClient* client);
     static void NetworkReplicatorClear();
@@ -50,6 +132,13 @@ class NetworkInternal
     static void OnNetworkMessageObjectRole(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRpcPart(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+#if USE_NETWORK_REPLICATOR_DELTA
+    // Sends the acknowledgements of the received objects states (pairs of object id and frame) in batched messages. Clears the list.
+    static void SendReplicationAcks(NetworkPeer* peer, Array<Pair<Guid, uint32>>& acks);
+    // Reads the id and frame of the object state received in the replication message that has to be acknowledged. Returns true if message doesn't need an acknowledgement.
+    static bool ReadReplicationAck(NetworkMessage& message, Guid& objectId, uint32& frame);
+#endif
 
 #if COMPILE_WITH_PROFILER
 
@@ -392,6 +392,7 @@ namespace
         NetworkInternal::OnNetworkMessageObjectRole,
         NetworkInternal::OnNetworkMessageObjectRpc,
         NetworkInternal::OnNetworkMessageObjectRpcPart,
+        NetworkInternal::OnNetworkMessageObjectReplicateAck,
     };
 }
 
@@ -414,6 +415,26 @@ class NetworkManagerService : public EngineService
 
 NetworkManagerService NetworkManagerServiceInstance;
 
+void NetworkInternal::SendHandshake(NetworkPeer* peer, const NetworkClientConnectionData& connectionData)
+{
+    NetworkMessageHandshake msgData;
+    msgData.EngineBuild = FLAXENGINE_VERSION_BUILD;
+    msgData.EngineProtocolVersion = NETWORK_PROTOCOL_VERSION;
+    msgData.GameProtocolVersion = GameProtocolVersion;
+    msgData.Platform = (byte)connectionData.Platform;
+    msgData.Architecture = (byte)connectionData.Architecture;
+    msgData.PayloadDataSize = (uint16)connectionData.PayloadData.Count();
+    NetworkMessage msg = peer->BeginSendMessage();
+    msg.WriteStructure(msgData);
+    msg.WriteBytes(connectionData.PayloadData.Get(), connectionData.PayloadData.Count());
+    peer->EndSendMessage(NetworkChannelType::ReliableOrdered, msg);
+}
+
+void NetworkInternal::NetworkManagerUpdate()
+{
+    NetworkManagerServiceInstance.Update();
+}
+
 bool StartPeer()
 {
     PROFILE_CPU();
@@ -759,17 +780,7 @@ void NetworkManagerService::Update()
                 }
 
                 // Send initial handshake message from client to server
-                NetworkMessageHandshake msgData;
-                msgData.EngineBuild = FLAXENGINE_VERSION_BUILD;
-                msgData.EngineProtocolVersion = NETWORK_PROTOCOL_VERSION;
-                msgData.GameProtocolVersion = GameProtocolVersion;
-                msgData.Platform = (byte)connectionData.Platform;
-                msgData.Architecture = (byte)connectionData.Architecture;
-                msgData.PayloadDataSize = (uint16)connectionData.PayloadData.Count();
-                NetworkMessage msg = peer->BeginSendMessage();
-                msg.WriteStructure(msgData);
-                msg.WriteBytes(connectionData.PayloadData.Get(), connectionData.PayloadData.Count());
-                peer->EndSendMessage(NetworkChannelType::ReliableOrdered, msg);
+                NetworkInternal::SendHandshake(peer, connectionData);
             }
             else
             {
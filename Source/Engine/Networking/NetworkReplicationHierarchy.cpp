@@ -25,7 +25,11 @@ void NetworkReplicationHierarchyUpdateResult::Init()
     _clients.Resize(NetworkManager::Clients.Count());
     _clientsMask = NetworkManager::Mode == NetworkManagerMode::Client ? NetworkClientsMask::All : NetworkClientsMask();
     for (int32 i = 0; i < _clients.Count(); i++)
+    {
         _clientsMask.SetBit(i);
+        _clients[i].HasLocation = false;
+        _clients[i].HasDirection = false;
+    }
     _entries.Clear();
     ReplicationScale = 1.0f;
 }
@@ -47,6 +51,22 @@ bool NetworkReplicationHierarchyUpdateResult::GetClientLocation(int32 clientInde
     return client.HasLocation;
 }
 
+void NetworkReplicationHierarchyUpdateResult::SetClientDirection(int32 clientIndex, const Float3& direction)
+{
+    CHECK(clientIndex >= 0 && clientIndex < _clients.Count());
+    Client& client = _clients[clientIndex];
+    client.HasDirection = true;
+    client.Direction = direction;
+}
+
+bool NetworkReplicationHierarchyUpdateResult::GetClientDirection(int32 clientIndex, Float3& direction) const
+{
+    CHECK_RETURN(clientIndex >= 0 && clientIndex < _clients.Count(), false);
+    const Client& client = _clients[clientIndex];
+    direction = client.Direction;
+    return client.HasDirection;
+}
+
 void NetworkReplicationNode::AddObject(NetworkReplicationHierarchyObject obj)
 {
     if (obj.ReplicationFPS > ZeroTolerance) // > 0
@@ -117,14 +137,14 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             {
                 // Marked as dirty to sync manually
                 obj.ReplicationUpdatesLeft = 0;
-                result->AddObject(obj.Object);
+                result->AddObject(obj.Object, NetworkClientsMask::All, obj.Importance);
             }
             continue;
         }
         else if (obj.ReplicationFPS < ZeroTolerance) // == 0
         {
             // Always relevant
-            result->AddObject(obj.Object);
+            result->AddObject(obj.Object, NetworkClientsMask::All, obj.Importance);
         }
         else if (obj.ReplicationUpdatesLeft > 0)
         {
@@ -160,7 +180,7 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             if (targetClients && obj.Object)
             {
                 // Replicate this frame
-                result->AddObject(obj.Object, targetClients);
+                result->AddObject(obj.Object, targetClients, obj.Importance);
             }
 
             // Calculate frames until next replication
@@ -278,3 +298,28 @@ void NetworkReplicationGridNode::Update(NetworkReplicationHierarchyUpdateResult*
         }
     }
 }
+
+float NetworkReplicationHierarchy::GetPriority(NetworkReplicationHierarchyUpdateResult* result, int32 clientIndex, ScriptingObject* obj, float importance)
+{
+    CHECK_RETURN(result && clientIndex >= 0 && clientIndex < result->_clients.Count(), importance);
+    const auto& client = result->_clients[clientIndex];
+    const Actor* actor = client.HasLocation ? NetworkReplicationHierarchyObject(obj).GetActor() : nullptr;
+    if (!actor)
+        return importance;
+    const Vector3 toObject = actor->GetPosition() - client.Location;
+    const Real distance = toObject.Length();
+    float priority = importance;
+
+    // Closer objects are more important
+    if (PriorityDistance > ZeroTolerance)
+        priority /= 1.0f + (float)distance / PriorityDistance;
+
+    // Objects behind the viewer are less important (but still get replicated)
+    if (client.HasDirection && distance > ZeroTolerance)
+    {
+        const float dot = Float3::Dot(Float3(toObject / distance), client.Direction);
+        priority *= 0.25f + 0.75f * Math::Saturate(dot * 0.5f + 0.5f);
+    }
+
+    return priority;
+}
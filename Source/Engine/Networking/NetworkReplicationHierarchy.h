@@ -24,6 +24,8 @@ API_STRUCT(NoDefault, Namespace="FlaxEngine.Networking") struct FLAXENGINE_API N
     API_FIELD() float ReplicationFPS = 60;
     // The minimum distance from the player to the object at which it can process replication. For example, players further away won't receive object data. Use 0 if unused.
     API_FIELD() float CullDistance = 15000;
+    // The object importance used to prioritize replication when data sent to the client is limited (see NetworkReplicationHierarchy::ClientBytesBudget). Objects with higher importance are sent more often than the others.
+    API_FIELD() float Importance = 1.0f;
     // Runtime value for update frames left for the next replication of this object. Matches NetworkManager::NetworkFPS calculated from ReplicationFPS. Set to 1 if ReplicationFPS less than 0 to indicate dirty object.
     API_FIELD(Attributes="HideInEditor") uint16 ReplicationUpdatesLeft = 0;
 
@@ -144,18 +146,22 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplica
     friend class NetworkInternal;
     friend class NetworkReplicationNode;
     friend class NetworkReplicationGridNode;
+    friend class NetworkReplicationHierarchy;
 
 private:
     struct Client
     {
         bool HasLocation;
+        bool HasDirection;
         Vector3 Location;
+        Float3 Direction;
     };
 
     struct Entry
     {
         ScriptingObject* Object;
         NetworkClientsMask TargetClients;
+        float Importance;
     };
 
     bool _clientsHaveLocation;
@@ -175,6 +181,7 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplica
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = NetworkClientsMask::All;
+        e.Importance = 1.0f;
     }
 
     // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client). Mask matches NetworkManager::Clients.
@@ -183,6 +190,16 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplica
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = targetClients;
+        e.Importance = 1.0f;
+    }
+
+    // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client) and the object importance used to prioritize replication when data sent to the client is limited. Mask matches NetworkManager::Clients.
+    API_FUNCTION() void AddObject(ScriptingObject* obj, NetworkClientsMask targetClients, float importance)
+    {
+        Entry& e = _entries.AddOne();
+        e.Object = obj;
+        e.TargetClients = targetClients;
+        e.Importance = importance;
     }
 
     // Gets amount of the clients to use. Matches NetworkManager::Clients.
@@ -202,6 +219,12 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplica
 
     // Gets the viewer location for a certain client. Client index must match NetworkManager::Clients. Returns true if got a location set, otherwise false.
     API_FUNCTION() bool GetClientLocation(int32 clientIndex, API_PARAM(out) Vector3& location) const;
+
+    // Sets the viewer direction for a certain client (normalized). Client index must match NetworkManager::Clients. Used to prioritize replication of the objects in front of the viewer.
+    API_FUNCTION() void SetClientDirection(int32 clientIndex, const Float3& direction);
+
+    // Gets the viewer direction for a certain client. Client index must match NetworkManager::Clients. Returns true if got a direction set, otherwise false.
+    API_FUNCTION() bool GetClientDirection(int32 clientIndex, API_PARAM(out) Float3& direction) const;
 };
 
 /// <summary>
@@ -305,4 +328,24 @@ API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplica
 API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkReplicationHierarchy : public NetworkReplicationNode
 {
     DECLARE_SCRIPTING_TYPE_WITH_CONSTRUCTOR_IMPL(NetworkReplicationHierarchy, NetworkReplicationNode);
+
+    /// <summary>
+    /// The limit of the replicated objects data sent to a single client per update (in bytes). Objects are sent in the order of the priority (accumulated over time from the distance, view direction and object importance) and the ones that didn't fit keep gaining priority until they get sent. Use 0 to disable limit.
+    /// </summary>
+    API_FIELD() int32 ClientBytesBudget = 0;
+
+    /// <summary>
+    /// The distance from the client location at which the object replication priority is halved (in world units).
+    /// </summary>
+    API_FIELD() float PriorityDistance = 5000.0f;
+
+    /// <summary>
+    /// Calculates the object replication priority for a certain client (gained per update). Used to order objects sent to the client when ClientBytesBudget is used.
+    /// </summary>
+    /// <param name="result">The update results container.</param>
+    /// <param name="clientIndex">The client index. Matches NetworkManager::Clients.</param>
+    /// <param name="obj">The object to replicate.</param>
+    /// <param name="importance">The object importance.</param>
+    /// <returns>The priority value.</returns>
+    API_FUNCTION() virtual float GetPriority(NetworkReplicationHierarchyUpdateResult* result, int32 clientIndex, ScriptingObject* obj, float importance);
 };
@@ -16,8 +16,10 @@
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Types/DataContainer.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ReadWriteLock.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Level/SceneObject.h"
@@ -28,12 +30,15 @@
 #include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ThreadLocal.h"
 #if USE_EDITOR
 #include "FlaxEngine.Gen.h"
 #endif
 
+bool NetworkReplicator::EnableParallelSerialization = false;
+
 #if !BUILD_RELEASE
 bool NetworkReplicator::EnableLog = false;
 #include "Engine/Core/Log.h"
@@ -53,6 +58,15 @@ PACK_STRUCT(struct NetworkMessageObjectReplicate
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicate;
     uint32 OwnerFrame;
+    uint32 BaselineFrame; // Frame of the state that payload is delta-encoded against (if UseDelta is set)
+    uint8 UseDelta : 1; // True if payload is delta-encoded against the baseline state
+    uint8 UseAck : 1; // True if receiver should acknowledge the received state (sender uses it as a baseline for the delta-encoding)
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectReplicateAck
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicateAck;
+    uint16 ItemsCount; // Followed by pairs of object id and acknowledged frame
     });
 
 PACK_STRUCT(struct NetworkMessageObjectPartPayload
@@ -128,6 +142,38 @@ struct NetworkReplicatedObject
         }
     } RepCache;
 
+#if USE_NETWORK_REPLICATOR_DELTA
+    NetworkReplicatorDeltaCache DeltaCache;
+#endif
+
+    struct
+    {
+        struct Client
+        {
+            uint32 ClientId;
+            float Priority;
+        };
+
+        // The replication priority accumulated for each client until the object gets sent (indexed by client index, validated with client id).
+        Array<Client> Clients;
+        // The clients that didn't receive the object state due to the bytes budget (object gets replicated to them in the next update).
+        NetworkClientsMask Starved;
+        float Importance = 1.0f;
+
+        float& Get(int32 clientIndex, uint32 clientId)
+        {
+            while (Clients.Count() <= clientIndex)
+                Clients.Add({ NetworkManager::ServerClientId, 0.0f });
+            Client& client = Clients[clientIndex];
+            if (client.ClientId != clientId)
+            {
+                client.ClientId = clientId;
+                client.Priority = 0.0f;
+            }
+            return client.Priority;
+        }
+    } Priority;
+
     ScriptingObjectReference<ScriptingObject> Object;
     Guid ObjectId;
     Guid ParentId;
@@ -187,6 +233,23 @@ struct Serializer
     void* Tags[2];
 };
 
+struct ReplicationEntry
+{
+    NetworkReplicatedObject* Item;
+    ScriptingObject* Object;
+    NetworkClientsMask TargetClients;
+    float Importance;
+    Serializer Methods;
+    uint32 Offset;
+    uint32 Size;
+    bool Failed;
+    bool Changed;
+#if USE_NETWORK_REPLICATOR_DELTA
+    uint32 DeltaBaselineFrame; // Baseline frame of the cached DeltaSize (0 if not evaluated)
+    uint32 DeltaSize;
+#endif
+};
+
 struct PartsItem
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -195,6 +258,7 @@ struct PartsItem
     uint32 OwnerFrame;
     uint32 OwnerClientId;
     const void* Tag;
+    bool UseAck = false;
     Array<byte> Data;
 };
 
@@ -249,14 +313,24 @@ namespace
     NetworkStream* CachedWriteStream = nullptr;
     NetworkStream* CachedReadStream = nullptr;
     NetworkReplicationHierarchyUpdateResult* CachedReplicationResult = nullptr;
+    Array<ReplicationEntry> CachedReplicationEntries;
+    Array<NetworkStream*> CachedReplicationStreams;
+    Array<NetworkReplicationBudget::Item> CachedReplicationPriorities;
+    Array<Guid> StarvedReplication;
     NetworkReplicationHierarchy* Hierarchy = nullptr;
     Array<NetworkClient*> NewClients;
     Array<NetworkConnection> CachedTargets;
     Dictionary<ScriptingTypeHandle, Serializer> SerializersTable;
+    ReadWriteLock SerializersLock; // Serializers are resolved from jobs when serializing objects in parallel (eg. nested types or base types)
 #if !COMPILE_WITHOUT_CSHARP
     Dictionary<StringAnsiView, StringAnsi*> CSharpCachedNames;
 #endif
     Array<Guid> DespawnedObjects;
+#if USE_NETWORK_REPLICATOR_DELTA
+    Array<Pair<Guid, uint32>> ReplicationAcks;
+    Array<byte> CachedDeltaBuffer;
+    Array<Pair<uint32, Array<NetworkConnection>>> CachedDeltaTargets;
+#endif
     uint32 SpawnId = 0;
     uint32 RpcId = 0;
 
@@ -274,10 +348,13 @@ namespace
 
         // Clear any references to non-engine scripts before code hot-reload
         BinaryModule* flaxModule = GetBinaryModuleFlaxEngine();
-        for (auto i = SerializersTable.Begin(); i.IsNotEnd(); ++i)
         {
-            if (i->Key.Module != flaxModule)
-                SerializersTable.Remove(i);
+            ScopeWriteLock serializersLock(SerializersLock);
+            for (auto i = SerializersTable.Begin(); i.IsNotEnd(); ++i)
+            {
+                if (i->Key.Module != flaxModule)
+                    SerializersTable.Remove(i);
+            }
         }
         for (auto i = NetworkRpcInfo::RPCsTable.Begin(); i.IsNotEnd(); ++i)
         {
@@ -696,41 +773,434 @@ void SendDespawn(DespawnItem& e)
         peer->EndSendMessage(NetworkChannelType::ReliableOrdered, msg, CachedTargets);
 }
 
-void SendReplication(ScriptingObject* obj, NetworkClientsMask targetClients)
+#if USE_NETWORK_REPLICATOR_DELTA
+
+FORCE_INLINE void WriteDeltaVarInt(Array<byte>& output, uint32 value)
 {
-    auto it = Objects.Find(obj->GetID());
-    if (it.IsEnd())
-        return;
-    auto& item = it->Item;
-    const bool isClient = NetworkManager::IsClient();
-    const NetworkClientsMask fullTargetClients = targetClients;
+    while (value >= 0x80)
+    {
+        output.Add((byte)(value | 0x80));
+        value >>= 7;
+    }
+    output.Add((byte)value);
+}
 
-    // If server has no recipients, skip early.
-    if (!isClient && !targetClients)
-        return;
+FORCE_INLINE bool ReadDeltaVarInt(const byte*& data, const byte* end, uint32& value)
+{
+    value = 0;
+    for (int32 shift = 0; shift < 32 && data < end; shift += 7)
+    {
+        const byte b = *data++;
+        value |= (uint32)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            return false;
+    }
+    return true;
+}
 
-    if (item.AsNetworkObject)
-        item.AsNetworkObject->OnNetworkSerialize();
+const NetworkReplicatorDeltaCache::Baseline* NetworkReplicatorDeltaCache::Find(uint32 frame) const
+{
+    if (frame != 0)
+    {
+        for (const Baseline& e : Baselines)
+        {
+            if (e.Frame == frame)
+                return &e;
+        }
+    }
+    return nullptr;
+}
+
+void NetworkReplicatorDeltaCache::Add(uint32 frame, const byte* data, uint32 size)
+{
+    Latest = (Latest + 1) % NETWORK_REPLICATOR_DELTA_BASELINES;
+    Baseline& e = Baselines[Latest];
+    e.Frame = frame;
+    if (size != 0)
+        e.Data.Copy(data, (int32)size);
+    else
+        e.Data.Release();
+}
+
+uint32 NetworkReplicatorDeltaCache::GetAck(int32 clientIndex, uint32 clientId) const
+{
+    if (clientIndex < Acks.Count() && Acks.Get()[clientIndex].ClientId == clientId)
+        return Acks.Get()[clientIndex].Frame;
+    return 0;
+}
+
+void NetworkReplicatorDeltaCache::SetAck(int32 clientIndex, uint32 clientId, uint32 frame)
+{
+    while (Acks.Count() <= clientIndex)
+        Acks.Add({ NetworkManager::ServerClientId, 0 });
+    Ack& ack = Acks[clientIndex];
+    if (ack.ClientId != clientId || frame > ack.Frame)
+    {
+        ack.ClientId = clientId;
+        ack.Frame = frame;
+    }
+}
+
+uint32 NetworkReplicatorDeltaCache::GetBaseline(int32 clientIndex, uint32 clientId) const
+{
+    const uint32 frame = GetAck(clientIndex, clientId);
+    return Find(frame) ? frame : 0;
+}
+
+void NetworkReplicatorDeltaCache::Encode(Array<byte>& output, const byte* data, uint32 size, const byte* baseline, uint32 baselineSize)
+{
+    output.Clear();
+    WriteDeltaVarInt(output, size);
+    uint32 pos = 0;
+    while (pos < size)
+    {
+        // Unchanged bytes
+        const uint32 skipStart = pos;
+        while (pos < size && pos < baselineSize && data[pos] == baseline[pos])
+            pos++;
+        const uint32 skip = pos - skipStart;
+
+        // Changed bytes (short runs of unchanged bytes in between are included to reduce the overhead)
+        const uint32 start = pos;
+        while (pos < size)
+        {
+            if (pos < baselineSize && data[pos] == baseline[pos])
+            {
+                uint32 run = pos;
+                while (run < size && run < baselineSize && data[run] == baseline[run] && run - pos < 3)
+                    run++;
+                if (run - pos >= 3 || run == size)
+                    break;
+                pos = run;
+            }
+            else
+                pos++;
+        }
+        WriteDeltaVarInt(output, skip);
+        WriteDeltaVarInt(output, pos - start);
+        for (uint32 i = start; i < pos; i++)
+            output.Add(i < baselineSize ? data[i] ^ baseline[i] : data[i]);
+    }
+}
+
+bool NetworkReplicatorDeltaCache::Decode(Array<byte>& output, const byte* delta, uint32 deltaSize, const byte* baseline, uint32 baselineSize)
+{
+    const byte* end = delta + deltaSize;
+    uint32 size;
+    if (ReadDeltaVarInt(delta, end, size) || size > MAX_uint16)
+        return true;
+    output.Resize(size, false);
+    uint32 pos = 0;
+    while (pos < size)
+    {
+        uint32 skip, count;
+        if (ReadDeltaVarInt(delta, end, skip) || ReadDeltaVarInt(delta, end, count))
+            return true;
+        if (skip + count == 0 || pos + skip + count > size || pos + skip > baselineSize || (uint32)(end - delta) < count)
+            return true;
+        Platform::MemoryCopy(output.Get() + pos, baseline + pos, skip);
+        pos += skip;
+        for (uint32 i = 0; i < count; i++, pos++)
+            output.Get()[pos] = pos < baselineSize ? *delta++ ^ baseline[pos] : *delta++;
+    }
+    return false;
+}
+
+void SendReplicationDelta(NetworkReplicatedObject& item, ScriptingObject* obj, const byte* data, uint32 size, NetworkClientsMask targetClients, bool changed)
+{
+    auto& cache = item.DeltaCache;
+
+    // Store the new object state (unless it didn't change)
+    if (changed)
+        cache.Add(NetworkManager::Frame, data, size);
+    const uint32 frame = cache.GetLatest().Frame;
+
+    // Group target clients by the last acknowledged state (clients that already have the latest state are skipped)
+    for (auto& e : CachedDeltaTargets)
+        e.Second.Clear();
+    int32 groupsCount = 0;
+    const auto& clients = NetworkManager::Clients;
+    for (int32 clientIndex = 0; clientIndex < clients.Count(); clientIndex++)
+    {
+        const NetworkClient* client = clients.Get()[clientIndex];
+        if (client->State != NetworkConnectionState::Connected || client->ClientId == item.OwnerClientId || !targetClients.HasBit(clientIndex))
+            continue;
+        if (item.TargetClientIds.IsValid() && !SpanContains<uint32>(item.TargetClientIds, client->ClientId))
+            continue;
+        if (cache.GetAck(clientIndex, client->ClientId) == frame)
+            continue;
+        const uint32 baselineFrame = cache.GetBaseline(clientIndex, client->ClientId); // Send full state if acknowledged state is too old
+        int32 groupIndex = 0;
+        while (groupIndex < groupsCount && CachedDeltaTargets[groupIndex].First != baselineFrame)
+            groupIndex++;
+        if (groupIndex == groupsCount)
+        {
+            if (groupsCount == CachedDeltaTargets.Count())
+                CachedDeltaTargets.AddOne();
+            CachedDeltaTargets[groupsCount++].First = baselineFrame;
+        }
+        CachedDeltaTargets[groupIndex].Second.Add(client->Connection);
+    }
+
+    // Send object state to each group of clients
+    Guid objectId = item.ObjectId, parentId = item.ParentId;
+    {
+        // Remap local client object ids into server ids
+        IdsRemappingTable.KeyOf(objectId, &objectId);
+        IdsRemappingTable.KeyOf(parentId, &parentId);
+    }
+    NetworkPeer* peer = NetworkManager::Peer;
+    const NetworkRpcName name(obj->GetTypeHandle(), StringAnsiView::Empty);
+    for (int32 groupIndex = 0; groupIndex < groupsCount; groupIndex++)
+    {
+        auto& group = CachedDeltaTargets[groupIndex];
+        NetworkMessageObjectReplicate msgData;
+        msgData.OwnerFrame = frame;
+        msgData.BaselineFrame = group.First;
+        msgData.UseDelta = 0;
+        msgData.UseAck = 1;
+        NetworkMessage msg = peer->BeginSendMessage();
+        auto* msgHeader = (NetworkMessageObjectReplicate*)(msg.Buffer + msg.Position);
+        msg.WriteStructure(msgData);
+        msg.WriteNetworkId(objectId);
+        msg.WriteNetworkId(parentId);
+        msg.WriteNetworkName(obj->GetType().Fullname);
+        const uint32 msgMaxData = peer->Config.MessageSize - msg.Position - sizeof(NetworkMessageObjectPartPayload);
+        const byte* payload = data;
+        uint32 payloadSize = size;
+        if (const auto* baseline = cache.Find(group.First))
+        {
+            NetworkReplicatorDeltaCache::Encode(CachedDeltaBuffer, data, size, baseline->Data.Get(), baseline->Data.Length());
+            if ((uint32)CachedDeltaBuffer.Count() < size && (uint32)CachedDeltaBuffer.Count() <= msgMaxData)
+            {
+                payload = CachedDeltaBuffer.Get();
+                payloadSize = CachedDeltaBuffer.Count();
+                msgHeader->UseDelta = 1;
+            }
+        }
 
-    // Serialize object
-    NetworkStream* stream = CachedWriteStream;
+        // Use unreliable channel if state fits into a single message (lost states get resent against the last acknowledged state), otherwise send full state in parts
+        const NetworkChannelType channel = payloadSize <= msgMaxData ? NetworkChannelType::Unreliable : NetworkChannelType::Reliable;
+        CachedTargets.Clear();
+        CachedTargets.Add(group.Second);
+        SendInParts(peer, channel, payload, payloadSize, msg, name, false, objectId, frame, NetworkMessageIDs::ObjectReplicatePart);
+    }
+}
+
+void NetworkInternal::SendReplicationAcks(NetworkPeer* peer, Array<Pair<Guid, uint32>>& acks)
+{
+    constexpr uint32 ackMaxSize = sizeof(uint32) + sizeof(Guid) + sizeof(uint32); // Network Key worst-case size + frame
+    const int32 msgMaxItems = Math::Min<int32>((peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicateAck)) / ackMaxSize, MAX_uint16);
+    for (int32 start = 0; start < acks.Count();)
+    {
+        NetworkMessageObjectReplicateAck msgData;
+        msgData.ItemsCount = (uint16)Math::Min(acks.Count() - start, msgMaxItems);
+        NetworkMessage msg = peer->BeginSendMessage();
+        msg.WriteStructure(msgData);
+        for (int32 i = 0; i < msgData.ItemsCount; i++)
+        {
+            const auto& e = acks.Get()[start + i];
+            Guid objectId = e.First;
+            IdsRemappingTable.KeyOf(objectId, &objectId);
+            msg.WriteNetworkId(objectId);
+            msg.WriteUInt32(e.Second);
+        }
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+        start += msgData.ItemsCount;
+    }
+    acks.Clear();
+}
+
+bool NetworkInternal::ReadReplicationAck(NetworkMessage& message, Guid& objectId, uint32& frame)
+{
+    if (*message.Buffer != (uint8)NetworkMessageIDs::ObjectReplicate)
+        return true;
+    NetworkMessageObjectReplicate msgData;
+    message.ReadStructure(msgData);
+    message.ReadNetworkId(objectId);
+    frame = msgData.OwnerFrame;
+    return !msgData.UseAck;
+}
+
+#endif
+
+bool HasReplicationChanged(const NetworkReplicatedObject& item, const byte* data, uint32 size, bool isClient)
+{
+#if USE_NETWORK_REPLICATOR_DELTA
+    if (!isClient)
+    {
+        const auto& latest = item.DeltaCache.GetLatest();
+        return latest.Frame == 0 || latest.Data.Length() != (int32)size || Platform::MemoryCompare(latest.Data.Get(), data, size) != 0;
+    }
+#endif
+#if USE_NETWORK_REPLICATOR_CACHE
+    return item.RepCache.Data.Length() != (int32)size || Platform::MemoryCompare(item.RepCache.Data.Get(), data, size) != 0;
+#else
+    return true;
+#endif
+}
+
+void SerializeReplication(int32 batchIndex)
+{
+    PROFILE_CPU();
+    const bool isClient = NetworkManager::IsClient();
+
+    // Serialize objects from a batch into a single stream (each batch uses own stream)
+    NetworkStream* stream = CachedReplicationStreams[batchIndex];
     stream->Initialize();
-    const bool failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
-    if (failed)
+    stream->SenderId = NetworkManager::LocalClientId;
+    const int32 start = batchIndex * NETWORK_REPLICATOR_JOB_BATCH_SIZE;
+    const int32 end = Math::Min(start + NETWORK_REPLICATOR_JOB_BATCH_SIZE, CachedReplicationEntries.Count());
+    for (int32 i = start; i < end; i++)
+    {
+        auto& e = CachedReplicationEntries.Get()[i];
+        e.Offset = stream->GetPosition();
+        e.Methods.Methods[0](e.Object, stream, e.Methods.Tags[0]);
+        stream->FlushBits();
+        e.Size = stream->GetPosition() - e.Offset;
+        e.Failed = e.Size > MAX_uint16;
+        if (e.Failed)
+        {
+            LOG(Error, "Too much data for object {} replication ({} bytes provided while limit is {}).", e.Item->ToString(), e.Size, MAX_uint16);
+            continue;
+        }
+
+        // Compare against the previous state to skip sending unchanged data
+        e.Changed = HasReplicationChanged(*e.Item, stream->GetBuffer() + e.Offset, e.Size, isClient);
+    }
+}
+
+bool SortByPriorityDescending(const NetworkReplicationBudget::Item& a, const NetworkReplicationBudget::Item& b)
+{
+    return a.Priority > b.Priority;
+}
+
+uint32 NetworkReplicationBudget::Apply(Array<Item>& items, uint32 budget)
+{
+    Sorting::QuickSort(items.Get(), items.Count(), &SortByPriorityDescending);
+    uint32 bytes = 0;
+    for (Item& e : items)
     {
-        //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
-        return;
+        e.Send = bytes == 0 || bytes + e.Size <= budget;
+        if (e.Send)
+            bytes += e.Size;
     }
-    const uint32 size = stream->GetPosition();
-    if (size > MAX_uint16)
+    return bytes;
+}
+
+#if USE_NETWORK_REPLICATOR_DELTA
+
+// Gets the size of the object state that will be sent to the client (delta against its last acknowledged state or the full state, see SendReplicationDelta)
+uint32 GetReplicationDeltaSize(ReplicationEntry& e, int32 entryIndex, int32 clientIndex, uint32 clientId)
+{
+    const auto& cache = e.Item->DeltaCache;
+    const uint32 baselineFrame = cache.GetBaseline(clientIndex, clientId);
+    if (baselineFrame == 0)
+        return e.Size;
+    if (e.Changed && cache.Baselines[(cache.Latest + 1) % NETWORK_REPLICATOR_DELTA_BASELINES].Frame == baselineFrame)
+        return e.Size; // Baseline gets overridden by the new state before sending
+    if (e.DeltaBaselineFrame != baselineFrame)
+    {
+        // Clients with the same baseline reuse the encoded size
+        const auto* baseline = cache.Find(baselineFrame);
+        const byte* data = CachedReplicationStreams[entryIndex / NETWORK_REPLICATOR_JOB_BATCH_SIZE]->GetBuffer() + e.Offset;
+        NetworkReplicatorDeltaCache::Encode(CachedDeltaBuffer, data, e.Size, baseline->Data.Get(), baseline->Data.Length());
+        e.DeltaBaselineFrame = baselineFrame;
+        e.DeltaSize = Math::Min((uint32)CachedDeltaBuffer.Count(), e.Size);
+    }
+    return e.DeltaSize;
+}
+
+#endif
+
+void PrioritizeReplication(int32 budget)
+{
+    PROFILE_CPU();
+    const auto& clients = NetworkManager::Clients;
+    for (int32 clientIndex = 0; clientIndex < clients.Count(); clientIndex++)
     {
-        LOG(Error, "Too much data for object {} replication ({} bytes provided while limit is {}).", item.ToString(), size, MAX_uint16);
+        const NetworkClient* client = clients.Get()[clientIndex];
+        if (client->State != NetworkConnectionState::Connected)
+            continue;
+
+        // Accumulate priority of the objects to send to this client
+        CachedReplicationPriorities.Clear();
+        for (int32 i = 0; i < CachedReplicationEntries.Count(); i++)
+        {
+            auto& e = CachedReplicationEntries.Get()[i];
+            auto& item = *e.Item;
+            if (e.Failed || !e.TargetClients.HasBit(clientIndex) || item.OwnerClientId == client->ClientId)
+                continue;
+            if (item.TargetClientIds.IsValid() && !SpanContains<uint32>(item.TargetClientIds, client->ClientId))
+                continue;
+#if USE_NETWORK_REPLICATOR_DELTA
+            if (!e.Changed && item.DeltaCache.GetAck(clientIndex, client->ClientId) == item.DeltaCache.GetLatest().Frame)
+                continue; // Client already has the latest state
+#elif USE_NETWORK_REPLICATOR_CACHE
+            if (!e.Changed && item.RepCache.Mask.HasBit(clientIndex))
+                continue; // Client already has the latest state
+#endif
+            float& priority = item.Priority.Get(clientIndex, client->ClientId);
+            priority += Hierarchy->GetPriority(CachedReplicationResult, clientIndex, e.Object, e.Importance);
+#if USE_NETWORK_REPLICATOR_DELTA
+            const uint32 size = GetReplicationDeltaSize(e, i, clientIndex, client->ClientId);
+#else
+            const uint32 size = e.Size;
+#endif
+            CachedReplicationPriorities.Add({ priority, i, (uint32)(size + sizeof(NetworkMessageObjectReplicate)), false });
+        }
+
+        // Send the most important objects that fit into the budget
+        NetworkReplicationBudget::Apply(CachedReplicationPriorities, (uint32)budget);
+        for (const auto& p : CachedReplicationPriorities)
+        {
+            auto& e = CachedReplicationEntries.Get()[p.Index];
+            if (!p.Send)
+            {
+                // Skip it and keep the accumulated priority to send it earlier in the next updates
+                e.TargetClients.UnsetBit(clientIndex);
+                e.Item->Priority.Starved.SetBit(clientIndex);
+                continue;
+            }
+            e.Item->Priority.Get(clientIndex, client->ClientId) = 0.0f;
+        }
+    }
+
+    // Track objects that need to be replicated again in the next update
+    for (const auto& e : CachedReplicationEntries)
+    {
+        if (e.Item->Priority.Starved)
+        {
+            e.Item->Priority.Importance = e.Importance;
+            StarvedReplication.Add(e.Item->ObjectId);
+        }
+    }
+}
+
+void SendReplication(int32 entryIndex)
+{
+    const auto& e = CachedReplicationEntries[entryIndex];
+    if (e.Failed)
+        return;
+    auto& item = *e.Item;
+    ScriptingObject* obj = e.Object;
+    const byte* data = CachedReplicationStreams[entryIndex / NETWORK_REPLICATOR_JOB_BATCH_SIZE]->GetBuffer() + e.Offset;
+    const uint32 size = e.Size;
+    const bool isClient = NetworkManager::IsClient();
+    NetworkClientsMask targetClients = e.TargetClients;
+
+#if USE_NETWORK_REPLICATOR_DELTA
+    if (!isClient)
+    {
+        // Send object state to clients as a delta against their last acknowledged state
+        SendReplicationDelta(item, obj, data, size, targetClients, e.Changed);
         return;
     }
+#endif
 
 #if USE_NETWORK_REPLICATOR_CACHE
     // Process replication cache to skip sending object data if it didn't change
-    if (item.RepCache.Data.Length() == size && Platform::MemoryCompare(item.RepCache.Data.Get(), stream->GetBuffer(), size) == 0)
+    if (!e.Changed)
     {
         // Check if only newly joined clients are missing this data to avoid resending it to everyone
         NetworkClientsMask missingClients = targetClients & ~item.RepCache.Mask;
@@ -740,8 +1210,8 @@ void SendReplication(ScriptingObject* obj, NetworkClientsMask targetClients)
             return;
         targetClients = missingClients;
     }
-    item.RepCache.Mask = fullTargetClients;
-    item.RepCache.Data.Copy(stream->GetBuffer(), size);
+    item.RepCache.Mask = e.TargetClients;
+    item.RepCache.Data.Copy(data, size);
 #endif
     // TODO: use Unreliable for dynamic objects that are replicated every frame? (eg. player state)
     constexpr NetworkChannelType repChannel = NetworkChannelType::Reliable;
@@ -757,6 +1227,9 @@ void SendReplication(ScriptingObject* obj, NetworkClientsMask targetClients)
     // Send object to clients
     NetworkMessageObjectReplicate msgData;
     msgData.OwnerFrame = NetworkManager::Frame;
+    msgData.BaselineFrame = 0;
+    msgData.UseDelta = 0;
+    msgData.UseAck = 0;
     Guid objectId = item.ObjectId, parentId = item.ParentId;
     {
         // Remap local client object ids into server ids
@@ -770,7 +1243,7 @@ void SendReplication(ScriptingObject* obj, NetworkClientsMask targetClients)
     msg.WriteNetworkId(parentId);
     msg.WriteNetworkName(obj->GetType().Fullname);
     const NetworkRpcName name(obj->GetTypeHandle(), StringAnsiView::Empty);
-    SendInParts(peer, repChannel, stream->GetBuffer(), size, msg, name, isClient, objectId, msgData.OwnerFrame, NetworkMessageIDs::ObjectReplicatePart);
+    SendInParts(peer, repChannel, data, size, msg, name, isClient, objectId, msgData.OwnerFrame, NetworkMessageIDs::ObjectReplicatePart);
 }
 
 void SendRpc(RpcSendItem& e)
@@ -1033,6 +1506,31 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
         DirtyObjectImpl(item, obj);
 }
 
+void ReceiveObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, uint32 baselineFrame, bool useDelta, bool useAck, byte* data, uint32 dataSize, uint32 senderClientId)
+{
+#if USE_NETWORK_REPLICATOR_DELTA
+    if (useAck)
+    {
+        auto& cache = item.DeltaCache;
+        if (useDelta)
+        {
+            // Reconstruct object state from the baseline
+            const auto* baseline = cache.Find(baselineFrame);
+            if (!baseline || NetworkReplicatorDeltaCache::Decode(CachedDeltaBuffer, data, dataSize, baseline->Data.Get(), baseline->Data.Length()))
+                return; // Sender will resend the full state once acknowledged state gets too old
+            data = CachedDeltaBuffer.Get();
+            dataSize = CachedDeltaBuffer.Count();
+        }
+
+        // Keep state for the delta-encoding and acknowledge it (even if it's a duplicate, eg. when the previous ack was lost)
+        if (!cache.Find(ownerFrame))
+            cache.Add(ownerFrame, data, dataSize);
+        ReplicationAcks.Add(ToPair(item.ObjectId, ownerFrame));
+    }
+#endif
+    InvokeObjectReplication(item, ownerFrame, data, dataSize, senderClientId);
+}
+
 FORCE_INLINE PartsItem* AddObjectRpcItem(NetworkEvent& event, uint32 ownerFrame, uint16 partsCount, uint16 dataSize, const Guid& objectId, uint16 partStart, uint16 partSize, uint32 senderClientId)
 {
     return AddPartsItem(RpcParts, event, ownerFrame, partsCount, dataSize, objectId, partStart, partSize, senderClientId);
@@ -1379,49 +1877,66 @@ void NetworkReplicator::AddSerializer(const ScriptingTypeHandle& typeHandle, Ser
         return;
     PROFILE_MEM(Networking);
     const Serializer serializer{ { serialize, deserialize }, { serializeTag, deserializeTag } };
+    ScopeWriteLock lock(SerializersLock);
     SerializersTable[typeHandle] = serializer;
 }
 
-bool NetworkReplicator::InvokeSerializer(const ScriptingTypeHandle& typeHandle, void* instance, NetworkStream* stream, bool serialize)
+void NetworkReplicator::RemoveSerializer(const ScriptingTypeHandle& typeHandle)
 {
-    if (!typeHandle || !instance || !stream)
-        return true;
+    ScopeWriteLock lock(SerializersLock);
+    SerializersTable.Remove(typeHandle);
+}
 
-    // Get serializers pair from table
-    Serializer serializer;
-    if (!SerializersTable.TryGet(typeHandle, serializer))
+bool GetSerializer(const ScriptingTypeHandle& typeHandle, Serializer& serializer)
+{
+    {
+        ScopeReadLock lock(SerializersLock);
+        if (SerializersTable.TryGet(typeHandle, serializer))
+            return false;
+    }
+
+    // Fallback to INetworkSerializable interface (if type implements it)
+    const ScriptingType& type = typeHandle.GetType();
+    const ScriptingType::InterfaceImplementation* interface = type.GetInterface(INetworkSerializable::TypeInitializer);
+    if (interface)
     {
-        // Fallback to INetworkSerializable interface (if type implements it)
-        const ScriptingType& type = typeHandle.GetType();
-        const ScriptingType::InterfaceImplementation* interface = type.GetInterface(INetworkSerializable::TypeInitializer);
-        if (interface)
+        if (interface->IsNative)
         {
-            if (interface->IsNative)
-            {
-                // Native interface (implemented in C++)
-                serializer.Methods[0] = INetworkSerializable_Native_Serialize;
-                serializer.Methods[1] = INetworkSerializable_Native_Deserialize;
-                serializer.Tags[0] = serializer.Tags[1] = (void*)(intptr)interface->VTableOffset; // Pass VTableOffset to the callback
-            }
-            else
-            {
-                // Generic interface (implemented in C# or elsewhere)
-                ASSERT(type.Type == ScriptingTypes::Script);
-                serializer.Methods[0] = INetworkSerializable_Script_Serialize;
-                serializer.Methods[1] = INetworkSerializable_Script_Deserialize;
-                serializer.Tags[0] = serializer.Tags[1] = nullptr;
-            }
-            PROFILE_MEM(Networking);
-            SerializersTable.Add(typeHandle, serializer);
+            // Native interface (implemented in C++)
+            serializer.Methods[0] = INetworkSerializable_Native_Serialize;
+            serializer.Methods[1] = INetworkSerializable_Native_Deserialize;
+            serializer.Tags[0] = serializer.Tags[1] = (void*)(intptr)interface->VTableOffset; // Pass VTableOffset to the callback
         }
-        else if (const ScriptingTypeHandle baseTypeHandle = typeHandle.GetType().GetBaseType())
+        else
         {
-            // Fallback to base type
-            return InvokeSerializer(baseTypeHandle, instance, stream, serialize);
+            // Generic interface (implemented in C# or elsewhere)
+            ASSERT(type.Type == ScriptingTypes::Script);
+            serializer.Methods[0] = INetworkSerializable_Script_Serialize;
+            serializer.Methods[1] = INetworkSerializable_Script_Deserialize;
+            serializer.Tags[0] = serializer.Tags[1] = nullptr;
         }
-        else
-            return true;
+        PROFILE_MEM(Networking);
+        ScopeWriteLock lock(SerializersLock);
+        SerializersTable[typeHandle] = serializer; // Other thread could add it in the meantime
+        return false;
+    }
+    if (const ScriptingTypeHandle baseTypeHandle = type.GetBaseType())
+    {
+        // Fallback to base type
+        return GetSerializer(baseTypeHandle, serializer);
     }
+    return true;
+}
+
+bool NetworkReplicator::InvokeSerializer(const ScriptingTypeHandle& typeHandle, void* instance, NetworkStream* stream, bool serialize)
+{
+    if (!typeHandle || !instance || !stream)
+        return true;
+
+    // Get serializers pair from table
+    Serializer serializer;
+    if (GetSerializer(typeHandle, serializer))
+        return true;
 
     // Invoke serializer
     const byte idx = serialize ? 0 : 1;
@@ -1832,7 +2347,9 @@ bool NetworkReplicator::EndInvokeRPC(ScriptingObject* obj, const ScriptingTypeHa
     rpc.Name.First = type;
     rpc.Name.Second = name;
     rpc.Info = *info;
-    rpc.ArgsData.Copy(Span<byte>(argsStream->GetBuffer(), argsStream->GetPosition()));
+    argsStream->FlushBits();
+    const uint32 argsSize = argsStream->GetPosition();
+    rpc.ArgsData.Copy(Span<byte>(argsStream->GetBuffer(), argsSize));
     rpc.Targets.Copy(targetIds);
     ObjectsLock.Unlock();
 
@@ -1937,9 +2454,17 @@ void NetworkInternal::NetworkReplicatorClear()
     SAFE_DELETE(CachedWriteStream);
     SAFE_DELETE(CachedReadStream);
     SAFE_DELETE(CachedReplicationResult);
+    CachedReplicationEntries.Clear();
+    CachedReplicationStreams.ClearDelete();
+    CachedReplicationPriorities.Clear();
+    StarvedReplication.Clear();
     NewClients.Clear();
     CachedTargets.Clear();
     DespawnedObjects.Clear();
+#if USE_NETWORK_REPLICATOR_DELTA
+    ReplicationAcks.Clear();
+    CachedDeltaTargets.Clear();
+#endif
 }
 
 void NetworkInternal::NetworkReplicatorPreUpdate()
@@ -2107,7 +2632,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
                     auto& item = it->Item;
 
                     // Replicate from all collected parts data
-                    InvokeObjectReplication(item, e.OwnerFrame, e.Data.Get(), e.Data.Count(), e.OwnerClientId);
+                    ReceiveObjectReplication(item, e.OwnerFrame, 0, false, e.UseAck, e.Data.Get(), e.Data.Count(), e.OwnerClientId);
                 }
             }
 
@@ -2131,6 +2656,31 @@ void NetworkInternal::NetworkReplicatorUpdate()
         // Tick using hierarchy
         PROFILE_CPU_NAMED("ReplicationHierarchyUpdate");
         Hierarchy->Update(CachedReplicationResult);
+
+        // Add objects that didn't fit into the budget in the previous update
+        if (StarvedReplication.HasItems())
+        {
+            for (auto& e : CachedReplicationResult->_entries)
+            {
+                auto it = Objects.Find(e.Object->GetID());
+                if (it.IsNotEnd() && it->Item.Priority.Starved)
+                {
+                    e.TargetClients |= it->Item.Priority.Starved;
+                    it->Item.Priority.Starved = NetworkClientsMask();
+                }
+            }
+            for (const Guid& id : StarvedReplication)
+            {
+                auto it = Objects.Find(id);
+                if (it.IsNotEnd() && it->Item.Priority.Starved)
+                {
+                    if (ScriptingObject* obj = it->Item.Object.Get())
+                        CachedReplicationResult->AddObject(obj, it->Item.Priority.Starved, it->Item.Priority.Importance);
+                    it->Item.Priority.Starved = NetworkClientsMask();
+                }
+            }
+            StarvedReplication.Clear();
+        }
     }
     else
     {
@@ -2155,16 +2705,71 @@ void NetworkInternal::NetworkReplicatorUpdate()
     if (CachedReplicationResult->_entries.HasItems())
     {
         PROFILE_CPU_NAMED("Replication");
-        if (CachedWriteStream == nullptr)
-            CachedWriteStream = New<NetworkStream>();
-        CachedWriteStream->SenderId = NetworkManager::LocalClientId;
-        // TODO: use Job System when replicated objects count is large
-        for (auto& e : CachedReplicationResult->_entries)
+        auto& entries = CachedReplicationResult->_entries;
+
+        // Prepare objects for serialization (on a main thread as it might run gameplay logic)
+        for (auto& e : entries)
         {
-            SendReplication(e.Object, e.TargetClients);
+            auto it = Objects.Find(e.Object->GetID());
+            if (it.IsNotEnd() && it->Item.AsNetworkObject && (isClient || e.TargetClients))
+                it->Item.AsNetworkObject->OnNetworkSerialize();
+        }
+        CachedReplicationEntries.Clear();
+        for (auto& e : entries)
+        {
+            auto it = Objects.Find(e.Object->GetID());
+            if (it.IsEnd() || (!isClient && !e.TargetClients))
+                continue; // Server has no recipients
+            Serializer serializer;
+            if (GetSerializer(e.Object->GetTypeHandle(), serializer))
+                continue; // Missing serialization logic
+            auto& entry = CachedReplicationEntries.AddOne();
+            entry.Item = &it->Item;
+            entry.Object = e.Object;
+            entry.TargetClients = e.TargetClients;
+            entry.Importance = e.Importance;
+            entry.Methods = serializer;
+#if USE_NETWORK_REPLICATOR_DELTA
+            entry.DeltaBaselineFrame = 0;
+#endif
+        }
+
+        // Serialize objects in batches (in parallel if there are many objects)
+        const int32 batchesCount = Math::DivideAndRoundUp(CachedReplicationEntries.Count(), NETWORK_REPLICATOR_JOB_BATCH_SIZE);
+        while (CachedReplicationStreams.Count() < batchesCount)
+            CachedReplicationStreams.Add(New<NetworkStream>());
+        if (batchesCount > 1 && NetworkReplicator::EnableParallelSerialization)
+        {
+            JobSystem::Execute(SerializeReplication, batchesCount);
+        }
+        else
+        {
+            for (int32 batchIndex = 0; batchIndex < batchesCount; batchIndex++)
+                SerializeReplication(batchIndex);
+        }
+
+        // Limit data sent to each client and prioritize objects
+        if (!isClient && Hierarchy && Hierarchy->ClientBytesBudget > 0)
+        {
+            PrioritizeReplication(Hierarchy->ClientBytesBudget);
+        }
+
+        // Send objects data in a deterministic order
+        for (int32 i = 0; i < CachedReplicationEntries.Count(); i++)
+        {
+            SendReplication(i);
         }
     }
 
+#if USE_NETWORK_REPLICATOR_DELTA
+    // Acknowledge received objects states
+    if (ReplicationAcks.HasItems())
+    {
+        PROFILE_CPU_NAMED("ReplicationAcks");
+        NetworkInternal::SendReplicationAcks(NetworkManager::Peer, ReplicationAcks);
+    }
+#endif
+
     // Invoke RPCs
     {
         PROFILE_CPU_NAMED("Rpc");
@@ -2207,14 +2812,39 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     if (msgDataPayload.PartsCount == 1)
     {
         // Replicate
-        InvokeObjectReplication(item, msgData.OwnerFrame, event.Message.Buffer + event.Message.Position, msgDataPayload.DataSize, senderClientId);
+        ReceiveObjectReplication(item, msgData.OwnerFrame, msgData.BaselineFrame, msgData.UseDelta, msgData.UseAck, event.Message.Buffer + event.Message.Position, msgDataPayload.DataSize, senderClientId);
     }
     else
     {
         // Add to replication from multiple parts
         PartsItem* replicateItem = AddObjectReplicateItem(event, msgData.OwnerFrame, msgDataPayload.PartsCount, msgDataPayload.DataSize, objectId, 0, msgDataPayload.PartSize, senderClientId);
         replicateItem->Object = e->Object;
+        replicateItem->UseAck = msgData.UseAck;
+    }
+}
+
+void NetworkInternal::OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+#if USE_NETWORK_REPLICATOR_DELTA
+    PROFILE_CPU();
+    if (!client)
+        return; // Only server tracks acknowledged states of clients
+    NetworkMessageObjectReplicateAck msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    const int32 clientIndex = NetworkManager::Clients.Find(client);
+    if (clientIndex == -1)
+        return;
+    for (int32 i = 0; i < msgData.ItemsCount; i++)
+    {
+        Guid objectId;
+        event.Message.ReadNetworkId(objectId);
+        const uint32 frame = event.Message.ReadUInt32();
+        auto it = Objects.Find(objectId);
+        if (it != Objects.End())
+            it->Item.DeltaCache.SetAck(clientIndex, client->ClientId, frame);
     }
+#endif
 }
 
 void NetworkInternal::OnNetworkMessageObjectReplicatePart(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
@@ -43,6 +43,11 @@ API_CLASS(static, Namespace="FlaxEngine.Networking") class FLAXENGINE_API Networ
     API_FIELD(Attributes="DebugCommand") static bool EnableLog;
 #endif
 
+    /// <summary>
+    /// Enables serialization of the replicated objects in parallel via Job System (when there are many objects to replicate). Disabled by default. Enable it only if serialization logic of all replicated objects is thread-safe (eg. cannot modify the scene or access other objects state that changes during serialization). OnNetworkSerialize is always called on the main thread before serialization.
+    /// </summary>
+    API_FIELD() static bool EnableParallelSerialization;
+
     /// <summary>
     /// Gets the network replication hierarchy.
     /// </summary>
@@ -64,6 +69,12 @@ API_CLASS(static, Namespace="FlaxEngine.Networking") class FLAXENGINE_API Networ
     /// <param name="deserializeTag">Deserialization callback method tag value.</param>
     static void AddSerializer(const ScriptingTypeHandle& typeHandle, SerializeFunc serialize, SerializeFunc deserialize, void* serializeTag = nullptr, void* deserializeTag = nullptr);
 
+    /// <summary>
+    /// Removes the network replication serializer for a given type (added with AddSerializer).
+    /// </summary>
+    /// <param name="typeHandle">The scripting type.</param>
+    static void RemoveSerializer(const ScriptingTypeHandle& typeHandle);
+
     /// <summary>
     /// Invokes the network replication serializer for a given type.
     /// </summary>
@@ -4,6 +4,7 @@
 #include "INetworkSerializable.h"
 #include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Math/Vector3.h"
 #include "Engine/Profiler/ProfilerMemory.h"
 
 // Quaternion quantized for optimized network data size.
@@ -93,6 +94,30 @@ struct NetworkQuaternion
     }
 };
 
+namespace
+{
+    // The maximum absolute value of the smallest three components of the normalized quaternion (1 / sqrt(2))
+    constexpr float QuaternionComponentMax = 0.70710678f;
+
+    FORCE_INLINE uint32 GetBitsMask(int32 bits)
+    {
+        return bits >= 32 ? MAX_uint32 : (1u << bits) - 1;
+    }
+
+    FORCE_INLINE uint32 Quantize(double value, double min, double max, int32 bits)
+    {
+        const uint32 mask = GetBitsMask(bits);
+        const double alpha = max > min ? Math::Saturate((value - min) / (max - min)) : 0.0;
+        return (uint32)(alpha * mask + 0.5);
+    }
+
+    FORCE_INLINE double Dequantize(uint32 value, double min, double max, int32 bits)
+    {
+        const uint32 mask = GetBitsMask(bits);
+        return min + (max - min) * ((double)value / mask);
+    }
+}
+
 NetworkStream::NetworkStream(const SpawnParams& params)
     : ScriptingObject(params)
     , ReadStream()
@@ -128,6 +153,8 @@ void NetworkStream::Initialize(uint32 minCapacity)
 
     // Reset pointer to the start
     _position = _buffer;
+    _writeBits = _readBits = 0;
+    _writeBitsCount = _readBitsCount = 0;
 }
 
 void NetworkStream::Initialize(byte* buffer, uint32 length)
@@ -137,6 +164,153 @@ void NetworkStream::Initialize(byte* buffer, uint32 length)
     _position = _buffer = buffer;
     _length = length;
     _allocated = false;
+    _writeBits = _readBits = 0;
+    _writeBitsCount = _readBitsCount = 0;
+}
+
+void NetworkStream::WriteBits(uint32 value, int32 bits)
+{
+    ASSERT_LOW_LAYER(bits > 0 && bits <= 32);
+    _writeBits |= (uint64)(value & GetBitsMask(bits)) << _writeBitsCount;
+    _writeBitsCount += bits;
+    if (_writeBitsCount >= 32)
+    {
+        // Output the full words (little-endian)
+        Reserve(4);
+        for (int32 i = 0; i < 4; i++)
+            _position[i] = (byte)(_writeBits >> (i * 8));
+        _position += 4;
+        _writeBits >>= 32;
+        _writeBitsCount -= 32;
+    }
+}
+
+uint32 NetworkStream::ReadBits(int32 bits)
+{
+    ASSERT_LOW_LAYER(bits > 0 && bits <= 32);
+    while (_readBitsCount < (uint32)bits)
+    {
+        ASSERT(_position < _buffer + _length);
+        _readBits |= (uint64)*_position++ << _readBitsCount;
+        _readBitsCount += 8;
+    }
+    const uint32 result = (uint32)_readBits & GetBitsMask(bits);
+    _readBits >>= bits;
+    _readBitsCount -= bits;
+    return result;
+}
+
+void NetworkStream::FlushBits()
+{
+    if (_writeBitsCount == 0)
+        return;
+    const uint32 bytes = (_writeBitsCount + 7) / 8;
+    Reserve(bytes);
+    for (uint32 i = 0; i < bytes; i++)
+        _position[i] = (byte)(_writeBits >> (i * 8));
+    _position += bytes;
+    _writeBits = 0;
+    _writeBitsCount = 0;
+}
+
+void NetworkStream::WriteVarUInt(uint64 value)
+{
+    while (value >= 0x80)
+    {
+        WriteBits((uint32)(value & 0x7f) | 0x80, 8);
+        value >>= 7;
+    }
+    WriteBits((uint32)value, 8);
+}
+
+uint64 NetworkStream::ReadVarUInt()
+{
+    uint64 result = 0;
+    for (int32 shift = 0; shift < 64; shift += 7)
+    {
+        const uint32 data = ReadBits(8);
+        result |= (uint64)(data & 0x7f) << shift;
+        if ((data & 0x80) == 0)
+            break;
+    }
+    return result;
+}
+
+void NetworkStream::WriteVarInt(int64 value)
+{
+    WriteVarUInt(((uint64)value << 1) ^ (uint64)(value >> 63));
+}
+
+int64 NetworkStream::ReadVarInt()
+{
+    const uint64 value = ReadVarUInt();
+    return (int64)(value >> 1) ^ -(int64)(value & 1);
+}
+
+void NetworkStream::WriteQuantizedFloat(float value, float min, float max, int32 bits)
+{
+    WriteBits(Quantize(value, min, max, bits), bits);
+}
+
+float NetworkStream::ReadQuantizedFloat(float min, float max, int32 bits)
+{
+    return (float)Dequantize(ReadBits(bits), min, max, bits);
+}
+
+void NetworkStream::WriteQuantizedVector3(const Vector3& value, const Vector3& min, const Vector3& max, int32 bits)
+{
+    for (int32 i = 0; i < 3; i++)
+        WriteBits(Quantize(value.Raw[i], min.Raw[i], max.Raw[i], bits), bits);
+}
+
+Vector3 NetworkStream::ReadQuantizedVector3(const Vector3& min, const Vector3& max, int32 bits)
+{
+    Vector3 result;
+    for (int32 i = 0; i < 3; i++)
+        result.Raw[i] = (Real)Dequantize(ReadBits(bits), min.Raw[i], max.Raw[i], bits);
+    return result;
+}
+
+void NetworkStream::WriteQuantizedQuaternion(const Quaternion& value, int32 bits)
+{
+    ASSERT_LOW_LAYER(bits >= 2 && bits <= 16);
+    Quaternion raw = value;
+    raw.Normalize();
+
+    // Skip the largest component (restored from the unit length) and make it positive (q and -q are the same rotation)
+    int32 largest = 0;
+    for (int32 i = 1; i < 4; i++)
+    {
+        if (Math::Abs(raw.Raw[i]) > Math::Abs(raw.Raw[largest]))
+            largest = i;
+    }
+    const float sign = raw.Raw[largest] < 0.0f ? -1.0f : 1.0f;
+    WriteBits(largest, 2);
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+            WriteBits(Quantize(raw.Raw[i] * sign, -QuaternionComponentMax, QuaternionComponentMax, bits), bits);
+    }
+}
+
+Quaternion NetworkStream::ReadQuantizedQuaternion(int32 bits)
+{
+    ASSERT_LOW_LAYER(bits >= 2 && bits <= 16);
+    Quaternion raw;
+    const int32 largest = (int32)ReadBits(2);
+    float sum = 0.0f;
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+        {
+            const float comp = (float)Dequantize(ReadBits(bits), -QuaternionComponentMax, QuaternionComponentMax, bits);
+            raw.Raw[i] = comp;
+            sum += comp * comp;
+        }
+    }
+    raw.Raw[largest] = Math::Sqrt(Math::Max(1.0f - sum, 0.0f));
+    raw.Normalize();
+    return raw;
 }
 
 void NetworkStream::Read(INetworkSerializable& obj)
@@ -198,11 +372,13 @@ void NetworkStream::Write(const Transform& data, bool useDouble)
 
 void NetworkStream::Flush()
 {
-    // Nothing to do
+    FlushBits();
 }
 
 void NetworkStream::Close()
 {
+    _writeBits = _readBits = 0;
+    _writeBitsCount = _readBitsCount = 0;
     if (_allocated)
         Allocator::Free(_buffer);
     _position = _buffer = nullptr;
@@ -224,10 +400,14 @@ void NetworkStream::SetPosition(uint32 seek)
 {
     ASSERT(_length > 0);
     _position = _buffer + seek;
+    _writeBits = _readBits = 0;
+    _writeBitsCount = _readBitsCount = 0;
 }
 
 void NetworkStream::ReadBytes(void* data, uint32 bytes)
 {
+    _readBits = 0;
+    _readBitsCount = 0;
     if (bytes > 0)
     {
         ASSERT(data && GetLength() - GetPosition() >= bytes);
@@ -237,9 +417,19 @@ void NetworkStream::ReadBytes(void* data, uint32 bytes)
 }
 
 void NetworkStream::WriteBytes(const void* data, uint32 bytes)
+{
+    FlushBits();
+    Reserve(bytes);
+
+    // Copy data
+    Platform::MemoryCopy(_position, data, bytes);
+    _position += bytes;
+}
+
+void NetworkStream::Reserve(uint32 bytes)
 {
     // Calculate current position
-    const uint32 position = GetPosition();
+    const uint32 position = static_cast<uint32>(_position - _buffer);
 
     // Check if there is need to update a buffer size
     if (_length - position < bytes)
@@ -261,8 +451,4 @@ void NetworkStream::WriteBytes(const void* data, uint32 bytes)
         _position = _buffer + position;
         _allocated = true;
     }
-
-    // Copy data
-    Platform::MemoryCopy(_position, data, bytes);
-    _position += bytes;
 }
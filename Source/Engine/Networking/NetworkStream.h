@@ -19,6 +19,10 @@ API_CLASS(sealed, Namespace="FlaxEngine.Networking") class FLAXENGINE_API Networ
     byte* _position = nullptr;
     uint32 _length = 0;
     bool _allocated = false;
+    uint64 _writeBits = 0;
+    uint32 _writeBitsCount = 0;
+    uint64 _readBits = 0;
+    uint32 _readBitsCount = 0;
 
 public:
     ~NetworkStream();
@@ -69,6 +73,101 @@ API_CLASS(sealed, Namespace="FlaxEngine.Networking") class FLAXENGINE_API Networ
         ReadBytes(data, bytes);
     }
 
+public:
+    /// <summary>
+    /// Writes the lowest bits of the value to the stream. Bits are packed together until the next byte-level write (or FlushBits call) that aligns the stream to the full byte. Pending bits are not included in the stream position.
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="bits">The amount of bits to write (in range 1-32).</param>
+    API_FUNCTION() void WriteBits(uint32 value, int32 bits);
+
+    /// <summary>
+    /// Reads the bits from the stream (written with WriteBits). Next byte-level read skips the remaining bits of the current byte.
+    /// </summary>
+    /// <param name="bits">The amount of bits to read (in range 1-32).</param>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() uint32 ReadBits(int32 bits);
+
+    /// <summary>
+    /// Writes the pending bits to the stream (aligned to the full byte). Called automatically before any byte-level write. Call it at the end of the message before reading the stream position or buffer.
+    /// </summary>
+    API_FUNCTION() void FlushBits();
+
+    /// <summary>
+    /// Writes the unsigned integer using variable-length encoding (7 bits per byte, small values use less space).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarUInt(uint64 value);
+
+    /// <summary>
+    /// Reads the unsigned integer written with WriteVarUInt.
+    /// </summary>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() uint64 ReadVarUInt();
+
+    /// <summary>
+    /// Writes the signed integer using variable-length zig-zag encoding (values close to zero use less space).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarInt(int64 value);
+
+    /// <summary>
+    /// Reads the signed integer written with WriteVarInt.
+    /// </summary>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() int64 ReadVarInt();
+
+    /// <summary>
+    /// Writes the floating-point value quantized into the range. Values outside the range are clamped.
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use (in range 1-32). Precision is (max - min) / (2^bits - 1).</param>
+    API_FUNCTION() void WriteQuantizedFloat(float value, float min, float max, int32 bits);
+
+    /// <summary>
+    /// Reads the floating-point value written with WriteQuantizedFloat. Uses the same range and bits count as when writing.
+    /// </summary>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use (in range 1-32).</param>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() float ReadQuantizedFloat(float min, float max, int32 bits);
+
+    /// <summary>
+    /// Writes the vector quantized into the bounds (per-component). Values outside the bounds are clamped.
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="min">The minimum value of the bounds.</param>
+    /// <param name="max">The maximum value of the bounds.</param>
+    /// <param name="bits">The amount of bits to use per component (in range 1-32).</param>
+    API_FUNCTION() void WriteQuantizedVector3(API_PARAM(Ref) const Vector3& value, API_PARAM(Ref) const Vector3& min, API_PARAM(Ref) const Vector3& max, int32 bits);
+
+    /// <summary>
+    /// Reads the vector written with WriteQuantizedVector3. Uses the same bounds and bits count as when writing.
+    /// </summary>
+    /// <param name="min">The minimum value of the bounds.</param>
+    /// <param name="max">The maximum value of the bounds.</param>
+    /// <param name="bits">The amount of bits to use per component (in range 1-32).</param>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() Vector3 ReadQuantizedVector3(API_PARAM(Ref) const Vector3& min, API_PARAM(Ref) const Vector3& max, int32 bits);
+
+    /// <summary>
+    /// Writes the rotation using smallest-three encoding (index of the largest component and three remaining components quantized).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="bits">The amount of bits to use per component (in range 2-16). The rotation takes 2 + 3 * bits bits.</param>
+    API_FUNCTION() void WriteQuantizedQuaternion(API_PARAM(Ref) const Quaternion& value, int32 bits = 12);
+
+    /// <summary>
+    /// Reads the rotation written with WriteQuantizedQuaternion. Uses the same bits count as when writing.
+    /// </summary>
+    /// <param name="bits">The amount of bits to use per component (in range 2-16).</param>
+    /// <returns>The read value.</returns>
+    API_FUNCTION() Quaternion ReadQuantizedQuaternion(int32 bits = 12);
+
+public:
     using ReadStream::Read;
     void Read(INetworkSerializable& obj);
     void Read(INetworkSerializable* obj);
@@ -94,4 +193,7 @@ API_CLASS(sealed, Namespace="FlaxEngine.Networking") class FLAXENGINE_API Networ
 
     // [WriteStream]
     void WriteBytes(const void* data, uint32 bytes) override;
+
+private:
+    void Reserve(uint32 bytes);
 };
@@ -13,6 +13,7 @@
 #include "Engine/Utilities/Noise.h"
 #include "Engine/Debug/DebugDraw.h"
 #include "Engine/Engine/Units.h"
+#include "Engine/Particles/ParticleStreams.h"
 
 // ReSharper disable CppCStyleCast
 // ReSharper disable CppClangTidyClangDiagnosticCastAlign
@@ -127,11 +128,37 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
     return result;
 }
 
+bool ParticleEmitterGraphCPUExecutor::ProcessModuleProgram(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd)
+{
+    if (node->ProgramIndex == -1)
+        return false;
+    auto& context = *Context.Get();
+    const auto& program = _graph.Programs[node->ProgramIndex];
+
+    // Evaluate particle-independent values once (fallback to per-particle graph evaluation if value type doesn't match the compiled program)
+    Float4 hoisted[PARTICLE_EMITTER_PROGRAM_MAX_HOISTED];
+    context.ParticleIndex = particlesStart;
+    for (int32 i = 0; i < program.Hoisted.Count(); i++)
+    {
+        const auto& e = program.Hoisted[i];
+        const Value value = eatBox((Node*)node, e.Box);
+        if (ParticleEmitterGraphCPUProgram::GetWidth(value.Type.Type) != e.Width)
+            return false;
+        hoisted[i] = value.Cast(ValueType(ValueType::Float4)).AsFloat4();
+    }
+
+    context.ProgramRegisters.Resize(program.GetRegistersSize(), false);
+    program.Execute(context.Data->Buffer, context.ProgramRegisters.Get(), hoisted, particlesStart, particlesEnd, context.DeltaTime);
+    return true;
+}
+
 void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd)
 {
     auto& context = *Context.Get();
-    auto stride = context.Data->Buffer->Stride;
-    auto start = context.Data->Buffer->GetParticleCPU(particlesStart);
+    auto buffer = context.Data->Buffer;
+
+    // SoA layout allows to process the whole attribute streams with the vectorized kernels (if module inputs are not evaluated per-particle)
+    const bool useStreams = buffer->BufferLayout == ParticleBufferLayout::SoA;
 
     switch (node->TypeID)
     {
@@ -143,18 +170,20 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto spriteFacingMode = node->Values[2].AsInt;
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-            byte* spriteFacingModePtr = start + attribute.Offset;
+            byte* spriteFacingModePtr = buffer->GetAttributeCPU(particlesStart, attribute);
+            const int32 spriteFacingModeStride = buffer->GetAttributeStride(attribute);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 *((int32*)spriteFacingModePtr) = spriteFacingMode;
-                spriteFacingModePtr += stride;
+                spriteFacingModePtr += spriteFacingModeStride;
             }
         }
         if ((ParticleSpriteFacingMode)spriteFacingMode == ParticleSpriteFacingMode::CustomFacingVector ||
             (ParticleSpriteFacingMode)spriteFacingMode == ParticleSpriteFacingMode::FixedAxis)
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
-            byte* customFacingVectorPtr = start + attribute.Offset;
+            byte* customFacingVectorPtr = buffer->GetAttributeCPU(particlesStart, attribute);
+            const int32 customFacingVectorStride = buffer->GetAttributeStride(attribute);
             auto box = node->GetBox(0);
             if (node->UsePerParticleDataResolve())
             {
@@ -163,7 +192,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                     context.ParticleIndex = particleIndex;
                     const Float3 vector = (Float3)GetValue(box, 3);
                     *((Float3*)customFacingVectorPtr) = vector;
-                    customFacingVectorPtr += stride;
+                    customFacingVectorPtr += customFacingVectorStride;
                 }
             }
             else
@@ -172,7 +201,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                 for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
                 {
                     *((Float3*)customFacingVectorPtr) = vector;
-                    customFacingVectorPtr += stride;
+                    customFacingVectorPtr += customFacingVectorStride;
                 }
             }
         }
@@ -186,11 +215,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto modelFacingMode = node->Values[2].AsInt;
         {
             auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-            byte* modelFacingModePtr = start + attribute.Offset;
+            byte* modelFacingModePtr = buffer->GetAttributeCPU(particlesStart, attribute);
+            const int32 modelFacingModeStride = buffer->GetAttributeStride(attribute);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 *((int32*)modelFacingModePtr) = modelFacingMode;
-                modelFacingModePtr += stride;
+                modelFacingModePtr += modelFacingModeStride;
             }
         }
         break;
@@ -200,11 +230,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Update Age");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* agePtr = start + attribute.Offset;
+        byte* agePtr = buffer->GetAttributeCPU(particlesStart, attribute);
+        const int32 ageStride = buffer->GetAttributeStride(attribute);
+        if (useStreams)
+        {
+            ParticleStreams::Add((float*)agePtr, context.DeltaTime, particlesEnd - particlesStart);
+            break;
+        }
         for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
         {
             *((float*)agePtr) += context.DeltaTime;
-            agePtr += stride;
+            agePtr += ageStride;
         }
         break;
     }
@@ -214,25 +250,33 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Gravity/Force");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* velocityPtr = start + attribute.Offset;
+        byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, attribute);
+        const int32 velocityStride = buffer->GetAttributeStride(attribute);
         auto box = node->GetBox(0);
         if (node->UsePerParticleDataResolve())
         {
+            if (ProcessModuleProgram(node, particlesStart, particlesEnd))
+                break;
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 context.ParticleIndex = particleIndex;
                 const Float3 force = (Float3)GetValue(box, 2);
                 *((Float3*)velocityPtr) += force * context.DeltaTime;
-                velocityPtr += stride;
+                velocityPtr += velocityStride;
             }
         }
+        else if (useStreams)
+        {
+            const Float3 force = (Float3)GetValue(box, 2);
+            ParticleStreams::Add((Float3*)velocityPtr, force * context.DeltaTime, particlesEnd - particlesStart);
+        }
         else
         {
             const Float3 force = (Float3)GetValue(box, 2);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 *((Float3*)velocityPtr) += force * context.DeltaTime;
-                velocityPtr += stride;
+                velocityPtr += velocityStride;
             }
         }
         break;
@@ -245,9 +289,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
 
-        byte* positionPtr = start + position.Offset;
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, position);
+        const int32 positionStride = buffer->GetAttributeStride(position);
+        byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, velocity);
+        const int32 velocityStride = buffer->GetAttributeStride(velocity);
+        byte* massPtr = buffer->GetAttributeCPU(particlesStart, mass);
+        const int32 massStride = buffer->GetAttributeStride(mass);
 
         auto sphereCenterBox = node->GetBox(0);
         auto sphereRadiusBox = node->GetBox(1);
@@ -275,9 +322,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	float deltaSpeed = tgtSpeed - spdNormal; \
 	Float3 deltaVelocity = dir * (Math::Sign(deltaSpeed) * Math::Min(Math::Abs(deltaSpeed), context.DeltaTime * Math::Lerp(stickForce, attractionForce, ratio)) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
 	*(Float3*)velocityPtr = velocity + deltaVelocity; \
-	positionPtr += stride; \
-	velocityPtr += stride; \
-	massPtr += stride
+	positionPtr += positionStride; \
+	velocityPtr += velocityStride; \
+	massPtr += massStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -306,7 +353,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Kill");
         auto& position = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + position.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, position);
+        const int32 positionStride = buffer->GetAttributeStride(position);
 
         auto sphereCenterBox = node->GetBox(0);
         auto sphereRadiusBox = node->GetBox(1);
@@ -323,10 +371,10 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	{ \
 		particlesEnd--; \
 		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
+		buffer->CopyParticleCPU(particleIndex, buffer->CPU.Count); \
 		particleIndex--; \
 	} \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -355,7 +403,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Kill");
         auto& position = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + position.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, position);
+        const int32 positionStride = buffer->GetAttributeStride(position);
 
         auto boxCenterBox = node->GetBox(0);
         auto boxSizeBox = node->GetBox(1);
@@ -377,10 +426,10 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	{ \
 		particlesEnd--; \
 		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
+		buffer->CopyParticleCPU(particleIndex, buffer->CPU.Count); \
 		particleIndex--; \
 	} \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -416,7 +465,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	{ \
 		particlesEnd--; \
 		context.Data->Buffer->CPU.Count--; \
-		Platform::MemoryCopy(context.Data->Buffer->GetParticleCPU(particleIndex), context.Data->Buffer->GetParticleCPU(context.Data->Buffer->CPU.Count), context.Data->Buffer->Stride); \
+		buffer->CopyParticleCPU(particleIndex, buffer->CPU.Count); \
 		particleIndex--; \
 	}
 
@@ -450,10 +499,13 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
-        byte* spriteSizePtr = useSpriteSize ? start + context.Data->Buffer->Layout->Attributes[node->Attributes[2]].Offset : nullptr;
+        byte* spriteSizePtr = useSpriteSize ? buffer->GetAttributeCPU(particlesStart, context.Data->Buffer->Layout->Attributes[node->Attributes[2]]) : nullptr;
+        const int32 spriteSizeStride = useSpriteSize ? buffer->GetAttributeStride(sizeof(Float2)) : 0;
 
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, velocity);
+        const int32 velocityStride = buffer->GetAttributeStride(velocity);
+        byte* massPtr = buffer->GetAttributeCPU(particlesStart, mass);
+        const int32 massStride = buffer->GetAttributeStride(mass);
 
 #define INPUTS_FETCH() \
 	const float drag = (float)GetValue(box, 2)
@@ -462,9 +514,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     if (useSpriteSize) \
         particleDrag *= ((Float2*)spriteSizePtr)->MulValues(); \
     *((Float3*)velocityPtr) *= Math::Max(0.0f, 1.0f - (particleDrag * context.DeltaTime) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
-    velocityPtr += stride; \
-    massPtr += stride; \
-    spriteSizePtr += stride
+    velocityPtr += velocityStride; \
+    massPtr += massStride; \
+    spriteSizePtr += spriteSizeStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -475,6 +527,11 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                 LOGIC();
             }
         }
+        else if (useStreams)
+        {
+            INPUTS_FETCH();
+            ParticleStreams::LinearDrag((Float3*)velocityPtr, (const float*)massPtr, (const Float2*)spriteSizePtr, drag, context.DeltaTime, particlesEnd - particlesStart);
+        }
         else
         {
             INPUTS_FETCH();
@@ -495,9 +552,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
 
-        byte* positionPtr = start + position.Offset;
-        byte* velocityPtr = start + velocity.Offset;
-        byte* massPtr = start + mass.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, position);
+        const int32 positionStride = buffer->GetAttributeStride(position);
+        byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, velocity);
+        const int32 velocityStride = buffer->GetAttributeStride(velocity);
+        byte* massPtr = buffer->GetAttributeCPU(particlesStart, mass);
+        const int32 massStride = buffer->GetAttributeStride(mass);
 
         auto roughnessBox = node->GetBox(3);
         auto intensityBox = node->GetBox(4);
@@ -522,9 +582,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Float3 force = Noise::CustomNoise3D(vectorFieldUVW + 0.5f, octavesCount, roughness); \
     force = Float3::Transform(force, fieldTransformMatrix) * intensity; \
     *((Float3*)velocityPtr) += force * (context.DeltaTime / Math::Max(*(float*)massPtr, ZeroTolerance)); \
-    positionPtr += stride; \
-    velocityPtr += stride; \
-    massPtr += stride
+    positionPtr += positionStride; \
+    velocityPtr += velocityStride; \
+    massPtr += massStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -553,28 +613,36 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Set Attribute");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* dataPtr = start + attribute.Offset;
+        byte* dataPtr = buffer->GetAttributeCPU(particlesStart, attribute);
+        const int32 dataStride = buffer->GetAttributeStride(attribute);
         int32 dataSize = attribute.GetSize();
         auto box = node->GetBox(0);
         ValueType type(GetVariantType(attribute.ValueType));
         if (node->UsePerParticleDataResolve())
         {
+            if (ProcessModuleProgram(node, particlesStart, particlesEnd))
+                break;
             Value value;
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 4).Cast(type);
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataStride;
             }
         }
+        else if (useStreams)
+        {
+            const Value value = GetValue(box, 4).Cast(type);
+            ParticleStreams::Fill(dataPtr, &value.AsPointer, dataSize, particlesEnd - particlesStart);
+        }
         else
         {
             const Value value = GetValue(box, 4).Cast(type);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataStride;
             }
         }
         break;
@@ -611,28 +679,36 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     {
         PARTICLE_EMITTER_MODULE("Set");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
-        byte* dataPtr = start + attribute.Offset;
+        byte* dataPtr = buffer->GetAttributeCPU(particlesStart, attribute);
+        const int32 dataStride = buffer->GetAttributeStride(attribute);
         int32 dataSize = attribute.GetSize();
         auto box = node->GetBox(0);
         ValueType type(GetVariantType(attribute.ValueType));
         if (node->UsePerParticleDataResolve())
         {
+            if (ProcessModuleProgram(node, particlesStart, particlesEnd))
+                break;
             Value value;
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 2).Cast(type);
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataStride;
             }
         }
+        else if (useStreams)
+        {
+            const Value value = GetValue(box, 2).Cast(type);
+            ParticleStreams::Fill(dataPtr, &value.AsPointer, dataSize, particlesEnd - particlesStart);
+        }
         else
         {
             const Value value = GetValue(box, 2).Cast(type);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
                 Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                dataPtr += dataStride;
             }
         }
         break;
@@ -643,7 +719,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -660,7 +737,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	sincosTheta *= Math::Sqrt(1.0f - cosPhi * cosPhi); \
 	*(Float3*)positionPtr = Float3(sincosTheta, cosPhi) * radius + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -689,7 +766,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
@@ -699,7 +777,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	const Float2 size = (Float2)GetValue(sizeBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = Float3((RAND - 0.5f) * size.X, 0.0f, (RAND - 0.5f) * size.Y) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -728,7 +806,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -743,7 +822,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta, 0.0f) * radius + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -772,7 +851,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -787,7 +867,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta, 0.0f) * (radius * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -816,7 +896,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
@@ -838,7 +919,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	else \
 		cube = Float3(cube.Z, cube.X, cube.Y); \
 	*(Float3*)positionPtr = cube * size + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -867,7 +948,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto sizeBox = node->GetBox(1);
@@ -877,7 +959,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	const Float3 size = (Float3)GetValue(sizeBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = size * (RAND3 - 0.5f) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -906,7 +988,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -923,7 +1006,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Float2 sincosTheta; \
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	*(Float3*)positionPtr = Float3(sincosTheta * radius, height * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -952,7 +1035,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto startBox = node->GetBox(0);
         auto endBox = node->GetBox(1);
@@ -962,7 +1046,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	const Float3 end = (Float3)GetValue(endBox, 3);
 #define LOGIC() \
 	*(Float3*)positionPtr = Math::Lerp(start, end, RAND); \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -991,7 +1075,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -1027,7 +1112,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(phi, c, s); \
 	Float3 t2 = Float3(c * t.X - s * t.Y, c * t.Y + s * t.X, t.Z); \
 	*(Float3*)positionPtr = center + radius * t2; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1056,7 +1141,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Position");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto centerBox = node->GetBox(0);
         auto radiusBox = node->GetBox(1);
@@ -1073,7 +1159,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	Math::SinCos(theta, sincosTheta.X, sincosTheta.Y); \
 	sincosTheta *= Math::Sqrt(1.0f - cosPhi * cosPhi); \
 	*(Float3*)positionPtr = Float3(sincosTheta, cosPhi) * (radius * RAND) + center; \
-	positionPtr += stride
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1109,8 +1195,10 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         auto& velocityAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
 
-        byte* positionPtr = start + positionAttr.Offset;
-        byte* velocityPtr = start + velocityAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
+        byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, velocityAttr);
+        const int32 velocityStride = buffer->GetAttributeStride(velocityAttr);
 
         auto centerBox = node->GetBox(0);
         auto rotationSpeedBox = node->GetBox(1);
@@ -1129,8 +1217,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	arc += arcStep; \
 	*(Float3*)velocityPtr = Float3(sincosTheta * velocityScale, 0.0f); \
 	*(Float3*)positionPtr = center; \
-	velocityPtr += stride; \
-	positionPtr += stride
+	velocityPtr += velocityStride; \
+	positionPtr += positionStride
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1165,7 +1253,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Rotate Position Shape");
         auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
 
-        byte* positionPtr = start + positionAttr.Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr);
+        const int32 positionStride = buffer->GetAttributeStride(positionAttr);
 
         auto quatBox = node->GetBox(0);
 
@@ -1177,7 +1266,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     Quaternion q = Quaternion(v3.X, v3.Y, v3.Z, 0.0f); \
     Quaternion rq = quat * (q * nq); \
     *(Float3*)positionPtr = Float3(rq.X, rq.Y, rq.Z); \
-    positionPtr += stride;
+    positionPtr += positionStride;
 
         if (node->UsePerParticleDataResolve())
         {
@@ -1207,9 +1296,12 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 	auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]]; \
 	auto& velocityAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[1]]; \
 	auto& ageAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[2]]; \
-	byte* positionPtr = start + positionAttr.Offset; \
-	byte* velocityPtr = start + velocityAttr.Offset; \
-	byte* agePtr = start + ageAttr.Offset; \
+	byte* positionPtr = buffer->GetAttributeCPU(particlesStart, positionAttr); \
+	const int32 positionStride = buffer->GetAttributeStride(positionAttr); \
+	byte* velocityPtr = buffer->GetAttributeCPU(particlesStart, velocityAttr); \
+	const int32 velocityStride = buffer->GetAttributeStride(velocityAttr); \
+	byte* agePtr = buffer->GetAttributeCPU(particlesStart, ageAttr); \
+	const int32 ageStride = buffer->GetAttributeStride(ageAttr); \
 	auto invert = (bool)node->Values[2]; \
 	auto sign = invert ? -1.0f : 1.0f; \
 	auto radiusBox = node->GetBox(0); \
@@ -1237,9 +1329,9 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 		*(Float3*)velocityPtr = velocity; \
 		*(float*)agePtr += lifetimeLoss; \
 	} \
-	positionPtr += stride; \
-	velocityPtr += stride; \
-	agePtr += stride
+	positionPtr += positionStride; \
+	velocityPtr += velocityStride; \
+	agePtr += ageStride
 
     // Collision (plane)
     case 330:
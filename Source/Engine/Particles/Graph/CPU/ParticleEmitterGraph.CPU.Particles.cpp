@@ -1,13 +1,14 @@
 // Copyright (c) Wojciech Figat. All rights reserved.
 
 #include "ParticleEmitterGraph.CPU.h"
+#include "Engine/Core/Random.h"
 #include "Engine/Particles/ParticleEmitter.h"
 #include "Engine/Particles/ParticleEffect.h"
 #include "Engine/Particles/ParticleEmitterFunction.h"
 #include "Engine/Graphics/RenderTask.h"
 
 #define GET_VIEW() auto mainViewTask = MainRenderTask::Instance && MainRenderTask::Instance->LastUsedFrame != 0 ? MainRenderTask::Instance : nullptr
-#define ACCESS_PARTICLE_ATTRIBUTE(index) (context.Data->Buffer->GetParticleCPU(context.ParticleIndex) + context.Data->Buffer->Layout->Attributes[context.AttributesRemappingTable[node->Attributes[index]]].Offset)
+#define ACCESS_PARTICLE_ATTRIBUTE(index) context.Data->Buffer->GetAttributeCPU(context.ParticleIndex, context.Data->Buffer->Layout->Attributes[context.AttributesRemappingTable[node->Attributes[index]]])
 #define GET_PARTICLE_ATTRIBUTE(index, type) *(type*)ACCESS_PARTICLE_ATTRIBUTE(index)
 
 void ParticleEmitterGraphCPUExecutor::ProcessGroupParameters(Box* box, Node* node, Value& value)
@@ -222,7 +223,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
     case 303:
     {
         const auto particleIndex = tryGetValue(node->GetBox(1), context.ParticleIndex);
-        byte* ptr = (context.Data->Buffer->GetParticleCPU((uint32)particleIndex) + context.Data->Buffer->Layout->Attributes[node->Attributes[0]].Offset);
+        byte* ptr = context.Data->Buffer->GetAttributeCPU((uint32)particleIndex, context.Data->Buffer->Layout->Attributes[node->Attributes[0]]);
         switch ((ParticleAttribute::ValueTypes)node->Attributes[1])
         {
         case ParticleAttribute::ValueTypes::Float:
@@ -373,6 +374,25 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
             value = Float2(size.Z, size.W);
         break;
     }
+    // Random Float/Vector2/Vector3/Vector4 (components are drawn in order to match the module programs, see OpCode::Random)
+    case 208:
+    case 209:
+    case 210:
+    case 211:
+    {
+        Float4 v;
+        for (int32 c = 0; c < node->TypeID - 207; c++)
+            v.Raw[c] = Random::Rand();
+        if (node->TypeID == 208)
+            value = v.X;
+        else if (node->TypeID == 209)
+            value = Float2(v.X, v.Y);
+        else if (node->TypeID == 210)
+            value = Float3(v.X, v.Y, v.Z);
+        else
+            value = v;
+        break;
+    }
     // Particle Position (world space)
     case 212:
         value = GET_PARTICLE_ATTRIBUTE(0, Float3);
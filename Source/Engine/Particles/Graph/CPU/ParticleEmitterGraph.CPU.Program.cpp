@@ -0,0 +1,782 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "ParticleEmitterGraph.CPU.h"
+#include "Engine/Core/Math/Color.h"
+#include "Engine/Core/Random.h"
+#include "Engine/Core/SIMD.h"
+
+#define BATCH_SIZE PARTICLE_EMITTER_PROGRAM_BATCH_SIZE
+#define GET_REGISTER(index) (registers + (index) * 4 * BATCH_SIZE)
+
+namespace
+{
+    typedef ParticleEmitterGraphCPUProgram::OpCode OpCode;
+    typedef ParticleEmitterGraphCPUProgram::Instruction Instruction;
+
+    struct ProgramRegister
+    {
+        int32 Index;
+        int32 Width;
+        bool IsConstant;
+    };
+
+    class ProgramCompiler
+    {
+    public:
+        ParticleEmitterGraphCPU& Graph;
+        ParticleEmitterGraphCPUProgram& Program;
+        Dictionary<ParticleEmitterGraphCPUBox*, ProgramRegister> Cache;
+        int32 Depth = 0;
+
+        ProgramCompiler(ParticleEmitterGraphCPU& graph, ParticleEmitterGraphCPUProgram& program)
+            : Graph(graph)
+            , Program(program)
+        {
+        }
+
+        bool Emit(OpCode code, int32 op, int32 width, bool isConstant, const ProgramRegister* src, int32 srcCount, int32 index0, int32 index1, ProgramRegister& result)
+        {
+            if (Program.RegistersCount >= PARTICLE_EMITTER_PROGRAM_MAX_REGISTERS)
+                return true;
+            Instruction e;
+            e.Code = code;
+            e.Op = (byte)op;
+            e.Width = (byte)width;
+            e.Dst = (byte)Program.RegistersCount++;
+            for (int32 i = 0; i < 3; i++)
+                e.Src[i] = i < srcCount ? (byte)src[i].Index : 0;
+            e.Index[0] = (int16)index0;
+            e.Index[1] = (int16)index1;
+
+            // Particle-independent values are computed once per module update
+            if (isConstant)
+                Program.Setup.Add(e);
+            else
+                Program.Instructions.Add(e);
+            result.Index = e.Dst;
+            result.Width = width;
+            result.IsConstant = isConstant;
+            return false;
+        }
+
+        bool Constant(const Variant& value, ProgramRegister& result)
+        {
+            const int32 width = ParticleEmitterGraphCPUProgram::GetWidth(value.Type.Type);
+            if (width == 0)
+                return true;
+            const int32 index = Program.Constants.Count();
+            Program.Constants.Add(value.Cast(VariantType(VariantType::Float4)).AsFloat4());
+            return Emit(OpCode::Constant, 0, width, true, nullptr, 0, index, 0, result);
+        }
+
+        bool Cast(const ProgramRegister& src, int32 width, ProgramRegister& result)
+        {
+            if (src.Width == width)
+            {
+                result = src;
+                return false;
+            }
+            return Emit(OpCode::Cast, src.Width, width, src.IsConstant, &src, 1, 0, 0, result);
+        }
+
+        bool Attribute(int32 index, ProgramRegister& result)
+        {
+            const int32 width = GetAttributeWidth(index);
+            if (width == 0)
+                return true;
+            return Emit(OpCode::Attribute, 0, width, false, nullptr, 0, index, 0, result);
+        }
+
+        int32 GetAttributeWidth(int32 index) const
+        {
+            if (index < 0 || index >= Graph.Layout.Attributes.Count())
+                return 0;
+            switch (Graph.Layout.Attributes[index].ValueType)
+            {
+            case ParticleAttribute::ValueTypes::Float:
+                return 1;
+            case ParticleAttribute::ValueTypes::Float2:
+                return 2;
+            case ParticleAttribute::ValueTypes::Float3:
+                return 3;
+            case ParticleAttribute::ValueTypes::Float4:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        // Compiles the node input (matches VisjectExecutor::tryGetValue)
+        bool Input(ParticleEmitterGraphCPUNode* node, int32 boxId, int32 defaultValueIndex, const Variant& defaultValue, ProgramRegister& result)
+        {
+            const auto box = node->TryGetBox(boxId);
+            if (box && box->HasConnection())
+                return CompileBox((ParticleEmitterGraphCPUBox*)box->FirstConnection(), result);
+            if (defaultValueIndex != -1 && node->Values.Count() > defaultValueIndex)
+                return Constant(node->Values[defaultValueIndex], result);
+            return Constant(defaultValue, result);
+        }
+
+        // Gets the components count of the particle-independent value evaluated with the graph executor
+        int32 GetHoistedWidth(ParticleEmitterGraphCPUBox* box) const
+        {
+            const auto node = box->GetParent<ParticleEmitterGraphCPUNode>();
+            switch (node->Type)
+            {
+            // Get Parameter
+            case GRAPH_NODE_MAKE_TYPE(6, 1):
+            case GRAPH_NODE_MAKE_TYPE(6, 2):
+            {
+                const auto param = Graph.GetParameter((Guid)node->Values[0]);
+                if (!param)
+                    return 1;
+                const int32 width = ParticleEmitterGraphCPUProgram::GetWidth(param->Type.Type);
+                return width > 1 && box->ID >= 1 && box->ID <= width ? 1 : width;
+            }
+            // Time
+            case GRAPH_NODE_MAKE_TYPE(7, 8):
+                return 1;
+            // Effect Position, Effect Scale, View Position, View Direction
+            case GRAPH_NODE_MAKE_TYPE(14, 200):
+            case GRAPH_NODE_MAKE_TYPE(14, 202):
+            case GRAPH_NODE_MAKE_TYPE(14, 204):
+            case GRAPH_NODE_MAKE_TYPE(14, 205):
+                return 3;
+            // View Far Plane
+            case GRAPH_NODE_MAKE_TYPE(14, 206):
+                return 1;
+            default:
+                return 0;
+            }
+        }
+
+        // Compiles the value of the node output box
+        bool CompileBox(ParticleEmitterGraphCPUBox* box, ProgramRegister& result)
+        {
+            if (Cache.TryGet(box, result))
+                return false;
+            if (Depth >= PARTICLE_EMITTER_MAX_CALL_STACK)
+                return true;
+            Depth++;
+            const bool failed = ProcessBox(box, result);
+            Depth--;
+            if (failed)
+                return true;
+
+            // Random values are drawn on every use (the same as the per-particle graph evaluation)
+            const auto node = box->GetParent<ParticleEmitterGraphCPUNode>();
+            if (node->GroupID != 14 || node->TypeID < 208 || node->TypeID > 211)
+                Cache.Add(box, result);
+            return false;
+        }
+
+        bool ProcessBox(ParticleEmitterGraphCPUBox* box, ProgramRegister& result)
+        {
+            const auto node = box->GetParent<ParticleEmitterGraphCPUNode>();
+            switch (node->GroupID)
+            {
+            // Constants
+            case 2:
+                switch (node->TypeID)
+                {
+                // Constant value
+                case 1:
+                case 2:
+                case 3:
+                case 12:
+                case 15:
+                    return Constant(node->Values[0], result);
+                // Float2/3/4, Color
+                case 4:
+                case 5:
+                case 6:
+                case 7:
+                {
+                    const Variant& v = node->Values[0];
+                    if (box->ID == 0)
+                        return Constant(v, result);
+                    if (box->ID > 4)
+                        return true;
+                    const Float4 cv = (Float4)v;
+                    return Constant(Variant(cv.Raw[box->ID - 1]), result);
+                }
+                // PI
+                case 10:
+                    return Constant(Variant(PI), result);
+                default:
+                    return true;
+                }
+            // Math
+            case 3:
+                switch (node->TypeID)
+                {
+                // Add, Subtract, Multiply, Divide, Max, Min, Pow, Fmod, Atan2
+                case 1:
+                case 2:
+                case 3:
+                case 5:
+                case 21:
+                case 22:
+                case 23:
+                case 40:
+                case 41:
+                {
+                    ProgramRegister src[2];
+                    if (Input(node, 0, 0, Variant::Zero, src[0]) || Input(node, 1, 1, Variant::Zero, src[1]))
+                        return true;
+
+                    // The second input is converted to the type of the first one if it's connected, otherwise the first input is converted
+                    const int32 width = node->GetBox(0)->HasConnection() ? src[0].Width : src[1].Width;
+                    if (Cast(src[0], width, src[0]) || Cast(src[1], width, src[1]))
+                        return true;
+                    return Emit(OpCode::Binary, node->TypeID, width, src[0].IsConstant && src[1].IsConstant, src, 2, 0, 0, result);
+                }
+                // Absolute Value, Ceil, Cosine, Floor, Round, Saturate, Sine, Sqrt, Tangent, Negate, 1 - Value, Asine, Acosine, Atan, Trunc, Frac, Degrees, Radians
+                case 7:
+                case 8:
+                case 9:
+                case 10:
+                case 13:
+                case 14:
+                case 15:
+                case 16:
+                case 17:
+                case 27:
+                case 28:
+                case 33:
+                case 34:
+                case 35:
+                case 38:
+                case 39:
+                case 43:
+                case 44:
+                {
+                    ProgramRegister src;
+                    if (Input(node, 0, -1, Variant::Zero, src))
+                        return true;
+                    return Emit(OpCode::Unary, node->TypeID, src.Width, src.IsConstant, &src, 1, 0, 0, result);
+                }
+                // Lerp
+                case 25:
+                {
+                    ProgramRegister src[3];
+                    if (Input(node, 0, 0, Variant::Zero, src[0]) || Input(node, 1, 1, Variant::One, src[1]) || Input(node, 2, 2, Variant::Zero, src[2]))
+                        return true;
+                    if (Cast(src[1], src[0].Width, src[1]) || Cast(src[2], 1, src[2]))
+                        return true;
+                    return Emit(OpCode::Lerp, 0, src[0].Width, src[0].IsConstant && src[1].IsConstant && src[2].IsConstant, src, 3, 0, 0, result);
+                }
+                default:
+                    break;
+                }
+                break;
+            // Tools
+            case 7:
+                switch (node->TypeID)
+                {
+                // Color Gradient
+                case 10:
+                {
+                    const int32 count = (int32)node->Values[0];
+                    if (count <= 0 || node->Values.Count() < 1 + count * 2)
+                        return true;
+                    if (count == 1)
+                        return Constant(Variant((Color)node->Values[2]), result);
+                    ProgramRegister time;
+                    if (Input(node, 0, -1, Variant::Zero, time) || Cast(time, 1, time))
+                        return true;
+                    const int32 index = Program.Constants.Count();
+                    for (int32 i = 0; i < count; i++)
+                    {
+                        Program.Constants.Add(Float4((float)node->Values[1 + i * 2], 0.0f, 0.0f, 0.0f));
+                        Program.Constants.Add(Float4((Color)node->Values[2 + i * 2]));
+                    }
+                    return Emit(OpCode::Gradient, 0, 4, time.IsConstant, &time, 1, index, count, result);
+                }
+                // Curve
+                case 12:
+                case 13:
+                case 14:
+                case 15:
+                {
+                    ProgramRegister time;
+                    if (Input(node, 0, -1, Variant::Zero, time) || Cast(time, 1, time))
+                        return true;
+                    return Emit(OpCode::Curve, 0, node->TypeID - 11, time.IsConstant, &time, 1, node->CurveIndex, 0, result);
+                }
+                default:
+                    break;
+                }
+                break;
+            // Particles
+            case 14:
+                switch (node->TypeID)
+                {
+                // Particle Attribute (by index)
+                case 303:
+                {
+                    // Only the current particle attribute is supported (reading other particles is left to the graph executor)
+                    const auto indexBox = node->TryGetBox(1);
+                    if (indexBox && indexBox->HasConnection())
+                        return true;
+                    return Attribute(node->Attributes[0], result);
+                }
+                // Particle Attribute
+                case 100:
+                // Particle Position/Lifetime/Age/Color/Velocity/Sprite Size/Mass/Rotation/Angular Velocity/Radius/Scale
+                case 101:
+                case 102:
+                case 103:
+                case 104:
+                case 105:
+                case 106:
+                case 107:
+                case 108:
+                case 109:
+                case 111:
+                case 112:
+                    return Attribute(node->Attributes[0], result);
+                // Particle Normalized Age
+                case 110:
+                    if (GetAttributeWidth(node->Attributes[0]) != 1 || GetAttributeWidth(node->Attributes[1]) != 1)
+                        return true;
+                    return Emit(OpCode::NormalizedAge, 0, 1, false, nullptr, 0, node->Attributes[0], node->Attributes[1], result);
+                // Random Float/Vector2/Vector3/Vector4
+                case 208:
+                case 209:
+                case 210:
+                case 211:
+                    return Emit(OpCode::Random, 0, node->TypeID - 207, false, nullptr, 0, 0, 0, result);
+                default:
+                    break;
+                }
+                break;
+            default:
+                break;
+            }
+
+            // Evaluate other particle-independent values once per module update with the graph executor
+            if (node->UsesParticleData || !node->IsConstant || Program.Hoisted.Count() >= PARTICLE_EMITTER_PROGRAM_MAX_HOISTED)
+                return true;
+            const int32 width = GetHoistedWidth(box);
+            if (width == 0)
+                return true;
+            const int32 index = Program.Hoisted.Count();
+            Program.Hoisted.Add({ box, width });
+            return Emit(OpCode::Hoisted, 0, width, true, nullptr, 0, index, 0, result);
+        }
+    };
+
+    template<typename OpType>
+    FORCE_INLINE void UnaryOp(float* dst, const float* a, int32 count, OpType op)
+    {
+        for (int32 i = 0; i < count; i++)
+            dst[i] = op(a[i]);
+    }
+
+    template<typename OpType>
+    FORCE_INLINE void BinaryOp(float* dst, const float* a, const float* b, int32 count, OpType op)
+    {
+        for (int32 i = 0; i < count; i++)
+            dst[i] = op(a[i], b[i]);
+    }
+
+    // Executes the math operation (matches GraphUtilities::ApplySomeMathHere)
+    void Unary(int32 op, float* dst, const float* a, int32 count)
+    {
+        switch (op)
+        {
+        case 7:
+            UnaryOp(dst, a, count, [](float x) { return Math::Abs(x); });
+            break;
+        case 8:
+            UnaryOp(dst, a, count, [](float x) { return Math::Ceil(x); });
+            break;
+        case 9:
+            UnaryOp(dst, a, count, [](float x) { return Math::Cos(x); });
+            break;
+        case 10:
+            UnaryOp(dst, a, count, [](float x) { return Math::Floor(x); });
+            break;
+        case 13:
+            UnaryOp(dst, a, count, [](float x) { return Math::Round(x); });
+            break;
+        case 14:
+            UnaryOp(dst, a, count, [](float x) { return Math::Saturate(x); });
+            break;
+        case 15:
+            UnaryOp(dst, a, count, [](float x) { return Math::Sin(x); });
+            break;
+        case 16:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Sqrt(SIMD::Load(a + i)));
+            break;
+        case 17:
+            UnaryOp(dst, a, count, [](float x) { return Math::Tan(x); });
+            break;
+        case 27:
+            UnaryOp(dst, a, count, [](float x) { return -x; });
+            break;
+        case 28:
+            UnaryOp(dst, a, count, [](float x) { return 1 - x; });
+            break;
+        case 33:
+            UnaryOp(dst, a, count, [](float x) { return Math::Asin(x); });
+            break;
+        case 34:
+            UnaryOp(dst, a, count, [](float x) { return Math::Acos(x); });
+            break;
+        case 35:
+            UnaryOp(dst, a, count, [](float x) { return Math::Atan(x); });
+            break;
+        case 38:
+            UnaryOp(dst, a, count, [](float x) { return Math::Trunc(x); });
+            break;
+        case 39:
+            UnaryOp(dst, a, count, [](float x)
+            {
+                float tmp;
+                return Math::ModF(x, &tmp);
+            });
+            break;
+        case 43:
+            UnaryOp(dst, a, count, [](float x) { return x * RadiansToDegrees; });
+            break;
+        case 44:
+            UnaryOp(dst, a, count, [](float x) { return x * DegreesToRadians; });
+            break;
+        default:
+            break;
+        }
+    }
+
+    void Binary(int32 op, float* dst, const float* a, const float* b, int32 count)
+    {
+        switch (op)
+        {
+        case 1:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Add(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 2:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Sub(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 3:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Mul(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 5:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Div(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 21:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Max(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 22:
+            for (int32 i = 0; i < count; i += 4)
+                SIMD::Store(dst + i, SIMD::Min(SIMD::Load(a + i), SIMD::Load(b + i)));
+            break;
+        case 23:
+            BinaryOp(dst, a, b, count, [](float x, float y) { return Math::Pow(x, y); });
+            break;
+        case 40:
+            BinaryOp(dst, a, b, count, [](float x, float y) { return Math::Mod(x, y); });
+            break;
+        case 41:
+            BinaryOp(dst, a, b, count, [](float x, float y) { return Math::Atan2(x, y); });
+            break;
+        default:
+            break;
+        }
+    }
+
+    template<typename T>
+    void SampleCurve(const BezierCurve<T>& curve, float* dst, const float* time, int32 count)
+    {
+        constexpr int32 width = sizeof(T) / sizeof(float);
+        T value;
+        for (int32 i = 0; i < count; i++)
+        {
+            curve.Evaluate(value, time[i], false);
+            for (int32 c = 0; c < width; c++)
+                dst[c * BATCH_SIZE + i] = ((const float*)&value)[c];
+        }
+    }
+
+    // Samples the color gradient (matches VisjectExecutor::ProcessGroupTools)
+    void SampleGradient(const Float4* stops, int32 stopsCount, float* dst, const float* time, int32 count)
+    {
+        const float lastTime = stops[stopsCount * 2 - 2].X;
+        const Float4& lastColor = stops[stopsCount * 2 - 1];
+        for (int32 i = 0; i < count; i++)
+        {
+            const float t = time[i];
+            Float4 color = lastColor;
+            if (stopsCount == 2 || t < lastTime)
+            {
+                for (int32 s = 1; s < stopsCount; s++)
+                {
+                    const float prevTime = stops[s * 2 - 2].X, curTime = stops[s * 2].X;
+                    if (t <= curTime || s == stopsCount - 1)
+                    {
+                        color = Float4::Lerp(stops[s * 2 - 1], stops[s * 2 + 1], Math::Saturate((t - prevTime) / (curTime - prevTime)));
+                        break;
+                    }
+                }
+            }
+            for (int32 c = 0; c < 4; c++)
+                dst[c * BATCH_SIZE + i] = color.Raw[c];
+        }
+    }
+
+    void ExecuteInstruction(const Instruction& e, const ParticleEmitterGraphCPU* graph, ParticleBuffer* buffer, float* registers, const Float4* constants, const Float4* hoisted, int32 particlesStart, int32 count, float deltaTime)
+    {
+        float* dst = GET_REGISTER(e.Dst);
+        const float* a = GET_REGISTER(e.Src[0]);
+
+        // Math operations process the whole SIMD vectors (registers are padded to the batch size)
+        const int32 countAligned = Math::AlignUp(count, 4);
+        switch (e.Code)
+        {
+        case OpCode::Constant:
+        case OpCode::Hoisted:
+        {
+            const Float4& value = e.Code == OpCode::Constant ? constants[e.Index[0]] : hoisted[e.Index[0]];
+            for (int32 c = 0; c < e.Width; c++)
+            {
+                float* ptr = dst + c * BATCH_SIZE;
+                for (int32 i = 0; i < count; i++)
+                    ptr[i] = value.Raw[c];
+            }
+            break;
+        }
+        case OpCode::Attribute:
+        {
+            const auto& attribute = buffer->Layout->Attributes[e.Index[0]];
+            const byte* ptr = buffer->GetAttributeCPU(particlesStart, attribute);
+            const int32 stride = buffer->GetAttributeStride(attribute);
+            for (int32 i = 0; i < count; i++)
+            {
+                for (int32 c = 0; c < e.Width; c++)
+                    dst[c * BATCH_SIZE + i] = ((const float*)ptr)[c];
+                ptr += stride;
+            }
+            break;
+        }
+        case OpCode::NormalizedAge:
+        {
+            const auto& ageAttribute = buffer->Layout->Attributes[e.Index[0]];
+            const auto& lifetimeAttribute = buffer->Layout->Attributes[e.Index[1]];
+            const byte* agePtr = buffer->GetAttributeCPU(particlesStart, ageAttribute);
+            const int32 ageStride = buffer->GetAttributeStride(ageAttribute);
+            const byte* lifetimePtr = buffer->GetAttributeCPU(particlesStart, lifetimeAttribute);
+            const int32 lifetimeStride = buffer->GetAttributeStride(lifetimeAttribute);
+            for (int32 i = 0; i < count; i++)
+            {
+                dst[i] = *(const float*)agePtr / Math::Max(*(const float*)lifetimePtr, ZeroTolerance);
+                agePtr += ageStride;
+                lifetimePtr += lifetimeStride;
+            }
+            break;
+        }
+        case OpCode::Random:
+            for (int32 i = 0; i < count; i++)
+            {
+                for (int32 c = 0; c < e.Width; c++)
+                    dst[c * BATCH_SIZE + i] = Random::Rand();
+            }
+            break;
+        case OpCode::Cast:
+            for (int32 c = 0; c < e.Width; c++)
+            {
+                // Scalar is replicated, vector is truncated or extended with zeros
+                float* ptr = dst + c * BATCH_SIZE;
+                if (e.Op == 1 || c < e.Op)
+                    Platform::MemoryCopy(ptr, e.Op == 1 ? a : a + c * BATCH_SIZE, count * sizeof(float));
+                else
+                    Platform::MemoryClear(ptr, count * sizeof(float));
+            }
+            break;
+        case OpCode::Unary:
+            for (int32 c = 0; c < e.Width; c++)
+                Unary(e.Op, dst + c * BATCH_SIZE, a + c * BATCH_SIZE, countAligned);
+            break;
+        case OpCode::Binary:
+        {
+            const float* b = GET_REGISTER(e.Src[1]);
+            for (int32 c = 0; c < e.Width; c++)
+                Binary(e.Op, dst + c * BATCH_SIZE, a + c * BATCH_SIZE, b + c * BATCH_SIZE, countAligned);
+            break;
+        }
+        case OpCode::Lerp:
+        {
+            const float* b = GET_REGISTER(e.Src[1]);
+            const float* alpha = GET_REGISTER(e.Src[2]);
+            for (int32 c = 0; c < e.Width; c++)
+            {
+                float* dstPtr = dst + c * BATCH_SIZE;
+                const float* aPtr = a + c * BATCH_SIZE;
+                const float* bPtr = b + c * BATCH_SIZE;
+                for (int32 i = 0; i < countAligned; i += 4)
+                {
+                    const SimdVector4 aV = SIMD::Load(aPtr + i);
+                    SIMD::Store(dstPtr + i, SIMD::Add(aV, SIMD::Mul(SIMD::Load(alpha + i), SIMD::Sub(SIMD::Load(bPtr + i), aV))));
+                }
+            }
+            break;
+        }
+        case OpCode::Curve:
+            switch (e.Width)
+            {
+            case 1:
+                SampleCurve(graph->FloatCurves[e.Index[0]], dst, a, count);
+                break;
+            case 2:
+                SampleCurve(graph->Float2Curves[e.Index[0]], dst, a, count);
+                break;
+            case 3:
+                SampleCurve(graph->Float3Curves[e.Index[0]], dst, a, count);
+                break;
+            case 4:
+                SampleCurve(graph->Float4Curves[e.Index[0]], dst, a, count);
+                break;
+            }
+            break;
+        case OpCode::Gradient:
+            SampleGradient(constants + e.Index[0], e.Index[1], dst, a, count);
+            break;
+        case OpCode::Store:
+        case OpCode::StoreAddScaled:
+        {
+            const auto& attribute = buffer->Layout->Attributes[e.Index[0]];
+            byte* ptr = buffer->GetAttributeCPU(particlesStart, attribute);
+            const int32 stride = buffer->GetAttributeStride(attribute);
+            if (e.Code == OpCode::Store)
+            {
+                for (int32 i = 0; i < count; i++)
+                {
+                    for (int32 c = 0; c < e.Width; c++)
+                        ((float*)ptr)[c] = a[c * BATCH_SIZE + i];
+                    ptr += stride;
+                }
+            }
+            else
+            {
+                for (int32 i = 0; i < count; i++)
+                {
+                    for (int32 c = 0; c < e.Width; c++)
+                        ((float*)ptr)[c] += a[c * BATCH_SIZE + i] * deltaTime;
+                    ptr += stride;
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+int32 ParticleEmitterGraphCPUProgram::GetWidth(VariantType::Types type)
+{
+    switch (type)
+    {
+    case VariantType::Float:
+        return 1;
+    case VariantType::Float2:
+        return 2;
+    case VariantType::Float3:
+        return 3;
+    case VariantType::Float4:
+    case VariantType::Color:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool ParticleEmitterGraphCPUProgram::Compile(ParticleEmitterGraphCPU& graph, ParticleEmitterGraphCPUNode* module)
+{
+    Setup.Clear();
+    Instructions.Clear();
+    Constants.Clear();
+    Hoisted.Clear();
+    RegistersCount = 0;
+    Graph = &graph;
+    ProgramCompiler compiler(graph, *this);
+
+    // Get the module input and the way it's applied to the particle attribute
+    OpCode storeCode;
+    int32 width;
+    switch (module->Type)
+    {
+    // Set Attribute
+    case GRAPH_NODE_MAKE_TYPE(15, 200):
+    case GRAPH_NODE_MAKE_TYPE(15, 302):
+    // Set Position/Lifetime/Age/..
+    case GRAPH_NODE_MAKE_TYPE(15, 250):
+    case GRAPH_NODE_MAKE_TYPE(15, 251):
+    case GRAPH_NODE_MAKE_TYPE(15, 252):
+    case GRAPH_NODE_MAKE_TYPE(15, 253):
+    case GRAPH_NODE_MAKE_TYPE(15, 254):
+    case GRAPH_NODE_MAKE_TYPE(15, 255):
+    case GRAPH_NODE_MAKE_TYPE(15, 256):
+    case GRAPH_NODE_MAKE_TYPE(15, 257):
+    case GRAPH_NODE_MAKE_TYPE(15, 258):
+    case GRAPH_NODE_MAKE_TYPE(15, 259):
+    case GRAPH_NODE_MAKE_TYPE(15, 260):
+    case GRAPH_NODE_MAKE_TYPE(15, 261):
+    case GRAPH_NODE_MAKE_TYPE(15, 262):
+    case GRAPH_NODE_MAKE_TYPE(15, 263):
+    case GRAPH_NODE_MAKE_TYPE(15, 350):
+    case GRAPH_NODE_MAKE_TYPE(15, 351):
+    case GRAPH_NODE_MAKE_TYPE(15, 352):
+    case GRAPH_NODE_MAKE_TYPE(15, 353):
+    case GRAPH_NODE_MAKE_TYPE(15, 354):
+    case GRAPH_NODE_MAKE_TYPE(15, 355):
+    case GRAPH_NODE_MAKE_TYPE(15, 356):
+    case GRAPH_NODE_MAKE_TYPE(15, 357):
+    case GRAPH_NODE_MAKE_TYPE(15, 358):
+    case GRAPH_NODE_MAKE_TYPE(15, 359):
+    case GRAPH_NODE_MAKE_TYPE(15, 360):
+    case GRAPH_NODE_MAKE_TYPE(15, 361):
+    case GRAPH_NODE_MAKE_TYPE(15, 362):
+    case GRAPH_NODE_MAKE_TYPE(15, 363):
+        storeCode = OpCode::Store;
+        width = compiler.GetAttributeWidth(module->Attributes[0]);
+        break;
+    // Gravity/Force
+    case GRAPH_NODE_MAKE_TYPE(15, 301):
+    case GRAPH_NODE_MAKE_TYPE(15, 304):
+        storeCode = OpCode::StoreAddScaled;
+        width = compiler.GetAttributeWidth(module->Attributes[0]) == 3 ? 3 : 0;
+        break;
+    default:
+        return true;
+    }
+    const auto box = module->TryGetBox(0);
+    if (width == 0 || !box || !box->HasConnection())
+        return true;
+
+    // Lower the input graph into instructions and write the result to the particle attribute
+    ProgramRegister value, result;
+    if (compiler.CompileBox((ParticleEmitterGraphCPUBox*)box->FirstConnection(), value) ||
+        compiler.Cast(value, width, value) ||
+        compiler.Emit(storeCode, 0, width, false, &value, 1, module->Attributes[0], 0, result))
+        return true;
+    return false;
+}
+
+void ParticleEmitterGraphCPUProgram::Execute(ParticleBuffer* buffer, float* registers, const Float4* hoisted, int32 particlesStart, int32 particlesEnd, float deltaTime) const
+{
+    // Compute particle-independent values for the whole batch (registers are not overwritten later)
+    for (const Instruction& e : Setup)
+        ExecuteInstruction(e, Graph, buffer, registers, Constants.Get(), hoisted, particlesStart, BATCH_SIZE, deltaTime);
+
+    for (int32 batchStart = particlesStart; batchStart < particlesEnd; batchStart += BATCH_SIZE)
+    {
+        const int32 count = Math::Min(particlesEnd - batchStart, BATCH_SIZE);
+        for (const Instruction& e : Instructions)
+            ExecuteInstruction(e, Graph, buffer, registers, Constants.Get(), hoisted, batchStart, count, deltaTime);
+    }
+}
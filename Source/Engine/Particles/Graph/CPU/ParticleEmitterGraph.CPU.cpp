@@ -5,6 +5,7 @@
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Particles/ParticleEffect.h"
+#include "Engine/Particles/ParticleStreams.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Debug/DebugDraw.h"
@@ -90,6 +91,23 @@ bool ParticleEmitterGraphCPU::Load(ReadStream* stream, bool loadMeta)
         }
     }
 
+    // Compile the modules that evaluate inputs per-particle into programs that process batches of particles
+    Programs.Clear();
+#define COMPILE_MODULES(modules) \
+    for (int32 i = 0; i < modules.Count(); i++) \
+    { \
+        const auto module = modules[i]; \
+        ParticleEmitterGraphCPUProgram program; \
+        if (module->UsePerParticleDataResolve() && !program.Compile(*this, module)) \
+        { \
+            module->ProgramIndex = Programs.Count(); \
+            Programs.Add(MoveTemp(program)); \
+        } \
+    }
+    COMPILE_MODULES(InitModules);
+    COMPILE_MODULES(UpdateModules);
+#undef COMPILE_MODULES
+
     return false;
 }
 
@@ -134,7 +152,7 @@ void ParticleEmitterGraphCPUExecutor::Init(ParticleEmitter* emitter, ParticleEff
     context.Effect = effect;
     context.DeltaTime = dt;
     context.ParticleIndex = 0;
-    context.ViewTask = effect->GetRenderTask();
+    context.ViewTask = effect ? effect->GetRenderTask() : nullptr;
     context.CallStackSize = 0;
     context.Functions.Clear();
     for (int32 i = 0; i < PARTICLE_ATTRIBUTES_MAX_COUNT; i++)
@@ -152,18 +170,18 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
         _graph._attrPosition != -1)
     {
         const int32 count = data.Buffer->CPU.Count;
-        byte* bufferPtr = data.Buffer->CPU.Buffer.Get();
+        auto buffer = data.Buffer;
         auto layout = data.Buffer->Layout;
-        const int32 stride = data.Buffer->Stride;
 
         // Build sphere bounds out of all living particles positions
-        byte* positionPtr = bufferPtr + layout->Attributes[_graph._attrPosition].Offset;
+        byte* positionPtr = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrPosition]);
+        const int32 positionStride = buffer->GetAttributeStride(layout->Attributes[_graph._attrPosition]);
 #if 0
         BoundingSphere sphere(*((Float3*)positionPtr), 0.0f);
         for (int32 particleIndex = 0; particleIndex < count; particleIndex++)
         {
             BoundingSphere::Merge(sphere, *((Float3*)positionPtr), &sphere);
-            positionPtr += stride;
+            positionPtr += positionStride;
         }
 #endif
 #if 0
@@ -174,18 +192,18 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
             for (int32 i = 0; i < count; i++)
             {
                 Vector3::Add(*((Float3*)positionPtr), center, &center);
-                positionPtr += stride;
+                positionPtr += positionStride;
             }
             center /= static_cast<float>(count);
 
             // Find the radius of the sphere
             float radius = 0.0f;
-            positionPtr = bufferPtr + layout->Attributes[_attrPosition].Offset;
+            positionPtr = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrPosition]);
             for (int32 i = 0; i < count; i++)
             {
                 // We are doing a relative distance comparison to find the maximum distance from the center of our sphere
                 const float distance = Float3::DistanceSquared(center, *(Float3*)positionPtr);
-                positionPtr += stride;
+                positionPtr += positionStride;
 
                 if (distance > radius)
                     radius = distance;
@@ -211,7 +229,7 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                     Vector3::Min(box.Minimum, position, box.Minimum);
                     Vector3::Max(box.Maximum, position, box.Maximum);
                 }
-                positionPtr += stride;
+                positionPtr += positionStride;
             }
             BoundingSphere::FromBox(box, sphere);
 #if ENABLE_ASSERTION
@@ -239,11 +257,12 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum local bounds of the particle sprite
                     Vector2 maxSpriteSize = Vector2::Zero;
-                    byte* spriteSize = bufferPtr + layout->Attributes[_graph._attrSpriteSize].Offset;
+                    byte* spriteSize = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrSpriteSize]);
+                    const int32 spriteSizeStride = buffer->GetAttributeStride(layout->Attributes[_graph._attrSpriteSize]);
                     for (int32 i = 0; i < count; i++)
                     {
                         Vector2::Max(*((Vector2*)spriteSize), maxSpriteSize, maxSpriteSize);
-                        spriteSize += stride;
+                        spriteSize += spriteSizeStride;
                     }
                     CHECK_RETURN(!maxSpriteSize.IsNanOrInfinity(), false);
 
@@ -288,11 +307,12 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum local bounds of the particle model
                     Float3 maxScale = Float3::Zero;
-                    byte* scale = bufferPtr + layout->Attributes[_graph._attrScale].Offset;
+                    byte* scale = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrScale]);
+                    const int32 scaleStride = buffer->GetAttributeStride(layout->Attributes[_graph._attrScale]);
                     for (int32 i = 0; i < count; i++)
                     {
                         Float3::Max(*((Float3*)scale), maxScale, maxScale);
-                        scale += stride;
+                        scale += scaleStride;
                     }
 
                     // Enlarge the emitter bounds sphere
@@ -310,11 +330,12 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum ribbon width of the particle
                     float maxRibbonWidth = 0.0f;
-                    byte* ribbonWidth = bufferPtr + layout->Attributes[_graph._attrRibbonWidth].Offset;
+                    byte* ribbonWidth = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrRibbonWidth]);
+                    const int32 ribbonWidthStride = buffer->GetAttributeStride(layout->Attributes[_graph._attrRibbonWidth]);
                     for (int32 i = 0; i < count; i++)
                     {
                         maxRibbonWidth = Math::Max(*((float*)ribbonWidth), maxRibbonWidth);
-                        ribbonWidth += stride;
+                        ribbonWidth += ribbonWidthStride;
                     }
                     CHECK_RETURN(!isnan(maxRibbonWidth) && !isinf(maxRibbonWidth), false);
 
@@ -330,11 +351,12 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 float maxRadius = 0.0f;
                 if (_graph._attrRadius != -1)
                 {
-                    byte* radius = bufferPtr + layout->Attributes[_graph._attrRadius].Offset;
+                    byte* radius = buffer->GetAttributeCPU(0, layout->Attributes[_graph._attrRadius]);
+                    const int32 radiusStride = buffer->GetAttributeStride(layout->Attributes[_graph._attrRadius]);
                     for (int32 i = 0; i < count; i++)
                     {
                         maxRadius = Math::Max(*((float*)radius), maxRadius);
-                        radius += stride;
+                        radius += radiusStride;
                     }
                     CHECK_RETURN(!isnan(maxRadius) && !isinf(maxRadius), false);
                 }
@@ -375,9 +397,9 @@ void ParticleEmitterGraphCPUExecutor::Draw(ParticleEmitter* emitter, ParticleEff
 
     // Prepare particles buffer access
     auto buffer = data.Buffer;
-    byte* positionPtr = buffer->CPU.Buffer.Get() + buffer->Layout->Attributes[_graph._attrPosition].Offset;
+    byte* positionPtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrPosition]);
+    const int32 positionStride = buffer->GetAttributeStride(buffer->Layout->Attributes[_graph._attrPosition]);
     const int32 count = buffer->CPU.Count;
-    const int32 stride = buffer->Stride;
 
     // Prepare graph data
     Init(emitter, effect, data);
@@ -419,7 +441,7 @@ void ParticleEmitterGraphCPUExecutor::Draw(ParticleEmitter* emitter, ParticleEff
 
             renderContext.List->PointLights.Add(lightData);
 
-            positionPtr += stride;
+            positionPtr += positionStride;
         }
     }
 }
@@ -448,7 +470,9 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     // Prepare data
     Init(emitter, effect, data, dt);
     auto& context = Context.Get();
-    auto& cpu = data.Buffer->CPU;
+    auto buffer = data.Buffer;
+    auto& cpu = buffer->CPU;
+    const bool useStreams = buffer->BufferLayout == ParticleBufferLayout::SoA;
 
     // Update particles
     if (cpu.Count > 0)
@@ -464,20 +488,32 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (_graph._attrAge != -1 && _graph._attrLifetime != -1)
     {
         PROFILE_CPU_NAMED("Age kill");
-        byte* agePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAge].Offset;
-        byte* lifetimePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrLifetime].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+        byte* agePtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrAge]);
+        byte* lifetimePtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrLifetime]);
+        if (useStreams)
         {
-            if (*(float*)agePtr >= *(float*)lifetimePtr)
+            int32 particleIndex = 0;
+            while ((particleIndex = ParticleStreams::FindDead((const float*)agePtr, (const float*)lifetimePtr, particleIndex, cpu.Count)) != cpu.Count)
             {
                 cpu.Count--;
-                Platform::MemoryCopy(data.Buffer->GetParticleCPU(particleIndex), data.Buffer->GetParticleCPU(cpu.Count), data.Buffer->Stride);
-                particleIndex--;
+                buffer->CopyParticleCPU(particleIndex, cpu.Count);
             }
-            else
+        }
+        else
+        {
+            for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
             {
-                agePtr += data.Buffer->Stride;
-                lifetimePtr += data.Buffer->Stride;
+                if (*(float*)agePtr >= *(float*)lifetimePtr)
+                {
+                    cpu.Count--;
+                    buffer->CopyParticleCPU(particleIndex, cpu.Count);
+                    particleIndex--;
+                }
+                else
+                {
+                    agePtr += buffer->Stride;
+                    lifetimePtr += buffer->Stride;
+                }
             }
         }
     }
@@ -486,12 +522,10 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     // Debug validation for NANs in data
     if (_graph._attrPosition != -1)
     {
-        byte* positionPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrPosition].Offset;
         for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
         {
-            Float3 pos = *((Float3*)positionPtr);
+            Float3 pos = *((Float3*)buffer->GetAttributeCPU(particleIndex, buffer->Layout->Attributes[_graph._attrPosition]));
             ASSERT(!pos.IsNanOrInfinity());
-            positionPtr += data.Buffer->Stride;
         }
     }
 #endif
@@ -500,13 +534,20 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (_graph._attrPosition != -1 && _graph._attrVelocity != -1)
     {
         PROFILE_CPU_NAMED("Euler Integration");
-        byte* positionPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrPosition].Offset;
-        byte* velocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+        byte* positionPtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrPosition]);
+        byte* velocityPtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrVelocity]);
+        if (useStreams)
         {
-            *((Float3*)positionPtr) += *((Float3*)velocityPtr) * dt;
-            positionPtr += data.Buffer->Stride;
-            velocityPtr += data.Buffer->Stride;
+            ParticleStreams::MultiplyAdd((Float3*)positionPtr, (const Float3*)velocityPtr, dt, cpu.Count);
+        }
+        else
+        {
+            for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+            {
+                *((Float3*)positionPtr) += *((Float3*)velocityPtr) * dt;
+                positionPtr += buffer->Stride;
+                velocityPtr += buffer->Stride;
+            }
         }
     }
 
@@ -514,13 +555,20 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (_graph._attrRotation != -1 && _graph._attrAngularVelocity != -1)
     {
         PROFILE_CPU_NAMED("Angular Euler Integration");
-        byte* rotationPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrRotation].Offset;
-        byte* angularVelocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAngularVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+        byte* rotationPtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrRotation]);
+        byte* angularVelocityPtr = buffer->GetAttributeCPU(0, buffer->Layout->Attributes[_graph._attrAngularVelocity]);
+        if (useStreams)
+        {
+            ParticleStreams::MultiplyAdd((Float3*)rotationPtr, (const Float3*)angularVelocityPtr, dt, cpu.Count);
+        }
+        else
         {
-            *((Float3*)rotationPtr) += *((Float3*)angularVelocityPtr) * dt;
-            rotationPtr += data.Buffer->Stride;
-            angularVelocityPtr += data.Buffer->Stride;
+            for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+            {
+                *((Float3*)rotationPtr) += *((Float3*)angularVelocityPtr) * dt;
+                rotationPtr += buffer->Stride;
+                angularVelocityPtr += buffer->Stride;
+            }
         }
     }
 
@@ -546,9 +594,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
             data.Buffer->CPU.Count = countAfter;
 
             // Initialize particles data
-            //Platform::MemoryClear(data.Buffer->GetParticleCPU(countBefore), spawnCount * data.Buffer->Stride);
-            for (int32 i = 0; i < spawnCount; i++)
-                Platform::MemoryCopy(data.Buffer->GetParticleCPU(countBefore + i), _graph._defaultParticleData.Get(), data.Buffer->Stride);
+            buffer->SetParticlesCPU(countBefore, spawnCount, _graph._defaultParticleData.Get());
 
             // Initialize particles
             for (int32 i = 0; i < _graph.InitModules.Count(); i++)
@@ -586,6 +632,13 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     }
 }
 
+void ParticleEmitterGraphCPUExecutor::UpdateModule(ParticleEmitterGraphCPUNode* module, ParticleEmitterInstance& data, float dt)
+{
+    Init(nullptr, nullptr, data, dt);
+    if (data.Buffer->CPU.Count > 0)
+        ProcessModule(module, 0, data.Buffer->CPU.Count);
+}
+
 int32 ParticleEmitterGraphCPUExecutor::UpdateSpawn(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt)
 {
     PROFILE_CPU_NAMED("Spawn");
@@ -6,6 +6,7 @@
 #include "Engine/Particles/ParticlesSimulation.h"
 #include "Engine/Particles/ParticlesData.h"
 #include "Engine/Visject/VisjectGraph.h"
+#include "Engine/Core/Math/Vector4.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Threading/ThreadLocal.h"
 
@@ -30,6 +31,15 @@ class ParticleEmitterGraphCPUExecutor;
 
 #define PARTICLE_EMITTER_MAX_CALL_STACK 100
 
+// The amount of particles processed at once by the compiled module programs
+#define PARTICLE_EMITTER_PROGRAM_BATCH_SIZE 64
+
+// The maximum amount of registers used by the compiled module program (each register holds up to 4 components for every particle in a batch)
+#define PARTICLE_EMITTER_PROGRAM_MAX_REGISTERS 32
+
+// The maximum amount of particle-independent graph values used by the compiled module program
+#define PARTICLE_EMITTER_PROGRAM_MAX_HOISTED 16
+
 class ParticleEmitterGraphCPUBox : public VisjectGraphBox
 {
 };
@@ -48,6 +58,11 @@ class ParticleEmitterGraphCPUNode : public ParticleEmitterGraphNode<VisjectGraph
         int32 RibbonOrderOffset;
     };
 
+    /// <summary>
+    /// The index of the compiled program used to evaluate the module inputs for batches of particles (see ParticleEmitterGraphCPU::Programs), or -1 if module uses per-particle graph evaluation.
+    /// </summary>
+    int32 ProgramIndex = -1;
+
     /// <summary>
     /// True if this node uses the per-particle data resolve instead of optimized whole-collection fetch.
     /// </summary>
@@ -57,6 +72,133 @@ class ParticleEmitterGraphCPUNode : public ParticleEmitterGraphNode<VisjectGraph
     }
 };
 
+/// <summary>
+/// The particle module inputs graph lowered into the flat list of register-based instructions that operate on the particle attribute streams. Used to evaluate the module for batches of particles instead of the recursive per-particle graph evaluation with Variant values.
+/// </summary>
+/// <remarks>
+/// Registers hold up to 4 float components for every particle in a batch (stored per component). Particle-independent values (constants, parameters and math on them) are computed once per module update by the setup instructions into the registers that are never overwritten by the per-batch instructions.
+/// </remarks>
+class FLAXENGINE_API ParticleEmitterGraphCPUProgram
+{
+public:
+    enum class OpCode : byte
+    {
+        // Dst = Constants[Index[0]]
+        Constant,
+        // Dst = hoisted[Index[0]] (the particle-independent graph value evaluated once per module update)
+        Hoisted,
+        // Dst = particle attribute Index[0]
+        Attribute,
+        // Dst = particle attribute Index[0] / Max(particle attribute Index[1], ZeroTolerance)
+        NormalizedAge,
+        // Dst = random value in range [0;1] (drawn per particle and then per component, so a single random node gives the same values as the per-particle graph evaluation)
+        Random,
+        // Dst = Src[0] converted to Width components (follows the Variant cast rules)
+        Cast,
+        // Dst = Op(Src[0])
+        Unary,
+        // Dst = Op(Src[0], Src[1])
+        Binary,
+        // Dst = Lerp(Src[0], Src[1], Src[2].X)
+        Lerp,
+        // Dst = graph curve Index[0] (of Width components) sampled at Src[0].X
+        Curve,
+        // Dst = color gradient with Index[1] stops (time and color pairs stored at Constants[Index[0]]) sampled at Src[0].X
+        Gradient,
+        // particle attribute Index[0] = Src[0]
+        Store,
+        // particle attribute Index[0] += Src[0] * deltaTime
+        StoreAddScaled,
+    };
+
+    struct Instruction
+    {
+        OpCode Code;
+        // The math node type for Unary/Binary operation or the source components count for Cast.
+        byte Op;
+        // The destination components count.
+        byte Width;
+        byte Dst;
+        byte Src[3];
+        // The constant, hoisted value or particle attribute indices.
+        int16 Index[2];
+    };
+
+    struct HoistedValue
+    {
+        // The graph box to evaluate.
+        ParticleEmitterGraphCPUBox* Box;
+        // The value components count.
+        int32 Width;
+    };
+
+public:
+    /// <summary>
+    /// The instructions executed once per module update (computes the particle-independent values).
+    /// </summary>
+    Array<Instruction> Setup;
+
+    /// <summary>
+    /// The instructions executed for every batch of particles.
+    /// </summary>
+    Array<Instruction> Instructions;
+
+    /// <summary>
+    /// The constant values folded during compilation.
+    /// </summary>
+    Array<Float4> Constants;
+
+    /// <summary>
+    /// The particle-independent graph values that are evaluated once per module update (eg. parameters).
+    /// </summary>
+    Array<HoistedValue, FixedAllocation<PARTICLE_EMITTER_PROGRAM_MAX_HOISTED>> Hoisted;
+
+    /// <summary>
+    /// The amount of used registers.
+    /// </summary>
+    int32 RegistersCount = 0;
+
+    /// <summary>
+    /// The graph that owns the program (used to sample the graph curves).
+    /// </summary>
+    const ParticleEmitterGraphCPU* Graph = nullptr;
+
+public:
+    /// <summary>
+    /// Gets the size of the registers memory (in floats) required to execute the program.
+    /// </summary>
+    FORCE_INLINE int32 GetRegistersSize() const
+    {
+        return RegistersCount * 4 * PARTICLE_EMITTER_PROGRAM_BATCH_SIZE;
+    }
+
+    /// <summary>
+    /// Gets the components count of the value type supported by the programs (floating-point scalar or vector).
+    /// </summary>
+    /// <param name="type">The value type.</param>
+    /// <returns>The components count or 0 if type is not supported.</returns>
+    static int32 GetWidth(VariantType::Types type);
+
+    /// <summary>
+    /// Compiles the particle module inputs graph. Fails if graph uses nodes that are not supported by the programs (module should use per-particle graph evaluation then).
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="module">The particle module node.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Compile(ParticleEmitterGraphCPU& graph, ParticleEmitterGraphCPUNode* module);
+
+    /// <summary>
+    /// Executes the program for the range of particles.
+    /// </summary>
+    /// <param name="buffer">The particles buffer.</param>
+    /// <param name="registers">The registers memory (see GetRegistersSize).</param>
+    /// <param name="hoisted">The evaluated values of the particle-independent graph values (see Hoisted).</param>
+    /// <param name="particlesStart">The first particle index.</param>
+    /// <param name="particlesEnd">The end particle index (exclusive).</param>
+    /// <param name="deltaTime">The simulation delta time (in seconds).</param>
+    void Execute(ParticleBuffer* buffer, float* registers, const Float4* hoisted, int32 particlesStart, int32 particlesEnd, float deltaTime) const;
+};
+
 /// <summary>
 /// The Particle Emitter Graph used to simulate CPU particles.
 /// </summary>
@@ -79,6 +221,9 @@ class ParticleEmitterGraphCPU : public ParticleEmitterGraph<VisjectGraph<Particl
     // Size of the custom pre-node data buffer used for state tracking (eg. position on spiral arc progression).
     int32 CustomDataSize = 0;
 
+    // The compiled programs of the particle modules that evaluate inputs per-particle (see ParticleEmitterGraphCPUNode::ProgramIndex).
+    Array<ParticleEmitterGraphCPUProgram> Programs;
+
     /// <summary>
     /// Creates the default surface graph (the main root node) for the particle emitter. Ensure to dispose the previous graph data before.
     /// </summary>
@@ -122,6 +267,7 @@ struct ParticleEmitterGraphCPUContext
     byte AttributesRemappingTable[PARTICLE_ATTRIBUTES_MAX_COUNT]; // Maps node attribute indices to the current particle layout (used to support accessing particle data from function graph which has different layout).
     int32 CallStackSize = 0;
     VisjectExecutor::Node* CallStack[PARTICLE_EMITTER_MAX_CALL_STACK];
+    Array<float> ProgramRegisters; // The registers memory used to execute the compiled module programs.
 };
 
 /// <summary>
@@ -192,6 +338,14 @@ class ParticleEmitterGraphCPUExecutor : public VisjectExecutor
     /// <returns>The particles to spawn count</returns>
     int32 UpdateSpawn(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt);
 
+    /// <summary>
+    /// Updates the particles with a single module (uses the module program if it has been compiled). Effect and emitter data is not available, so the module cannot use it.
+    /// </summary>
+    /// <param name="module">The particle module node.</param>
+    /// <param name="data">The instance data.</param>
+    /// <param name="dt">The delta time (in seconds).</param>
+    void UpdateModule(ParticleEmitterGraphCPUNode* module, ParticleEmitterInstance& data, float dt);
+
 private:
     void Init(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt = 0.0f);
     Value eatBox(Node* caller, Box* box) override;
@@ -205,6 +359,7 @@ class ParticleEmitterGraphCPUExecutor : public VisjectExecutor
 
     int32 ProcessSpawnModule(int32 index);
     void ProcessModule(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd);
+    bool ProcessModuleProgram(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd);
 #if USE_EDITOR
     void DebugDrawModule(ParticleEmitterGraphCPUNode* node, const Transform& transform);
 #endif
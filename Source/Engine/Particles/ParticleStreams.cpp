@@ -0,0 +1,124 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "ParticleStreams.h"
+#include "Engine/Core/SIMD.h"
+
+void ParticleStreams::Add(float* data, float value, int32 count)
+{
+    const SimdVector4 valueV = SIMD::Splat(value);
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        SIMD::Store(data + i, SIMD::Add(SIMD::Load(data + i), valueV));
+    for (; i < count; i++)
+        data[i] += value;
+}
+
+void ParticleStreams::Add(Float3* data, const Float3& value, int32 count)
+{
+    // Process 4 elements at once as 3 vectors with the value components pattern repeated
+    float* ptr = data->Raw;
+    const SimdVector4 valueA = SIMD::Load(value.X, value.Y, value.Z, value.X);
+    const SimdVector4 valueB = SIMD::Load(value.Y, value.Z, value.X, value.Y);
+    const SimdVector4 valueC = SIMD::Load(value.Z, value.X, value.Y, value.Z);
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        SIMD::Store(ptr, SIMD::Add(SIMD::Load(ptr), valueA));
+        SIMD::Store(ptr + 4, SIMD::Add(SIMD::Load(ptr + 4), valueB));
+        SIMD::Store(ptr + 8, SIMD::Add(SIMD::Load(ptr + 8), valueC));
+        ptr += 12;
+    }
+    for (; i < count; i++)
+        data[i] += value;
+}
+
+void ParticleStreams::MultiplyAdd(Float3* data, const Float3* src, float scale, int32 count)
+{
+    // Streams have the same layout so process them as plain floats
+    float* dstPtr = data->Raw;
+    const float* srcPtr = src->Raw;
+    const int32 floatsCount = count * 3;
+    const SimdVector4 scaleV = SIMD::Splat(scale);
+    int32 i = 0;
+    for (; i + 4 <= floatsCount; i += 4)
+        SIMD::Store(dstPtr + i, SIMD::Add(SIMD::Load(dstPtr + i), SIMD::Mul(SIMD::Load(srcPtr + i), scaleV)));
+    for (; i < floatsCount; i++)
+        dstPtr[i] += srcPtr[i] * scale;
+}
+
+void ParticleStreams::LinearDrag(Float3* velocity, const float* mass, const Float2* spriteSize, float drag, float deltaTime, int32 count)
+{
+    const SimdVector4 zero = SIMD::Splat(0.0f);
+    const SimdVector4 one = SIMD::Splat(1.0f);
+    const SimdVector4 massMin = SIMD::Splat(ZeroTolerance);
+    const SimdVector4 deltaTimeV = SIMD::Splat(deltaTime);
+    float* ptr = velocity->Raw;
+    float factors[4];
+    int32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Calculate velocity scale for 4 particles
+        SimdVector4 dragV = SIMD::Splat(drag);
+        if (spriteSize)
+            dragV = SIMD::Mul(dragV, SIMD::Load(spriteSize[i].MulValues(), spriteSize[i + 1].MulValues(), spriteSize[i + 2].MulValues(), spriteSize[i + 3].MulValues()));
+        const SimdVector4 factor = SIMD::Max(zero, SIMD::Sub(one, SIMD::Div(SIMD::Mul(dragV, deltaTimeV), SIMD::Max(SIMD::Load(mass + i), massMin))));
+        SIMD::Store(factors, factor);
+
+        // Scale 4 velocities (12 floats)
+        SIMD::Store(ptr, SIMD::Mul(SIMD::Load(ptr), SIMD::Load(factors[0], factors[0], factors[0], factors[1])));
+        SIMD::Store(ptr + 4, SIMD::Mul(SIMD::Load(ptr + 4), SIMD::Load(factors[1], factors[1], factors[2], factors[2])));
+        SIMD::Store(ptr + 8, SIMD::Mul(SIMD::Load(ptr + 8), SIMD::Load(factors[2], factors[3], factors[3], factors[3])));
+        ptr += 12;
+    }
+    for (; i < count; i++)
+    {
+        float particleDrag = drag;
+        if (spriteSize)
+            particleDrag *= spriteSize[i].MulValues();
+        velocity[i] *= Math::Max(0.0f, 1.0f - (particleDrag * deltaTime) / Math::Max(mass[i], ZeroTolerance));
+    }
+}
+
+int32 ParticleStreams::FindDead(const float* age, const float* lifetime, int32 start, int32 count)
+{
+    int32 i = start;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Skip quickly over the alive particles
+        if (SIMD::MoveMask(SIMD::Less(SIMD::Load(age + i), SIMD::Load(lifetime + i))) == 0xf)
+            continue;
+        for (int32 j = i; j < i + 4; j++)
+        {
+            if (age[j] >= lifetime[j])
+                return j;
+        }
+    }
+    for (; i < count; i++)
+    {
+        if (age[i] >= lifetime[i])
+            return i;
+    }
+    return count;
+}
+
+void ParticleStreams::Fill(byte* data, const void* value, int32 size, int32 count)
+{
+    switch (size)
+    {
+    case 4:
+    {
+        const uint32 v = *(const uint32*)value;
+        uint32* ptr = (uint32*)data;
+        for (int32 i = 0; i < count; i++)
+            ptr[i] = v;
+        break;
+    }
+    default:
+        for (int32 i = 0; i < count; i++)
+        {
+            Platform::MemoryCopy(data, value, size);
+            data += size;
+        }
+        break;
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+
+/// <summary>
+/// The vectorized kernels that process the whole particle attribute streams (used by CPU particles stored in SoA layout).
+/// </summary>
+namespace ParticleStreams
+{
+    /// <summary>
+    /// Adds the value to all elements of the stream (eg. updates the particles age).
+    /// </summary>
+    /// <param name="data">The stream data.</param>
+    /// <param name="value">The value to add.</param>
+    /// <param name="count">The amount of elements.</param>
+    FLAXENGINE_API void Add(float* data, float value, int32 count);
+
+    /// <summary>
+    /// Adds the value to all elements of the stream (eg. applies the constant force to the particles velocity).
+    /// </summary>
+    /// <param name="data">The stream data.</param>
+    /// <param name="value">The value to add.</param>
+    /// <param name="count">The amount of elements.</param>
+    FLAXENGINE_API void Add(Float3* data, const Float3& value, int32 count);
+
+    /// <summary>
+    /// Adds the scaled source stream to the destination stream (eg. integrates the particles velocity into position).
+    /// </summary>
+    /// <param name="data">The destination stream data.</param>
+    /// <param name="src">The source stream data.</param>
+    /// <param name="scale">The source values scale.</param>
+    /// <param name="count">The amount of elements.</param>
+    FLAXENGINE_API void MultiplyAdd(Float3* data, const Float3* src, float scale, int32 count);
+
+    /// <summary>
+    /// Applies the linear drag to the particles velocity.
+    /// </summary>
+    /// <param name="velocity">The velocity stream data.</param>
+    /// <param name="mass">The mass stream data.</param>
+    /// <param name="spriteSize">The sprite size stream data (drag is scaled by the sprite area). Can be null.</param>
+    /// <param name="drag">The drag amount.</param>
+    /// <param name="deltaTime">The simulation delta time.</param>
+    /// <param name="count">The amount of elements.</param>
+    FLAXENGINE_API void LinearDrag(Float3* velocity, const float* mass, const Float2* spriteSize, float drag, float deltaTime, int32 count);
+
+    /// <summary>
+    /// Finds the first dead particle (with age larger or equal to the lifetime).
+    /// </summary>
+    /// <param name="age">The age stream data.</param>
+    /// <param name="lifetime">The lifetime stream data.</param>
+    /// <param name="start">The index of the first element to check.</param>
+    /// <param name="count">The amount of elements.</param>
+    /// <returns>The index of the dead particle or count if all particles are alive.</returns>
+    FLAXENGINE_API int32 FindDead(const float* age, const float* lifetime, int32 start, int32 count);
+
+    /// <summary>
+    /// Sets all elements of the stream to the value.
+    /// </summary>
+    /// <param name="data">The stream data.</param>
+    /// <param name="value">The value data.</param>
+    /// <param name="size">The value size (in bytes).</param>
+    /// <param name="count">The amount of elements.</param>
+    FLAXENGINE_API void Fill(byte* data, const void* value, int32 size, int32 count);
+}
@@ -137,6 +137,7 @@ TaskGraphSystem* Particles::System = nullptr;
 ReadWriteLock Particles::SystemLocker;
 bool Particles::EnableParticleBufferPooling = true;
 float Particles::ParticleBufferRecycleTimeout = 10.0f;
+ParticleBufferLayout Particles::CPUParticleBufferLayout = ParticleBufferLayout::AoS;
 
 SpriteParticleRenderer SpriteRenderer;
 
@@ -207,7 +208,6 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
             auto module = emitter->Graph.SortModules[moduleIndex];
             const int32 sortedIndicesOffset = module->SortedIndicesOffset;
             const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
-            const int32 stride = buffer->Stride;
             const int32 listSize = buffer->CPU.Count;
             const int32 indicesByteSize = listSize * buffer->GPU.SortedIndices->GetStride();
             RenderListAlloc sortingAllocs[4];
@@ -224,14 +224,15 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
                 if (positionOffset == -1)
                     break;
                 const Matrix viewProjection = renderContextBatch.GetMainContext().View.ViewProjection();
-                const byte* positionPtr = buffer->CPU.Buffer.Get() + positionOffset;
+                const byte* positionPtr = buffer->GetAttributeCPU(0, positionOffset, sizeof(Float3));
+                const int32 positionStride = buffer->GetAttributeStride(sizeof(Float3));
                 if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
                 {
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         // TODO: use SIMD
                         sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, Matrix::TransformPosition(drawCall.World, *(const Float3*)positionPtr)).W) ^ sortKeyXor;
-                        positionPtr += stride;
+                        positionPtr += positionStride;
                     }
                 }
                 else
@@ -239,7 +240,7 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, *(const Float3*)positionPtr).W) ^ sortKeyXor;
-                        positionPtr += stride;
+                        positionPtr += positionStride;
                     }
                 }
                 break;
@@ -250,14 +251,15 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
                 if (positionOffset == -1)
                     break;
                 const Float3 viewPosition = renderContextBatch.GetMainContext().View.Position;
-                const byte* positionPtr = buffer->CPU.Buffer.Get() + positionOffset;
+                const byte* positionPtr = buffer->GetAttributeCPU(0, positionOffset, sizeof(Float3));
+                const int32 positionStride = buffer->GetAttributeStride(sizeof(Float3));
                 if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
                 {
                     for (int32 i = 0; i < buffer->CPU.Count; i++)
                     {
                         // TODO: use SIMD
                         sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - Float3::Transform(*(const Float3*)positionPtr, drawCall.World)).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
+                        positionPtr += positionStride;
                     }
                 }
                 else
@@ -266,7 +268,7 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
                     {
                         // TODO: use SIMD
                         sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - *(const Float3*)positionPtr).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
+                        positionPtr += positionStride;
                     }
                 }
                 break;
@@ -280,11 +282,12 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
                 const int32 attributeOffset = emitter->Graph.Layout.Attributes[attributeIdx].Offset;
                 if (attributeOffset == -1)
                     break;
-                const byte* attributePtr = buffer->CPU.Buffer.Get() + attributeOffset;
+                const byte* attributePtr = buffer->GetAttributeCPU(0, attributeOffset, sizeof(float));
+                const int32 attributeStride = buffer->GetAttributeStride(sizeof(float));
                 for (int32 i = 0; i < buffer->CPU.Count; i++)
                 {
                     sortedKeys[i] = RenderTools::ComputeDistanceSortKey(*(const float*)attributePtr) ^ sortKeyXor;
-                    attributePtr += stride;
+                    attributePtr += attributeStride;
                 }
                 break;
             }
@@ -336,10 +339,18 @@ void DrawEmitterCPU(RenderContextBatch& renderContextBatch, ParticleBuffer* buff
         }
     }
 
-    // Upload CPU particles data to GPU
+    // Upload CPU particles data to GPU (rendering uses AoS layout)
     {
+        const byte* particlesData = buffer->CPU.Buffer.Get();
+        RenderListAlloc particlesDataAlloc;
+        if (buffer->BufferLayout == ParticleBufferLayout::SoA && buffer->CPU.Count != 0)
+        {
+            byte* data = (byte*)particlesDataAlloc.Init(renderContextBatch.GetMainContext().List, buffer->CPU.Count * buffer->Stride);
+            buffer->GetParticlesCPU(data);
+            particlesData = data;
+        }
         RenderContext::GPULocker.Lock();
-        context->UpdateBuffer(buffer->GPU.Buffer, buffer->CPU.Buffer.Get(), buffer->CPU.Count * buffer->Stride);
+        context->UpdateBuffer(buffer->GPU.Buffer, particlesData, buffer->CPU.Count * buffer->Stride);
         RenderContext::GPULocker.Unlock();
     }
 
@@ -1470,7 +1481,7 @@ ParticleBuffer* Particles::AcquireParticleBuffer(ParticleEmitter* emitter)
                 entries->RemoveLast();
 
                 // Remove old buffers
-                if (result->Version != emitter->Graph.Version)
+                if (result->Version != emitter->Graph.Version || (result->Mode == ParticlesSimulationMode::CPU && result->BufferLayout != CPUParticleBufferLayout))
                 {
                     Delete(result);
                     result = nullptr;
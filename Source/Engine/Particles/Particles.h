@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Scripting/ScriptingType.h"
+#include "Types.h"
 
 class TaskGraphSystem;
 struct RenderContextBatch;
@@ -70,6 +71,11 @@ API_CLASS(Static) class FLAXENGINE_API Particles
     /// </summary>
     static float ParticleBufferRecycleTimeout;
 
+    /// <summary>
+    /// The memory layout of the CPU particles data used by the newly created particle buffers. SoA layout stores each particle attribute in a separate stream which allows to update particles with vectorized loops. Changing it at runtime affects only the particle buffers acquired later (pooled buffers with a different layout are not reused).
+    /// </summary>
+    API_FIELD() static ParticleBufferLayout CPUParticleBufferLayout;
+
     /// <summary>
     /// Acquires the free particle buffer for the emitter instance data.
     /// </summary>
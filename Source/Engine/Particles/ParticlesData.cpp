@@ -2,6 +2,7 @@
 
 #include "ParticlesData.h"
 #include "ParticleEmitter.h"
+#include "Particles.h"
 #include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/DynamicBuffer.h"
@@ -115,6 +116,7 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
     Layout = &emitter->Graph.Layout;
     Stride = Layout->Size;
     Mode = emitter->SimulationMode;
+    BufferLayout = Mode == ParticlesSimulationMode::CPU ? Particles::CPUParticleBufferLayout : ParticleBufferLayout::AoS;
 
     const int32 size = Capacity * Stride;
     switch (Mode)
@@ -229,3 +231,59 @@ void ParticleBuffer::Clear()
         CRASH;
     }
 }
+
+void ParticleBuffer::CopyParticleCPU(int32 dstIndex, int32 srcIndex)
+{
+    if (BufferLayout == ParticleBufferLayout::AoS)
+    {
+        Platform::MemoryCopy(CPU.Buffer.Get() + dstIndex * Stride, CPU.Buffer.Get() + srcIndex * Stride, Stride);
+        return;
+    }
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        const int32 size = attribute.GetSize();
+        Platform::MemoryCopy(GetAttributeCPU(dstIndex, attribute.Offset, size), GetAttributeCPU(srcIndex, attribute.Offset, size), size);
+    }
+}
+
+void ParticleBuffer::SetParticlesCPU(int32 particleIndex, int32 count, const byte* data)
+{
+    if (BufferLayout == ParticleBufferLayout::AoS)
+    {
+        byte* dst = CPU.Buffer.Get() + particleIndex * Stride;
+        for (int32 i = 0; i < count; i++)
+            Platform::MemoryCopy(dst + i * Stride, data, Stride);
+        return;
+    }
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        // Fill the attribute stream with the value
+        const int32 size = attribute.GetSize();
+        const byte* value = data + attribute.Offset;
+        byte* dst = GetAttributeCPU(particleIndex, attribute.Offset, size);
+        for (int32 i = 0; i < count; i++)
+            Platform::MemoryCopy(dst + i * size, value, size);
+    }
+}
+
+void ParticleBuffer::GetParticlesCPU(byte* data) const
+{
+    if (BufferLayout == ParticleBufferLayout::AoS)
+    {
+        Platform::MemoryCopy(data, CPU.Buffer.Get(), CPU.Count * Stride);
+        return;
+    }
+    for (const ParticleAttribute& attribute : Layout->Attributes)
+    {
+        // Interleave the attribute stream into particles
+        const int32 size = attribute.GetSize();
+        const byte* src = CPU.Buffer.Get() + attribute.Offset * Capacity;
+        byte* dst = data + attribute.Offset;
+        for (int32 i = 0; i < CPU.Count; i++)
+        {
+            Platform::MemoryCopy(dst, src, size);
+            src += size;
+            dst += Stride;
+        }
+    }
+}
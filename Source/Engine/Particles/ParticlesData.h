@@ -160,6 +160,11 @@ class FLAXENGINE_API ParticleBuffer
     /// </summary>
     ParticlesSimulationMode Mode;
 
+    /// <summary>
+    /// The CPU particles data memory layout. GPU particles always use AoS layout.
+    /// </summary>
+    ParticleBufferLayout BufferLayout;
+
     /// <summary>
     /// The emitter.
     /// </summary>
@@ -178,7 +183,7 @@ class FLAXENGINE_API ParticleBuffer
         int32 Count;
 
         /// <summary>
-        /// The particles data buffer (CPU side).
+        /// The particles data buffer (CPU side). Uses memory layout specified by BufferLayout.
         /// </summary>
         Array<byte> Buffer;
 
@@ -277,24 +282,92 @@ class FLAXENGINE_API ParticleBuffer
     void Clear();
 
     /// <summary>
-    /// Gets the pointer to the particle data.
+    /// Gets the pointer to the particle data. Valid only for AoS layout.
     /// </summary>
     /// <param name="particleIndex">Index of the particle.</param>
     /// <returns>The particle data start address.</returns>
     FORCE_INLINE byte* GetParticleCPU(int32 particleIndex)
     {
+        ASSERT_LOW_LAYER(BufferLayout == ParticleBufferLayout::AoS);
         return CPU.Buffer.Get() + particleIndex * Stride;
     }
 
     /// <summary>
-    /// Gets the pointer to the particle data.
+    /// Gets the pointer to the particle data. Valid only for AoS layout.
     /// </summary>
     /// <param name="particleIndex">Index of the particle.</param>
     /// <returns>The particle data start address.</returns>
     FORCE_INLINE const byte* GetParticleCPU(int32 particleIndex) const
     {
+        ASSERT_LOW_LAYER(BufferLayout == ParticleBufferLayout::AoS);
         return CPU.Buffer.Get() + particleIndex * Stride;
     }
+
+    /// <summary>
+    /// Gets the pointer to the particle attribute data.
+    /// </summary>
+    /// <param name="particleIndex">Index of the particle.</param>
+    /// <param name="offset">The attribute offset (in bytes) from particle data start.</param>
+    /// <param name="size">The attribute size (in bytes).</param>
+    /// <returns>The particle attribute data address.</returns>
+    FORCE_INLINE byte* GetAttributeCPU(int32 particleIndex, int32 offset, int32 size)
+    {
+        if (BufferLayout == ParticleBufferLayout::SoA)
+            return CPU.Buffer.Get() + offset * Capacity + particleIndex * size;
+        return CPU.Buffer.Get() + particleIndex * Stride + offset;
+    }
+
+    /// <summary>
+    /// Gets the pointer to the particle attribute data.
+    /// </summary>
+    /// <param name="particleIndex">Index of the particle.</param>
+    /// <param name="attribute">The attribute.</param>
+    /// <returns>The particle attribute data address.</returns>
+    FORCE_INLINE byte* GetAttributeCPU(int32 particleIndex, const ParticleAttribute& attribute)
+    {
+        return GetAttributeCPU(particleIndex, attribute.Offset, attribute.GetSize());
+    }
+
+    /// <summary>
+    /// Gets the distance (in bytes) between the attribute data of the subsequent particles.
+    /// </summary>
+    /// <param name="size">The attribute size (in bytes).</param>
+    /// <returns>The attribute data stride.</returns>
+    FORCE_INLINE int32 GetAttributeStride(int32 size) const
+    {
+        return BufferLayout == ParticleBufferLayout::SoA ? size : Stride;
+    }
+
+    /// <summary>
+    /// Gets the distance (in bytes) between the attribute data of the subsequent particles.
+    /// </summary>
+    /// <param name="attribute">The attribute.</param>
+    /// <returns>The attribute data stride.</returns>
+    FORCE_INLINE int32 GetAttributeStride(const ParticleAttribute& attribute) const
+    {
+        return GetAttributeStride(attribute.GetSize());
+    }
+
+    /// <summary>
+    /// Copies the particle data to the other particle (eg. to remove the dead particle by swapping it with the last one).
+    /// </summary>
+    /// <param name="dstIndex">Index of the destination particle.</param>
+    /// <param name="srcIndex">Index of the source particle.</param>
+    void CopyParticleCPU(int32 dstIndex, int32 srcIndex);
+
+    /// <summary>
+    /// Initializes the range of particles with the given particle data.
+    /// </summary>
+    /// <param name="particleIndex">Index of the first particle.</param>
+    /// <param name="count">The amount of particles to initialize.</param>
+    /// <param name="data">The particle data (stored in AoS layout, of Stride size).</param>
+    void SetParticlesCPU(int32 particleIndex, int32 count, const byte* data);
+
+    /// <summary>
+    /// Gets the active particles data in AoS layout (eg. for the upload to the GPU buffer).
+    /// </summary>
+    /// <param name="data">The destination data (of CPU.Count * Stride size).</param>
+    void GetParticlesCPU(byte* data) const;
 };
 
 struct ParticleBufferCPUDataAccessorBase
@@ -345,7 +418,7 @@ struct ParticleBufferCPUDataAccessor : ParticleBufferCPUDataAccessorBase
     FORCE_INLINE T Get(int32 index) const
     {
         ASSERT(IsValid() && index >= 0 && index < _buffer->CPU.Count);
-        return *(T*)(_buffer->CPU.Buffer.Get() + _offset + index * _buffer->Stride);
+        return *(T*)_buffer->GetAttributeCPU(index, _offset, sizeof(T));
     }
 
     FORCE_INLINE T Get(int32 index, const T& defaultValue) const
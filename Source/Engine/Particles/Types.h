@@ -123,3 +123,19 @@ API_ENUM() enum class ParticleSortMode
     /// </summary>
     CustomDescending,
 };
+
+/// <summary>
+/// The CPU particles data memory layout.
+/// </summary>
+API_ENUM() enum class ParticleBufferLayout
+{
+    /// <summary>
+    /// Array of structures. Particle attributes are interleaved (single particle data is stored together).
+    /// </summary>
+    AoS,
+
+    /// <summary>
+    /// Structure of arrays. Each particle attribute is stored in a separate, contiguous stream which allows to process particles with vectorized loops.
+    /// </summary>
+    SoA,
+};
@@ -0,0 +1,90 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#if COMPILE_WITH_PHYSX
+
+#include "CpuDispatcherPhysX.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
+#include <ThirdParty/PhysX/task/PxTask.h>
+
+CpuDispatcherPhysX::CpuDispatcherPhysX()
+    : _queue(New<Queue>())
+{
+}
+
+CpuDispatcherPhysX::~CpuDispatcherPhysX()
+{
+    // Wait for all the jobs to finish (jobs can finish in any order and tasks could be already executed by other thread)
+    // Job System doesn't start the queued jobs when engine is exiting so then just leave the queue to be released by the last job that runs (if any)
+    if (!Engine::IsRequestingExit)
+    {
+        while (Platform::AtomicRead(&_queue->JobsLeft) != 0)
+            Platform::Yield();
+    }
+    _queue->Release();
+}
+
+bool CpuDispatcherPhysX::RunTask()
+{
+    return _queue->RunTask();
+}
+
+bool CpuDispatcherPhysX::Queue::RunTask()
+{
+    PxBaseTask* task;
+    Locker.Lock();
+    if (TasksStart == Tasks.Count())
+    {
+        Locker.Unlock();
+        return false;
+    }
+    task = Tasks[TasksStart++];
+    if (TasksStart == Tasks.Count())
+    {
+        // Reuse the queue memory once it's empty
+        Tasks.Clear();
+        TasksStart = 0;
+    }
+    Locker.Unlock();
+
+    PROFILE_CPU_NAMED("Physics");
+    task->run();
+    task->release();
+    return true;
+}
+
+void CpuDispatcherPhysX::Queue::RunJob(int32 index)
+{
+    // Each job runs a single task (the task might be already executed by the thread waiting for the simulation)
+    RunTask();
+    Platform::InterlockedDecrement(&JobsLeft);
+    Release();
+}
+
+void CpuDispatcherPhysX::Queue::Release()
+{
+    if (Platform::InterlockedDecrement(&RefCount) == 0)
+        Delete(this);
+}
+
+void CpuDispatcherPhysX::submitTask(PxBaseTask& task)
+{
+    _queue->Locker.Lock();
+    _queue->Tasks.Add(&task);
+    _queue->Locker.Unlock();
+
+    // Each job holds a reference to the queue
+    Function<void(int32)> job;
+    job.Bind<Queue, &Queue::RunJob>(_queue);
+    Platform::InterlockedIncrement(&_queue->RefCount);
+    Platform::InterlockedIncrement(&_queue->JobsLeft);
+    JobSystem::Dispatch(job);
+}
+
+uint32_t CpuDispatcherPhysX::getWorkerCount() const
+{
+    return (uint32_t)Math::Max(JobSystem::GetThreadsCount(), 1);
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if COMPILE_WITH_PHYSX
+
+#include "Types.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
+#include <ThirdParty/PhysX/task/PxCpuDispatcher.h>
+
+/// <summary>
+/// Implementation of the PxCpuDispatcher that runs PhysX tasks via engine Job System (shares the worker threads with the other engine systems instead of using a separate thread pool).
+/// </summary>
+class CpuDispatcherPhysX : public PxCpuDispatcher
+{
+private:
+    // The tasks queue shared with the dispatched jobs (reference counted so the jobs that are still queued when dispatcher gets destroyed won't access the freed memory).
+    struct Queue
+    {
+        CriticalSection Locker;
+        Array<PxBaseTask*> Tasks;
+        int32 TasksStart = 0;
+        int64 JobsLeft = 0;
+        int64 RefCount = 1;
+
+        bool RunTask();
+        void RunJob(int32 index);
+        void Release();
+    };
+
+    Queue* _queue;
+
+public:
+    CpuDispatcherPhysX();
+    ~CpuDispatcherPhysX();
+
+    /// <summary>
+    /// Executes a single pending task on the calling thread (eg. to help with the simulation while waiting for its end).
+    /// </summary>
+    /// <returns>True if task was executed, otherwise false if there are no pending tasks.</returns>
+    bool RunTask();
+
+public:
+    // [PxCpuDispatcher]
+    void submitTask(PxBaseTask& task) override;
+    uint32_t getWorkerCount() const override;
+};
+
+#endif
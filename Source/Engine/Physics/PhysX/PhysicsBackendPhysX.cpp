@@ -4,6 +4,7 @@
 
 #include "PhysicsBackendPhysX.h"
 #include "PhysicsStepperPhysX.h"
+#include "CpuDispatcherPhysX.h"
 #include "SimulationEventCallbackPhysX.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Utilities.h"
@@ -21,7 +22,6 @@
 #include "Engine/Physics/Joints/SphericalJoint.h"
 #include "Engine/Physics/Joints/D6Joint.h"
 #include "Engine/Physics/Colliders/Collider.h"
-#include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
@@ -73,6 +73,9 @@
 // Temporary result buffer size
 #define PHYSX_HIT_BUFFER_SIZE 128
 
+// The amount of scene queries executed by a single job in the batched queries
+#define PHYSX_BATCH_QUERY_JOB_SIZE 64
+
 struct ActionDataPhysX
 {
     PhysicsBackend::ActionType Type;
@@ -564,7 +567,7 @@ namespace
     PxFoundation* Foundation = nullptr;
     PxPhysics* PhysX = nullptr;
 #if PLATFORM_THREADS_LIMIT > 1
-    PxDefaultCpuDispatcher* CpuDispatcher = nullptr;
+    CpuDispatcherPhysX* CpuDispatcher = nullptr;
 #else
     DummyCpuDispatcher* CpuDispatcher = nullptr;
 #endif
@@ -1766,11 +1769,7 @@ void PhysicsBackend::Shutdown()
 #if WITH_PVD
     RELEASE_PHYSX(PVD);
 #endif
-#if PLATFORM_THREADS_LIMIT > 1
-    RELEASE_PHYSX(CpuDispatcher);
-#else
     SAFE_DELETE(CpuDispatcher);
-#endif
     RELEASE_PHYSX(Foundation);
     SceneOrigins.Clear();
 }
@@ -1831,13 +1830,10 @@ void* PhysicsBackend::CreateScene(const PhysicsSettings& settings)
         if (CpuDispatcher == nullptr)
         {
 #if PLATFORM_THREADS_LIMIT > 1
-            uint32 threads = Math::Clamp<uint32>(Platform::GetCPUInfo().ProcessorCoreCount - 1, 1, 8);
-            CpuDispatcher = PxDefaultCpuDispatcherCreate(threads);
-            CHECK_INIT(CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
+            CpuDispatcher = New<CpuDispatcherPhysX>();
 #else
             CpuDispatcher = New<DummyCpuDispatcher>();
 #endif
-            CHECK_INIT(CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
         }
         sceneDesc.cpuDispatcher = CpuDispatcher;
     }
@@ -1968,6 +1964,14 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         PROFILE_CPU_NAMED("Physics.Fetch");
 
         // Gather results (with waiting for the end)
+#if PLATFORM_THREADS_LIMIT > 1
+        while (!scenePhysX->Stepper.isDone())
+        {
+            // Help with the simulation tasks execution meantime (more tasks can be submitted later so keep going until the step ends)
+            if (!CpuDispatcher->RunTask())
+                Platform::Yield();
+        }
+#endif
         scenePhysX->Stepper.wait(scenePhysX->Scene);
     }
 
@@ -2380,6 +2384,141 @@ bool PhysicsBackend::OverlapConvex(void* scene, const Vector3& center, const Col
     return true;
 }
 
+namespace
+{
+    void SetupBatchQueryFilter(PxQueryFilterData& filterData, const PhysicsQuery& query, bool blockSingle)
+    {
+        filterData.flags |= PxQueryFlag::ePREFILTER;
+        filterData.data.word0 = query.LayerMask;
+        filterData.data.word1 = blockSingle ? 1 : 0;
+        filterData.data.word2 = query.HitTriggers ? 1 : 0;
+    }
+
+    bool GetQueryGeometry(const PhysicsQuery& query, PxGeometryHolder& geometry)
+    {
+        switch (query.Shape)
+        {
+        case PhysicsQueryShape::Sphere:
+            geometry.storeAny(PxSphereGeometry(query.Radius));
+            break;
+        case PhysicsQueryShape::Box:
+            geometry.storeAny(PxBoxGeometry(C2P(query.HalfExtents)));
+            break;
+        case PhysicsQueryShape::Capsule:
+            geometry.storeAny(PxCapsuleGeometry(query.Radius, query.Height * 0.5f));
+            break;
+        case PhysicsQueryShape::ConvexMesh:
+            if (!query.ConvexMesh || query.ConvexMesh->GetOptions().Type != CollisionDataType::ConvexMesh)
+                return false;
+            geometry.storeAny(PxConvexMeshGeometry((PxConvexMesh*)query.ConvexMesh->GetConvex(), PxMeshScale(C2P(query.Scale))));
+            break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
+    bool BatchRayCast(ScenePhysX* scenePhysX, const PhysicsQuery& query, RayCastHit& hitInfo)
+    {
+        PxQueryFilterData filterData;
+        SetupBatchQueryFilter(filterData, query, true);
+        PxRaycastBuffer buffer;
+        if (!scenePhysX->Scene->raycast(C2P(query.Origin - scenePhysX->Origin), C2P(query.Direction), query.MaxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
+        {
+            hitInfo.Collider = nullptr;
+            hitInfo.Distance = MAX_float;
+            return false;
+        }
+        SCENE_QUERY_COLLECT_SINGLE();
+        return true;
+    }
+
+    bool BatchShapeCast(ScenePhysX* scenePhysX, const PhysicsQuery& query, RayCastHit& hitInfo)
+    {
+        PxQueryFilterData filterData;
+        SetupBatchQueryFilter(filterData, query, true);
+        PxSweepBufferN<1> buffer;
+        PxGeometryHolder geometry;
+        const PxTransform pose(C2P(query.Origin - scenePhysX->Origin), C2P(query.Rotation));
+        if (!GetQueryGeometry(query, geometry) || !scenePhysX->Scene->sweep(geometry.any(), pose, C2P(query.Direction), query.MaxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
+        {
+            hitInfo.Collider = nullptr;
+            hitInfo.Distance = MAX_float;
+            return false;
+        }
+        SCENE_QUERY_COLLECT_SINGLE();
+        return true;
+    }
+
+    bool BatchOverlap(ScenePhysX* scenePhysX, const PhysicsQuery& query, PhysicsColliderActor*& result)
+    {
+        PxQueryFilterData filterData;
+        SetupBatchQueryFilter(filterData, query, false);
+        PxOverlapBufferN<1> buffer;
+        PxGeometryHolder geometry;
+        const PxTransform pose(C2P(query.Origin - scenePhysX->Origin), C2P(query.Rotation));
+        if (!GetQueryGeometry(query, geometry) || !scenePhysX->Scene->overlap(geometry.any(), pose, buffer, filterData, &QueryFilter) || buffer.getNbAnyHits() == 0)
+        {
+            result = nullptr;
+            return false;
+        }
+        const auto& hit = buffer.getAnyHit(0);
+        result = hit.shape ? static_cast<PhysicsColliderActor*>(hit.shape->userData) : nullptr;
+        return true;
+    }
+
+    template<typename ResultType>
+    bool ExecuteBatchQuery(void* scene, const Span<PhysicsQuery>& queries, Span<ResultType>& results, bool (*query)(ScenePhysX*, const PhysicsQuery&, ResultType&))
+    {
+        auto scenePhysX = (ScenePhysX*)scene;
+        if (scene == nullptr)
+            return false;
+        int32 anyHit = 0;
+        const auto job = [&](int32 jobIndex)
+        {
+            // Run queries from a single chunk (results are written to separate locations so no need to synchronize)
+            const int32 start = jobIndex * PHYSX_BATCH_QUERY_JOB_SIZE;
+            const int32 end = Math::Min(start + PHYSX_BATCH_QUERY_JOB_SIZE, queries.Length());
+            bool hit = false;
+            for (int32 i = start; i < end; i++)
+                hit |= query(scenePhysX, queries[i], results[i]);
+            if (hit)
+                Platform::AtomicStore(&anyHit, 1);
+        };
+        const int32 jobsCount = Math::DivideAndRoundUp(queries.Length(), PHYSX_BATCH_QUERY_JOB_SIZE);
+#if PLATFORM_THREADS_LIMIT > 1
+        if (jobsCount > 1 && JobSystem::GetThreadsCount() > 1)
+        {
+            JobSystem::Execute(job, jobsCount);
+        }
+        else
+#endif
+        {
+            for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                job(jobIndex);
+        }
+        return anyHit != 0;
+    }
+}
+
+bool PhysicsBackend::RayCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    PROFILE_CPU();
+    return ExecuteBatchQuery(scene, queries, results, BatchRayCast);
+}
+
+bool PhysicsBackend::ShapeCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    PROFILE_CPU();
+    return ExecuteBatchQuery(scene, queries, results, BatchShapeCast);
+}
+
+bool PhysicsBackend::OverlapBatch(void* scene, const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results)
+{
+    PROFILE_CPU();
+    return ExecuteBatchQuery(scene, queries, results, BatchOverlap);
+}
+
 PhysicsBackend::ActorFlags PhysicsBackend::GetActorFlags(void* actor)
 {
     auto actorPhysX = (PxActor*)actor;
@@ -115,6 +115,12 @@ class MultiThreadStepper : public PhysicsStepper
             mSync->wait();
     }
 
+    // checks if the simulation has been completed (non-blocking)
+    bool isDone() const
+    {
+        return !mNbSubSteps || !mSync || mSync->wait(0);
+    }
+
     virtual void shutdown();
 
     virtual void reset() = 0;
@@ -428,6 +428,36 @@ bool Physics::OverlapConvex(const Vector3& center, const CollisionData* convexMe
     return DefaultScene->OverlapConvex(center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
 
+bool Physics::RayCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    return DefaultScene->RayCastBatch(queries, results);
+}
+
+bool Physics::RayCastBatch(const Array<PhysicsQuery>& queries, Array<RayCastHit>& results)
+{
+    return DefaultScene->RayCastBatch(queries, results);
+}
+
+bool Physics::ShapeCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    return DefaultScene->ShapeCastBatch(queries, results);
+}
+
+bool Physics::ShapeCastBatch(const Array<PhysicsQuery>& queries, Array<RayCastHit>& results)
+{
+    return DefaultScene->ShapeCastBatch(queries, results);
+}
+
+bool Physics::OverlapBatch(const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results)
+{
+    return DefaultScene->OverlapBatch(queries, results);
+}
+
+bool Physics::OverlapBatch(const Array<PhysicsQuery>& queries, Array<PhysicsColliderActor*>& results)
+{
+    return DefaultScene->OverlapBatch(queries, results);
+}
+
 PhysicsScene::PhysicsScene(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -757,3 +787,39 @@ bool PhysicsScene::OverlapConvex(const Vector3& center, const CollisionData* con
 {
     return PhysicsBackend::OverlapConvex(_scene, center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
+
+bool PhysicsScene::RayCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    CHECK_RETURN(queries.Length() == results.Length(), false);
+    return PhysicsBackend::RayCastBatch(_scene, queries, results);
+}
+
+bool PhysicsScene::RayCastBatch(const Array<PhysicsQuery>& queries, Array<RayCastHit>& results)
+{
+    results.Resize(queries.Count());
+    return RayCastBatch(ToSpan(queries), ToSpan(results));
+}
+
+bool PhysicsScene::ShapeCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    CHECK_RETURN(queries.Length() == results.Length(), false);
+    return PhysicsBackend::ShapeCastBatch(_scene, queries, results);
+}
+
+bool PhysicsScene::ShapeCastBatch(const Array<PhysicsQuery>& queries, Array<RayCastHit>& results)
+{
+    results.Resize(queries.Count());
+    return ShapeCastBatch(ToSpan(queries), ToSpan(results));
+}
+
+bool PhysicsScene::OverlapBatch(const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results)
+{
+    CHECK_RETURN(queries.Length() == results.Length(), false);
+    return PhysicsBackend::OverlapBatch(_scene, queries, results);
+}
+
+bool PhysicsScene::OverlapBatch(const Array<PhysicsQuery>& queries, Array<PhysicsColliderActor*>& results)
+{
+    results.Resize(queries.Count());
+    return OverlapBatch(ToSpan(queries), ToSpan(results));
+}
@@ -143,6 +143,9 @@ class FLAXENGINE_API PhysicsBackend
     static bool OverlapSphere(void* scene, const Vector3& center, float radius, Array<PhysicsColliderActor*, HeapAllocation>& results, uint32 layerMask, bool hitTriggers);
     static bool OverlapCapsule(void* scene, const Vector3& center, float radius, float height, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
     static bool OverlapConvex(void* scene, const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
+    static bool RayCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results);
+    static bool ShapeCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results);
+    static bool OverlapBatch(void* scene, const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results);
 
     // Actors
     static ActorFlags GetActorFlags(void* actor);
@@ -247,6 +247,33 @@ bool PhysicsBackend::OverlapConvex(void* scene, const Vector3& center, const Col
     return false;
 }
 
+bool PhysicsBackend::RayCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    for (RayCastHit& hit : results)
+    {
+        hit.Collider = nullptr;
+        hit.Distance = MAX_float;
+    }
+    return false;
+}
+
+bool PhysicsBackend::ShapeCastBatch(void* scene, const Span<PhysicsQuery>& queries, Span<RayCastHit> results)
+{
+    for (RayCastHit& hit : results)
+    {
+        hit.Collider = nullptr;
+        hit.Distance = MAX_float;
+    }
+    return false;
+}
+
+bool PhysicsBackend::OverlapBatch(void* scene, const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results)
+{
+    for (PhysicsColliderActor*& collider : results)
+        collider = nullptr;
+    return false;
+}
+
 PhysicsBackend::ActorFlags PhysicsBackend::GetActorFlags(void* actor)
 {
     return ActorFlags::None;
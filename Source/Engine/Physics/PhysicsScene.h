@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Types.h"
 
@@ -509,4 +510,52 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
     /// <returns>True if convex mesh overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() bool OverlapConvex(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs many raycasts against objects in the scene at once (queries are executed in parallel via Job System). Avoids the overhead of the separate calls.
+    /// </summary>
+    /// <param name="queries">The raycasts to perform.</param>
+    /// <param name="results">The result hits (one per query, Collider is null and Distance is MAX_float if query didn't hit anything). Must have the same length as queries.</param>
+    /// <returns>True if any query hits a matching object, otherwise false.</returns>
+    bool RayCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Performs many raycasts against objects in the scene at once (queries are executed in parallel via Job System).
+    /// </summary>
+    /// <param name="queries">The raycasts to perform.</param>
+    /// <param name="results">The result hits (one per query, Collider is null and Distance is MAX_float if query didn't hit anything).</param>
+    /// <returns>True if any query hits a matching object, otherwise false.</returns>
+    API_FUNCTION() bool RayCastBatch(const Array<PhysicsQuery, HeapAllocation>& queries, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results);
+
+    /// <summary>
+    /// Performs many shape sweeps against objects in the scene at once (queries are executed in parallel via Job System). Avoids the overhead of the separate calls.
+    /// </summary>
+    /// <param name="queries">The sweeps to perform.</param>
+    /// <param name="results">The result hits (one per query, Collider is null and Distance is MAX_float if query didn't hit anything). Must have the same length as queries.</param>
+    /// <returns>True if any query hits a matching object, otherwise false.</returns>
+    bool ShapeCastBatch(const Span<PhysicsQuery>& queries, Span<RayCastHit> results);
+
+    /// <summary>
+    /// Performs many shape sweeps against objects in the scene at once (queries are executed in parallel via Job System).
+    /// </summary>
+    /// <param name="queries">The sweeps to perform.</param>
+    /// <param name="results">The result hits (one per query, Collider is null and Distance is MAX_float if query didn't hit anything).</param>
+    /// <returns>True if any query hits a matching object, otherwise false.</returns>
+    API_FUNCTION() bool ShapeCastBatch(const Array<PhysicsQuery, HeapAllocation>& queries, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results);
+
+    /// <summary>
+    /// Performs many shape overlap tests against objects in the scene at once (queries are executed in parallel via Job System). Avoids the overhead of the separate calls.
+    /// </summary>
+    /// <param name="queries">The overlap tests to perform.</param>
+    /// <param name="results">The result colliders (one per query, the first found object that overlaps the shape or null). Must have the same length as queries.</param>
+    /// <returns>True if any query overlaps a matching object, otherwise false.</returns>
+    bool OverlapBatch(const Span<PhysicsQuery>& queries, Span<PhysicsColliderActor*> results);
+
+    /// <summary>
+    /// Performs many shape overlap tests against objects in the scene at once (queries are executed in parallel via Job System).
+    /// </summary>
+    /// <param name="queries">The overlap tests to perform.</param>
+    /// <param name="results">The result colliders (one per query, the first found object that overlaps the shape or null).</param>
+    /// <returns>True if any query overlaps a matching object, otherwise false.</returns>
+    API_FUNCTION() bool OverlapBatch(const Array<PhysicsQuery, HeapAllocation>& queries, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results);
 };
@@ -5,6 +5,7 @@
 #include "Engine/Core/Config.h"
 #include "Engine/Core/Math/Vector2.h"
 #include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Scripting/ScriptingType.h"
 
 struct PhysicsStatistics;
@@ -278,3 +279,97 @@ struct FLAXENGINE_API CollisionShape
         HeightField.ColumnScale = columnScale;
     }
 };
+
+/// <summary>
+/// The shape types used by the batched physics scene queries.
+/// </summary>
+API_ENUM() enum class PhysicsQueryShape : byte
+{
+    /// <summary>
+    /// The sphere (uses Radius).
+    /// </summary>
+    Sphere,
+
+    /// <summary>
+    /// The box (uses HalfExtents).
+    /// </summary>
+    Box,
+
+    /// <summary>
+    /// The capsule (uses Radius and Height).
+    /// </summary>
+    Capsule,
+
+    /// <summary>
+    /// The convex mesh (uses ConvexMesh and Scale).
+    /// </summary>
+    ConvexMesh,
+};
+
+/// <summary>
+/// Physics scene query description used by the batched queries (eg. Physics::RayCastBatch).
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API PhysicsQuery
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(PhysicsQuery);
+
+    /// <summary>
+    /// The query shape type (unused by raycasts).
+    /// </summary>
+    API_FIELD() PhysicsQueryShape Shape = PhysicsQueryShape::Sphere;
+
+    /// <summary>
+    /// The radius of the sphere or the capsule.
+    /// </summary>
+    API_FIELD() float Radius = 1.0f;
+
+    /// <summary>
+    /// The height of the capsule, excluding the top and bottom spheres.
+    /// </summary>
+    API_FIELD() float Height = 1.0f;
+
+    /// <summary>
+    /// The half size of the box in each direction.
+    /// </summary>
+    API_FIELD() Vector3 HalfExtents = Vector3::One;
+
+    /// <summary>
+    /// The collision data of the convex mesh.
+    /// </summary>
+    API_FIELD() CollisionData* ConvexMesh = nullptr;
+
+    /// <summary>
+    /// The scale of the convex mesh.
+    /// </summary>
+    API_FIELD() Vector3 Scale = Vector3::One;
+
+    /// <summary>
+    /// The origin of the ray or the shape center.
+    /// </summary>
+    API_FIELD() Vector3 Origin;
+
+    /// <summary>
+    /// The normalized direction of the ray or the shape sweep (unused by overlaps).
+    /// </summary>
+    API_FIELD() Vector3 Direction;
+
+    /// <summary>
+    /// The shape rotation.
+    /// </summary>
+    API_FIELD() Quaternion Rotation = Quaternion::Identity;
+
+    /// <summary>
+    /// The maximum distance the ray or the shape should check for collisions.
+    /// </summary>
+    API_FIELD() float MaxDistance = MAX_float;
+
+    /// <summary>
+    /// The layer mask used to filter the results.
+    /// </summary>
+    API_FIELD() uint32 LayerMask = MAX_uint32;
+
+    /// <summary>
+    /// If set to true triggers will be hit, otherwise will skip them.
+    /// </summary>
+    API_FIELD() bool HitTriggers = true;
+};
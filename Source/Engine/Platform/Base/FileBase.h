@@ -129,6 +129,25 @@ class FLAXENGINE_API FileBase : public NonCopyable
     /// <returns>True if file is opened, otherwise false.</returns>
     virtual bool IsOpened() const = 0;
 
+    /// <summary>
+    /// Maps the file contents into the process address space for the read-only access. The view has to be unmapped before closing the file.
+    /// </summary>
+    /// <param name="size">The size of the view (in bytes, from the file beginning).</param>
+    /// <returns>The mapped file data or null if failed or not supported by the platform.</returns>
+    virtual const byte* MapView(uint32 size)
+    {
+        return nullptr;
+    }
+
+    /// <summary>
+    /// Unmaps the file view created with MapView.
+    /// </summary>
+    /// <param name="view">The mapped file data.</param>
+    /// <param name="size">The size of the view (in bytes).</param>
+    virtual void UnmapView(const byte* view, uint32 size)
+    {
+    }
+
 public:
     static bool ReadAllBytes(const StringView& path, void* data, int32 length);
     static bool ReadAllBytes(const StringView& path, Array<byte, HeapAllocation>& data);
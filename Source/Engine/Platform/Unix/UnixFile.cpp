@@ -15,6 +15,7 @@
 #endif
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <cerrno>
@@ -157,4 +158,23 @@ bool UnixFile::IsOpened() const
     return _handle != -1;
 }
 
+const byte* UnixFile::MapView(uint32 size)
+{
+    if (_handle == -1 || size == 0)
+        return nullptr;
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, _handle, 0);
+    if (view == MAP_FAILED)
+    {
+        LOG_UNIX_LAST_ERROR;
+        return nullptr;
+    }
+    return (const byte*)view;
+}
+
+void UnixFile::UnmapView(const byte* view, uint32 size)
+{
+    if (view)
+        munmap((void*)view, size);
+}
+
 #endif
@@ -108,4 +108,36 @@ bool Win32File::IsOpened() const
     return _handle != nullptr;
 }
 
+const byte* Win32File::MapView(uint32 size)
+{
+#if PLATFORM_UWP
+    // Not supported
+    return nullptr;
+#else
+    if (_handle == nullptr || size == 0)
+        return nullptr;
+    HANDLE mapping = CreateFileMappingW(_handle, nullptr, PAGE_READONLY, 0, size, nullptr);
+    if (mapping == nullptr)
+    {
+        LOG_WIN32_LAST_ERROR;
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    if (view == nullptr)
+    {
+        LOG_WIN32_LAST_ERROR;
+    }
+    CloseHandle(mapping); // View holds the reference to the mapping object
+    return (const byte*)view;
+#endif
+}
+
+void Win32File::UnmapView(const byte* view, uint32 size)
+{
+#if !PLATFORM_UWP
+    if (view)
+        UnmapViewOfFile(view);
+#endif
+}
+
 #endif
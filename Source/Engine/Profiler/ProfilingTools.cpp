@@ -9,6 +9,7 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Networking/NetworkInternal.h"
+#include "Engine/Threading/ThreadPool.h"
 
 ProfilingTools::MainStats ProfilingTools::Stats;
 Array<ProfilingTools::ThreadStats, InlinedAllocation<64>> ProfilingTools::EventsCPU;
@@ -52,6 +53,8 @@ void ProfilingToolsService::Update()
         float presentTime;
         ProfilerGPU::GetLastFrameData(stats.DrawGPUTimeMs, presentTime, stats.DrawStats);
         stats.DrawCPUTimeMs = Math::Max(stats.DrawCPUTimeMs - presentTime, 0.0f); // Remove swapchain present wait time to exclude from drawing on CPU
+        stats.Jobs = JobSystem::GetStats(true);
+        ThreadPool::GetStats(stats.ThreadPoolQueues, true);
     }
 
     // Extract CPU profiler events
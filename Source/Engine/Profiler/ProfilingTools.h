@@ -8,6 +8,7 @@
 #include "Engine/Platform/MemoryStats.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Profiler/Profiler.h"
+#include "Engine/Threading/JobSystem.h"
 
 /// <summary>
 /// Profiler tools for development. Allows to gather profiling data and events from the engine.
@@ -85,6 +86,16 @@ API_CLASS(Static) class FLAXENGINE_API ProfilingTools
         /// The last rendered frame stats.
         /// </summary>
         API_FIELD() RenderStatsData DrawStats;
+
+        /// <summary>
+        /// The job system stats (peak values are per-frame).
+        /// </summary>
+        API_FIELD() JobSystemStats Jobs;
+
+        /// <summary>
+        /// The thread pool tasks queues statistics.
+        /// </summary>
+        API_FIELD() JobQueueStats ThreadPoolQueues;
     };
 
     /// <summary>
@@ -38,6 +38,16 @@ API_STRUCT() struct RenderStatsData
     /// </summary>
     API_FIELD() int64 PipelineStateChanges;
 
+    /// <summary>
+    /// The objects count culled by the CPU occlusion culling (hidden behind the occluders).
+    /// </summary>
+    API_FIELD() int64 OccludedObjects;
+
+    /// <summary>
+    /// The objects count that passed the CPU occlusion culling test (visible).
+    /// </summary>
+    API_FIELD() int64 OcclusionVisibleObjects;
+
     /// <summary>
     /// Initializes a new instance of the <see cref="RenderStatsData"/> struct.
     /// </summary>
@@ -47,6 +57,8 @@ API_STRUCT() struct RenderStatsData
         , Vertices(0)
         , Triangles(0)
         , PipelineStateChanges(0)
+        , OccludedObjects(0)
+        , OcclusionVisibleObjects(0)
     {
     }
 
@@ -67,6 +79,8 @@ API_STRUCT() struct RenderStatsData
         MIX(Vertices);
         MIX(Triangles);
         MIX(PipelineStateChanges);
+        MIX(OccludedObjects);
+        MIX(OcclusionVisibleObjects);
 #undef MIX
     }
 
@@ -78,6 +92,8 @@ API_STRUCT() struct RenderStatsData
         MIX(Vertices);
         MIX(Triangles);
         MIX(PipelineStateChanges);
+        MIX(OccludedObjects);
+        MIX(OcclusionVisibleObjects);
 #undef MIX
         return *this;
     }
@@ -90,6 +106,8 @@ API_STRUCT() struct RenderStatsData
         MIX(Vertices);
         MIX(Triangles);
         MIX(PipelineStateChanges);
+        MIX(OccludedObjects);
+        MIX(OcclusionVisibleObjects);
 #undef MIX
         return *this;
     }
@@ -101,11 +119,15 @@ API_STRUCT() struct RenderStatsData
 	Platform::InterlockedIncrement(&RenderStatsData::Counter.DrawCalls); \
 	Platform::InterlockedAdd(&RenderStatsData::Counter.Vertices, vertices); \
 	Platform::InterlockedAdd(&RenderStatsData::Counter.Triangles, triangles)
+#define RENDER_STAT_OCCLUSION(visible, occluded) \
+	Platform::InterlockedAdd(&RenderStatsData::Counter.OcclusionVisibleObjects, visible); \
+	Platform::InterlockedAdd(&RenderStatsData::Counter.OccludedObjects, occluded)
 
 #else
 
 #define RENDER_STAT_DISPATCH_CALL()
 #define RENDER_STAT_PS_STATE_CHANGE()
 #define RENDER_STAT_DRAW_CALL(vertices, primitives)
+#define RENDER_STAT_OCCLUSION(visible, occluded)
 
 #endif
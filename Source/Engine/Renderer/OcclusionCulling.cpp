@@ -0,0 +1,307 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "OcclusionCulling.h"
+#include "RenderList.h"
+#include "RendererAllocation.h"
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/RenderView.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/Models/CollisionProxy.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+static_assert(OcclusionBuffer::Width % 4 == 0, "Occlusion buffer rows are processed in groups of 4 pixels.");
+static_assert(OcclusionBuffer::Height % OcclusionBuffer::BinHeight == 0, "Occlusion buffer height has to be a multiple of the bin height.");
+
+namespace
+{
+    FORCE_INLINE Float4 TransformCoordinate(const Float3& v, const Matrix& m)
+    {
+        return Float4(
+            v.X * m.M11 + v.Y * m.M21 + v.Z * m.M31 + m.M41,
+            v.X * m.M12 + v.Y * m.M22 + v.Z * m.M32 + m.M42,
+            v.X * m.M13 + v.Y * m.M23 + v.Z * m.M33 + m.M43,
+            v.X * m.M14 + v.Y * m.M24 + v.Z * m.M34 + m.M44);
+    }
+
+    struct OccluderCandidate
+    {
+        const IOccluder* Occluder;
+        float ScreenSize;
+        bool Forced;
+
+        bool operator<(const OccluderCandidate& other) const
+        {
+            // Forced occluders go first, then the biggest ones on the screen
+            if (Forced != other.Forced)
+                return Forced;
+            return ScreenSize > other.ScreenSize;
+        }
+    };
+}
+
+void OcclusionBuffer::Init(const RenderView& view)
+{
+    Init(view.View, view.NonJitteredProjection, view.Near, view.Origin);
+}
+
+void OcclusionBuffer::Init(const Matrix& view, const Matrix& projection, float nearPlane, const Vector3& origin)
+{
+    _isValid = false;
+    _view = view;
+    _projection = projection;
+    Matrix::Multiply(view, projection, _viewProjection);
+    _origin = origin;
+    _near = nearPlane;
+    _triangles.Clear();
+    _depth.Resize(Width * Height);
+    const SimdVector4 far = SIMD::Splat(MAX_float);
+    float* depth = _depth.Get();
+    for (int32 i = 0; i < Width * Height; i += 4)
+        SIMD::Store(depth + i, far);
+}
+
+void OcclusionBuffer::AddOccluder(const CollisionProxy& proxy, const Matrix& world)
+{
+    static_assert(sizeof(CollisionProxy::CollisionTriangle) == sizeof(Float3) * 3, "Invalid collision triangle layout.");
+    AddOccluder((const Float3*)proxy.Triangles.Get(), proxy.Triangles.Count(), world);
+}
+
+void OcclusionBuffer::AddOccluder(const Float3* vertices, int32 trianglesCount, const Matrix& world)
+{
+    Matrix worldViewProjection;
+    Matrix::Multiply(world, _viewProjection, worldViewProjection);
+    _triangles.EnsureCapacity(_triangles.Count() + trianglesCount);
+    for (int32 i = 0; i < trianglesCount; i++)
+    {
+        Float2 screen[3];
+        Triangle triangle;
+        triangle.Depth = 0.0f;
+        bool clipped = false;
+        for (int32 j = 0; j < 3; j++)
+        {
+            const Float4 clip = TransformCoordinate(vertices[i * 3 + j], worldViewProjection);
+            if (clip.W <= ZeroTolerance || clip.Z < 0.0f)
+            {
+                // Skip triangles crossing the near plane (occluders don't need to be complete)
+                clipped = true;
+                break;
+            }
+            const float invW = 1.0f / clip.W;
+            screen[j] = Float2((clip.X * invW * 0.5f + 0.5f) * Width, (0.5f - clip.Y * invW * 0.5f) * Height);
+            triangle.Depth = Math::Max(triangle.Depth, clip.Z * invW);
+        }
+        if (clipped)
+            continue;
+
+        // Use consistent winding (occluders are double-sided) and skip degenerate triangles
+        const float area = (screen[1].X - screen[0].X) * (screen[2].Y - screen[0].Y) - (screen[1].Y - screen[0].Y) * (screen[2].X - screen[0].X);
+        if (Math::Abs(area) < ZeroTolerance)
+            continue;
+        triangle.V0 = screen[0];
+        triangle.V1 = area > 0.0f ? screen[1] : screen[2];
+        triangle.V2 = area > 0.0f ? screen[2] : screen[1];
+
+        // Clip bounds to the screen
+        const Float2 min = Float2::Min(Float2::Min(screen[0], screen[1]), screen[2]);
+        const Float2 max = Float2::Max(Float2::Max(screen[0], screen[1]), screen[2]);
+        const int32 minX = Math::Max((int32)Math::Floor(min.X), 0);
+        const int32 minY = Math::Max((int32)Math::Floor(min.Y), 0);
+        const int32 maxX = Math::Min((int32)Math::Ceil(max.X), Width - 1);
+        const int32 maxY = Math::Min((int32)Math::Ceil(max.Y), Height - 1);
+        if (minX > maxX || minY > maxY)
+            continue;
+        triangle.MinX = (int16)minX;
+        triangle.MinY = (int16)minY;
+        triangle.MaxX = (int16)maxX;
+        triangle.MaxY = (int16)maxY;
+        _triangles.Add(triangle);
+    }
+}
+
+void OcclusionBuffer::Rasterize()
+{
+    PROFILE_CPU();
+    if (_triangles.IsEmpty())
+        return;
+    constexpr int32 binsCount = Height / BinHeight;
+    Function<void(int32)> job;
+    job.Bind<OcclusionBuffer, &OcclusionBuffer::RasterizeBin>(this);
+    const int64 label = JobSystem::Dispatch(job, binsCount, JobPriority::FrameCritical);
+    JobSystem::Wait(label);
+    _isValid = true;
+}
+
+void OcclusionBuffer::RasterizeBin(int32 binIndex)
+{
+    PROFILE_CPU();
+    const int32 binMinY = binIndex * BinHeight;
+    const int32 binMaxY = binMinY + BinHeight - 1;
+    float* depthBuffer = _depth.Get();
+    const SimdVector4 laneOffsets = SIMD::Load(0.5f, 1.5f, 2.5f, 3.5f);
+    for (const Triangle& triangle : _triangles)
+    {
+        if (triangle.MaxY < binMinY || triangle.MinY > binMaxY)
+            continue;
+        const int32 minX = triangle.MinX & ~3;
+        const int32 maxX = triangle.MaxX;
+        const int32 minY = Math::Max<int32>(triangle.MinY, binMinY);
+        const int32 maxY = Math::Min<int32>(triangle.MaxY, binMaxY);
+
+        // Edge functions (positive inside the triangle): E(x, y) = A * x + B * y + C
+        const Float2* v[3] = { &triangle.V0, &triangle.V1, &triangle.V2 };
+        float a[3], b[3], c[3];
+        for (int32 i = 0; i < 3; i++)
+        {
+            const Float2& v0 = *v[i];
+            const Float2& v1 = *v[(i + 1) % 3];
+            a[i] = v0.Y - v1.Y;
+            b[i] = v1.X - v0.X;
+            c[i] = v0.X * v1.Y - v0.Y * v1.X;
+        }
+        const SimdVector4 stepX0 = SIMD::Splat(a[0] * 4.0f);
+        const SimdVector4 stepX1 = SIMD::Splat(a[1] * 4.0f);
+        const SimdVector4 stepX2 = SIMD::Splat(a[2] * 4.0f);
+        const SimdVector4 depth = SIMD::Splat(triangle.Depth);
+        const SimdVector4 px = SIMD::Add(SIMD::Splat((float)minX), laneOffsets);
+        const SimdVector4 rowEdge0 = SIMD::Mul(SIMD::Splat(a[0]), px);
+        const SimdVector4 rowEdge1 = SIMD::Mul(SIMD::Splat(a[1]), px);
+        const SimdVector4 rowEdge2 = SIMD::Mul(SIMD::Splat(a[2]), px);
+        for (int32 y = minY; y <= maxY; y++)
+        {
+            const float py = (float)y + 0.5f;
+            SimdVector4 e0 = SIMD::Add(rowEdge0, SIMD::Splat(b[0] * py + c[0]));
+            SimdVector4 e1 = SIMD::Add(rowEdge1, SIMD::Splat(b[1] * py + c[1]));
+            SimdVector4 e2 = SIMD::Add(rowEdge2, SIMD::Splat(b[2] * py + c[2]));
+            float* row = depthBuffer + y * Width;
+            for (int32 x = minX; x <= maxX; x += 4)
+            {
+                // Pixel is inside if all edge functions are non-negative (sign bit of the minimum is clear)
+                const int32 inside = ~SIMD::MoveMask(SIMD::Min(SIMD::Min(e0, e1), e2)) & 0xf;
+                if (inside == 0xf)
+                {
+                    SIMD::Store(row + x, SIMD::Min(SIMD::Load(row + x), depth));
+                }
+                else if (inside != 0)
+                {
+                    for (int32 i = 0; i < 4; i++)
+                    {
+                        if (inside & (1 << i))
+                            row[x + i] = Math::Min(row[x + i], triangle.Depth);
+                    }
+                }
+                e0 = SIMD::Add(e0, stepX0);
+                e1 = SIMD::Add(e1, stepX1);
+                e2 = SIMD::Add(e2, stepX2);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::Reset()
+{
+    _isValid = false;
+    _triangles.Clear();
+}
+
+bool OcclusionBuffer::IsOccluded(const BoundingSphere& bounds) const
+{
+    ASSERT_LOW_LAYER(_isValid);
+    const Float3 center = bounds.Center;
+    const float radius = (float)bounds.Radius;
+
+    // Find the nearest depth of the bounds (objects intersecting near plane are visible)
+    const float viewZ = center.X * _view.M13 + center.Y * _view.M23 + center.Z * _view.M33 + _view.M43 - radius;
+    if (viewZ <= _near)
+        return false;
+    const float nearDepth = (viewZ * _projection.M33 + _projection.M43) / (viewZ * _projection.M34 + _projection.M44);
+
+    // Find the screen-space bounds of the object
+    Float2 min(MAX_float), max(MIN_float);
+    for (int32 i = 0; i < 8; i++)
+    {
+        const Float3 corner(center.X + (i & 1 ? radius : -radius), center.Y + (i & 2 ? radius : -radius), center.Z + (i & 4 ? radius : -radius));
+        const Float4 clip = TransformCoordinate(corner, _viewProjection);
+        if (clip.W <= ZeroTolerance)
+            return false;
+        const float invW = 1.0f / clip.W;
+        const Float2 screen((clip.X * invW * 0.5f + 0.5f) * Width, (0.5f - clip.Y * invW * 0.5f) * Height);
+        min = Float2::Min(min, screen);
+        max = Float2::Max(max, screen);
+    }
+    const int32 minX = Math::Max((int32)Math::Floor(min.X), 0) & ~3;
+    const int32 minY = Math::Max((int32)Math::Floor(min.Y), 0);
+    const int32 maxX = Math::Min((int32)Math::Ceil(max.X), Width - 1);
+    const int32 maxY = Math::Min((int32)Math::Ceil(max.Y), Height - 1);
+    if (minX > maxX || minY > maxY)
+        return false;
+
+    // Object is occluded if all pixels of the occluders are closer than the object
+    const float* depthBuffer = _depth.Get();
+    const SimdVector4 objectDepth = SIMD::Splat(nearDepth);
+    for (int32 y = minY; y <= maxY; y++)
+    {
+        const float* row = depthBuffer + y * Width;
+        SimdVector4 rowMax = SIMD::Load(row + minX);
+        for (int32 x = minX + 4; x <= maxX; x += 4)
+            rowMax = SIMD::Max(rowMax, SIMD::Load(row + x));
+        if (SIMD::MoveMask(SIMD::Sub(rowMax, objectDepth)) != 0xf)
+            return false;
+    }
+    return true;
+}
+
+void OcclusionBuffer::DrawOccluders(const RenderContext& renderContext)
+{
+    Reset();
+    const RenderView& view = renderContext.View;
+    if (!Graphics::OcclusionCulling::Enabled || view.IsCullingDisabled || Graphics::OcclusionCulling::MaxOccluders <= 0)
+        return;
+    PROFILE_CPU();
+
+    // Find the visible occluders
+    Array<OccluderCandidate, RendererAllocation> candidates;
+    const float minScreenSizeSq = Math::Square(Graphics::OcclusionCulling::MinOccluderScreenSize * 0.5f);
+    for (Scene* scene : Level::Scenes)
+    {
+        if (!scene->IsActiveInHierarchy())
+            continue;
+        SceneRendering& rendering = scene->Rendering;
+        const bool lock = !rendering.IsRendering(); // Scene is already locked for reading during drawing
+        if (lock)
+            rendering.Locker.ReadLock();
+        for (const IOccluder* occluder : rendering.Occluders)
+        {
+            if (!occluder)
+                continue;
+            BoundingSphere bounds;
+            OccluderCandidate candidate;
+            if (!occluder->GetOccluderBounds(bounds, candidate.Forced))
+                continue;
+            bounds.Center -= view.Origin;
+            if (!view.CullingFrustum.Intersects(bounds))
+                continue;
+            candidate.Occluder = occluder;
+            candidate.ScreenSize = RenderTools::ComputeBoundsScreenRadiusSquared(bounds.Center, (float)bounds.Radius, view);
+            if (candidate.Forced || candidate.ScreenSize >= minScreenSizeSq)
+                candidates.Add(candidate);
+        }
+        if (lock)
+            rendering.Locker.ReadUnlock();
+    }
+    if (candidates.IsEmpty())
+        return;
+
+    // Rasterize the biggest occluders
+    Sorting::QuickSort(candidates);
+    Init(view);
+    const int32 count = Math::Min(candidates.Count(), Graphics::OcclusionCulling::MaxOccluders);
+    for (int32 i = 0; i < count; i++)
+        candidates.Get()[i].Occluder->DrawOccluder(*this);
+    Rasterize();
+}
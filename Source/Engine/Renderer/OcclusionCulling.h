@@ -0,0 +1,187 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+
+struct RenderContext;
+struct RenderView;
+class CollisionProxy;
+class OcclusionBuffer;
+
+/// <summary>
+/// The object usage mode for the CPU occlusion culling.
+/// </summary>
+API_ENUM() enum class OccluderMode : byte
+{
+    /// <summary>
+    /// Object is never used as occluder.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// Object is used as occluder if it's static (has Transform static flag) and big enough on the screen.
+    /// </summary>
+    Auto = 1,
+
+    /// <summary>
+    /// Object is always used as occluder when it's visible.
+    /// </summary>
+    Always = 2,
+};
+
+/// <summary>
+/// Interface for objects that can occlude other objects in the CPU occlusion culling.
+/// </summary>
+class FLAXENGINE_API IOccluder
+{
+public:
+    /// <summary>
+    /// Gets the occluder bounds. Returns false if object cannot be used as occluder at the moment (eg. geometry is not loaded).
+    /// </summary>
+    /// <param name="bounds">The result world-space bounds.</param>
+    /// <param name="forced">The result flag set to true if occluder should be always used (otherwise it's picked by the screen size).</param>
+    /// <returns>True if object can be used as occluder, otherwise false.</returns>
+    virtual bool GetOccluderBounds(BoundingSphere& bounds, bool& forced) const = 0;
+
+    /// <summary>
+    /// Draws the occluder geometry into the occlusion buffer.
+    /// </summary>
+    /// <param name="buffer">The occlusion buffer.</param>
+    virtual void DrawOccluder(OcclusionBuffer& buffer) const = 0;
+};
+
+/// <summary>
+/// Low-resolution depth buffer rasterized on a CPU from the occluders geometry. Used to cull objects that are hidden behind the big occluders before drawing them.
+/// </summary>
+class FLAXENGINE_API OcclusionBuffer
+{
+public:
+    /// <summary>
+    /// The buffer width (in pixels).
+    /// </summary>
+    static constexpr int32 Width = 256;
+
+    /// <summary>
+    /// The buffer height (in pixels).
+    /// </summary>
+    static constexpr int32 Height = 128;
+
+    /// <summary>
+    /// The amount of rows rasterized by a single job.
+    /// </summary>
+    static constexpr int32 BinHeight = 16;
+
+private:
+    struct Triangle
+    {
+        // Screen-space vertices.
+        Float2 V0, V1, V2;
+        // The conservative (farthest) triangle depth.
+        float Depth;
+        // The screen-space bounds (in pixels).
+        int16 MinX, MinY, MaxX, MaxY;
+    };
+
+    bool _isValid = false;
+    Matrix _view;
+    Matrix _projection;
+    Matrix _viewProjection;
+    Vector3 _origin;
+    float _near;
+    Array<float> _depth;
+    Array<Triangle> _triangles;
+
+public:
+    /// <summary>
+    /// Returns true if buffer has been rasterized and can be used to test the objects.
+    /// </summary>
+    FORCE_INLINE bool IsValid() const
+    {
+        return _isValid;
+    }
+
+    /// <summary>
+    /// Gets the rasterized triangles count.
+    /// </summary>
+    FORCE_INLINE int32 GetTrianglesCount() const
+    {
+        return _triangles.Count();
+    }
+
+    /// <summary>
+    /// Gets the view origin used by the buffer (world-space geometry is offset by it).
+    /// </summary>
+    FORCE_INLINE const Vector3& GetOrigin() const
+    {
+        return _origin;
+    }
+
+    /// <summary>
+    /// Gets the depth buffer data (Width x Height, device depth of the nearest occluder per pixel).
+    /// </summary>
+    FORCE_INLINE const float* GetDepth() const
+    {
+        return _depth.Get();
+    }
+
+public:
+    /// <summary>
+    /// Begins the occluders drawing for the view. Clears the buffer.
+    /// </summary>
+    /// <param name="view">The render view.</param>
+    void Init(const RenderView& view);
+
+    /// <summary>
+    /// Begins the occluders drawing for the view. Clears the buffer.
+    /// </summary>
+    /// <param name="view">The view matrix.</param>
+    /// <param name="projection">The projection matrix (non-jittered).</param>
+    /// <param name="nearPlane">The view near plane.</param>
+    /// <param name="origin">The view origin (world-space geometry is offset by it).</param>
+    void Init(const Matrix& view, const Matrix& projection, float nearPlane, const Vector3& origin);
+
+    /// <summary>
+    /// Adds the occluder geometry triangles. Triangles that cross the near plane are skipped.
+    /// </summary>
+    /// <param name="proxy">The geometry triangles (in local-space).</param>
+    /// <param name="world">The geometry world matrix (relative to the view origin).</param>
+    void AddOccluder(const CollisionProxy& proxy, const Matrix& world);
+
+    /// <summary>
+    /// Adds the occluder triangles.
+    /// </summary>
+    /// <param name="vertices">The triangle vertices (3 per triangle, in local-space).</param>
+    /// <param name="trianglesCount">The triangles count.</param>
+    /// <param name="world">The geometry world matrix (relative to the view origin).</param>
+    void AddOccluder(const Float3* vertices, int32 trianglesCount, const Matrix& world);
+
+    /// <summary>
+    /// Rasterizes the occluders into the depth buffer (in parallel via Job System). Buffer can be used for testing after that.
+    /// </summary>
+    void Rasterize();
+
+    /// <summary>
+    /// Invalidates the buffer (eg. on the frame end).
+    /// </summary>
+    void Reset();
+
+    /// <summary>
+    /// Tests if the object bounds are fully hidden behind the occluders. Thread-safe.
+    /// </summary>
+    /// <param name="bounds">The object bounds (relative to the view origin).</param>
+    /// <returns>True if object is occluded, otherwise false.</returns>
+    bool IsOccluded(const BoundingSphere& bounds) const;
+
+    /// <summary>
+    /// Draws the occluders from the scenes into the buffer. Picks the biggest visible occluders on the screen. Buffer is left invalid if CPU occlusion culling is disabled or there are no occluders.
+    /// </summary>
+    /// <param name="renderContext">The main render context.</param>
+    void DrawOccluders(const RenderContext& renderContext);
+
+private:
+    void RasterizeBin(int32 binIndex);
+};
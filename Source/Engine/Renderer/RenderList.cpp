@@ -585,6 +585,7 @@ void RenderList::Init(RenderContext& renderContext)
 void RenderList::Clear()
 {
     Scenes.Clear();
+    Occlusion.Reset();
     DrawCalls.Clear();
     BatchedDrawCalls.Clear();
     for (auto& list : DrawCallsLists)
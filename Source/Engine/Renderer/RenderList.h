@@ -12,6 +12,7 @@
 #include "RenderListBuffer.h"
 #include "RendererAllocation.h"
 #include "RenderSetup.h"
+#include "OcclusionCulling.h"
 
 enum class StaticFlags;
 class RenderBuffers;
@@ -369,6 +370,11 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     Array<SceneRendering*> Scenes;
 
+    /// <summary>
+    /// The CPU occlusion culling buffer for the main view (valid only if occlusion culling is enabled and there are visible occluders).
+    /// </summary>
+    OcclusionBuffer Occlusion;
+
     /// <summary>
     /// Draw calls list (for all draw passes).
     /// </summary>
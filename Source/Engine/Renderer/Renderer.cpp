@@ -470,6 +470,9 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
         GBufferPass::Instance()->PreOverrideDrawCalls(renderContext);
 #endif
 
+        // Rasterize the biggest occluders to skip drawing of the hidden objects
+        renderContext.List->Occlusion.DrawOccluders(renderContext);
+
         // Dispatch drawing (via JobSystem - multiple job batches for every scene)
         JobSystem::SetJobStartingOnDispatch(false);
         task->OnCollectDrawCalls(renderContextBatch, SceneRendering::DrawCategory::SceneDraw);
@@ -541,9 +544,9 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
         // Dispatch async jobs
         Function<void(int32)> func;
         func.Bind<DrawCallsProcessor, &DrawCallsProcessor::BuildObjectsBufferJob>(&processor);
-        const int64 buildObjectsBufferJob = JobSystem::Dispatch(func, renderContextBatch.Contexts.Count());
+        const int64 buildObjectsBufferJob = JobSystem::Dispatch(func, renderContextBatch.Contexts.Count(), JobPriority::FrameCritical);
         func.Bind<DrawCallsProcessor, &DrawCallsProcessor::SortDrawCallsJob>(&processor);
-        const int64 sortDrawCallsJob = JobSystem::Dispatch(func, ARRAY_COUNT(DrawCallsProcessor::MainContextSorting) + renderContextBatch.Contexts.Count());
+        const int64 sortDrawCallsJob = JobSystem::Dispatch(func, ARRAY_COUNT(DrawCallsProcessor::MainContextSorting) + renderContextBatch.Contexts.Count(), JobPriority::FrameCritical);
 
         // Upload objects buffers to the GPU
         JobSystem::Wait(buildObjectsBufferJob);
@@ -23,6 +23,17 @@ class FLAXENGINE_API IStreamingHandler
     /// <returns>Target quality (0-1).</returns>
     virtual float CalculateTargetQuality(StreamableResource* resource, double currentTime) = 0;
 
+    /// <summary>
+    /// Calculates the resource importance used to order streaming work and to pick resources to reduce quality when going over the memory budget (the least important go first).
+    /// </summary>
+    /// <param name="resource">The resource.</param>
+    /// <param name="currentTime">The current platform time (seconds).</param>
+    /// <returns>The priority (higher is more important).</returns>
+    virtual float CalculatePriority(StreamableResource* resource, double currentTime)
+    {
+        return 1.0f;
+    }
+
     /// <summary>
     /// Calculates the residency level for a given resource and quality level.
     /// </summary>
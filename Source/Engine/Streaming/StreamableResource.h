@@ -13,11 +13,14 @@ class Task;
 /// </summary>
 class FLAXENGINE_API StreamableResource
 {
+    friend class StreamingSystem;
 protected:
 
     StreamingGroup* _group;
     bool _isDynamic, _isStreaming;
     float _streamingQuality;
+    mutable int64 _reportedScreenSize = 0;
+    int64 _streamingDirty = 0;
 
     StreamableResource(StreamingGroup* group);
     ~StreamableResource();
@@ -79,6 +82,16 @@ class FLAXENGINE_API StreamableResource
     /// </summary>
     virtual int32 GetAllocatedResidency() const = 0;
 
+    /// <summary>
+    /// Gets the estimated memory usage (in bytes) of the resource data at the given residency level. Used by the streaming memory budgets. Returns 0 if unknown (resource is not included in budgets).
+    /// </summary>
+    /// <param name="residency">The residency level.</param>
+    /// <returns>The amount of bytes.</returns>
+    virtual uint64 GetResidencyMemoryUsage(int32 residency) const
+    {
+        return 0;
+    }
+
 public:
 
     /// <summary>
@@ -113,6 +126,13 @@ class FLAXENGINE_API StreamableResource
         double LastUpdateTime = 0.0;
         double TargetResidencyChangeTime = 0;
         int32 TargetResidency = 0;
+        // The residency level picked from the target quality (before applying memory budgets).
+        int32 QualityResidency = 0;
+        // The resource importance used to order streaming and to pick resources to reduce quality when going over the memory budget.
+        float Priority = 0.0f;
+        // The maximum screen size (squared radius) of the resource reported since the last update. Decays on every update the resource was not drawn in.
+        float ScreenSize = 0.0f;
+        double LastVisibleTime = -1.0;
         bool Error = false;
         SamplesBuffer<float, 5> QualitySamples;
     };
@@ -125,9 +145,15 @@ class FLAXENGINE_API StreamableResource
     Action ResidencyChanged;
 
     /// <summary>
-    /// Requests the streaming update for this resource during next streaming manager update.
+    /// Requests the streaming update for this resource during next streaming manager update. Only this resource target residency is updated (within the memory budgets left from the last full update).
     /// </summary>
     void RequestStreamingUpdate();
+
+    /// <summary>
+    /// Reports the resource usage on the screen (eg. when selecting model LOD). Used to calculate the target quality and priority of the resource. Thread-safe.
+    /// </summary>
+    /// <param name="screenRadiusSquared">The squared radius of the resource bounds on the screen (normalized).</param>
+    void ReportScreenSize(float screenRadiusSquared) const;
     
     /// <summary>
     /// Stops the streaming (eg. on streaming fail).
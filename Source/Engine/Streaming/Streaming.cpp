@@ -2,10 +2,12 @@
 
 #include "Streaming.h"
 #include "StreamableResource.h"
+#include "StreamingBudget.h"
 #include "StreamingGroup.h"
 #include "StreamingSettings.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Threading/Threading.h"
@@ -15,11 +17,18 @@
 #include "Engine/Graphics/Textures/GPUSampler.h"
 #include "Engine/Serialization/Serialization.h"
 
+// The scale applied to the resource screen size on every streaming update it was not drawn in (lowers the target quality of the resources that are not visible anymore)
+#define STREAMING_SCREEN_SIZE_DECAY 0.5f
+
 namespace StreamingManagerImpl
 {
-    int32 LastUpdateResourcesIndex = 0;
+    double LastUpdateTime = 0.0;
+    int64 DirtyResourcesCount = 0;
+    int32 UpdateQueueIndex = 0;
     CriticalSection ResourcesLock;
     Array<StreamableResource*> Resources;
+    Array<StreamableResource*> UpdateQueue;
+    StreamingStats BudgetStats;
     Array<GPUSampler*, InlinedAllocation<32>> TextureGroupSamplers;
     GPUSampler* FallbackSampler = nullptr;
 }
@@ -43,16 +52,123 @@ class StreamingSystem : public TaskGraphSystem
 public:
     void Job(int32 index);
     void Execute(TaskGraph* graph) override;
+
+private:
+    int32 UpdateQuality(StreamableResource* resource, double currentTime);
+    void UpdateTargets(double currentTime);
+    void UpdateDirtyTargets(double currentTime);
 };
 
 namespace
 {
     TaskGraphSystem* System = nullptr;
+
+    // Priority queue (binary min-heap) of the budget items ordered by the importance of their highest residency level.
+    struct EvictionQueue
+    {
+        Array<StreamingBudget::Item>& Items;
+        Array<int32> Heap;
+
+        EvictionQueue(Array<StreamingBudget::Item>& items)
+            : Items(items)
+        {
+        }
+
+        float GetKey(int32 item) const
+        {
+            // Each next level removed from the same resource is more important (lower mips are smaller but visible for longer)
+            const StreamingBudget::Item& e = Items.Get()[item];
+            return e.Priority * (float)(1 + e.QualityResidency - e.Residency);
+        }
+
+        void Push(int32 item)
+        {
+            int32 index = Heap.Count();
+            Heap.Add(item);
+            int32* heap = Heap.Get();
+            const float key = GetKey(item);
+            while (index > 0)
+            {
+                const int32 parent = (index - 1) / 2;
+                if (GetKey(heap[parent]) <= key)
+                    break;
+                heap[index] = heap[parent];
+                index = parent;
+            }
+            heap[index] = item;
+        }
+
+        int32 Pop()
+        {
+            int32* heap = Heap.Get();
+            const int32 result = heap[0];
+            const int32 last = heap[Heap.Count() - 1];
+            Heap.RemoveLast();
+            const int32 count = Heap.Count();
+            if (count != 0)
+            {
+                const float key = GetKey(last);
+                int32 index = 0;
+                while (true)
+                {
+                    int32 child = index * 2 + 1;
+                    if (child >= count)
+                        break;
+                    if (child + 1 < count && GetKey(heap[child + 1]) < GetKey(heap[child]))
+                        child++;
+                    if (key <= GetKey(heap[child]))
+                        break;
+                    heap[index] = heap[child];
+                    index = child;
+                }
+                heap[index] = last;
+            }
+            return result;
+        }
+    };
+
+    struct UpdateQueueItem
+    {
+        StreamableResource* Resource;
+        float Priority;
+
+        bool operator<(const UpdateQueueItem& other) const
+        {
+            // Sort from the most important
+            return Priority > other.Priority;
+        }
+    };
+}
+
+uint64 StreamingBudget::Apply(Array<Item>& items, int32 groupIndex, uint64 memory, uint64 budget)
+{
+    EvictionQueue queue(items);
+    for (int32 i = 0; i < items.Count(); i++)
+    {
+        const Item& e = items.Get()[i];
+        if ((groupIndex == -1 || e.GroupIndex == groupIndex) && e.Residency > e.MinResidency)
+            queue.Push(i);
+    }
+    while (memory > budget && queue.Heap.HasItems())
+    {
+        const int32 index = queue.Pop();
+        Item& e = items.Get()[index];
+        e.Residency--;
+        const uint64 newMemory = Math::Min(e.Resource->GetResidencyMemoryUsage(e.Residency), e.Memory);
+        memory -= e.Memory - newMemory;
+        e.Memory = newMemory;
+        if (e.Residency > e.MinResidency)
+            queue.Push(index);
+    }
+    return memory;
 }
 
 StreamingService StreamingServiceInstance;
 
 Array<TextureGroup, InlinedAllocation<32>> Streaming::TextureGroups;
+uint64 Streaming::MemoryBudget = 0;
+float Streaming::UpdateInterval = 0.1f;
+int32 Streaming::MaxResourcesPerUpdate = 50;
 
 void StreamingSettings::Apply()
 {
@@ -60,6 +176,13 @@ void StreamingSettings::Apply()
     Streaming::TextureGroups = TextureGroups;
     SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
     TextureGroupSamplers.Resize(TextureGroups.Count(), false);
+    Streaming::UpdateInterval = UpdateInterval;
+    Streaming::MaxResourcesPerUpdate = MaxResourcesPerUpdate;
+    Streaming::MemoryBudget = (uint64)Math::Max(MemoryBudget, 0) * 1024 * 1024;
+    auto groups = StreamingGroups::Instance();
+    groups->Textures()->SetMemoryBudget((uint64)Math::Max(TexturesMemoryBudget, 0) * 1024 * 1024);
+    groups->Models()->SetMemoryBudget((uint64)Math::Max(ModelsMemoryBudget, 0) * 1024 * 1024);
+    groups->SkinnedModels()->SetMemoryBudget((uint64)Math::Max(ModelsMemoryBudget, 0) * 1024 * 1024);
 }
 
 StreamableResource::StreamableResource(StreamingGroup* group)
@@ -78,7 +201,21 @@ StreamableResource::~StreamableResource()
 
 void StreamableResource::RequestStreamingUpdate()
 {
+    // Update only this resource on the next streaming update (full update happens at fixed intervals)
     Streaming.LastUpdateTime = 0.0;
+    if (Platform::InterlockedExchange(&_streamingDirty, 1) == 0)
+        Platform::InterlockedIncrement(&DirtyResourcesCount);
+}
+
+void StreamableResource::ReportScreenSize(float screenRadiusSquared) const
+{
+    // Positive floats have the same order as their bits interpreted as integers so skip the compare-exchange loop (lost update is not a problem here)
+    int32 bits;
+    static_assert(sizeof(bits) == sizeof(screenRadiusSquared), "Invalid float size.");
+    Platform::MemoryCopy(&bits, &screenRadiusSquared, sizeof(bits));
+    const int64 value = bits;
+    if (value > Platform::AtomicRead(&_reportedScreenSize))
+        Platform::AtomicStore(&_reportedScreenSize, value);
 }
 
 void StreamableResource::ResetStreaming(bool error)
@@ -107,26 +244,108 @@ void StreamableResource::StopStreaming()
     {
         ResourcesLock.Lock();
         Resources.Remove(this);
+        for (StreamableResource*& e : UpdateQueue)
+        {
+            // Resource can be queued multiple times (eg. already processed entry and the requested one)
+            if (e == this)
+                e = nullptr;
+        }
+        if (Platform::InterlockedExchange(&_streamingDirty, 0) != 0)
+            Platform::InterlockedDecrement(&DirtyResourcesCount);
         ResourcesLock.Unlock();
         Streaming = StreamingCache();
         _isStreaming = false;
     }
 }
 
-void UpdateResource(StreamableResource* resource, double currentTime)
+bool UpdateResource(StreamableResource* resource)
 {
     ASSERT(resource && resource->CanBeUpdated());
+    auto handler = resource->GetGroup()->GetHandler();
+    const int32 currentResidency = resource->GetCurrentResidency();
+    const int32 allocatedResidency = resource->GetAllocatedResidency();
+    const int32 targetResidency = resource->Streaming.TargetResidency;
+    ASSERT(allocatedResidency >= currentResidency && allocatedResidency >= 0);
+
+    // Check if need to change resource current residency
+    if (!handler->RequiresStreaming(resource, currentResidency, targetResidency))
+        return false;
+
+    // Check if need to change allocation for that resource
+    if (allocatedResidency != targetResidency)
+    {
+        // Update resource allocation
+        Task* allocateTask = resource->UpdateAllocation(targetResidency);
+        if (allocateTask)
+        {
+            // When resource wants to perform reallocation on a task then skip further updating until it's done (it will be queued again on the next update)
+            allocateTask->Start();
+            return true;
+        }
+        else if (resource->GetAllocatedResidency() < targetResidency)
+        {
+            // Allocation failed (eg. texture format is not supported or run out of memory)
+            resource->ResetStreaming();
+            return false;
+        }
+    }
+
+    // Calculate residency level to stream in (resources may want to increase/decrease it's quality in steps rather than at once)
+    const int32 requestedResidency = handler->CalculateRequestedResidency(resource, targetResidency);
+
+    // Create streaming task (resource type specific)
+    Task* streamingTask = resource->CreateStreamingTask(requestedResidency);
+    if (streamingTask != nullptr)
+    {
+        streamingTask->Start();
+        return true;
+    }
+    return false;
+}
 
-    // Pick group and handler dedicated for that resource
-    auto group = resource->GetGroup();
-    auto handler = group->GetHandler();
+bool StreamingService::Init()
+{
+    PROFILE_MEM(ContentStreaming);
+    System = New<StreamingSystem>();
+    Engine::UpdateGraph->AddSystem(System);
+    return false;
+}
+
+void StreamingService::BeforeExit()
+{
+    SAFE_DELETE_GPU_RESOURCE(FallbackSampler);
+    SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
+    TextureGroupSamplers.Resize(0);
+    SAFE_DELETE(System);
+}
+
+int32 StreamingSystem::UpdateQuality(StreamableResource* resource, double currentTime)
+{
+    auto handler = resource->GetGroup()->GetHandler();
+    if (Platform::InterlockedExchange(&resource->_streamingDirty, 0) != 0)
+        Platform::InterlockedDecrement(&DirtyResourcesCount);
+
+    // Update the screen size reported by the rendering (views report the maximum since the last update, old size decays if resource was not drawn)
+    const int64 reportedScreenSize = Platform::InterlockedExchange(&resource->_reportedScreenSize, 0);
+    if (reportedScreenSize != 0)
+    {
+        const int32 screenSizeBits = (int32)reportedScreenSize;
+        Platform::MemoryCopy(&resource->Streaming.ScreenSize, &screenSizeBits, sizeof(screenSizeBits));
+        resource->Streaming.LastVisibleTime = currentTime;
+    }
+    else
+    {
+        resource->Streaming.ScreenSize *= STREAMING_SCREEN_SIZE_DECAY;
+    }
 
     // Calculate target quality for that asset
     float targetQuality = 1.0f;
+    float priority = MAX_float;
     if (resource->IsDynamic())
     {
         targetQuality = handler->CalculateTargetQuality(resource, currentTime);
         targetQuality = Math::Saturate(targetQuality);
+        priority = handler->CalculatePriority(resource, currentTime);
     }
 
     // Update quality smoothing
@@ -135,126 +354,222 @@ void UpdateResource(StreamableResource* resource, double currentTime)
     targetQuality = Math::Saturate(targetQuality);
 
     // Calculate target residency level (discrete value)
-    auto maxResidency = resource->GetMaxResidency();
-    auto currentResidency = resource->GetCurrentResidency();
-    auto allocatedResidency = resource->GetAllocatedResidency();
-    auto targetResidency = handler->CalculateResidency(resource, targetQuality);
-    ASSERT(allocatedResidency >= currentResidency && allocatedResidency >= 0);
+    const int32 residency = handler->CalculateResidency(resource, targetQuality);
+    resource->Streaming.QualityResidency = residency;
+    resource->Streaming.Priority = priority;
     resource->Streaming.LastUpdateTime = currentTime;
+    return residency;
+}
 
-    // Check if a target residency level has been changed
-    if (targetResidency != resource->Streaming.TargetResidency)
-    {
-        // Register change
-        resource->Streaming.TargetResidency = targetResidency;
-        resource->Streaming.TargetResidencyChangeTime = currentTime;
-    }
-
-    // Check if need to change resource current residency
-    if (handler->RequiresStreaming(resource, currentResidency, targetResidency))
+void StreamingSystem::UpdateTargets(double currentTime)
+{
+    PROFILE_CPU();
+    const auto& groups = StreamingGroups::Instance()->Groups();
+    Array<uint64, InlinedAllocation<8>> groupsWantedMemory, groupsMemory, groupsPendingBytes;
+    groupsWantedMemory.Resize(groups.Count());
+    groupsMemory.Resize(groups.Count());
+    groupsPendingBytes.Resize(groups.Count());
+    Platform::MemoryClear(groupsWantedMemory.Get(), groupsWantedMemory.Count() * sizeof(uint64));
+    Platform::MemoryClear(groupsMemory.Get(), groupsMemory.Count() * sizeof(uint64));
+    Platform::MemoryClear(groupsPendingBytes.Get(), groupsPendingBytes.Count() * sizeof(uint64));
+    uint64 wantedMemory = 0;
+    Array<StreamingBudget::Item> items;
+    Array<UpdateQueueItem> queue;
+    items.EnsureCapacity(Resources.Count());
+
+    // Calculate target residency for all resources (from the quality)
+    for (StreamableResource* resource : Resources)
     {
-        // Check if need to change allocation for that resource
-        if (allocatedResidency != targetResidency)
+        StreamingGroup* group = resource->GetGroup();
+        const int32 groupIndex = groups.Find(group);
+        auto handler = group->GetHandler();
+        const int32 currentResidency = resource->GetCurrentResidency();
+        const uint64 currentMemory = resource->GetResidencyMemoryUsage(currentResidency);
+        if (groupIndex != -1)
+            groupsMemory[groupIndex] += currentMemory;
+        if (resource->Streaming.LastUpdateTime > currentTime || !resource->CanBeUpdated())
         {
-            // Update resource allocation
-            Task* allocateTask = resource->UpdateAllocation(targetResidency);
-            if (allocateTask)
+            // Skip resources during streaming or with streaming disabled (count memory they use or are going to use)
+            const uint64 memory = Math::Max(currentMemory, resource->GetResidencyMemoryUsage(resource->Streaming.TargetResidency));
+            wantedMemory += memory;
+            if (groupIndex != -1)
             {
-                // When resource wants to perform reallocation on a task then skip further updating until it's done
-                allocateTask->Start();
-                resource->RequestStreamingUpdate();
-                return;
+                groupsWantedMemory[groupIndex] += memory;
+                groupsPendingBytes[groupIndex] += memory - currentMemory;
             }
-            else if (resource->GetAllocatedResidency() < targetResidency)
+            continue;
+        }
+
+        const int32 residency = UpdateQuality(resource, currentTime);
+        const float priority = resource->Streaming.Priority;
+        const uint64 memory = resource->GetResidencyMemoryUsage(residency);
+        if (memory != 0 && groupIndex != -1)
+        {
+            // Resource with known memory usage can be limited by the budgets (down to the lowest quality)
+            auto& e = items.AddOne();
+            e.Resource = resource;
+            e.GroupIndex = groupIndex;
+            e.QualityResidency = residency;
+            e.Residency = residency;
+            e.MinResidency = resource->IsDynamic() ? Math::Min(residency, handler->CalculateResidency(resource, ZeroTolerance)) : residency;
+            e.QualityMemory = memory;
+            e.Memory = memory;
+            e.Priority = priority;
+            wantedMemory += memory;
+            groupsWantedMemory[groupIndex] += memory;
+        }
+        else
+        {
+            if (residency != resource->Streaming.TargetResidency)
             {
-                // Allocation failed (eg. texture format is not supported or run out of memory)
-                resource->ResetStreaming();
-                return;
+                resource->Streaming.TargetResidency = residency;
+                resource->Streaming.TargetResidencyChangeTime = currentTime;
             }
+            if (handler->RequiresStreaming(resource, currentResidency, residency))
+                queue.Add({ resource, priority });
         }
+    }
 
-        // Calculate residency level to stream in (resources may want to increase/decrease it's quality in steps rather than at once)
-        int32 requestedResidency = handler->CalculateRequestedResidency(resource, targetResidency);
+    // Apply per-group memory budgets and then the global one
+    for (int32 groupIndex = 0; groupIndex < groups.Count(); groupIndex++)
+    {
+        const StreamingGroup* group = groups[groupIndex];
+        if (group->_memoryBudget != 0 && groupsWantedMemory[groupIndex] > group->_memoryBudget)
+            StreamingBudget::Apply(items, groupIndex, groupsWantedMemory[groupIndex], group->_memoryBudget);
+    }
+    if (Streaming::MemoryBudget != 0)
+    {
+        uint64 memory = wantedMemory;
+        for (const StreamingBudget::Item& e : items)
+            memory -= e.QualityMemory - e.Memory;
+        if (memory > Streaming::MemoryBudget)
+            StreamingBudget::Apply(items, -1, memory, Streaming::MemoryBudget);
+    }
 
-        // Create streaming task (resource type specific)
-        Task* streamingTask = resource->CreateStreamingTask(requestedResidency);
-        if (streamingTask != nullptr)
+    // Update resources target residency and queue the ones that need streaming
+    int32 budgetLimitedCount = 0;
+    for (const StreamingBudget::Item& e : items)
+    {
+        StreamableResource* resource = e.Resource;
+        if (e.Residency != resource->Streaming.TargetResidency)
+        {
+            resource->Streaming.TargetResidency = e.Residency;
+            resource->Streaming.TargetResidencyChangeTime = currentTime;
+        }
+        if (e.Residency < e.QualityResidency)
+            budgetLimitedCount++;
+        const int32 currentResidency = resource->GetCurrentResidency();
+        const uint64 currentMemory = resource->GetResidencyMemoryUsage(currentResidency);
+        groupsPendingBytes[e.GroupIndex] += e.Memory > currentMemory ? e.Memory - currentMemory : 0;
+        if (resource->GetGroup()->GetHandler()->RequiresStreaming(resource, currentResidency, e.Residency))
         {
-            streamingTask->Start();
+            // Stream out first to free the memory
+            queue.Add({ resource, e.Residency < currentResidency ? MAX_float : e.Priority });
         }
     }
-    else
+    Sorting::QuickSort(queue);
+    UpdateQueue.Clear();
+    UpdateQueue.EnsureCapacity(queue.Count());
+    for (const UpdateQueueItem& e : queue)
+        UpdateQueue.Add(e.Resource);
+    UpdateQueueIndex = 0;
+
+    // Update stats
+    BudgetStats = StreamingStats();
+    BudgetStats.MemoryBudget = Streaming::MemoryBudget;
+    BudgetStats.MemoryPressure = Streaming::MemoryBudget != 0 ? (float)((double)wantedMemory / (double)Streaming::MemoryBudget) : 0.0f;
+    BudgetStats.BudgetLimitedResourcesCount = budgetLimitedCount;
+    for (int32 groupIndex = 0; groupIndex < groups.Count(); groupIndex++)
     {
-        // TODO: Check if target residency is stable (no changes for a while)
-
-        // TODO: deallocate or decrease memory usage after timeout? (timeout should be smaller on low mem)
+        StreamingGroup* group = groups[groupIndex];
+        group->_memoryUsage = groupsMemory[groupIndex];
+        group->_pendingBytes = groupsPendingBytes[groupIndex];
+        group->_memoryPressure = group->_memoryBudget != 0 ? (float)((double)groupsWantedMemory[groupIndex] / (double)group->_memoryBudget) : 0.0f;
+        BudgetStats.MemoryUsage += group->_memoryUsage;
+        BudgetStats.PendingBytes += group->_pendingBytes;
     }
-
-    // low memory case:
-    // if we are on budget and cannot load everything we have to:
-    // decrease global resources quality scale (per resources group)
-    // decrease asset deallocate timeout
-
-    // low mem detecting:
-    // for low mem we have to get whole memory budget for a group and then
-    // subtract immutable resources mem usage (like render targets or non dynamic resources)
-    // so we get amount of memory we can distribute and we can detect if we are out of the limit
-    // low mem should be updated once per a few frames
 }
 
-bool StreamingService::Init()
+void StreamingSystem::UpdateDirtyTargets(double currentTime)
 {
-    PROFILE_MEM(ContentStreaming);
-    System = New<StreamingSystem>();
-    Engine::UpdateGraph->AddSystem(System);
-    return false;
-}
-
-void StreamingService::BeforeExit()
-{
-    SAFE_DELETE_GPU_RESOURCE(FallbackSampler);
-    SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
-    TextureGroupSamplers.Resize(0);
-    SAFE_DELETE(System);
+    PROFILE_CPU();
+    const auto& groups = StreamingGroups::Instance()->Groups();
+    for (StreamableResource* resource : Resources)
+    {
+        if (Platform::AtomicRead(&resource->_streamingDirty) == 0 || !resource->CanBeUpdated())
+            continue;
+        const int32 residency = UpdateQuality(resource, currentTime);
+        int32 targetResidency = residency;
+        StreamingGroup* group = resource->GetGroup();
+        const uint64 memory = resource->GetResidencyMemoryUsage(residency);
+        const uint64 targetMemory = resource->GetResidencyMemoryUsage(resource->Streaming.TargetResidency);
+        if (memory > targetMemory && groups.Contains(group))
+        {
+            // Grow only within the budgets left from the last full update (it will rebalance all resources)
+            const uint64 extraMemory = memory - targetMemory;
+            if ((Streaming::MemoryBudget != 0 && BudgetStats.MemoryUsage + BudgetStats.PendingBytes + extraMemory > Streaming::MemoryBudget) ||
+                (group->_memoryBudget != 0 && group->_memoryUsage + group->_pendingBytes + extraMemory > group->_memoryBudget))
+            {
+                targetResidency = resource->Streaming.TargetResidency;
+            }
+            else
+            {
+                BudgetStats.PendingBytes += extraMemory;
+                group->_pendingBytes += extraMemory;
+            }
+        }
+        if (targetResidency != resource->Streaming.TargetResidency)
+        {
+            resource->Streaming.TargetResidency = targetResidency;
+            resource->Streaming.TargetResidencyChangeTime = currentTime;
+        }
+        if (group->GetHandler()->RequiresStreaming(resource, resource->GetCurrentResidency(), targetResidency))
+        {
+            // Requested resources go first
+            bool queued = false;
+            for (int32 i = 0; i < UpdateQueue.Count(); i++)
+            {
+                StreamableResource*& e = UpdateQueue.Get()[i];
+                if (e != resource)
+                    continue;
+                if (i >= UpdateQueueIndex)
+                    queued = true;
+                else
+                    e = nullptr; // Keep resource in the queue only once
+            }
+            if (!queued)
+                UpdateQueue.Insert(UpdateQueueIndex, resource);
+        }
+    }
 }
 
 void StreamingSystem::Job(int32 index)
 {
     PROFILE_CPU_NAMED("Streaming.Job");
     PROFILE_MEM(ContentStreaming);
-
-    // TODO: use streaming settings
-    const double ResourceUpdatesInterval = 0.1;
-    int32 MaxResourcesPerUpdate = 50;
-
-    // Start update
     ScopeLock lock(ResourcesLock);
-    const int32 resourcesCount = Resources.Count();
-    int32 resourcesUpdates = Math::Min(MaxResourcesPerUpdate, resourcesCount);
     const double currentTime = Platform::GetTimeSeconds();
 
-    // Update high priority queue and then rest of the resources
-    // Note: resources in the update queue are updated always, while others only between specified intervals
-    int32 resourcesChecks = resourcesCount;
-    while (resourcesUpdates > 0 && resourcesChecks-- > 0)
+    // Update resources target residency and memory budgets (at fixed intervals)
+    if (currentTime - LastUpdateTime >= Streaming::UpdateInterval)
     {
-        // Move forward
-        LastUpdateResourcesIndex++;
-        if (LastUpdateResourcesIndex >= resourcesCount)
-            LastUpdateResourcesIndex = 0;
-
-        // Peek resource
-        const auto resource = Resources[LastUpdateResourcesIndex];
+        LastUpdateTime = currentTime;
+        UpdateTargets(currentTime);
+    }
+    else if (Platform::AtomicRead(&DirtyResourcesCount) != 0)
+    {
+        // Update resources that requested it
+        UpdateDirtyTargets(currentTime);
+    }
 
-        // Try to update it
-        if (currentTime - resource->Streaming.LastUpdateTime >= ResourceUpdatesInterval && resource->CanBeUpdated())
-        {
-            UpdateResource(resource, currentTime);
+    // Start streaming of the most important resources
+    int32 resourcesUpdates = Streaming::MaxResourcesPerUpdate;
+    while (resourcesUpdates > 0 && UpdateQueueIndex < UpdateQueue.Count())
+    {
+        StreamableResource* resource = UpdateQueue.Get()[UpdateQueueIndex++];
+        if (resource && resource->CanBeUpdated() && UpdateResource(resource))
             resourcesUpdates--;
-        }
     }
-
-    // TODO: add StreamingManager stats, update time per frame, updates per frame, etc.
 }
 
 void StreamingSystem::Execute(TaskGraph* graph)
@@ -270,8 +585,8 @@ void StreamingSystem::Execute(TaskGraph* graph)
 
 StreamingStats Streaming::GetStats()
 {
-    StreamingStats stats;
     ResourcesLock.Lock();
+    StreamingStats stats = BudgetStats;
     stats.ResourcesCount = Resources.Count();
     for (auto e : Resources)
     {
@@ -287,7 +602,8 @@ void Streaming::RequestStreamingUpdate()
     PROFILE_CPU();
     ResourcesLock.Lock();
     for (auto e : Resources)
-        e->RequestStreamingUpdate();
+        e->Streaming.LastUpdateTime = 0.0;
+    LastUpdateTime = 0.0;
     ResourcesLock.Unlock();
 }
 
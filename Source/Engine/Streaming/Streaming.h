@@ -16,6 +16,16 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingStats);
     API_FIELD() int32 ResourcesCount = 0;
     // Amount of resources that are during streaming in (target residency is higher that the current). Zero if all resources are streamed in.
     API_FIELD() int32 StreamingResourcesCount = 0;
+    // The global memory budget (in bytes) for the streamed resources. Zero if unlimited.
+    API_FIELD() uint64 MemoryBudget = 0;
+    // The estimated memory usage (in bytes) of the streamed resources (at their current residency).
+    API_FIELD() uint64 MemoryUsage = 0;
+    // The estimated amount of bytes to stream in for all resources to reach their target residency.
+    API_FIELD() uint64 PendingBytes = 0;
+    // The memory required by the resources at the target quality divided by the global budget. Values above 1 mean that quality is reduced to fit into the budget. Zero if budget is unlimited.
+    API_FIELD() float MemoryPressure = 0.0f;
+    // Amount of resources that have reduced quality due to the memory budgets.
+    API_FIELD() int32 BudgetLimitedResourcesCount = 0;
 };
 
 /// <summary>
@@ -30,6 +40,21 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Streaming);
     /// </summary>
     API_FIELD() static Array<TextureGroup, InlinedAllocation<32>> TextureGroups;
 
+    /// <summary>
+    /// The global memory budget (in bytes) for the streamed resources (eg. textures and models). Value 0 means unlimited. When exceeded, the least important resources get their quality reduced (the highest mips or LODs are streamed out first).
+    /// </summary>
+    API_FIELD() static uint64 MemoryBudget;
+
+    /// <summary>
+    /// The interval (in seconds) between the streaming updates of the resources target quality and memory budgets.
+    /// </summary>
+    API_FIELD() static float UpdateInterval;
+
+    /// <summary>
+    /// The maximum amount of resources to start streaming per-frame (the most important ones go first).
+    /// </summary>
+    API_FIELD() static int32 MaxResourcesPerUpdate;
+
     /// <summary>
     /// Gets streaming statistics.
     /// </summary>
@@ -0,0 +1,44 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+
+class StreamableResource;
+
+/// <summary>
+/// The streaming memory budgets solver. Reduces residency of the least important resources until the memory usage fits into the budget.
+/// </summary>
+class FLAXENGINE_API StreamingBudget
+{
+public:
+    /// <summary>
+    /// Streamable resource state used when applying the memory budgets.
+    /// </summary>
+    struct Item
+    {
+        StreamableResource* Resource;
+        int32 GroupIndex;
+        // The residency picked from the quality.
+        int32 QualityResidency;
+        // The residency after applying the budgets.
+        int32 Residency;
+        // The lowest residency that budgets can reduce the resource to.
+        int32 MinResidency;
+        // The memory usage at the QualityResidency.
+        uint64 QualityMemory;
+        // The memory usage at the Residency.
+        uint64 Memory;
+        float Priority;
+    };
+
+    /// <summary>
+    /// Reduces residency of the least important resources until memory usage fits into the budget. Each next level removed from the same resource is more important.
+    /// </summary>
+    /// <param name="items">The resources to limit.</param>
+    /// <param name="groupIndex">The index of the streaming group to limit, or -1 to limit all items.</param>
+    /// <param name="memory">The current memory usage (in bytes).</param>
+    /// <param name="budget">The memory budget (in bytes).</param>
+    /// <returns>The memory usage after applying the budget. Can be higher than the budget if resources cannot be reduced any further.</returns>
+    static uint64 Apply(Array<Item>& items, int32 groupIndex, uint64 memory, uint64 budget);
+};
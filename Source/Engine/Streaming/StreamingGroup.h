@@ -12,6 +12,7 @@
 /// </summary>
 class FLAXENGINE_API StreamingGroup
 {
+    friend class StreamingSystem;
 public:
 
     DECLARE_ENUM_4(Type, Custom, Textures, Models, Audio);
@@ -20,6 +21,10 @@ class FLAXENGINE_API StreamingGroup
 
     Type _type;
     IStreamingHandler* _handler;
+    uint64 _memoryBudget = 0;
+    uint64 _memoryUsage = 0;
+    uint64 _pendingBytes = 0;
+    float _memoryPressure = 0.0f;
 
 public:
 
@@ -55,6 +60,46 @@ class FLAXENGINE_API StreamingGroup
     {
         return _handler;
     }
+
+    /// <summary>
+    /// Gets the memory budget (in bytes) for the resources in this group. Value 0 means unlimited.
+    /// </summary>
+    FORCE_INLINE uint64 GetMemoryBudget() const
+    {
+        return _memoryBudget;
+    }
+
+    /// <summary>
+    /// Sets the memory budget (in bytes) for the resources in this group. Value 0 means unlimited. When exceeded, the least important resources get their quality reduced.
+    /// </summary>
+    void SetMemoryBudget(uint64 value)
+    {
+        _memoryBudget = value;
+    }
+
+    /// <summary>
+    /// Gets the estimated memory usage (in bytes) of the resources in this group (at their current residency).
+    /// </summary>
+    FORCE_INLINE uint64 GetMemoryUsage() const
+    {
+        return _memoryUsage;
+    }
+
+    /// <summary>
+    /// Gets the estimated amount of bytes to stream in for the resources in this group to reach their target residency.
+    /// </summary>
+    FORCE_INLINE uint64 GetPendingBytes() const
+    {
+        return _pendingBytes;
+    }
+
+    /// <summary>
+    /// Gets the memory pressure of this group: the memory required by the resources at the target quality divided by the budget. Values above 1 mean that quality is reduced to fit into the budget. Zero if budget is unlimited.
+    /// </summary>
+    FORCE_INLINE float GetMemoryPressure() const
+    {
+        return _memoryPressure;
+    }
 };
 
 /// <summary>
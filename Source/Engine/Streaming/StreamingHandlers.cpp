@@ -11,6 +11,50 @@
 #include "Engine/Audio/Audio.h"
 #include "Engine/Audio/AudioSource.h"
 
+namespace
+{
+    // Gets the visibility factor (0-1) that fades out with the time since the last usage.
+    FORCE_INLINE float GetVisibility(double lastVisibleTime, double currentTime)
+    {
+        if (lastVisibleTime < 0)
+            return 0.0f;
+        return 1.0f / (1.0f + (float)Math::Max(currentTime - lastVisibleTime, 0.0));
+    }
+
+    template<typename ModelType>
+    float CalculateModelQuality(const ModelType& model)
+    {
+        // Keep full quality until model gets drawn (also when it's drawn with a forced LOD)
+        const auto& streaming = model.Streaming;
+        const int32 lodCount = model.LODs.Count();
+        if (streaming.LastVisibleTime < 0 || lodCount <= 1)
+            return 1.0f;
+
+        // Pick the LOD used by the biggest instance on the screen (the same way as RenderTools::ComputeModelLOD)
+        int32 lodIndex = 0;
+        for (int32 i = lodCount - 1; i > 0; i--)
+        {
+            if (Math::Square(model.LODs[i].ScreenSize * 0.5f) >= streaming.ScreenSize)
+            {
+                lodIndex = i;
+                break;
+            }
+        }
+
+        // Keep one more detailed LOD to have it ready when getting closer
+        lodIndex = Math::Max(lodIndex - 1, 0);
+        return (float)(lodCount - lodIndex) / (float)lodCount;
+    }
+
+    template<typename ModelType>
+    float CalculateModelPriority(const ModelType& model, double currentTime)
+    {
+        // Recently visible and bigger on the screen models are more important
+        const auto& streaming = model.Streaming;
+        return GetVisibility(streaming.LastVisibleTime, currentTime) * (1.0f + Math::Min(Math::Sqrt(streaming.ScreenSize), 1.0f));
+    }
+}
+
 float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
     ASSERT(resource);
@@ -33,6 +77,13 @@ float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resou
     return result;
 }
 
+float TexturesStreamingHandler::CalculatePriority(StreamableResource* resource, double currentTime)
+{
+    // Recently rendered textures are more important (screen size is unknown so use the medium value to match with models priority)
+    auto& texture = *(StreamingTexture*)resource;
+    return GetVisibility(texture.GetTexture()->LastRenderTime, currentTime) * 1.5f;
+}
+
 int32 TexturesStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
 {
     if (quality < ZeroTolerance)
@@ -95,8 +146,14 @@ int32 TexturesStreamingHandler::CalculateRequestedResidency(StreamableResource*
 
 float ModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
-    // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
-    return 1.0f;
+    ASSERT(resource);
+    return CalculateModelQuality(*(Model*)resource);
+}
+
+float ModelsStreamingHandler::CalculatePriority(StreamableResource* resource, double currentTime)
+{
+    ASSERT(resource);
+    return CalculateModelPriority(*(Model*)resource, currentTime);
 }
 
 int32 ModelsStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
@@ -134,8 +191,14 @@ int32 ModelsStreamingHandler::CalculateRequestedResidency(StreamableResource* re
 
 float SkinnedModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
-    // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
-    return 1.0f;
+    ASSERT(resource);
+    return CalculateModelQuality(*(SkinnedModel*)resource);
+}
+
+float SkinnedModelsStreamingHandler::CalculatePriority(StreamableResource* resource, double currentTime)
+{
+    ASSERT(resource);
+    return CalculateModelPriority(*(SkinnedModel*)resource, currentTime);
 }
 
 int32 SkinnedModelsStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
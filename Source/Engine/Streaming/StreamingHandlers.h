@@ -12,6 +12,7 @@ class FLAXENGINE_API TexturesStreamingHandler : public IStreamingHandler
 public:
     // [IStreamingHandler]
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
+    float CalculatePriority(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
 };
@@ -24,6 +25,7 @@ class FLAXENGINE_API ModelsStreamingHandler : public IStreamingHandler
 public:
     // [IStreamingHandler]
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
+    float CalculatePriority(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
 };
@@ -36,6 +38,7 @@ class FLAXENGINE_API SkinnedModelsStreamingHandler : public IStreamingHandler
 public:
     // [IStreamingHandler]
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
+    float CalculatePriority(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
 };
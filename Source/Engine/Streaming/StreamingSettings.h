@@ -14,6 +14,36 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_AUTO_SERIALIZATION();
 
 public:
+    /// <summary>
+    /// The interval (in seconds) between the streaming updates of the resources target quality and memory budgets.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), Limit(0, 10, 0.01f), EditorDisplay(\"General\")")
+    float UpdateInterval = 0.1f;
+
+    /// <summary>
+    /// The maximum amount of resources to start streaming per-frame (the most important ones go first).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(1, 10000), EditorDisplay(\"General\")")
+    int32 MaxResourcesPerUpdate = 50;
+
+    /// <summary>
+    /// The global memory budget (in megabytes) for the streamed resources (eg. textures and models). Value 0 means unlimited. When exceeded, the least important resources get their quality reduced (the highest mips or LODs are streamed out first).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(50), Limit(0), EditorDisplay(\"Budgets\", \"Memory Budget (MB)\")")
+    int32 MemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the streamed textures. Value 0 means unlimited.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(60), Limit(0), EditorDisplay(\"Budgets\", \"Textures Memory Budget (MB)\")")
+    int32 TexturesMemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the streamed models (applied separately to models and skinned models). Value 0 means unlimited.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(70), Limit(0), EditorDisplay(\"Budgets\", \"Models Memory Budget (MB)\")")
+    int32 ModelsMemoryBudget = 0;
+
     /// <summary>
     /// Textures streaming configuration (per-group).
     /// </summary>
@@ -2553,7 +2553,50 @@ void TerrainPatch::ExtractCollisionGeometry(Array<Float3>& vertexBuffer, Array<i
 
     int32 rows, cols;
     PhysicsBackend::GetHeightFieldSize(_physicsHeightField, rows, cols);
+    CacheCollisionVertices(rows, cols);
+    ExtractCollisionGeometry(0, 0, rows - 1, cols - 1, rows, vertexBuffer, indexBuffer);
+}
+
+void TerrainPatch::ExtractCollisionGeometry(const BoundingBox& bounds, Array<Float3>& vertexBuffer, Array<int32>& indexBuffer)
+{
+    PROFILE_CPU();
+    PROFILE_MEM(LevelTerrain);
+    vertexBuffer.Clear();
+    indexBuffer.Clear();
+
+    ScopeLock lock(_collisionLocker);
+    if (!_physicsShape || !GetBounds().Intersects(bounds))
+        return;
+
+    int32 rows, cols;
+    PhysicsBackend::GetHeightFieldSize(_physicsHeightField, rows, cols);
+    CacheCollisionVertices(rows, cols);
+
+    // Project bounds to the heightfield XZ plane (height scale is skipped, it doesn't affect rows and columns)
+    const float size = _terrain->_chunkSize * TERRAIN_UNITS_PER_VERTEX * Terrain::ChunksCountEdge;
+    const Transform localTransform(Vector3(_x * size, _yOffset, _z * size), Quaternion::Identity, Float3(_collisionScaleXZ, 1.0f, _collisionScaleXZ));
+    Matrix invWorld;
+    Matrix::Invert(localTransform.GetWorld() * _terrain->_transform.GetWorld(), invWorld);
+    Vector3 corners[8];
+    bounds.GetCorners(corners);
+    Vector3 min = Vector3::Maximum, max = Vector3::Minimum;
+    for (Vector3& corner : corners)
+    {
+        Vector3::Transform(corner, invWorld, corner);
+        Vector3::Min(min, corner, min);
+        Vector3::Max(max, corner, max);
+    }
 
+    // Shortcut: row=x, col=z
+    const int32 startRow = Math::Clamp((int32)Math::Floor(min.X), 0, rows - 1);
+    const int32 startCol = Math::Clamp((int32)Math::Floor(min.Z), 0, cols - 1);
+    const int32 endRow = Math::Clamp((int32)Math::Ceil(max.X), 0, rows - 1);
+    const int32 endCol = Math::Clamp((int32)Math::Ceil(max.Z), 0, cols - 1);
+    ExtractCollisionGeometry(startRow, startCol, endRow, endCol, rows, vertexBuffer, indexBuffer);
+}
+
+void TerrainPatch::CacheCollisionVertices(int32 rows, int32 cols)
+{
     // Cache pre-transformed collision heightfield vertices locations
     if (_collisionVertices.IsEmpty())
     {
@@ -2579,19 +2622,36 @@ void TerrainPatch::ExtractCollisionGeometry(Array<Float3>& vertexBuffer, Array<i
             }
         }
     }
+}
+
+void TerrainPatch::ExtractCollisionGeometry(int32 startRow, int32 startCol, int32 endRow, int32 endCol, int32 rows, Array<Float3>& vertexBuffer, Array<int32>& indexBuffer) const
+{
+    if (startRow >= endRow || startCol >= endCol)
+        return;
 
     // Copy vertex buffer
-    vertexBuffer.Add(_collisionVertices);
+    const int32 vertexRows = endRow - startRow + 1;
+    const int32 vertexCols = endCol - startCol + 1;
+    if (vertexRows == rows && vertexCols * rows == _collisionVertices.Count())
+    {
+        vertexBuffer.Add(_collisionVertices);
+    }
+    else
+    {
+        vertexBuffer.EnsureCapacity(vertexRows * vertexCols);
+        for (int32 col = startCol; col <= endCol; col++)
+            vertexBuffer.Add(_collisionVertices.Get() + col * rows + startRow, vertexRows);
+    }
 
     // Generate index buffer
-    const int32 indexCount = (rows - 1) * (cols - 1) * 6;
+    const int32 indexCount = (vertexRows - 1) * (vertexCols - 1) * 6;
     indexBuffer.Resize(indexCount);
     int32* ib = indexBuffer.Get();
-    for (int32 row = 0; row < rows - 1; row++)
+    for (int32 row = 0; row < vertexRows - 1; row++)
     {
-        for (int32 col = 0; col < cols - 1; col++)
+        for (int32 col = 0; col < vertexCols - 1; col++)
         {
-#define GET_INDEX(x, y) *ib++ = (col + (y)) * cols + (row + (x))
+#define GET_INDEX(x, y) *ib++ = (col + (y)) * vertexRows + (row + (x))
 
             GET_INDEX(0, 0);
             GET_INDEX(1, 1);
@@ -394,6 +394,14 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainPatch : public ScriptingO
     /// <param name="indexBuffer">The output index buffer.</param>
     API_FUNCTION() void ExtractCollisionGeometry(API_PARAM(Out) Array<Float3>& vertexBuffer, API_PARAM(Out) Array<int32>& indexBuffer);
 
+    /// <summary>
+    /// Extracts the collision data geometry into list of triangles. Extracts only the heightfield area that intersects with the given bounds.
+    /// </summary>
+    /// <param name="bounds">The world-space bounds of the area to extract.</param>
+    /// <param name="vertexBuffer">The output vertex buffer.</param>
+    /// <param name="indexBuffer">The output index buffer.</param>
+    void ExtractCollisionGeometry(const BoundingBox& bounds, Array<Float3>& vertexBuffer, Array<int32>& indexBuffer);
+
 private:
     /// <summary>
     /// Determines whether this patch has created collision representation.
@@ -408,6 +416,16 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainPatch : public ScriptingO
     /// </summary>
     void CreateCollision();
 
+    /// <summary>
+    /// Caches the world-space locations of the collision heightfield vertices (used by the geometry extraction).
+    /// </summary>
+    void CacheCollisionVertices(int32 rows, int32 cols);
+
+    /// <summary>
+    /// Extracts the collision geometry triangles from the given heightfield vertices range (inclusive).
+    /// </summary>
+    void ExtractCollisionGeometry(int32 startRow, int32 startCol, int32 endRow, int32 endCol, int32 rows, Array<Float3>& vertexBuffer, Array<int32>& indexBuffer) const;
+
     /// <summary>
     /// Creates the height field from the collision data and caches height field XZ scale parameter.
     /// </summary>
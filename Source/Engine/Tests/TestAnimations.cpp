@@ -0,0 +1,415 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Utilities.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Animations/Animations.h"
+#include "Engine/Animations/AnimationData.h"
+#include "Engine/Animations/Graph/AnimGraph.h"
+#include "Engine/Level/Actors/AnimatedModel.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    // Creates the animation with channels that have the moving position, rotating orientation and the constant default scale
+    void CreateAnimation(int32 channelsCount, int32 framesCount, AnimationData& animation)
+    {
+        animation.Duration = framesCount - 1;
+        animation.FramesPerSecond = 30.0;
+        animation.Channels.Resize(channelsCount);
+        for (int32 channelIndex = 0; channelIndex < channelsCount; channelIndex++)
+        {
+            auto& channel = animation.Channels[channelIndex];
+            channel.NodeName = String::Format(TEXT("Node{0}"), channelIndex);
+            auto& position = channel.Position.GetKeyframes();
+            auto& rotation = channel.Rotation.GetKeyframes();
+            auto& scale = channel.Scale.GetKeyframes();
+            position.Resize(framesCount);
+            rotation.Resize(framesCount);
+            scale.Resize(framesCount);
+            for (int32 frame = 0; frame < framesCount; frame++)
+            {
+                const float time = (float)frame;
+                const float angle = time * 0.1f + channelIndex;
+                position[frame] = LinearCurveKeyframe<Float3>(time, Float3(Math::Sin(angle) * 50.0f, channelIndex * 20.0f, Math::Cos(angle) * 10.0f));
+                rotation[frame] = LinearCurveKeyframe<Quaternion>(time, Quaternion::Euler(0.0f, angle * RadiansToDegrees, 10.0f));
+                scale[frame] = LinearCurveKeyframe<Float3>(time, Float3::One);
+            }
+        }
+    }
+
+    // Gets the maximum distance between the node children positions (at the node length) of the source and compressed animations
+    float GetError(const Array<NodeAnimationData>& source, const AnimationData& compressed, float length)
+    {
+        float error = 0.0f;
+        const Float3 child(length, 0.0f, 0.0f);
+        for (int32 frame = 0; frame <= (int32)compressed.Duration * 4; frame++)
+        {
+            const float time = frame * 0.25f;
+            for (int32 i = 0; i < source.Count(); i++)
+            {
+                Transform a = Transform::Identity, b = Transform::Identity;
+                source[i].Evaluate(time, &a, false);
+                compressed.EvaluateChannel(i, time, &b);
+                error = Math::Max(error, Float3::Distance(a.Translation, b.Translation));
+                error = Math::Max(error, Float3::Distance(a.LocalToWorld(child), b.LocalToWorld(child)));
+            }
+        }
+        return error;
+    }
+
+    // Creates the pose with some random nodes transformations
+    void CreatePose(int32 count, float seed, Array<Transform>& nodes, AnimGraphPose& pose)
+    {
+        nodes.Resize(count);
+        for (int32 i = 0; i < count; i++)
+        {
+            const float angle = seed + i * 0.7f;
+            nodes[i] = Transform(Vector3(Math::Sin(angle) * 10.0f, i, Math::Cos(angle)), Quaternion::Euler(angle * 20.0f, angle * 45.0f, seed * 30.0f), Float3(1.0f + Math::Sin(angle) * 0.1f));
+        }
+        pose.Resize(count);
+        pose.Load(nodes.Get());
+    }
+
+    bool NearEqual(const Transform& a, const Transform& b)
+    {
+        return Float3::NearEqual(a.Translation, b.Translation, 0.001f) &&
+                Float3::NearEqual(a.Scale, b.Scale, 0.001f) &&
+                Math::Abs(Quaternion::Dot(a.Orientation, b.Orientation)) >= 0.9999f;
+    }
+}
+
+TEST_CASE("Animations")
+{
+    SECTION("Test Compression")
+    {
+        constexpr int32 channelsCount = 4, framesCount = 100;
+        constexpr float maxError = 0.01f, length = 20.0f;
+        AnimationData animation;
+        CreateAnimation(channelsCount, framesCount, animation);
+        Array<NodeAnimationData> source;
+        source.Resize(channelsCount);
+        for (int32 i = 0; i < channelsCount; i++)
+        {
+            source[i].Position.SetKeyframes(animation.Channels[i].Position.GetKeyframes());
+            source[i].Rotation.SetKeyframes(animation.Channels[i].Rotation.GetKeyframes());
+            source[i].Scale.SetKeyframes(animation.Channels[i].Scale.GetKeyframes());
+        }
+        Array<AnimationCompressionNode> nodes;
+        nodes.Resize(channelsCount);
+        for (auto& node : nodes)
+        {
+            node.Length = length;
+            node.IsValid = true;
+        }
+
+        // Compressed animation is smaller and within the error (interpolation between the reduced keyframes adds a small error)
+        AnimationCompressionStats stats;
+        animation.Compress(maxError, ToSpan(nodes), stats);
+        CHECK(animation.IsCompressed());
+        CHECK(stats.MemoryAfter * 2 < stats.MemoryBefore);
+        CHECK(stats.StrippedTracks == channelsCount);
+        CHECK(stats.MaxPositionError <= maxError);
+        CHECK(GetError(source, animation, length) <= maxError * 2.0f);
+
+        // Decompressed animation matches the compressed one
+        AnimationData decompressed;
+        decompressed.Duration = animation.Duration;
+        decompressed.Channels.Resize(channelsCount);
+        for (int32 i = 0; i < channelsCount; i++)
+            animation.Compressed.Decompress(i, decompressed.Channels[i]);
+        CHECK(decompressed.Channels[0].Scale.GetKeyframes().IsEmpty());
+        CHECK(GetError(decompressed.Channels, animation, length) <= 0.001f);
+    }
+
+    SECTION("Test Compression Error Bound")
+    {
+        // Root motion over a large distance cannot be quantized within the error so track is stored raw
+        constexpr int32 framesCount = 100;
+        constexpr float maxError = 0.01f;
+        AnimationData animation;
+        CreateAnimation(2, framesCount, animation);
+        auto& position = animation.Channels[0].Position.GetKeyframes();
+        for (int32 frame = 0; frame < framesCount; frame++)
+            position[frame].Value = Float3(frame * 100.0f, Math::Sin(frame * 0.1f) * 5.0f, 0.0f);
+        Array<NodeAnimationData> source;
+        source.Resize(2);
+        for (int32 i = 0; i < 2; i++)
+        {
+            source[i].Position.SetKeyframes(animation.Channels[i].Position.GetKeyframes());
+            source[i].Rotation.SetKeyframes(animation.Channels[i].Rotation.GetKeyframes());
+            source[i].Scale.SetKeyframes(animation.Channels[i].Scale.GetKeyframes());
+        }
+        AnimationCompressionStats stats;
+        animation.Compress(maxError, Span<AnimationCompressionNode>(), stats);
+        CHECK(stats.RawTracks == 1);
+        CHECK(animation.Compressed.Channels[0].Position.Raw);
+        CHECK(!animation.Compressed.Channels[1].Position.Raw);
+        CHECK(stats.MaxPositionError <= maxError);
+        for (int32 frame = 0; frame < framesCount; frame++)
+        {
+            Transform t = Transform::Identity;
+            animation.EvaluateChannel(0, (float)frame, &t);
+            CHECK(Float3::Distance(t.Translation, source[0].Position.GetKeyframes()[frame].Value) <= maxError);
+        }
+
+        // Decompressed raw track matches the source keyframes
+        NodeAnimationData decompressed;
+        animation.Compressed.Decompress(0, decompressed);
+        bool valid = true;
+        for (const auto& k : decompressed.Position.GetKeyframes())
+        {
+            Transform t = Transform::Identity;
+            source[0].Evaluate(k.Time, &t, false);
+            valid &= Float3::Distance(t.Translation, k.Value) <= maxError;
+        }
+        CHECK(valid);
+    }
+
+    SECTION("Test Keyframe Cursors")
+    {
+        // Sampling with the cached keyframe cursors gives the same results (for playback in both directions and seeking)
+        constexpr int32 channelsCount = 4, framesCount = 100;
+        AnimationData animation;
+        CreateAnimation(channelsCount, framesCount, animation);
+        int32 cursors[channelsCount * 3] = {};
+        bool valid = true;
+        for (int32 pass = 0; pass < 2; pass++)
+        {
+            if (pass == 1)
+            {
+                AnimationCompressionStats stats;
+                animation.Compress(0.01f, Span<AnimationCompressionNode>(), stats);
+            }
+            for (const float time : { 0.0f, 0.3f, 0.9f, 1.5f, 2.0f, 7.2f, 50.0f, 49.5f, 10.0f, 99.0f, 98.9f, 0.1f })
+            {
+                for (int32 i = 0; i < channelsCount; i++)
+                {
+                    Transform a = Transform::Identity, b = Transform::Identity;
+                    animation.EvaluateChannel(i, time, &a);
+                    animation.EvaluateChannel(i, time, &b, cursors + i * 3);
+                    valid &= a == b;
+                }
+            }
+        }
+        CHECK(valid);
+    }
+
+    SECTION("Test Pose Blending")
+    {
+        // Vectorized pose blending matches the per-node transformations blending
+        constexpr int32 count = 11;
+        Array<Transform> nodesA, nodesB, nodesRef, result;
+        AnimGraphPose poseA, poseB, poseRef, pose;
+        CreatePose(count, 0.0f, nodesA, poseA);
+        CreatePose(count, 1.0f, nodesB, poseB);
+        CreatePose(count, 2.0f, nodesRef, poseRef);
+        result.Resize(count);
+        pose.Resize(count);
+
+        bool valid = true;
+        AnimGraphPose::Lerp(poseA, poseB, 0.3f, nullptr, pose);
+        pose.Store(result.Get());
+        for (int32 i = 0; i < count; i++)
+        {
+            Transform t;
+            Transform::Lerp(nodesA[i], nodesB[i], 0.3f, t);
+            valid &= NearEqual(t, result[i]);
+        }
+        CHECK(valid);
+
+        Array<float> mask;
+        mask.Resize(pose.Stride);
+        for (int32 i = 0; i < mask.Count(); i++)
+            mask[i] = i % 2 ? 1.0f : 0.0f;
+        AnimGraphPose::Lerp(poseA, poseB, 0.5f, mask.Get(), pose);
+        pose.Store(result.Get());
+        for (int32 i = 0; i < count; i++)
+        {
+            Transform t = nodesA[i];
+            if (i % 2)
+                Transform::Lerp(nodesA[i], nodesB[i], 0.5f, t);
+            valid &= NearEqual(t, result[i]);
+        }
+        CHECK(valid);
+
+        AnimGraphPose::BlendAdditive(poseA, poseB, poseRef, 1.0f, pose);
+        pose.Store(result.Get());
+        for (int32 i = 0; i < count; i++)
+        {
+            Transform t;
+            t.Translation = nodesA[i].Translation + (nodesB[i].Translation - nodesRef[i].Translation);
+            t.Orientation = nodesA[i].Orientation * (Quaternion::Invert(nodesRef[i].Orientation) * nodesB[i].Orientation);
+            t.Scale = nodesA[i].Scale + (nodesB[i].Scale - nodesRef[i].Scale);
+            valid &= NearEqual(t, result[i]);
+        }
+        CHECK(valid);
+
+        // Weighted blending (nodes with negative weight are skipped)
+        Array<float> weights;
+        weights.Resize(pose.Stride);
+        for (int32 i = 0; i < weights.Count(); i++)
+            weights[i] = i == 0 ? -1.0f : 0.5f;
+        pose.Copy(poseA);
+        pose.Blend(poseB, weights.Get(), AnimGraphPose::BlendMode::Override);
+        pose.Blend(poseRef, weights.Get(), AnimGraphPose::BlendMode::BlendAdditive);
+        pose.NormalizeRotations();
+        pose.Store(result.Get());
+        valid &= NearEqual(nodesA[0], result[0]);
+        for (int32 i = 1; i < count; i++)
+        {
+            Transform t;
+            Transform::Lerp(nodesB[i], nodesRef[i], 0.5f, t);
+            valid &= NearEqual(t, result[i]);
+        }
+        CHECK(valid);
+    }
+
+    SECTION("Test Pose Interpolation")
+    {
+        // Pose interpolated between the updates matches the blended nodes transformations
+        constexpr int32 count = 6;
+        AnimGraphInstanceData data;
+        Array<Transform> nodesA, nodesB;
+        CreatePose(count, 0.0f, nodesA, data.InterpolationPoseFrom);
+        CreatePose(count, 1.0f, nodesB, data.InterpolationPoseTo);
+        CHECK(!AnimGraphExecutor::Interpolate(data, 0.5f));
+        data.NodesPose.Resize(count);
+        CHECK(AnimGraphExecutor::Interpolate(data, 0.5f));
+        bool valid = true;
+        for (int32 i = 0; i < count; i++)
+        {
+            Transform t, result;
+            Transform::Lerp(nodesA[i], nodesB[i], 0.5f, t);
+            data.NodesPose[i].Decompose(result);
+            valid &= NearEqual(t, result);
+        }
+        CHECK(valid);
+        CHECK(NearEqual(data.RootTransform, Transform::Lerp(nodesA[0], nodesB[0], 0.5f)));
+    }
+
+    SECTION("Test Animation LOD")
+    {
+        // LOD from the distance to the camera
+        CHECK(AnimatedModel::CalculateAnimationLOD(Math::Square(1000.0f), 0.0f) == 0);
+        CHECK(AnimatedModel::CalculateAnimationLOD(Math::Square(4000.0f), 0.0f) == 1);
+        CHECK(AnimatedModel::CalculateAnimationLOD(Math::Square(8000.0f), 0.0f) == 2);
+        CHECK(AnimatedModel::CalculateAnimationLOD(Math::Square(20000.0f), 0.0f) == 3);
+        CHECK(AnimatedModel::CalculateAnimationLOD(MAX_Real, 0.0f) == 3);
+
+        // Models large on the screen use the higher quality LOD
+        const Real farDistanceSqr = Math::Square(20000.0f);
+        CHECK(AnimatedModel::CalculateAnimationLOD(farDistanceSqr, Math::Square(0.04f)) == 3);
+        CHECK(AnimatedModel::CalculateAnimationLOD(farDistanceSqr, Math::Square(0.06f)) == 2);
+        CHECK(AnimatedModel::CalculateAnimationLOD(farDistanceSqr, Math::Square(0.15f)) == 1);
+        CHECK(AnimatedModel::CalculateAnimationLOD(farDistanceSqr, Math::Square(0.3f)) == 0);
+
+        // Screen size never lowers the quality
+        CHECK(AnimatedModel::CalculateAnimationLOD(Math::Square(4000.0f), Math::Square(0.06f)) == 1);
+    }
+
+    SECTION("Test Update Budget")
+    {
+        Array<Animations::BudgetItem> items;
+        const auto addItem = [&](int32 lod, float cost, int32 delay)
+        {
+            auto& item = items.AddOne();
+            item.Model = nullptr;
+            item.LOD = lod;
+            item.Cost = cost;
+            item.Delay = delay;
+        };
+
+        // Updates are picked by LOD and wait time until the budget is used (the first one is always updated)
+        addItem(1, 4.0f, 0);
+        addItem(0, 4.0f, 0);
+        addItem(2, 1.0f, 0);
+        addItem(1, 4.0f, 2);
+        addItem(0, 5.0f, 1);
+        Animations::UpdateStats stats;
+        CHECK(Animations::ApplyBudget(items, 10.0f, stats) == 3);
+        CHECK(stats.Skipped == 2);
+        CHECK(items[0].LOD == 0);
+        CHECK(items[0].Cost == 5.0f);
+        CHECK(items[1].LOD == 0);
+        CHECK(items[1].Cost == 4.0f);
+        CHECK(items[2].LOD == 2);
+        CHECK(items[3].LOD == 1);
+        CHECK(items[4].LOD == 1);
+        CHECK(Math::Min(items[3].Delay, items[4].Delay) == 1);
+        CHECK(Math::Max(items[3].Delay, items[4].Delay) == 3);
+
+        // Updates are postponed for a limited amount of frames
+        items.Clear();
+        addItem(0, 10.0f, 0);
+        addItem(1, 10.0f, 0);
+        stats = Animations::UpdateStats();
+        for (int32 frame = 0; frame < ANIMATIONS_MAX_UPDATE_DELAY; frame++)
+        {
+            CHECK(Animations::ApplyBudget(items, 5.0f, stats) == 1);
+            CHECK(items[0].LOD == 0);
+            CHECK(items[1].Delay == frame + 1);
+        }
+        CHECK(stats.Skipped == ANIMATIONS_MAX_UPDATE_DELAY);
+        CHECK(Animations::ApplyBudget(items, 5.0f, stats) == 2);
+        CHECK(stats.Skipped == ANIMATIONS_MAX_UPDATE_DELAY);
+    }
+}
+
+TEST_CASE("Animations Benchmark", "[.][benchmark]")
+{
+    SECTION("Compression")
+    {
+        // Compare the memory usage and the sampling time of the raw and compressed animations
+        constexpr int32 channelsCount = 100, framesCount = 1000, samples = 100;
+        AnimationData animation;
+        CreateAnimation(channelsCount, framesCount, animation);
+        Transform result = Transform::Identity;
+        float times[2];
+        for (int32 i = 0; i < 2; i++)
+        {
+            if (i == 1)
+            {
+                AnimationCompressionStats stats;
+                animation.Compress(0.01f, Span<AnimationCompressionNode>(), stats);
+                LOG(Info, "Animation compression ({0} channels, {1} frames): {2} -> {3}, keyframes: {4} -> {5}", channelsCount, framesCount, Utilities::BytesToText(stats.MemoryBefore), Utilities::BytesToText(stats.MemoryAfter), stats.KeyframesBefore, stats.KeyframesAfter);
+            }
+            Stopwatch stopwatch;
+            for (int32 sample = 0; sample < samples; sample++)
+            {
+                const float time = (float)sample / samples * framesCount;
+                for (int32 channelIndex = 0; channelIndex < channelsCount; channelIndex++)
+                    animation.EvaluateChannel(channelIndex, time, &result);
+            }
+            stopwatch.Stop();
+            times[i] = stopwatch.GetTotalMilliseconds();
+        }
+        LOG(Info, "Animation sampling ({0} channels, {1} samples): raw: {2} ms, compressed: {3} ms", channelsCount, samples, times[0], times[1]);
+    }
+
+    SECTION("Pose Blending")
+    {
+        // Compare the per-node transformations blending against the vectorized pose blending
+        constexpr int32 count = 200, iterations = 10000;
+        Array<Transform> nodesA, nodesB, result;
+        AnimGraphPose poseA, poseB, pose;
+        CreatePose(count, 0.0f, nodesA, poseA);
+        CreatePose(count, 1.0f, nodesB, poseB);
+        result.Resize(count);
+        pose.Resize(count);
+        Stopwatch stopwatch;
+        for (int32 iteration = 0; iteration < iterations; iteration++)
+        {
+            for (int32 i = 0; i < count; i++)
+                Transform::Lerp(nodesA[i], nodesB[i], 0.5f, result[i]);
+        }
+        stopwatch.Stop();
+        const float nodesTime = stopwatch.GetTotalMilliseconds();
+        stopwatch.Start();
+        for (int32 iteration = 0; iteration < iterations; iteration++)
+            AnimGraphPose::Lerp(poseA, poseB, 0.5f, nullptr, pose);
+        stopwatch.Stop();
+        const float poseTime = stopwatch.GetTotalMilliseconds();
+        LOG(Info, "Pose blending ({0} nodes, {1} iterations): nodes: {2} ms, pose: {3} ms", count, iterations, nodesTime, poseTime);
+    }
+}
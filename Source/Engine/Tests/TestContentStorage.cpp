@@ -0,0 +1,215 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Utilities.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Content/Storage/ContentStorageManager.h"
+#include "Engine/Content/Storage/FlaxStorage.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/FileSystem.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+#if USE_EDITOR
+
+namespace
+{
+    // Creates the package with the assets that contain the raw and compressed chunks
+    bool CreatePackage(const String& path, int32 assetsCount, int32 chunksPerAsset, int32 chunkSize, Array<Guid>& ids)
+    {
+        Array<AssetInitData> assets;
+        assets.Resize(assetsCount);
+        ids.Resize(assetsCount);
+        for (int32 assetIndex = 0; assetIndex < assetsCount; assetIndex++)
+        {
+            AssetInitData& asset = assets[assetIndex];
+            asset.Header.ID = ids[assetIndex] = Guid::New();
+            asset.Header.TypeName = TEXT("FlaxEngine.BinaryAsset");
+            for (int32 chunkIndex = 0; chunkIndex < chunksPerAsset; chunkIndex++)
+            {
+                auto chunk = New<FlaxChunk>();
+                if (chunkIndex % 2 == 1)
+                    chunk->Flags = FlaxChunkFlags::CompressedLZ4;
+                chunk->Data.Allocate(chunkSize);
+                byte* data = chunk->Data.Get();
+                for (int32 i = 0; i < chunkSize; i++)
+                    data[i] = (byte)(assetIndex + chunkIndex * 7 + (i >> 4));
+                asset.Header.Chunks[chunkIndex] = chunk;
+            }
+        }
+        const bool result = FlaxStorage::Create(path, assets);
+        for (AssetInitData& asset : assets)
+            asset.Header.DeleteChunks();
+        return result;
+    }
+
+    void GetChunks(FlaxStorage* storage, const Array<Guid>& ids, int32 chunksPerAsset, Array<FlaxChunk*>& chunks)
+    {
+        for (const Guid& id : ids)
+        {
+            AssetInitData data;
+            if (storage->LoadAssetHeader(id, data))
+                continue;
+            for (int32 chunkIndex = 0; chunkIndex < chunksPerAsset; chunkIndex++)
+                chunks.Add(data.Header.Chunks[chunkIndex]);
+        }
+    }
+
+    void UnloadChunks(FlaxStorage* storage, const Array<FlaxChunk*>& chunks)
+    {
+        for (FlaxChunk* chunk : chunks)
+            chunk->Unload();
+        storage->CloseFileHandles();
+    }
+}
+
+TEST_CASE("ContentStorage")
+{
+    SECTION("Test Batched Chunks Loading")
+    {
+        constexpr int32 assetsCount = 8, chunksPerAsset = 4, chunkSize = 4096;
+        const String path = Globals::TemporaryFolder / TEXT("TestContentStorage.flaxpkg");
+        Array<Guid> ids;
+        REQUIRE(!CreatePackage(path, assetsCount, chunksPerAsset, chunkSize, ids));
+        for (const bool useMemoryMapping : { false, true })
+        {
+            ContentStorageManager::UseMemoryMapping = useMemoryMapping;
+            FlaxStorageReference storage = ContentStorageManager::GetStorage(path);
+            REQUIRE(storage);
+            Array<FlaxChunk*> chunks;
+            GetChunks(storage.Get(), ids, chunksPerAsset, chunks);
+            REQUIRE(chunks.Count() == assetsCount * chunksPerAsset);
+            for (int32 i = 0; i < chunks.Count() / 2; i++)
+                chunks[i]->AllowMappedData = true;
+
+            // Load every second chunk in a reversed order to test sorting and non-adjacent reads, then the rest
+            Array<FlaxChunk*> batch;
+            for (int32 i = chunks.Count() - 1; i >= 0; i -= 2)
+                batch.Add(chunks[i]);
+            CHECK(!storage->LoadAssetChunks(ToSpan(batch)));
+            CHECK(!storage->LoadAssetChunks(ToSpan(chunks)));
+            for (int32 assetIndex = 0; assetIndex < assetsCount; assetIndex++)
+            {
+                for (int32 chunkIndex = 0; chunkIndex < chunksPerAsset; chunkIndex++)
+                {
+                    const FlaxChunk* chunk = chunks[assetIndex * chunksPerAsset + chunkIndex];
+                    REQUIRE(chunk->IsLoaded());
+                    REQUIRE(chunk->Data.Length() == chunkSize);
+                    const byte* data = chunk->Data.Get();
+                    bool valid = true;
+                    for (int32 i = 0; i < chunkSize; i++)
+                        valid &= data[i] == (byte)(assetIndex + chunkIndex * 7 + (i >> 4));
+                    CHECK(valid);
+
+                    // Raw chunks from the memory-mapped package are not copied (only if chunk allows it)
+                    const bool compressed = EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4);
+                    CHECK(chunk->Data.IsAllocated() == (compressed || !useMemoryMapping || !chunk->AllowMappedData));
+                }
+            }
+
+            // Chunks that use the mapped memory get a copy of it when the file gets closed
+            const FlaxChunk* rawChunk = chunks[0];
+            storage->CloseFileHandles();
+            CHECK(rawChunk->IsLoaded());
+            CHECK(rawChunk->Data.IsAllocated());
+            CHECK(rawChunk->Data.Get()[chunkSize - 1] == (byte)((chunkSize - 1) >> 4));
+            UnloadChunks(storage.Get(), chunks);
+        }
+        ContentStorageManager::UseMemoryMapping = true;
+        ContentStorageManager::EnsureAccess(path);
+        FileSystem::DeleteFile(path);
+    }
+
+    SECTION("Test Memory-Mapped Chunks Ownership")
+    {
+        constexpr int32 assetsCount = 2, chunksPerAsset = 2, chunkSize = 4096;
+        const String path = Globals::TemporaryFolder / TEXT("TestContentStorageMapping.flaxpkg");
+        Array<Guid> ids;
+        REQUIRE(!CreatePackage(path, assetsCount, chunksPerAsset, chunkSize, ids));
+        {
+            FlaxStorageReference storage = ContentStorageManager::GetStorage(path);
+            REQUIRE(storage);
+            Array<FlaxChunk*> chunks;
+            GetChunks(storage.Get(), ids, chunksPerAsset, chunks);
+            REQUIRE(chunks.Count() == assetsCount * chunksPerAsset);
+            CHECK(!storage->LoadAssetChunks(ToSpan(chunks)));
+
+            // Take the data out of the raw chunks like assets do when loading (eg. Animation Graph Function swaps the surface data)
+            BytesContainer swapped, copied;
+            swapped.Swap(chunks[0]->Data);
+            copied = chunks[chunksPerAsset]->Data;
+            CHECK(swapped.IsAllocated());
+            CHECK(copied.IsAllocated());
+
+            // Unload chunks and release the file (unmaps it)
+            for (FlaxChunk* chunk : chunks)
+                chunk->Unload();
+            storage->Tick(Platform::GetTimeSeconds() + 1000000.0);
+            storage->CloseFileHandles();
+            REQUIRE(swapped.Length() == chunkSize);
+            REQUIRE(copied.Length() == chunkSize);
+            bool valid = true;
+            for (int32 i = 0; i < chunkSize; i++)
+                valid &= swapped[i] == (byte)(i >> 4) && copied[i] == (byte)(1 + (i >> 4));
+            CHECK(valid);
+        }
+        ContentStorageManager::EnsureAccess(path);
+        FileSystem::DeleteFile(path);
+    }
+}
+
+TEST_CASE("ContentStorage Benchmark", "[.][benchmark]")
+{
+    SECTION("Chunks Loading")
+    {
+        // Compare the per-chunk loading against the batched and memory-mapped loading of a large package (chunks data and file handles are released before each run)
+        constexpr int32 assetsCount = 256, chunksPerAsset = 8, chunkSize = 128 * 1024;
+        const String path = Globals::TemporaryFolder / TEXT("TestContentStorageBenchmark.flaxpkg");
+        Array<Guid> ids;
+        REQUIRE(!CreatePackage(path, assetsCount, chunksPerAsset, chunkSize, ids));
+        {
+            FlaxStorageReference storage = ContentStorageManager::GetStorage(path);
+            REQUIRE(storage);
+            Array<FlaxChunk*> chunks;
+            GetChunks(storage.Get(), ids, chunksPerAsset, chunks);
+            REQUIRE(chunks.Count() == assetsCount * chunksPerAsset);
+            const uint64 size = (uint64)chunks.Count() * chunkSize;
+            ContentStorageManager::UseMemoryMapping = false;
+
+            Stopwatch stopwatch;
+            for (FlaxChunk* chunk : chunks)
+                storage->LoadAssetChunk(chunk);
+            stopwatch.Stop();
+            const float singleTime = stopwatch.GetTotalMilliseconds();
+            UnloadChunks(storage.Get(), chunks);
+
+            stopwatch.Start();
+            for (int32 i = 0; i < chunks.Count(); i += chunksPerAsset)
+                storage->LoadAssetChunks(Span<FlaxChunk*>(chunks.Get() + i, chunksPerAsset));
+            stopwatch.Stop();
+            const float perAssetTime = stopwatch.GetTotalMilliseconds();
+            UnloadChunks(storage.Get(), chunks);
+
+            stopwatch.Start();
+            storage->LoadAssetChunks(ToSpan(chunks));
+            stopwatch.Stop();
+            const float batchTime = stopwatch.GetTotalMilliseconds();
+            UnloadChunks(storage.Get(), chunks);
+
+            ContentStorageManager::UseMemoryMapping = true;
+            stopwatch.Start();
+            for (int32 i = 0; i < chunks.Count(); i += chunksPerAsset)
+                storage->LoadAssetChunks(Span<FlaxChunk*>(chunks.Get() + i, chunksPerAsset));
+            stopwatch.Stop();
+            const float mappedTime = stopwatch.GetTotalMilliseconds();
+            const uint32 mappedMemoryUsage = storage->GetMemoryUsage();
+            UnloadChunks(storage.Get(), chunks);
+
+            LOG(Info, "Chunks loading ({0} chunks, {1}): single: {2} ms, batched per-asset: {3} ms, batched all: {4} ms, memory-mapped per-asset: {5} ms ({6} on heap)", chunks.Count(), Utilities::BytesToText(size), singleTime, perAssetTime, batchTime, mappedTime, Utilities::BytesToText(mappedMemoryUsage));
+        }
+        ContentStorageManager::EnsureAccess(path);
+        FileSystem::DeleteFile(path);
+    }
+}
+
+#endif
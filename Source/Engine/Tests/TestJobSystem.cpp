@@ -0,0 +1,199 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Types/Span.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Threading/JobSystem.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    volatile int64 Counter = 0;
+
+    void IncrementCounter(int32 index)
+    {
+        Platform::InterlockedIncrement(&Counter);
+    }
+
+    float BenchmarkWork(int32 index, int32 iterations)
+    {
+        float value = (float)index;
+        for (int32 i = 0; i < iterations; i++)
+            value = value * 0.999f + 1.0f;
+        return value;
+    }
+}
+
+TEST_CASE("JobSystem")
+{
+    SECTION("Test Execute")
+    {
+        // Ensure every job index gets executed exactly once (including ranges split across threads)
+        for (int32 jobCount : { 1, 2, 7, 64, 1000, 100000 })
+        {
+            Array<int32> executions;
+            executions.Resize(jobCount);
+            executions.SetAll(0);
+            int32* executionsPtr = executions.Get();
+            JobSystem::Execute([executionsPtr](int32 i)
+            {
+                executionsPtr[i]++;
+            }, jobCount);
+            int32 invalid = 0;
+            for (int32 i = 0; i < jobCount; i++)
+            {
+                if (executions[i] != 1)
+                    invalid++;
+            }
+            CHECK(invalid == 0);
+        }
+    }
+    SECTION("Test Dispatch")
+    {
+        Platform::AtomicStore(&Counter, 0);
+        const int64 label = JobSystem::Dispatch(IncrementCounter, 1000);
+        JobSystem::Wait(label);
+        CHECK(Platform::AtomicRead(&Counter) == 1000);
+
+        Platform::AtomicStore(&Counter, 0);
+        for (int32 i = 0; i < 500; i++)
+            JobSystem::Dispatch(IncrementCounter, 10);
+        JobSystem::Wait();
+        CHECK(Platform::AtomicRead(&Counter) == 5000);
+
+        // Waiting for all jobs from within the job returns instead of deadlocking
+        const int64 nested = JobSystem::Dispatch([](int32 i)
+        {
+            JobSystem::Wait();
+            Platform::InterlockedIncrement(&Counter);
+        });
+        JobSystem::Wait(nested);
+        CHECK(Platform::AtomicRead(&Counter) == 5001);
+    }
+    SECTION("Test Contexts Pool")
+    {
+        // Ensure many dispatches in flight grow the contexts pool instead of waiting
+        JobSystem::GetStats(true);
+        const JobSystemStats statsBefore = JobSystem::GetStats();
+        Platform::AtomicStore(&Counter, 0);
+        JobSystem::SetJobStartingOnDispatch(false);
+        Array<int64> labels;
+        for (int32 i = 0; i < 2000; i++)
+            labels.Add(JobSystem::Dispatch(IncrementCounter, 1));
+        JobSystem::SetJobStartingOnDispatch(true);
+        for (int64 label : labels)
+            JobSystem::Wait(label);
+        const JobSystemStats statsAfter = JobSystem::GetStats();
+        CHECK(Platform::AtomicRead(&Counter) == 2000);
+        CHECK(statsAfter.ContextsPeak >= 1);
+        CHECK(statsAfter.ContextsCapacity >= statsAfter.ContextsPeak);
+        CHECK(statsAfter.OverflowWaits == statsBefore.OverflowWaits);
+    }
+    SECTION("Test Dependencies")
+    {
+        volatile int64 first = 0, second = 0, failed = 0;
+        int64 labels[2];
+        labels[0] = JobSystem::Dispatch([&first](int32 i)
+        {
+            Platform::Sleep(1);
+            Platform::InterlockedIncrement(&first);
+        }, 16);
+        labels[1] = JobSystem::Dispatch([&first, &second, &failed](int32 i)
+        {
+            if (Platform::AtomicRead(&first) != 16)
+                Platform::InterlockedIncrement(&failed);
+            Platform::InterlockedIncrement(&second);
+        }, ToSpan(labels, 1), 16);
+        const int64 label = JobSystem::Dispatch([&second, &failed](int32 i)
+        {
+            if (Platform::AtomicRead(&second) != 16)
+                Platform::InterlockedIncrement(&failed);
+        }, ToSpan(labels, 2), 4);
+        JobSystem::Wait(label);
+        CHECK(Platform::AtomicRead(&failed) == 0);
+        CHECK(Platform::AtomicRead(&second) == 16);
+    }
+    SECTION("Test Nested")
+    {
+        // Ensure jobs can execute other jobs (waiting on job thread should process other jobs instead of blocking)
+        Platform::AtomicStore(&Counter, 0);
+        JobSystem::Execute([](int32)
+        {
+            JobSystem::Execute([](int32)
+            {
+                JobSystem::Execute(IncrementCounter, 10);
+            }, 8);
+        }, JobSystem::GetThreadsCount() * 4);
+        CHECK(Platform::AtomicRead(&Counter) == JobSystem::GetThreadsCount() * 4 * 8 * 10);
+    }
+    SECTION("Test Priorities")
+    {
+        // Ensure background jobs paused by the frame deadline still complete when waited for
+        JobSystem::GetStats(true);
+        volatile int64 frameCounter = 0;
+        Platform::AtomicStore(&Counter, 0);
+        JobSystem::SetFrameDeadline(Platform::GetTimeSeconds() + 0.001);
+        const int64 background = JobSystem::Dispatch(IncrementCounter, 1000, JobPriority::Background);
+        JobSystem::Execute([&frameCounter](int32)
+        {
+            Platform::InterlockedIncrement(&frameCounter);
+        }, 1000, JobPriority::FrameCritical);
+        CHECK(Platform::AtomicRead(&frameCounter) == 1000);
+        JobSystem::Wait(background);
+        JobSystem::SetFrameDeadline(0.0);
+        CHECK(Platform::AtomicRead(&Counter) == 1000);
+        const JobSystemStats stats = JobSystem::GetStats();
+        CHECK(stats.Queues.FrameCritical.Started >= 1);
+        CHECK(stats.Queues.Background.Started >= 1);
+        CHECK(stats.Queues.Background.QueueDepth == 0);
+    }
+}
+
+TEST_CASE("JobSystem Benchmark", "[.][benchmark]")
+{
+    const int32 threadsCount = JobSystem::GetThreadsCount();
+    LOG(Info, "Job System threads: {0}", threadsCount);
+
+    SECTION("Scaling")
+    {
+        // Split the fixed amount of work into more jobs to use more threads (ideally time scales down linearly)
+        constexpr int32 totalItems = 1 << 20;
+        constexpr int32 iterations = 64;
+        float baseTime = 0.0f;
+        Array<float> results;
+        for (int32 jobCount = 1; jobCount <= threadsCount; jobCount *= 2)
+        {
+            const int32 itemsPerJob = totalItems / jobCount;
+            results.Resize(jobCount);
+            float* resultsPtr = results.Get();
+            Stopwatch stopwatch;
+            JobSystem::Execute([itemsPerJob, resultsPtr](int32 job)
+            {
+                float result = 0.0f;
+                for (int32 i = 0; i < itemsPerJob; i++)
+                    result += BenchmarkWork(job * itemsPerJob + i, iterations);
+                resultsPtr[job] = result;
+            }, jobCount);
+            stopwatch.Stop();
+            const float time = stopwatch.GetTotalMilliseconds();
+            if (jobCount == 1)
+                baseTime = time;
+            LOG(Info, "Threads: {0}, time: {1} ms, speedup: {2}x", jobCount, time, baseTime / Math::Max(time, ZeroTolerance));
+        }
+    }
+    SECTION("Fine-grained")
+    {
+        // Measure per-item overhead of tiny jobs
+        for (int32 jobCount : { 1000, 100000, 1000000 })
+        {
+            Platform::AtomicStore(&Counter, 0);
+            Stopwatch stopwatch;
+            JobSystem::Execute(IncrementCounter, jobCount);
+            stopwatch.Stop();
+            CHECK(Platform::AtomicRead(&Counter) == jobCount);
+            LOG(Info, "Jobs: {0}, time: {1} ms, per job: {2} ns", jobCount, stopwatch.GetTotalMilliseconds(), stopwatch.GetTotalMilliseconds() * 1000000.0f / (float)jobCount);
+        }
+    }
+}
@@ -1,8 +1,60 @@
 // Copyright (c) Wojciech Figat. All rights reserved.
 
 #include "Engine/Tools/ModelTool/ModelTool.h"
+#include "Engine/Core/Types/StringView.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Utilities/Encryption.h"
 #include <ThirdParty/catch2/catch.hpp>
 
+#if USE_EDITOR
+
+namespace
+{
+    // Writes the glTF file with a 3-nodes chain (Root -> Bone -> Tip) and a single animation that rotates the Bone node
+    bool CreateAnimationFile(const String& path)
+    {
+        constexpr int32 framesCount = 11;
+        float buffer[framesCount * 5];
+        for (int32 i = 0; i < framesCount; i++)
+        {
+            const float time = (float)i / (framesCount - 1);
+            const float halfAngle = time * PI * 0.25f;
+            buffer[i] = time;
+            float* rotation = buffer + framesCount + i * 4;
+            rotation[0] = 0.0f;
+            rotation[1] = 0.0f;
+            rotation[2] = Math::Sin(halfAngle);
+            rotation[3] = Math::Cos(halfAngle);
+        }
+        Array<char> base64;
+        Encryption::Base64Encode((const byte*)buffer, sizeof(buffer), base64);
+
+        StringAnsi json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+            "\"nodes\":[{\"name\":\"Root\",\"children\":[1]},{\"name\":\"Bone\",\"translation\":[0,1,0],\"children\":[2]},{\"name\":\"Tip\",\"translation\":[0,1,0]}],"
+            "\"buffers\":[{\"byteLength\":220,\"uri\":\"data:application/octet-stream;base64,";
+        json += StringAnsiView(base64.Get(), base64.Count());
+        json += "\"}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":44},{\"buffer\":0,\"byteOffset\":44,\"byteLength\":176}],"
+            "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":11,\"type\":\"SCALAR\",\"min\":[0],\"max\":[1]},{\"bufferView\":1,\"componentType\":5126,\"count\":11,\"type\":\"VEC4\"}],"
+            "\"animations\":[{\"name\":\"Swing\",\"samplers\":[{\"input\":0,\"output\":1,\"interpolation\":\"LINEAR\"}],\"channels\":[{\"sampler\":0,\"target\":{\"node\":1,\"path\":\"rotation\"}}]}]}";
+        return File::WriteAllBytes(path, json.Get(), json.Length());
+    }
+
+    int32 FindChannel(const AnimationData& animation, const StringView& nodeName)
+    {
+        for (int32 i = 0; i < animation.Channels.Count(); i++)
+        {
+            if (animation.Channels[i].NodeName == nodeName)
+                return i;
+        }
+        return -1;
+    }
+}
+
+#endif
+
 TEST_CASE("ModelTool")
 {
     SECTION("Test DetectLodIndex")
@@ -21,4 +73,52 @@ TEST_CASE("ModelTool")
         CHECK(ModelTool::DetectLodIndex(TEXT("mesh_lod_1")) == 1);
         CHECK(ModelTool::DetectLodIndex(TEXT("mesh lod_2")) == 2);
     }
+#if USE_EDITOR
+    SECTION("Test Import Compressed Animation")
+    {
+        const String path = Globals::TemporaryFolder / TEXT("TestModelToolAnimation.gltf");
+        REQUIRE(!CreateAnimationFile(path));
+
+        // Import the source animation
+        ModelData source;
+        ModelTool::Options options;
+        options.Type = ModelTool::ModelType::Animation;
+        String errorMsg;
+        REQUIRE(!ModelTool::ImportModel(path, source, options, errorMsg));
+        REQUIRE(source.Animations.Count() == 1);
+
+        // Import the compressed animation (skeleton is imported to provide the nodes default pose and length)
+        ModelData data;
+        options = ModelTool::Options();
+        options.Type = ModelTool::ModelType::Animation;
+        options.CompressAnimation = true;
+        REQUIRE(!ModelTool::ImportModel(path, data, options, errorMsg));
+        FileSystem::DeleteFile(path);
+        REQUIRE(data.Animations.Count() == 1);
+        REQUIRE(data.Skeleton.FindNode(TEXT("Bone")) != -1);
+        const AnimationData& animation = data.Animations[0];
+        CHECK(animation.IsCompressed());
+        const int32 channelIndex = FindChannel(animation, TEXT("Bone"));
+        REQUIRE(channelIndex != -1);
+
+        // Constant track that matches the node default pose is stripped, animated track is kept
+        const CompressedAnimationData::Channel& channel = animation.Compressed.Channels[channelIndex];
+        CHECK(channel.Position.Count == 0);
+        CHECK(channel.Rotation.Count > 1);
+
+        // Compressed animation matches the source within the error
+        const int32 sourceChannelIndex = FindChannel(source.Animations[0], TEXT("Bone"));
+        REQUIRE(sourceChannelIndex != -1);
+        const Transform defaultPose = data.Skeleton.Nodes[data.Skeleton.FindNode(TEXT("Bone"))].LocalTransform;
+        for (int32 i = 0; i <= 20; i++)
+        {
+            const float time = (float)(animation.Duration * i / 20);
+            Transform expected = defaultPose, actual = defaultPose;
+            source.Animations[0].EvaluateChannel(sourceChannelIndex, time, &expected);
+            animation.EvaluateChannel(channelIndex, time, &actual);
+            CHECK(Float3::Distance(expected.Translation, actual.Translation) < 0.01f);
+            CHECK(Math::Abs(Quaternion::Dot(expected.Orientation, actual.Orientation)) > 0.9999f);
+        }
+    }
+#endif
 }
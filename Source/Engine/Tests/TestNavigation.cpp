@@ -0,0 +1,352 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Navigation/NavCrowd.h"
+#include "Engine/Navigation/NavMesh.h"
+#include "Engine/Navigation/NavMeshGeometryCache.h"
+#include "Engine/Navigation/NavMeshRuntime.h"
+#include "Engine/Threading/JobSystem.h"
+#include <ThirdParty/recastnavigation/DetourAlloc.h>
+#include <ThirdParty/recastnavigation/DetourNavMeshBuilder.h>
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    constexpr int32 CellVoxels = 10;
+    constexpr float VoxelSize = 10.0f;
+    constexpr float CellSize = CellVoxels * VoxelSize;
+
+    // Creates the navmesh tile with a grid of square polygons (with a wall in the middle that has a gap at the far end)
+    bool CreateTile(int32 size, NavMeshTileData& tile)
+    {
+        Array<uint16> verts, polys, polyFlags;
+        Array<byte> polyAreas;
+        for (int32 x = 0; x <= size; x++)
+        {
+            for (int32 z = 0; z <= size; z++)
+            {
+                verts.Add((uint16)(x * CellVoxels));
+                verts.Add(0);
+                verts.Add((uint16)(z * CellVoxels));
+            }
+        }
+        Array<int32> cells;
+        cells.Resize(size * size);
+        int32 polyCount = 0;
+        for (int32 x = 0; x < size; x++)
+        {
+            for (int32 z = 0; z < size; z++)
+                cells[x * size + z] = x == size / 2 && z != size - 1 ? -1 : polyCount++;
+        }
+        const auto getCell = [&](int32 x, int32 z)
+        {
+            return x >= 0 && z >= 0 && x < size && z < size && cells[x * size + z] != -1 ? (uint16)cells[x * size + z] : (uint16)0xffff;
+        };
+        for (int32 x = 0; x < size; x++)
+        {
+            for (int32 z = 0; z < size; z++)
+            {
+                if (cells[x * size + z] == -1)
+                    continue;
+                polys.Add((uint16)(x * (size + 1) + z));
+                polys.Add((uint16)(x * (size + 1) + z + 1));
+                polys.Add((uint16)((x + 1) * (size + 1) + z + 1));
+                polys.Add((uint16)((x + 1) * (size + 1) + z));
+                polys.Add(getCell(x - 1, z));
+                polys.Add(getCell(x, z + 1));
+                polys.Add(getCell(x + 1, z));
+                polys.Add(getCell(x, z - 1));
+                polyFlags.Add(1);
+                polyAreas.Add(0);
+            }
+        }
+
+        dtNavMeshCreateParams params;
+        Platform::MemoryClear(&params, sizeof(params));
+        params.verts = verts.Get();
+        params.vertCount = verts.Count() / 3;
+        params.polys = polys.Get();
+        params.polyFlags = polyFlags.Get();
+        params.polyAreas = polyAreas.Get();
+        params.polyCount = polyCount;
+        params.nvp = 4;
+        params.bmax[0] = params.bmax[2] = size * CellSize;
+        params.bmax[1] = VoxelSize;
+        params.walkableHeight = 100.0f;
+        params.walkableRadius = 10.0f;
+        params.walkableClimb = 10.0f;
+        params.cs = VoxelSize;
+        params.ch = VoxelSize;
+        params.buildBvTree = true;
+        unsigned char* data = nullptr;
+        int dataSize = 0;
+        if (!dtCreateNavMeshData(&params, &data, &dataSize))
+            return false;
+        tile.PosX = tile.PosY = tile.Layer = 0;
+        tile.Data.Copy(data, dataSize);
+        dtFree(data);
+        return true;
+    }
+
+    NavMeshRuntime* CreateNavMesh(int32 size, NavMesh*& navMesh)
+    {
+        NavMeshRuntime::NavAreasCosts[0] = 1.0f;
+        NavMeshTileData tile;
+        if (!CreateTile(size, tile))
+            return nullptr;
+        navMesh = New<NavMesh>();
+        navMesh->Data.TileSize = size * CellSize;
+        auto runtime = New<NavMeshRuntime>(NavMeshProperties());
+        runtime->AddTile(navMesh, tile);
+        return runtime;
+    }
+
+    void DeleteNavMesh(NavMeshRuntime* runtime, NavMesh* navMesh)
+    {
+        Delete(runtime);
+        navMesh->DeleteObject();
+    }
+
+    // Creates paths requests from the one side of the wall to the other one
+    void CreateRequests(int32 size, int32 count, Array<NavMeshPathRequest>& requests)
+    {
+        requests.Resize(count);
+        for (int32 i = 0; i < count; i++)
+        {
+            NavMeshPathRequest& request = requests[i];
+            const float z = ((i % size) + 0.5f) * CellSize;
+            request.StartPosition = Vector3(CellSize * 0.5f, 0.0f, z);
+            request.EndPosition = Vector3((size - 0.5f) * CellSize, 0.0f, size * CellSize - z);
+        }
+    }
+
+    // Creates the crowd with agents placed on a lattice that move to the opposite side of the navmesh
+    NavCrowd* CreateCrowd(NavMeshRuntime* runtime, int32 size, int32 count, bool useJobSystem)
+    {
+        auto crowd = New<NavCrowd>();
+        crowd->UseJobSystem = useJobSystem;
+        NavAgentProperties agent;
+        agent.Radius = 20.0f;
+        agent.MaxSpeed = 200.0f;
+        if (crowd->Init(agent.Radius * 3.0f, count, runtime))
+        {
+            Delete(crowd);
+            return nullptr;
+        }
+        const int32 rowSize = (int32)Math::Ceil(Math::Sqrt((float)count));
+        const float spacing = size * CellSize / rowSize;
+        const Vector3 center(size * CellSize * 0.5f, 0.0f, size * CellSize * 0.5f);
+        for (int32 i = 0; i < count; i++)
+        {
+            const Vector3 position(((i % rowSize) + 0.5f) * spacing, 0.0f, ((i / rowSize) + 0.5f) * spacing);
+            const int32 id = crowd->AddAgent(position, agent);
+            crowd->SetAgentMoveTarget(id, center * 2.0f - position);
+        }
+        return crowd;
+    }
+}
+
+TEST_CASE("Navigation")
+{
+    SECTION("Test Batched Paths")
+    {
+        constexpr int32 size = 16, count = 100;
+        NavMesh* navMesh;
+        NavMeshRuntime* runtime = CreateNavMesh(size, navMesh);
+        REQUIRE(runtime);
+        Array<NavMeshPathRequest> requests;
+        CreateRequests(size, count, requests);
+
+        // Single path goes around the wall
+        Array<Vector3> path;
+        NavMeshPathFlags flags;
+        CHECK(runtime->FindPath(requests[0].StartPosition, requests[0].EndPosition, path, flags));
+        CHECK(flags == NavMeshPathFlags::None);
+        CHECK(path.Count() > 2);
+
+        // Batched paths match the single paths
+        const auto checkResults = [&]()
+        {
+            bool valid = true;
+            for (const NavMeshPathRequest& request : requests)
+            {
+                valid &= runtime->FindPath(request.StartPosition, request.EndPosition, path, flags);
+                valid &= request.Result && request.ResultFlags == flags && request.ResultPath == path;
+            }
+            return valid;
+        };
+        runtime->FindPaths(ToSpan(requests));
+        CHECK(checkResults());
+        for (NavMeshPathRequest& request : requests)
+        {
+            request.Result = false;
+            request.ResultPath.Clear();
+        }
+        CHECK(runtime->FindPathsAsync(ToSpan(requests)) != 0);
+        runtime->WaitForPaths();
+        CHECK(checkResults());
+        CHECK(runtime->FindPathsAsync(Span<NavMeshPathRequest>()) == 0);
+
+        DeleteNavMesh(runtime, navMesh);
+    }
+
+    SECTION("Test Crowd Update")
+    {
+        // Parallel crowd update gives the same results as the single-threaded one
+        constexpr int32 size = 16, count = 300, updates = 30;
+        NavMesh* navMesh;
+        NavMeshRuntime* runtime = CreateNavMesh(size, navMesh);
+        REQUIRE(runtime);
+        NavCrowd* crowdA = CreateCrowd(runtime, size, count, false);
+        NavCrowd* crowdB = CreateCrowd(runtime, size, count, true);
+        REQUIRE(crowdA);
+        REQUIRE(crowdB);
+        for (int32 i = 0; i < updates; i++)
+        {
+            crowdA->Update(1.0f / 30.0f);
+            crowdB->Update(1.0f / 30.0f);
+        }
+        bool valid = true, moved = false;
+        for (int32 id = 0; id < count; id++)
+        {
+            valid &= crowdA->GetAgentPosition(id) == crowdB->GetAgentPosition(id);
+            valid &= crowdA->GetAgentVelocity(id) == crowdB->GetAgentVelocity(id);
+            moved |= !crowdA->GetAgentVelocity(id).IsZero();
+        }
+        CHECK(valid);
+        CHECK(moved);
+
+        Delete(crowdA);
+        Delete(crowdB);
+        DeleteNavMesh(runtime, navMesh);
+    }
+
+#if COMPILE_WITH_NAV_MESH_BUILDER
+    SECTION("Test Geometry Cache")
+    {
+        // Release leftovers (no build tasks are running during tests)
+        NavMeshGeometryCache::Invalidate();
+        NavMeshGeometryCache::Update();
+        REQUIRE(NavMeshGeometryCache::GetCount() == 0);
+        REQUIRE(NavMeshGeometryCache::GetSize() == 0);
+
+        // Triangle that overlaps two tiles
+        Array<Float3> vb;
+        vb.Add(Float3(10, 0, 10));
+        vb.Add(Float3(50, 0, 10));
+        vb.Add(Float3(10, 0, 150));
+        Array<int32> ib;
+        ib.Add(0);
+        ib.Add(1);
+        ib.Add(2);
+        const float tileSize = 100.0f;
+        const auto buildGeometry = [&](NavGeometry* geometry)
+        {
+            geometry->Version = NavMeshGeometryCache::GetVersion();
+            geometry->Source = &vb;
+            geometry->LocalToWorld = Matrix::Identity;
+            geometry->WorldToNavMesh = Matrix::Identity;
+            geometry->TileSize = tileSize;
+            geometry->TileBorderSize = 0.0f;
+            geometry->Build(vb, ib);
+            NavMeshGeometryCache::AddSize(geometry->Size);
+        };
+        const auto isValid = [&](const NavGeometry* geometry)
+        {
+            return geometry->IsValid(NavMeshGeometryCache::GetVersion(), &vb, Matrix::Identity, Matrix::Identity, tileSize, 0.0f);
+        };
+        const Guid actorA = Guid::New(), actorB = Guid::New();
+        NavGeometry* geometryA = NavMeshGeometryCache::Get(actorA, Quaternion::Identity);
+        NavGeometry* geometryB = NavMeshGeometryCache::Get(actorB, Quaternion::Identity);
+        CHECK(!isValid(geometryA));
+        buildGeometry(geometryA);
+        buildGeometry(geometryB);
+        CHECK(isValid(geometryA));
+        CHECK(geometryA->Tiles.Count() == 2);
+        CHECK(geometryA->Tiles.ContainsKey(Int2(0, 0)));
+        CHECK(geometryA->Tiles.ContainsKey(Int2(0, 1)));
+        CHECK(NavMeshGeometryCache::GetSize() == geometryA->Size + geometryB->Size);
+
+        // Cache hit for the same actor and navmesh orientation, miss for the other orientation
+        CHECK(NavMeshGeometryCache::Get(actorA, Quaternion::Identity) == geometryA);
+        CHECK(NavMeshGeometryCache::Get(actorA, Quaternion::Euler(0, 90, 0)) != geometryA);
+        CHECK(NavMeshGeometryCache::GetCount() == 3);
+
+        // Update keeps valid geometry
+        NavMeshGeometryCache::Update();
+        CHECK(NavMeshGeometryCache::GetCount() == 3);
+        CHECK(NavMeshGeometryCache::Get(actorA, Quaternion::Identity) == geometryA);
+        CHECK(isValid(geometryA));
+
+        // Evicted actor geometry is released on update (with outdated entries)
+        NavMeshGeometryCache::Evict(actorB);
+        NavMeshGeometryCache::Update();
+        CHECK(NavMeshGeometryCache::GetCount() == 1);
+        CHECK(NavMeshGeometryCache::Get(actorA, Quaternion::Identity) == geometryA);
+        CHECK(NavMeshGeometryCache::GetSize() == geometryA->Size);
+
+        // Invalidation makes geometry outdated and update releases it
+        NavMeshGeometryCache::Invalidate();
+        CHECK(!isValid(geometryA));
+        NavMeshGeometryCache::Update();
+        CHECK(NavMeshGeometryCache::GetCount() == 0);
+        CHECK(NavMeshGeometryCache::GetSize() == 0);
+    }
+#endif
+}
+
+TEST_CASE("Navigation Benchmark", "[.][benchmark]")
+{
+    SECTION("Paths")
+    {
+        // Compare many single path queries against the batched path queries (executed in parallel)
+        constexpr int32 size = 64, count = 10000;
+        NavMesh* navMesh;
+        NavMeshRuntime* runtime = CreateNavMesh(size, navMesh);
+        REQUIRE(runtime);
+        Array<NavMeshPathRequest> requests;
+        CreateRequests(size, count, requests);
+
+        Stopwatch stopwatch;
+        for (NavMeshPathRequest& request : requests)
+            request.Result = runtime->FindPath(request.StartPosition, request.EndPosition, request.ResultPath, request.ResultFlags);
+        stopwatch.Stop();
+        const float singleTime = stopwatch.GetTotalMilliseconds();
+
+        stopwatch.Start();
+        runtime->FindPaths(ToSpan(requests));
+        stopwatch.Stop();
+        const float batchTime = stopwatch.GetTotalMilliseconds();
+
+        LOG(Info, "Navigation paths ({0} paths, {1} threads): single: {2} ms, batched: {3} ms", count, JobSystem::GetThreadsCount(), singleTime, batchTime);
+        DeleteNavMesh(runtime, navMesh);
+    }
+
+    SECTION("Crowd")
+    {
+        // Compare the single-threaded and parallel crowd update for different agents counts
+        constexpr int32 size = 64, updates = 60;
+        NavMesh* navMesh;
+        NavMeshRuntime* runtime = CreateNavMesh(size, navMesh);
+        REQUIRE(runtime);
+        for (const int32 count : { 1000, 5000, 10000 })
+        {
+            float times[2];
+            for (int32 i = 0; i < 2; i++)
+            {
+                NavCrowd* crowd = CreateCrowd(runtime, size, count, i == 1);
+                REQUIRE(crowd);
+                Stopwatch stopwatch;
+                for (int32 update = 0; update < updates; update++)
+                    crowd->Update(1.0f / 60.0f);
+                stopwatch.Stop();
+                times[i] = stopwatch.GetTotalMilliseconds() / updates;
+                Delete(crowd);
+            }
+            LOG(Info, "Crowd update ({0} agents, {1} threads): single-threaded: {2} ms, Job System: {3} ms", count, JobSystem::GetThreadsCount(), times[0], times[1]);
+        }
+        DeleteNavMesh(runtime, navMesh);
+    }
+}
@@ -1,10 +1,42 @@
 // Copyright (c) Wojciech Figat. All rights reserved.
 
+#include "TestScripting.h"
+#include "Engine/Core/Log.h"
 #include "Engine/Core/Formatting.h"
+#include "Engine/Core/Utilities.h"
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Level/Actors/EmptyActor.h"
+#include "Engine/Networking/NetworkChannelType.h"
 #include "Engine/Networking/NetworkStream.h"
+#include "Engine/Networking/NetworkInternal.h"
+#include "Engine/Networking/NetworkManager.h"
+#include "Engine/Networking/NetworkPeer.h"
+#include "Engine/Networking/NetworkReplicator.h"
+#include "Engine/Networking/NetworkReplicationHierarchy.h"
+#include "Engine/Networking/NetworkSettings.h"
+#include "Engine/Networking/Components/NetworkTransform.h"
+#include "Engine/Networking/Drivers/NetworkLoopbackDriver.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/catch2/catch.hpp>
 
+namespace
+{
+    // Serializer that writes the nested object passed via tag (like the generated code does for the nested and base types).
+    void SerializeNested(void* instance, NetworkStream* stream, void* tag)
+    {
+        stream->WriteInt32(123);
+        NetworkReplicator::InvokeSerializer(NetworkTransform::TypeInitializer, tag, stream, true);
+        NetworkReplicator::InvokeSerializer(EmptyActor::TypeInitializer, tag, stream, true);
+    }
+
+    void DeserializeNested(void* instance, NetworkStream* stream, void* tag)
+    {
+    }
+}
+
 TEST_CASE("Networking")
 {
     SECTION("Test Network Stream")
@@ -63,7 +95,442 @@ TEST_CASE("Networking")
 #undef TEST_RAW
         }
 
+        // Bit-packed values
+        {
+            writeStream->Initialize();
+            writeStream->WriteBits(5, 3);
+            writeStream->WriteVarUInt(300);
+            writeStream->WriteVarInt(-2);
+            writeStream->WriteVarInt(MIN_int64);
+            writeStream->WriteBits(MAX_uint32, 32);
+            writeStream->WriteQuantizedFloat(0.25f, -1.0f, 1.0f, 10);
+            writeStream->WriteQuantizedFloat(5.0f, -1.0f, 1.0f, 10);
+            writeStream->WriteQuantizedVector3(Vector3(10, -20, 30), Vector3(-100), Vector3(100), 16);
+            writeStream->WriteQuantizedQuaternion(Quaternion::Euler(10, -170, 45));
+            writeStream->WriteQuantizedQuaternion(Quaternion::Euler(0, 180, 0), 16);
+            writeStream->WriteBits(1, 1);
+            writeStream->Write((uint16)1234);
+            writeStream->WriteBits(0, 2);
+            CHECK(writeStream->GetPosition() == 39);
+            writeStream->FlushBits();
+            const uint32 size = writeStream->GetPosition();
+            CHECK(size == 40);
+
+            readStream->Initialize(writeStream->GetBuffer(), size);
+            CHECK(readStream->ReadBits(3) == 5);
+            CHECK(readStream->ReadVarUInt() == 300);
+            CHECK(readStream->ReadVarInt() == -2);
+            CHECK(readStream->ReadVarInt() == MIN_int64);
+            CHECK(readStream->ReadBits(32) == MAX_uint32);
+            CHECK(Math::Abs(readStream->ReadQuantizedFloat(-1.0f, 1.0f, 10) - 0.25f) < 0.001f);
+            CHECK(readStream->ReadQuantizedFloat(-1.0f, 1.0f, 10) == 1.0f);
+            CHECK(Vector3::NearEqual(readStream->ReadQuantizedVector3(Vector3(-100), Vector3(100), 16), Vector3(10, -20, 30), 0.01f));
+            CHECK(Quaternion::Dot(readStream->ReadQuantizedQuaternion(), Quaternion::Euler(10, -170, 45)) > 0.9999f);
+            CHECK(Math::Abs(Quaternion::Dot(readStream->ReadQuantizedQuaternion(16), Quaternion::Euler(0, 180, 0))) > 0.9999f);
+            CHECK(readStream->ReadBits(1) == 1);
+            uint16 value;
+            readStream->Read(value);
+            CHECK(value == 1234);
+            CHECK(readStream->ReadBits(2) == 0);
+            CHECK(readStream->GetPosition() == size);
+        }
+
         Delete(readStream);
         Delete(writeStream);
     }
+
+    SECTION("Test Network Transform Quantization")
+    {
+        // Replicate transform with the bit-packed position and rotation (full components and the selected ones)
+        auto writeStream = New<NetworkStream>();
+        auto readStream = New<NetworkStream>();
+        auto source = New<EmptyActor>();
+        auto target = New<EmptyActor>();
+        auto sourceTransform = source->AddScript<NetworkTransform>();
+        auto targetTransform = target->AddScript<NetworkTransform>();
+        sourceTransform->PositionPrecision = 0.01f;
+        const Transform transform(Vector3(12345.678f, -0.004f, -9876.5f), Quaternion::Euler(10, -170, 45), Float3::One);
+        source->SetTransform(transform);
+
+        writeStream->Initialize();
+        sourceTransform->Serialize(writeStream);
+        writeStream->FlushBits();
+        const uint32 quantizedSize = writeStream->GetPosition();
+        readStream->Initialize(writeStream->GetBuffer(), quantizedSize);
+        targetTransform->Deserialize(readStream);
+        CHECK(readStream->GetPosition() == quantizedSize);
+        CHECK(Vector3::NearEqual(target->GetPosition(), transform.Translation, 0.006f));
+        CHECK(Quaternion::Dot(target->GetOrientation(), transform.Orientation) > 0.9999f);
+        CHECK(target->GetScale() == Float3::One);
+
+        // Unquantized data is larger
+        sourceTransform->PositionPrecision = 0.0f;
+        writeStream->Initialize();
+        sourceTransform->Serialize(writeStream);
+        writeStream->FlushBits();
+        CHECK(quantizedSize < writeStream->GetPosition());
+
+        // Partial components
+        sourceTransform->PositionPrecision = 0.5f;
+        sourceTransform->Components = NetworkTransform::ReplicationComponents::PositionX | NetworkTransform::ReplicationComponents::PositionZ | NetworkTransform::ReplicationComponents::Scale | NetworkTransform::ReplicationComponents::RotationY;
+        source->SetTransform(Transform(Vector3(-100.2f, 50.0f, 3.3f), Quaternion::Euler(0, 90, 0), Float3(2.0f)));
+        target->SetTransform(Transform::Identity);
+        writeStream->Initialize();
+        sourceTransform->Serialize(writeStream);
+        writeStream->FlushBits();
+        readStream->Initialize(writeStream->GetBuffer(), writeStream->GetPosition());
+        targetTransform->Deserialize(readStream);
+        CHECK(readStream->GetPosition() == writeStream->GetPosition());
+        CHECK(Vector3::NearEqual(target->GetPosition(), Vector3(-100.0f, 0.0f, 3.5f), 0.001f));
+        CHECK(Math::Abs(target->GetOrientation().GetEuler().Y - 90.0f) < 0.01f);
+        CHECK(target->GetScale() == Float3(2.0f));
+
+        source->DeleteObject();
+        target->DeleteObject();
+        Delete(readStream);
+        Delete(writeStream);
+    }
+
+    SECTION("Test Loopback Driver")
+    {
+        NetworkConfig config;
+        config.Port = 17777;
+        auto serverDriver = New<NetworkLoopbackDriver>();
+        config.NetworkDriver = serverDriver;
+        NetworkPeer* server = NetworkPeer::CreatePeer(config);
+        REQUIRE(server);
+        REQUIRE(server->Listen());
+        config.NetworkDriver = New<NetworkLoopbackDriver>();
+        NetworkPeer* client = NetworkPeer::CreatePeer(config);
+        REQUIRE(client);
+        REQUIRE(client->Connect());
+        NetworkEvent event;
+        REQUIRE(server->PopEvent(event));
+        CHECK(event.EventType == NetworkEventType::Connected);
+        const NetworkConnection connection = event.Sender;
+        REQUIRE(client->PopEvent(event));
+        CHECK(event.EventType == NetworkEventType::Connected);
+
+        // Client -> Server
+        NetworkMessage msg = client->BeginSendMessage();
+        msg.WriteInt32(123);
+        client->EndSendMessage(NetworkChannelType::Reliable, msg);
+        REQUIRE(server->PopEvent(event));
+        CHECK(event.EventType == NetworkEventType::Message);
+        CHECK(event.Sender == connection);
+        CHECK(event.Message.ReadInt32() == 123);
+        server->RecycleMessage(event.Message);
+
+        // Server -> Client (with packet loss of unreliable messages)
+        serverDriver->PacketLoss = 1.0f;
+        msg = server->BeginSendMessage();
+        msg.WriteInt32(1);
+        server->EndSendMessage(NetworkChannelType::Unreliable, msg, connection);
+        msg = server->BeginSendMessage();
+        msg.WriteInt32(2);
+        server->EndSendMessage(NetworkChannelType::Reliable, msg, connection);
+        REQUIRE(client->PopEvent(event));
+        CHECK(event.Message.ReadInt32() == 2);
+        client->RecycleMessage(event.Message);
+        CHECK(!client->PopEvent(event));
+        CHECK(serverDriver->GetMessagesSent() == 2);
+        CHECK(serverDriver->GetMessagesDropped() == 1);
+
+        // Latency
+        serverDriver->PacketLoss = 0.0f;
+        serverDriver->Latency = 50.0f;
+        msg = server->BeginSendMessage();
+        msg.WriteInt32(3);
+        server->EndSendMessage(NetworkChannelType::Unreliable, msg, connection);
+        CHECK(!client->PopEvent(event));
+        Platform::Sleep(60);
+        REQUIRE(client->PopEvent(event));
+        CHECK(event.Message.ReadInt32() == 3);
+        client->RecycleMessage(event.Message);
+
+        // Disconnect
+        client->Disconnect();
+        REQUIRE(server->PopEvent(event));
+        CHECK(event.EventType == NetworkEventType::Disconnected);
+        CHECK(event.Sender == connection);
+        NetworkPeer::ShutdownPeer(client);
+        NetworkPeer::ShutdownPeer(server);
+    }
+
+    SECTION("Test Parallel Serialization")
+    {
+        // Serialize objects with the nested types on many threads at once (serializers get resolved on job threads)
+        auto actor = New<EmptyActor>();
+        actor->SetPosition(Vector3(1, 2, 3));
+        auto transform = actor->AddScript<NetworkTransform>();
+        NetworkReplicator::AddSerializer(ScriptingTypeHandle(Foo::TypeInitializer), SerializeNested, DeserializeNested, transform, transform);
+        constexpr int32 jobsCount = 256;
+        Array<NetworkStream*> streams;
+        Array<bool> failed;
+        for (int32 i = 0; i < jobsCount; i++)
+            streams.Add(New<NetworkStream>());
+        failed.Resize(jobsCount);
+        JobSystem::Execute([&](int32 i)
+        {
+            streams[i]->Initialize();
+            failed[i] = NetworkReplicator::InvokeSerializer(Foo::TypeInitializer, transform, streams[i], true);
+        }, jobsCount);
+        for (int32 i = 0; i < jobsCount; i++)
+        {
+            CHECK(!failed[i]);
+            CHECK(streams[i]->GetPosition() == streams[0]->GetPosition());
+            CHECK(Platform::MemoryCompare(streams[i]->GetBuffer(), streams[0]->GetBuffer(), streams[0]->GetPosition()) == 0);
+        }
+        CHECK(streams[0]->GetPosition() > sizeof(int32));
+        NetworkReplicator::RemoveSerializer(ScriptingTypeHandle(Foo::TypeInitializer));
+        CHECK(NetworkReplicator::InvokeSerializer(Foo::TypeInitializer, transform, streams[0], true));
+        for (NetworkStream* stream : streams)
+            Delete(stream);
+        actor->DeleteObject();
+    }
+
+    SECTION("Test Replication Budget")
+    {
+        // Simulate objects replication to a client with a limited data budget (priority is accumulated every update until object gets sent)
+        constexpr int32 objectsCount = 10, updatesCount = 400;
+        constexpr uint32 budget = 350;
+        float priorities[objectsCount] = {}, gains[objectsCount];
+        int32 sentCount[objectsCount] = {}, lastSent[objectsCount], maxWait[objectsCount] = {};
+        for (int32 i = 0; i < objectsCount; i++)
+        {
+            gains[i] = i < 2 ? 0.05f : 1.0f; // First objects have low importance
+            lastSent[i] = -1;
+        }
+        Array<NetworkReplicationBudget::Item> items;
+        for (int32 update = 0; update < updatesCount; update++)
+        {
+            items.Clear();
+            for (int32 i = 0; i < objectsCount; i++)
+            {
+                priorities[i] += gains[i];
+                items.Add({ priorities[i], i, 100, false });
+            }
+            const uint32 bytes = NetworkReplicationBudget::Apply(items, budget);
+            CHECK(bytes <= budget);
+            uint32 sentBytes = 0;
+            for (const auto& e : items)
+            {
+                if (!e.Send)
+                    continue;
+                sentBytes += e.Size;
+                priorities[e.Index] = 0.0f;
+                sentCount[e.Index]++;
+                maxWait[e.Index] = Math::Max(maxWait[e.Index], update - lastSent[e.Index]);
+                lastSent[e.Index] = update;
+            }
+            CHECK(sentBytes == bytes);
+            CHECK(bytes == 300);
+        }
+        for (int32 i = 0; i < objectsCount; i++)
+        {
+            // Low priority objects are sent less often but they're not starved
+            CHECK(sentCount[i] > 0);
+            CHECK(maxWait[i] <= (i < 2 ? 100 : 10));
+            if (i >= 2)
+                CHECK(sentCount[i] > sentCount[0] * 4);
+        }
+
+        // Objects bigger than the budget are sent alone, smaller objects with lower priority fill the rest of the budget
+        items.Clear();
+        items.Add({ 1.0f, 0, 100, false });
+        items.Add({ 5.0f, 1, 1000, false });
+        items.Add({ 3.0f, 2, 300, false });
+        CHECK(NetworkReplicationBudget::Apply(items, budget) == 1000);
+        CHECK(items[0].Index == 1);
+        CHECK(items[0].Send);
+        CHECK(!items[1].Send);
+        CHECK(!items[2].Send);
+        items[0].Size = 200;
+        CHECK(NetworkReplicationBudget::Apply(items, budget) == 300);
+        CHECK(items[1].Index == 2);
+        CHECK(!items[1].Send);
+        CHECK(items[2].Send);
+    }
+
+#if USE_NETWORK_REPLICATOR_DELTA
+    SECTION("Test Replication Delta")
+    {
+        constexpr uint32 clientId = 1, stateSize = 64;
+        NetworkReplicatorDeltaCache server, client;
+        byte state1[stateSize], state2[stateSize + 16];
+        for (uint32 i = 0; i < stateSize; i++)
+            state1[i] = (byte)i;
+        Platform::MemoryCopy(state2, state1, stateSize);
+        state2[10] = 200;
+        state2[40] = 7;
+        for (uint32 i = stateSize; i < stateSize + 16; i++)
+            state2[i] = (byte)(i * 3);
+
+        // Server sends the first state as a full state and client acknowledges it
+        server.Add(1, state1, stateSize);
+        CHECK(server.GetBaseline(0, clientId) == 0);
+        client.Add(1, state1, stateSize);
+        server.SetAck(0, clientId, 1);
+        CHECK(server.GetAck(0, clientId) == 1);
+        CHECK(server.GetBaseline(0, clientId + 1) == 0);
+
+        // Delta round-trip against the acknowledged state
+        server.Add(2, state2, sizeof(state2));
+        const uint32 baselineFrame = server.GetBaseline(0, clientId);
+        REQUIRE(baselineFrame == 1);
+        const auto* baseline = server.Find(baselineFrame);
+        REQUIRE(baseline);
+        Array<byte> delta, decoded;
+        NetworkReplicatorDeltaCache::Encode(delta, state2, sizeof(state2), baseline->Data.Get(), baseline->Data.Length());
+        CHECK(delta.Count() < (int32)sizeof(state2));
+        const auto* clientBaseline = client.Find(baselineFrame);
+        REQUIRE(clientBaseline);
+        REQUIRE(!NetworkReplicatorDeltaCache::Decode(decoded, delta.Get(), delta.Count(), clientBaseline->Data.Get(), clientBaseline->Data.Length()));
+        REQUIRE(decoded.Count() == sizeof(state2));
+        CHECK(Platform::MemoryCompare(decoded.Get(), state2, sizeof(state2)) == 0);
+        client.Add(2, decoded.Get(), decoded.Count());
+
+        // Shrinking state
+        NetworkReplicatorDeltaCache::Encode(delta, state1, stateSize, state2, sizeof(state2));
+        REQUIRE(!NetworkReplicatorDeltaCache::Decode(decoded, delta.Get(), delta.Count(), state2, sizeof(state2)));
+        REQUIRE(decoded.Count() == stateSize);
+        CHECK(Platform::MemoryCompare(decoded.Get(), state1, stateSize) == 0);
+
+        // Missing baseline (client never received the state) or truncated delta is rejected
+        CHECK(client.Find(3) == nullptr);
+        NetworkReplicatorDeltaCache::Encode(delta, state2, sizeof(state2), state1, stateSize);
+        CHECK(NetworkReplicatorDeltaCache::Decode(decoded, delta.Get(), delta.Count() - 1, state1, stateSize));
+
+        // Older acknowledgements (eg. reordered messages) don't move the baseline back
+        server.SetAck(0, clientId, 2);
+        server.SetAck(0, clientId, 1);
+        CHECK(server.GetAck(0, clientId) == 2);
+        CHECK(server.GetBaseline(0, clientId) == 2);
+
+        // Stale baseline (acknowledged state left the history) falls back to the full state
+        for (uint32 frame = 3; frame < 3 + NETWORK_REPLICATOR_DELTA_BASELINES; frame++)
+            server.Add(frame, state1, stateSize);
+        CHECK(server.Find(2) == nullptr);
+        CHECK(server.GetAck(0, clientId) == 2);
+        CHECK(server.GetBaseline(0, clientId) == 0);
+        CHECK(server.GetLatest().Frame == 2 + NETWORK_REPLICATOR_DELTA_BASELINES);
+    }
+#endif
+}
+
+TEST_CASE("Networking Benchmark", "[.][benchmark]")
+{
+    SECTION("Replication")
+    {
+        // Replicate many objects from the server to the simulated clients connected via loopback driver (networking is ticked manually)
+        constexpr int32 clientsCount = 16, objectsCount = 4000, ticksCount = 60;
+        auto settings = NetworkSettings::Get();
+        const StringAnsi prevNetworkDriver = settings->NetworkDriver;
+        const float prevNetworkFPS = NetworkManager::NetworkFPS;
+        settings->NetworkDriver = "FlaxEngine.Networking.NetworkLoopbackDriver";
+        NetworkManager::NetworkFPS = 0.0f;
+        REQUIRE(!NetworkManager::StartServer());
+        Array<NetworkPeer*> clients;
+        for (int32 i = 0; i < clientsCount; i++)
+        {
+            NetworkConfig config;
+            config.Port = settings->Port;
+            config.ConnectionsLimit = 1;
+            config.NetworkDriver = New<NetworkLoopbackDriver>();
+            NetworkPeer* client = NetworkPeer::CreatePeer(config);
+            REQUIRE(client);
+            REQUIRE(client->Connect());
+            clients.Add(client);
+        }
+        const auto updateClients = [&clients]
+        {
+            NetworkEvent event;
+#if USE_NETWORK_REPLICATOR_DELTA
+            Array<Pair<Guid, uint32>> acks;
+#endif
+            for (NetworkPeer* client : clients)
+            {
+                while (client->PopEvent(event))
+                {
+                    if (event.EventType == NetworkEventType::Connected)
+                    {
+                        NetworkClientConnectionData connectionData;
+                        connectionData.Client = nullptr;
+                        connectionData.Result = 0;
+                        connectionData.Platform = PLATFORM_TYPE;
+                        connectionData.Architecture = PLATFORM_ARCH;
+                        NetworkInternal::SendHandshake(client, connectionData);
+                    }
+                    else if (event.EventType == NetworkEventType::Message)
+                    {
+#if USE_NETWORK_REPLICATOR_DELTA
+                        // Acknowledge received objects states so server can send deltas
+                        Guid objectId;
+                        uint32 frame;
+                        if (!NetworkInternal::ReadReplicationAck(event.Message, objectId, frame))
+                            acks.Add(ToPair(objectId, frame));
+#endif
+                        client->RecycleMessage(event.Message);
+                    }
+                }
+#if USE_NETWORK_REPLICATOR_DELTA
+                if (acks.HasItems())
+                    NetworkInternal::SendReplicationAcks(client, acks);
+#endif
+            }
+        };
+        updateClients();
+        NetworkInternal::NetworkManagerUpdate();
+        REQUIRE(NetworkManager::Clients.Count() == clientsCount);
+
+        // Create replicated objects
+        Array<EmptyActor*> actors;
+        for (int32 i = 0; i < objectsCount; i++)
+        {
+            auto actor = New<EmptyActor>();
+            auto transform = actor->AddScript<NetworkTransform>();
+            NetworkReplicator::AddObject(transform);
+            actors.Add(actor);
+        }
+
+        // Tick
+        const auto driver = (NetworkLoopbackDriver*)ScriptingObject::FromInterface(NetworkManager::Peer->NetworkDriver, INetworkDriver::TypeInitializer);
+        const auto tickReplication = [&](const Char* name)
+        {
+            const uint32 dataStart = driver->GetStats().TotalDataSent;
+            const uint32 messagesStart = driver->GetMessagesSent();
+            Stopwatch stopwatch;
+            double totalTime = 0.0;
+            for (int32 tick = 0; tick < ticksCount; tick++)
+            {
+                for (int32 i = 0; i < objectsCount; i++)
+                    actors[i]->SetPosition(Vector3((float)i, (float)tick, 0.0f));
+                stopwatch.Start();
+                NetworkInternal::NetworkManagerUpdate();
+                stopwatch.Stop();
+                totalTime += stopwatch.GetTotalMilliseconds();
+                updateClients();
+            }
+            const uint32 dataPerTick = (driver->GetStats().TotalDataSent - dataStart) / ticksCount;
+            const uint32 messagesPerTick = (driver->GetMessagesSent() - messagesStart) / ticksCount;
+            LOG(Info, "Replication {5} ({0} objects, {1} clients): {2} ms per tick, {3} per tick, {4} messages per tick", objectsCount, clientsCount, (float)(totalTime / ticksCount), Utilities::BytesToText(dataPerTick), messagesPerTick, name);
+        };
+        tickReplication(TEXT("all"));
+
+        // Tick with the per-client data limit (objects are sent by priority)
+        auto hierarchy = New<NetworkReplicationHierarchy>();
+        hierarchy->ClientBytesBudget = 16 * 1024;
+        NetworkReplicator::SetHierarchy(hierarchy);
+        tickReplication(TEXT("budget"));
+
+        // Cleanup
+        NetworkReplicator::SetHierarchy(nullptr);
+        NetworkManager::Stop();
+        for (NetworkPeer* client : clients)
+            NetworkPeer::ShutdownPeer(client);
+        for (EmptyActor* actor : actors)
+            actor->DeleteObject();
+        settings->NetworkDriver = prevNetworkDriver;
+        NetworkManager::NetworkFPS = prevNetworkFPS;
+    }
 }
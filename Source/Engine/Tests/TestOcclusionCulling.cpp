@@ -0,0 +1,110 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Graphics/Models/CollisionProxy.h"
+#include "Engine/Renderer/OcclusionCulling.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("OcclusionCulling")
+{
+    SECTION("Test Occlusion Buffer")
+    {
+        // Camera at the origin looking at the wall (100x100 quad at 100 units distance)
+        Matrix view, projection;
+        Matrix::LookAt(Vector3::Zero, Vector3::Forward, Vector3::Up, view);
+        Matrix::PerspectiveFov(PI * 0.5f, 2.0f, 1.0f, 1000.0f, projection);
+        const Float3 wall[6] =
+        {
+            Float3(-50, -50, 100), Float3(50, -50, 100), Float3(50, 50, 100),
+            Float3(-50, -50, 100), Float3(50, 50, 100), Float3(-50, 50, 100),
+        };
+        OcclusionBuffer buffer;
+        buffer.Init(view, projection, 1.0f, Vector3::Zero);
+        buffer.AddOccluder(wall, 2, Matrix::Identity);
+        CHECK(buffer.GetTrianglesCount() == 2);
+        buffer.Rasterize();
+        CHECK(buffer.IsValid());
+
+        // Behind the wall
+        CHECK(buffer.IsOccluded(BoundingSphere(Vector3(0, 0, 200), 10)));
+        CHECK(buffer.IsOccluded(BoundingSphere(Vector3(50, 20, 300), 30)));
+
+        // In front of the wall or crossing it
+        CHECK(!buffer.IsOccluded(BoundingSphere(Vector3(0, 0, 50), 10)));
+        CHECK(!buffer.IsOccluded(BoundingSphere(Vector3(0, 0, 200), 150)));
+
+        // Behind the wall but visible next to it
+        CHECK(!buffer.IsOccluded(BoundingSphere(Vector3(120, 0, 200), 10)));
+        CHECK(!buffer.IsOccluded(BoundingSphere(Vector3(0, 0, -200), 10)));
+
+        // Reset
+        buffer.Reset();
+        CHECK(!buffer.IsValid());
+    }
+
+    SECTION("Test Occluder Proxy")
+    {
+        Matrix view, projection;
+        Matrix::LookAt(Vector3::Zero, Vector3::Forward, Vector3::Up, view);
+        Matrix::PerspectiveFov(PI * 0.5f, 2.0f, 1.0f, 1000.0f, projection);
+
+        // Indexed quad with interleaved vertex data (like the mesh vertex buffer) and an invalid triangle that should be skipped
+        struct Vertex
+        {
+            Float3 Position;
+            Float2 TexCoord;
+        };
+        const Vertex vertices[4] =
+        {
+            { Float3(-50, -50, 0), Float2::Zero },
+            { Float3(50, -50, 0), Float2::Zero },
+            { Float3(50, 50, 0), Float2::Zero },
+            { Float3(-50, 50, 0), Float2::Zero },
+        };
+        const uint16 indices[9] = { 0, 1, 2, 0, 2, 3, 0, 1, 7 };
+        CollisionProxy proxy;
+        proxy.Init<uint16>(ARRAY_COUNT(vertices), 3, &vertices[0].Position, indices, sizeof(Vertex));
+        CHECK(proxy.Triangles.Count() == 2);
+        CHECK(proxy.Triangles[1].V2 == Float3(-50, 50, 0));
+
+        // Half-precision positions
+        const Half4 verticesHalf[4] =
+        {
+            Half4(-50.0f, -50.0f, 0.0f, 1.0f),
+            Half4(50.0f, -50.0f, 0.0f, 1.0f),
+            Half4(50.0f, 50.0f, 0.0f, 1.0f),
+            Half4(-50.0f, 50.0f, 0.0f, 1.0f),
+        };
+        const uint32 indices32[6] = { 0, 1, 2, 0, 2, 3 };
+        CollisionProxy proxyHalf;
+        proxyHalf.Init<uint32>(ARRAY_COUNT(verticesHalf), 2, (const Float3*)verticesHalf, indices32, sizeof(Half4), PixelFormat::R16G16B16A16_Float);
+        CHECK(proxyHalf.Triangles.Count() == 2);
+        CHECK(proxyHalf.Triangles[0].V1 == Float3(50, -50, 0));
+
+        // Place the proxy as a wall at 100 units distance
+        OcclusionBuffer buffer;
+        buffer.Init(view, projection, 1.0f, Vector3::Zero);
+        buffer.AddOccluder(proxy, Matrix::Translation(Float3(0, 0, 100)));
+        CHECK(buffer.GetTrianglesCount() == 2);
+        buffer.Rasterize();
+        CHECK(buffer.IsValid());
+        CHECK(buffer.IsOccluded(BoundingSphere(Vector3(0, 0, 200), 10)));
+        CHECK(!buffer.IsOccluded(BoundingSphere(Vector3(120, 0, 200), 10)));
+
+        // The same wall from the half-precision geometry
+        buffer.Init(view, projection, 1.0f, Vector3::Zero);
+        buffer.AddOccluder(proxyHalf, Matrix::Translation(Float3(0, 0, 100)));
+        buffer.Rasterize();
+        CHECK(buffer.IsOccluded(BoundingSphere(Vector3(0, 0, 200), 10)));
+
+        // Rejected occluders: crossing the near plane, behind the camera, outside the screen and degenerate
+        buffer.Init(view, projection, 1.0f, Vector3::Zero);
+        buffer.AddOccluder(proxy, Matrix::Translation(Float3(0, 0, 0.5f)));
+        buffer.AddOccluder(proxy, Matrix::Translation(Float3(0, 0, -100)));
+        buffer.AddOccluder(proxy, Matrix::Translation(Float3(1000, 0, 100)));
+        buffer.AddOccluder(proxy, Matrix::Scaling(0.0f, 1.0f, 1.0f) * Matrix::Translation(Float3(0, 0, 100)));
+        CHECK(buffer.GetTrianglesCount() == 0);
+        buffer.Rasterize();
+        CHECK(!buffer.IsValid());
+    }
+}
@@ -0,0 +1,453 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Color.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Particles/ParticlesData.h"
+#include "Engine/Particles/ParticlesSimulation.h"
+#include "Engine/Particles/ParticleStreams.h"
+#include "Engine/Particles/Graph/CPU/ParticleEmitterGraph.CPU.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    // The particle emitter graph built manually (uses the same particles layout as TestParticles)
+    struct TestGraph
+    {
+        ParticleEmitterGraphCPU Graph;
+        Array<ParticleEmitterGraphCPUNode> Nodes;
+        int32 NodesCount = 0;
+
+        TestGraph()
+        {
+            Graph.Layout.AddAttribute(TEXT("Position"), ParticleAttribute::ValueTypes::Float3);
+            Graph.Layout.AddAttribute(TEXT("Velocity"), ParticleAttribute::ValueTypes::Float3);
+            Graph.Layout.AddAttribute(TEXT("Mass"), ParticleAttribute::ValueTypes::Float);
+            Graph.Layout.AddAttribute(TEXT("Age"), ParticleAttribute::ValueTypes::Float);
+            Graph.Layout.AddAttribute(TEXT("Lifetime"), ParticleAttribute::ValueTypes::Float);
+            Graph.Layout.UpdateLayout();
+            Nodes.Resize(24);
+        }
+
+        ParticleEmitterGraphCPUNode* AddNode(uint16 groupId, uint16 typeId, int32 boxes, int32 attribute0 = -1, int32 attribute1 = -1)
+        {
+            auto& node = Nodes[NodesCount++];
+            node.GroupID = groupId;
+            node.TypeID = typeId;
+            node.Attributes[0] = attribute0;
+            node.Attributes[1] = attribute1;
+            node.Boxes.Resize(boxes);
+            for (int32 i = 0; i < boxes; i++)
+            {
+                node.Boxes[i].Parent = &node;
+                node.Boxes[i].ID = i;
+            }
+            return &node;
+        }
+
+        static void Connect(ParticleEmitterGraphCPUNode* output, int32 outputBox, ParticleEmitterGraphCPUNode* input, int32 inputBox)
+        {
+            output->Boxes[outputBox].Connections.Add(&input->Boxes[inputBox]);
+            input->Boxes[inputBox].Connections.Add(&output->Boxes[outputBox]);
+        }
+    };
+
+    struct TestParticles
+    {
+        ParticleLayout Layout;
+        ParticleBuffer Buffer;
+        int32 Position, Velocity, Mass, Age, Lifetime;
+
+        TestParticles(int32 count, ParticleBufferLayout layout)
+        {
+            Position = Layout.AddAttribute(TEXT("Position"), ParticleAttribute::ValueTypes::Float3);
+            Velocity = Layout.AddAttribute(TEXT("Velocity"), ParticleAttribute::ValueTypes::Float3);
+            Mass = Layout.AddAttribute(TEXT("Mass"), ParticleAttribute::ValueTypes::Float);
+            Age = Layout.AddAttribute(TEXT("Age"), ParticleAttribute::ValueTypes::Float);
+            Lifetime = Layout.AddAttribute(TEXT("Lifetime"), ParticleAttribute::ValueTypes::Float);
+            Layout.UpdateLayout();
+            Buffer.Layout = &Layout;
+            Buffer.Capacity = count;
+            Buffer.Stride = Layout.Size;
+            Buffer.Mode = ParticlesSimulationMode::CPU;
+            Buffer.BufferLayout = layout;
+            Buffer.CPU.Count = count;
+            Buffer.CPU.Buffer.Resize(count * Buffer.Stride);
+
+            // Use the same pseudo-random particles for every layout
+            for (int32 i = 0; i < count; i++)
+            {
+                Get<Float3>(Position, i) = Float3(Rand(i, 0), Rand(i, 1), Rand(i, 2)) * 100.0f;
+                Get<Float3>(Velocity, i) = Float3(Rand(i, 3), Rand(i, 4), Rand(i, 5)) * 10.0f;
+                Get<float>(Mass, i) = Rand(i, 6) * 2.0f;
+                Get<float>(Age, i) = Rand(i, 7);
+                Get<float>(Lifetime, i) = Rand(i, 8) * 2.0f;
+            }
+        }
+
+        static float Rand(int32 i, int32 k)
+        {
+            return (float)((i * 7919 + k * 104729) % 1000) / 1000.0f;
+        }
+
+        template<typename T>
+        T& Get(int32 attribute, int32 particleIndex)
+        {
+            return *(T*)Buffer.GetAttributeCPU(particleIndex, Layout.Attributes[attribute]);
+        }
+
+        // Particles update with scalar per-particle loops (matches the CPU particle modules with AoS layout)
+        void Update(const Float3& gravity, float drag, float dt)
+        {
+            auto& cpu = Buffer.CPU;
+            for (int32 i = 0; i < cpu.Count; i++)
+                Get<float>(Age, i) += dt;
+            for (int32 i = 0; i < cpu.Count; i++)
+                Get<Float3>(Velocity, i) += gravity * dt;
+            for (int32 i = 0; i < cpu.Count; i++)
+                Get<Float3>(Velocity, i) *= Math::Max(0.0f, 1.0f - (drag * dt) / Math::Max(Get<float>(Mass, i), ZeroTolerance));
+            for (int32 i = 0; i < cpu.Count; i++)
+            {
+                if (Get<float>(Age, i) >= Get<float>(Lifetime, i))
+                {
+                    cpu.Count--;
+                    Buffer.CopyParticleCPU(i, cpu.Count);
+                    i--;
+                }
+            }
+            for (int32 i = 0; i < cpu.Count; i++)
+                Get<Float3>(Position, i) += Get<Float3>(Velocity, i) * dt;
+        }
+
+        // Particles update with vectorized kernels over attribute streams (matches the CPU particle modules with SoA layout)
+        void UpdateStreams(const Float3& gravity, float drag, float dt)
+        {
+            auto& cpu = Buffer.CPU;
+            float* age = &Get<float>(Age, 0);
+            Float3* velocity = &Get<Float3>(Velocity, 0);
+            ParticleStreams::Add(age, dt, cpu.Count);
+            ParticleStreams::Add(velocity, gravity * dt, cpu.Count);
+            ParticleStreams::LinearDrag(velocity, &Get<float>(Mass, 0), nullptr, drag, dt, cpu.Count);
+            int32 i = 0;
+            while ((i = ParticleStreams::FindDead(age, &Get<float>(Lifetime, 0), i, cpu.Count)) != cpu.Count)
+            {
+                cpu.Count--;
+                Buffer.CopyParticleCPU(i, cpu.Count);
+            }
+            ParticleStreams::MultiplyAdd(&Get<Float3>(Position, 0), velocity, dt, cpu.Count);
+        }
+    };
+}
+
+TEST_CASE("Particles")
+{
+    SECTION("Test SoA Layout")
+    {
+        // Both layouts give the same particles data
+        constexpr int32 count = 37;
+        TestParticles aos(count, ParticleBufferLayout::AoS);
+        TestParticles soa(count, ParticleBufferLayout::SoA);
+        CHECK(soa.Buffer.GetAttributeStride(soa.Layout.Attributes[soa.Velocity]) == sizeof(Float3));
+        CHECK(aos.Buffer.GetAttributeStride(aos.Layout.Attributes[aos.Velocity]) == aos.Layout.Size);
+        Array<byte> aosData, soaData;
+        aosData.Resize(count * aos.Layout.Size);
+        soaData.Resize(count * soa.Layout.Size);
+        aos.Buffer.GetParticlesCPU(aosData.Get());
+        soa.Buffer.GetParticlesCPU(soaData.Get());
+        CHECK(aosData == soaData);
+
+        // Particles copy and initialization
+        aos.Buffer.CopyParticleCPU(3, 10);
+        soa.Buffer.CopyParticleCPU(3, 10);
+        aos.Buffer.SetParticlesCPU(20, 5, aosData.Get() + 7 * aos.Layout.Size);
+        soa.Buffer.SetParticlesCPU(20, 5, aosData.Get() + 7 * aos.Layout.Size);
+        aos.Buffer.GetParticlesCPU(aosData.Get());
+        soa.Buffer.GetParticlesCPU(soaData.Get());
+        CHECK(aosData == soaData);
+        CHECK(soa.Get<Float3>(soa.Position, 3) == soa.Get<Float3>(soa.Position, 10));
+        CHECK(soa.Get<float>(soa.Lifetime, 24) == aos.Get<float>(aos.Lifetime, 7));
+        ParticleBufferCPUDataAccessor<float> massData(&soa.Buffer, soa.Layout.Attributes[soa.Mass].Offset);
+        CHECK(massData[12] == aos.Get<float>(aos.Mass, 12));
+    }
+
+    SECTION("Test Streams Update")
+    {
+        // Vectorized kernels give the same results as the per-particle update
+        constexpr int32 count = 1001;
+        const Float3 gravity(0.0f, -981.0f, 0.0f);
+        TestParticles aos(count, ParticleBufferLayout::AoS);
+        TestParticles soa(count, ParticleBufferLayout::SoA);
+        for (int32 i = 0; i < 10; i++)
+        {
+            aos.Update(gravity, 0.5f, 1.0f / 30.0f);
+            soa.UpdateStreams(gravity, 0.5f, 1.0f / 30.0f);
+        }
+        REQUIRE(soa.Buffer.CPU.Count == aos.Buffer.CPU.Count);
+        CHECK(soa.Buffer.CPU.Count < count);
+        CHECK(soa.Buffer.CPU.Count > 0);
+        Array<byte> aosData, soaData;
+        aosData.Resize(count * aos.Layout.Size);
+        soaData.Resize(count * soa.Layout.Size);
+        aos.Buffer.GetParticlesCPU(aosData.Get());
+        soa.Buffer.GetParticlesCPU(soaData.Get());
+        CHECK(Platform::MemoryCompare(aosData.Get(), soaData.Get(), aos.Buffer.CPU.Count * aos.Layout.Size) == 0);
+
+        // Linear drag scaled by the sprite size
+        Float3 velocity[5], velocityExpected[5];
+        float mass[5];
+        Float2 spriteSize[5];
+        for (int32 i = 0; i < 5; i++)
+        {
+            velocity[i] = velocityExpected[i] = Float3((float)i, 1.0f, -2.0f);
+            mass[i] = i * 0.5f;
+            spriteSize[i] = Float2(0.5f, (float)i);
+            velocityExpected[i] *= Math::Max(0.0f, 1.0f - (2.0f * spriteSize[i].MulValues() * 0.1f) / Math::Max(mass[i], ZeroTolerance));
+        }
+        ParticleStreams::LinearDrag(velocity, mass, spriteSize, 2.0f, 0.1f, 5);
+        CHECK(Platform::MemoryCompare(velocity, velocityExpected, sizeof(velocity)) == 0);
+
+        // Stream fill
+        Float3 values[7];
+        const Float3 value(1.0f, 2.0f, 3.0f);
+        ParticleStreams::Fill((byte*)values, &value, sizeof(Float3), 7);
+        CHECK(values[0] == value);
+        CHECK(values[6] == value);
+    }
+}
+
+TEST_CASE("Particles Graph")
+{
+    SECTION("Test Module Program")
+    {
+        // Velocity = Lerp(Velocity, Position * Scale.Y + Random Float3, Saturate(NormalizedAge))
+        TestGraph graph;
+        TestParticles attributes(0, ParticleBufferLayout::AoS);
+        auto& scaleParam = graph.Graph.Parameters.AddOne();
+        scaleParam.Identifier = Guid(1, 2, 3, 4);
+        scaleParam.Type = VariantType(VariantType::Float3);
+        scaleParam.Value = Float3(1.0f, 2.0f, 3.0f);
+        auto position = graph.AddNode(14, 101, 1, attributes.Position);
+        auto velocity = graph.AddNode(14, 105, 1, attributes.Velocity);
+        auto normalizedAge = graph.AddNode(14, 110, 1, attributes.Age, attributes.Lifetime);
+        auto scale = graph.AddNode(6, 1, 4);
+        scale->Values.Add(scaleParam.Identifier);
+        auto random = graph.AddNode(14, 210, 1);
+        auto multiply = graph.AddNode(3, 3, 3);
+        multiply->Values.Add(0.0f);
+        multiply->Values.Add(0.0f);
+        auto add = graph.AddNode(3, 1, 3);
+        add->Values.Add(0.0f);
+        add->Values.Add(0.0f);
+        auto saturate = graph.AddNode(3, 14, 2);
+        auto lerp = graph.AddNode(3, 25, 4);
+        lerp->Values.Add(0.0f);
+        lerp->Values.Add(1.0f);
+        lerp->Values.Add(0.5f);
+        auto setVelocity = graph.AddNode(15, 200, 1, attributes.Velocity);
+        setVelocity->UsesParticleData = true;
+        TestGraph::Connect(position, 0, multiply, 0);
+        TestGraph::Connect(scale, 2, multiply, 1);
+        TestGraph::Connect(multiply, 2, add, 0);
+        TestGraph::Connect(random, 0, add, 1);
+        TestGraph::Connect(normalizedAge, 0, saturate, 0);
+        TestGraph::Connect(velocity, 0, lerp, 0);
+        TestGraph::Connect(add, 2, lerp, 1);
+        TestGraph::Connect(saturate, 1, lerp, 2);
+        TestGraph::Connect(lerp, 3, setVelocity, 0);
+        ParticleEmitterGraphCPUProgram program;
+        REQUIRE(!program.Compile(graph.Graph, setVelocity));
+        CHECK(program.Hoisted.Count() == 1);
+        setVelocity->ProgramIndex = graph.Graph.Programs.Count();
+        graph.Graph.Programs.Add(program);
+
+        // Program gives the same results as the per-particle graph evaluation for both layouts (random values are drawn in the same order)
+        constexpr int32 count = 1001;
+        ParticleEmitterGraphCPUExecutor executor(graph.Graph);
+        ParticleEmitterInstance data;
+        data.Parameters.Add(Float3(1.0f, 2.0f, 3.0f));
+        for (int32 i = 0; i < 2; i++)
+        {
+            const ParticleBufferLayout layout = i == 0 ? ParticleBufferLayout::AoS : ParticleBufferLayout::SoA;
+            TestParticles expected(count, layout), particles(count, layout);
+            const int32 programIndex = setVelocity->ProgramIndex;
+            setVelocity->ProgramIndex = -1;
+            data.Buffer = &expected.Buffer;
+            srand(1);
+            executor.UpdateModule(setVelocity, data, 0.1f);
+            setVelocity->ProgramIndex = programIndex;
+            data.Buffer = &particles.Buffer;
+            srand(1);
+            executor.UpdateModule(setVelocity, data, 0.1f);
+            int32 mismatches = 0;
+            for (int32 j = 0; j < count; j++)
+            {
+                if (!Float3::NearEqual(particles.Get<Float3>(particles.Velocity, j), expected.Get<Float3>(expected.Velocity, j), 0.0001f))
+                    mismatches++;
+            }
+            CHECK(mismatches == 0);
+        }
+        data.Buffer = nullptr;
+
+        // Force module adds the scaled value to the velocity (with the hoisted parameter value)
+        auto force = graph.AddNode(15, 301, 1, attributes.Velocity);
+        force->UsesParticleData = true;
+        TestGraph::Connect(multiply, 2, force, 0);
+        REQUIRE(!program.Compile(graph.Graph, force));
+        force->ProgramIndex = graph.Graph.Programs.Count();
+        graph.Graph.Programs.Add(program);
+        TestParticles particles(count, ParticleBufferLayout::SoA);
+        const Float3 velocityBefore = particles.Get<Float3>(particles.Velocity, 500);
+        data.Buffer = &particles.Buffer;
+        executor.UpdateModule(force, data, 0.1f);
+        CHECK(Float3::NearEqual(particles.Get<Float3>(particles.Velocity, 500), velocityBefore + particles.Get<Float3>(particles.Position, 500) * 2.0f * 0.1f, 0.0001f));
+        data.Buffer = nullptr;
+
+        // Every use of the random node draws new values
+        auto randomSum = graph.AddNode(3, 1, 3);
+        randomSum->Values.Add(0.0f);
+        randomSum->Values.Add(0.0f);
+        TestGraph::Connect(random, 0, randomSum, 0);
+        TestGraph::Connect(random, 0, randomSum, 1);
+        auto setPosition = graph.AddNode(15, 200, 1, attributes.Position);
+        TestGraph::Connect(randomSum, 2, setPosition, 0);
+        REQUIRE(!program.Compile(graph.Graph, setPosition));
+        int32 randomInstructions = 0;
+        for (const auto& e : program.Instructions)
+        {
+            if (e.Code == ParticleEmitterGraphCPUProgram::OpCode::Random)
+                randomInstructions++;
+        }
+        CHECK(randomInstructions == 2);
+
+        // Unsupported nodes use per-particle graph evaluation
+        auto function = graph.AddNode(14, 300, 17);
+        function->UsesParticleData = true;
+        auto setMass = graph.AddNode(15, 200, 1, attributes.Mass);
+        TestGraph::Connect(function, 16, setMass, 0);
+        CHECK(program.Compile(graph.Graph, setMass));
+
+        // Particle attribute by index reads the current particle unless the index is connected (then per-particle graph evaluation is used)
+        auto ageByIndex = graph.AddNode(14, 303, 2, attributes.Age, (int32)ParticleAttribute::ValueTypes::Float);
+        ageByIndex->UsesParticleData = true;
+        auto setMassToAge = graph.AddNode(15, 200, 1, attributes.Mass);
+        setMassToAge->UsesParticleData = true;
+        TestGraph::Connect(ageByIndex, 0, setMassToAge, 0);
+        REQUIRE(!program.Compile(graph.Graph, setMassToAge));
+        setMassToAge->ProgramIndex = graph.Graph.Programs.Count();
+        graph.Graph.Programs.Add(program);
+        {
+            TestParticles particles(count, ParticleBufferLayout::SoA);
+            data.Buffer = &particles.Buffer;
+            executor.UpdateModule(setMassToAge, data, 0.1f);
+            CHECK(particles.Get<float>(particles.Mass, 500) == particles.Get<float>(particles.Age, 500));
+        }
+        auto index = graph.AddNode(2, 2, 1);
+        index->Values.Add(7);
+        TestGraph::Connect(index, 0, ageByIndex, 1);
+        CHECK(program.Compile(graph.Graph, setMassToAge));
+        setMassToAge->ProgramIndex = -1;
+        {
+            TestParticles particles(count, ParticleBufferLayout::SoA);
+            data.Buffer = &particles.Buffer;
+            executor.UpdateModule(setMassToAge, data, 0.1f);
+            CHECK(particles.Get<float>(particles.Mass, 500) == particles.Get<float>(particles.Age, 7));
+        }
+        data.Buffer = nullptr;
+    }
+
+    SECTION("Test Module Program Over Life")
+    {
+        // Velocity = Color Gradient(NormalizedAge), Mass = Curve(NormalizedAge) (eg. color and size over life)
+        TestGraph graph;
+        TestParticles attributes(0, ParticleBufferLayout::AoS);
+        auto normalizedAge = graph.AddNode(14, 110, 1, attributes.Age, attributes.Lifetime);
+        auto gradient = graph.AddNode(7, 10, 2);
+        gradient->Values.Add(3);
+        gradient->Values.Add(0.0f);
+        gradient->Values.Add(Color::Red);
+        gradient->Values.Add(0.5f);
+        gradient->Values.Add(Color::Green);
+        gradient->Values.Add(1.0f);
+        gradient->Values.Add(Color::Blue);
+        auto curve = graph.AddNode(7, 12, 2);
+        curve->CurveIndex = graph.Graph.FloatCurves.Count();
+        auto& curveData = graph.Graph.FloatCurves.AddOne();
+        curveData.GetKeyframes().Add(BezierCurveKeyframe<float>(0.0f, 1.0f));
+        curveData.GetKeyframes().Add(BezierCurveKeyframe<float>(0.4f, 4.0f));
+        curveData.GetKeyframes().Add(BezierCurveKeyframe<float>(1.0f, 2.0f));
+        auto setVelocity = graph.AddNode(15, 200, 1, attributes.Velocity);
+        setVelocity->UsesParticleData = true;
+        auto setMass = graph.AddNode(15, 200, 1, attributes.Mass);
+        setMass->UsesParticleData = true;
+        TestGraph::Connect(normalizedAge, 0, gradient, 0);
+        TestGraph::Connect(gradient, 1, setVelocity, 0);
+        TestGraph::Connect(normalizedAge, 0, curve, 0);
+        TestGraph::Connect(curve, 1, setMass, 0);
+        ParticleEmitterGraphCPUProgram program;
+        REQUIRE(!program.Compile(graph.Graph, setVelocity));
+        CHECK(program.Hoisted.Count() == 0);
+        setVelocity->ProgramIndex = graph.Graph.Programs.Count();
+        graph.Graph.Programs.Add(program);
+        REQUIRE(!program.Compile(graph.Graph, setMass));
+        setMass->ProgramIndex = graph.Graph.Programs.Count();
+        graph.Graph.Programs.Add(program);
+
+        // Program gives the same results as the per-particle graph evaluation for both layouts
+        constexpr int32 count = 1001;
+        ParticleEmitterGraphCPUExecutor executor(graph.Graph);
+        ParticleEmitterInstance data;
+        for (int32 i = 0; i < 2; i++)
+        {
+            const ParticleBufferLayout layout = i == 0 ? ParticleBufferLayout::AoS : ParticleBufferLayout::SoA;
+            TestParticles expected(count, layout), particles(count, layout);
+            ParticleEmitterGraphCPUNode* modules[] = { setVelocity, setMass };
+            for (ParticleEmitterGraphCPUNode* module : modules)
+            {
+                const int32 programIndex = module->ProgramIndex;
+                module->ProgramIndex = -1;
+                data.Buffer = &expected.Buffer;
+                executor.UpdateModule(module, data, 0.1f);
+                module->ProgramIndex = programIndex;
+                data.Buffer = &particles.Buffer;
+                executor.UpdateModule(module, data, 0.1f);
+            }
+            int32 mismatches = 0;
+            for (int32 j = 0; j < count; j++)
+            {
+                if (!Float3::NearEqual(particles.Get<Float3>(particles.Velocity, j), expected.Get<Float3>(expected.Velocity, j), 0.0001f) ||
+                    !Math::NearEqual(particles.Get<float>(particles.Mass, j), expected.Get<float>(expected.Mass, j), 0.0001f))
+                    mismatches++;
+            }
+            CHECK(mismatches == 0);
+        }
+        data.Buffer = nullptr;
+    }
+}
+
+TEST_CASE("Particles Benchmark", "[.][benchmark]")
+{
+    SECTION("SoA Update")
+    {
+        // Compare the per-particle update of AoS data against the vectorized update of SoA data
+        constexpr int32 count = 100000, updates = 60;
+        const Float3 gravity(0.0f, -981.0f, 0.0f);
+        float times[2];
+        for (int32 i = 0; i < 2; i++)
+        {
+            TestParticles particles(count, i == 0 ? ParticleBufferLayout::AoS : ParticleBufferLayout::SoA);
+            for (int32 j = 0; j < count; j++)
+                particles.Get<float>(particles.Lifetime, j) = 1000.0f;
+            Stopwatch stopwatch;
+            for (int32 update = 0; update < updates; update++)
+            {
+                if (i == 0)
+                    particles.Update(gravity, 0.5f, 1.0f / 60.0f);
+                else
+                    particles.UpdateStreams(gravity, 0.5f, 1.0f / 60.0f);
+            }
+            stopwatch.Stop();
+            times[i] = stopwatch.GetTotalMilliseconds() / updates;
+        }
+        LOG(Info, "Particles update ({0} particles): AoS: {1} ms, SoA: {2} ms", count, times[0], times[1]);
+    }
+}
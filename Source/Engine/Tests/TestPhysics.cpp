@@ -0,0 +1,225 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Physics/Physics.h"
+#include "Engine/Physics/PhysicsBackend.h"
+#include "Engine/Physics/PhysicsScene.h"
+#if COMPILE_WITH_PHYSX
+#include "Engine/Physics/PhysX/CpuDispatcherPhysX.h"
+#include <ThirdParty/PhysX/task/PxTask.h>
+#endif
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+#if COMPILE_WITH_PHYSX
+    // Task that takes a different time to run (so jobs finish out of order) and counts its executions.
+    class TestTaskPhysX : public PxBaseTask
+    {
+    public:
+        int32 Index = 0;
+        volatile int64* Released = nullptr;
+
+        void run() override
+        {
+            Platform::Sleep(Index % 4);
+        }
+
+        const char* getName() const override
+        {
+            return "TestTaskPhysX";
+        }
+
+        void addReference() override
+        {
+        }
+
+        void removeReference() override
+        {
+        }
+
+        int32_t getReference() const override
+        {
+            return 1;
+        }
+
+        void release() override
+        {
+            Platform::InterlockedIncrement(Released);
+        }
+    };
+#endif
+
+    // Creates a grid of static boxes (spaced by 100 units, 20 units size) at the ground level
+    void CreateBoxes(PhysicsScene* scene, int32 size, Array<void*>& actors)
+    {
+        CollisionShape shape;
+        float halfExtents[3] = { 10.0f, 10.0f, 10.0f };
+        shape.SetBox(halfExtents);
+        for (int32 x = 0; x < size; x++)
+        {
+            for (int32 z = 0; z < size; z++)
+            {
+                void* actor = PhysicsBackend::CreateRigidStaticActor(nullptr, Vector3(x * 100.0f, 0.0f, z * 100.0f), Quaternion::Identity, scene->GetPhysicsScene());
+                void* shapeHandle = PhysicsBackend::CreateShape(nullptr, shape, (JsonAsset*)nullptr, true, false);
+                PhysicsBackend::SetShapeFilterMask(shapeHandle, MAX_uint32, MAX_uint32);
+                PhysicsBackend::AttachShape(shapeHandle, actor);
+                PhysicsBackend::AddSceneActor(scene->GetPhysicsScene(), actor);
+                actors.Add(actor);
+            }
+        }
+    }
+
+    void DeleteBoxes(PhysicsScene* scene, Array<void*>& actors)
+    {
+        for (void* actor : actors)
+        {
+            PhysicsBackend::RemoveSceneActor(scene->GetPhysicsScene(), actor, true);
+            PhysicsBackend::DestroyActor(actor);
+        }
+        actors.Clear();
+        Physics::DeleteScene(scene);
+    }
+
+    // Creates downward raycasts over the grid (every second one misses the boxes)
+    void CreateQueries(int32 size, int32 count, Array<PhysicsQuery>& queries)
+    {
+        queries.Resize(count);
+        for (int32 i = 0; i < count; i++)
+        {
+            PhysicsQuery& query = queries[i];
+            const int32 cell = i % (size * size);
+            const float offset = i % 2 == 0 ? 0.0f : 50.0f;
+            query.Shape = PhysicsQueryShape::Sphere;
+            query.Radius = 2.0f;
+            query.Origin = Vector3((cell / size) * 100.0f + offset, 100.0f, (cell % size) * 100.0f);
+            query.Direction = Vector3::Down;
+            query.Rotation = Quaternion::Identity;
+            query.MaxDistance = 200.0f;
+            query.LayerMask = MAX_uint32;
+            query.HitTriggers = true;
+        }
+    }
+}
+
+TEST_CASE("Physics")
+{
+    SECTION("Test Batched Queries")
+    {
+        constexpr int32 size = 8, count = 1000;
+        PhysicsScene* scene = Physics::FindOrCreateScene(TEXT("TestPhysics"));
+        REQUIRE(scene);
+        Array<void*> actors;
+        CreateBoxes(scene, size, actors);
+        Array<PhysicsQuery> queries;
+        CreateQueries(size, count, queries);
+
+        // Raycasts
+        Array<RayCastHit> hits;
+        hits.Resize(count);
+        CHECK(scene->RayCastBatch(ToSpan(queries), ToSpan(hits)));
+        bool valid = true;
+        for (int32 i = 0; i < count; i++)
+        {
+            const PhysicsQuery& query = queries[i];
+            RayCastHit hit;
+            const bool single = scene->RayCast(query.Origin, query.Direction, hit, query.MaxDistance, query.LayerMask, query.HitTriggers);
+            valid &= single == (i % 2 == 0);
+            valid &= single ? Math::NearEqual(hits[i].Distance, hit.Distance) && hits[i].Point == hit.Point : hits[i].Distance == MAX_float;
+        }
+        CHECK(valid);
+        CHECK(Math::NearEqual(hits[0].Distance, 90.0f));
+
+        // Shape sweeps
+        CHECK(scene->ShapeCastBatch(ToSpan(queries), ToSpan(hits)));
+        valid = true;
+        for (int32 i = 0; i < count; i++)
+        {
+            const PhysicsQuery& query = queries[i];
+            RayCastHit hit;
+            const bool single = scene->SphereCast(query.Origin, query.Radius, query.Direction, hit, query.MaxDistance, query.LayerMask, query.HitTriggers);
+            valid &= single == (i % 2 == 0);
+            valid &= single ? Math::NearEqual(hits[i].Distance, hit.Distance) : hits[i].Distance == MAX_float;
+        }
+        CHECK(valid);
+
+        // Overlaps (at the ground level)
+        for (PhysicsQuery& query : queries)
+            query.Origin.Y = 0.0f;
+        Array<PhysicsColliderActor*> colliders;
+        colliders.Resize(count);
+        CHECK(scene->OverlapBatch(ToSpan(queries), ToSpan(colliders)));
+        CHECK(!scene->OverlapBatch(Span<PhysicsQuery>(queries.Get() + 1, 1), Span<PhysicsColliderActor*>(colliders.Get() + 1, 1)));
+        CHECK(scene->CheckSphere(queries[0].Origin, queries[0].Radius));
+        CHECK(!scene->CheckSphere(queries[1].Origin, queries[1].Radius));
+
+        // Scripting overloads (results array gets resized to match the queries)
+        colliders.Clear();
+        CHECK(scene->OverlapBatch(queries, colliders));
+        CHECK(colliders.Count() == count);
+        CHECK(colliders[0] != nullptr && colliders[1] == nullptr);
+
+        DeleteBoxes(scene, actors);
+    }
+
+#if COMPILE_WITH_PHYSX
+    SECTION("Test CPU Dispatcher Teardown")
+    {
+        // Destroy dispatcher with tasks in flight (it has to wait for all the jobs that access it, not only the last dispatched one)
+        constexpr int32 tasksCount = 64;
+        volatile int64 released = 0;
+        Array<TestTaskPhysX> tasks;
+        tasks.Resize(tasksCount);
+        auto dispatcher = New<CpuDispatcherPhysX>();
+        for (int32 i = 0; i < tasksCount; i++)
+        {
+            tasks[i].Index = tasksCount - i;
+            tasks[i].Released = &released;
+            dispatcher->submitTask(tasks[i]);
+        }
+        Delete(dispatcher);
+        CHECK(Platform::AtomicRead(&released) == tasksCount);
+    }
+#endif
+}
+
+TEST_CASE("Physics Benchmark", "[.][benchmark]")
+{
+    SECTION("Scene Queries")
+    {
+        // Compare many single raycasts against the batched raycasts (executed in parallel)
+        constexpr int32 size = 64, count = 100000;
+        PhysicsScene* scene = Physics::FindOrCreateScene(TEXT("TestPhysicsBenchmark"));
+        REQUIRE(scene);
+        Array<void*> actors;
+        CreateBoxes(scene, size, actors);
+        Array<PhysicsQuery> queries;
+        CreateQueries(size, count, queries);
+        Array<RayCastHit> hits;
+        hits.Resize(count);
+
+        Stopwatch stopwatch;
+        for (int32 i = 0; i < count; i++)
+        {
+            const PhysicsQuery& query = queries[i];
+            scene->RayCast(query.Origin, query.Direction, hits[i], query.MaxDistance, query.LayerMask, query.HitTriggers);
+        }
+        stopwatch.Stop();
+        const float singleTime = stopwatch.GetTotalMilliseconds();
+
+        stopwatch.Start();
+        scene->RayCastBatch(ToSpan(queries), ToSpan(hits));
+        stopwatch.Stop();
+        const float batchTime = stopwatch.GetTotalMilliseconds();
+
+        stopwatch.Start();
+        scene->ShapeCastBatch(ToSpan(queries), ToSpan(hits));
+        stopwatch.Stop();
+        const float sweepBatchTime = stopwatch.GetTotalMilliseconds();
+
+        LOG(Info, "Scene queries ({0} queries, {1} boxes): single raycasts: {2} ms, batched raycasts: {3} ms, batched sphere sweeps: {4} ms", count, actors.Count(), singleTime, batchTime, sweepBatchTime);
+        DeleteBoxes(scene, actors);
+    }
+}
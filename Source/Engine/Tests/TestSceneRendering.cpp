@@ -0,0 +1,324 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Utilities.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Types/Stopwatch.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/FrustumCulling.h"
+#include "Engine/Level/Scene/SceneRenderingBVH.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    BoundingSphere RandomSphere(RandomStream& rand, float extent)
+    {
+        return BoundingSphere(Vector3(rand.GetFraction() * extent, rand.GetFraction() * 100.0f, rand.GetFraction() * extent), 1.0f + rand.GetFraction() * 20.0f);
+    }
+
+    BoundingFrustum CreateFrustum(const Vector3& position, const Vector3& direction, float farPlane)
+    {
+        Matrix view, projection, viewProjection;
+        Matrix::LookAt(position, position + direction, Vector3::Up, view);
+        Matrix::PerspectiveFov(PI * 0.4f, 16.0f / 9.0f, 10.0f, farPlane, projection);
+        Matrix::Multiply(view, projection, viewProjection);
+        return BoundingFrustum(viewProjection);
+    }
+
+    bool FrustumsListCull(const BoundingSphere& bounds, const BoundingFrustum* frustums, int32 frustumsCount)
+    {
+        for (int32 i = 0; i < frustumsCount; i++)
+        {
+            if (frustums[i].Intersects(bounds))
+                return true;
+        }
+        return false;
+    }
+
+    struct CullResult
+    {
+        Array<int32>* Visible;
+        const Array<BoundingSphere>* Bounds;
+        const BoundingFrustum* Frustums;
+        int32 FrustumsCount;
+
+        void operator()(int32 item, uint64 frustumsMask)
+        {
+            if (frustumsMask != 0)
+            {
+                // Test the actual bounds like scene rendering does
+                bool visible = false;
+                for (int32 i = 0; i < FrustumsCount && !visible; i++)
+                    visible = (frustumsMask & (1ull << i)) != 0 && Frustums[i].Intersects(Bounds->At(item));
+                if (!visible)
+                    return;
+            }
+            Visible->Add(item);
+        }
+    };
+
+    void CullTree(const SceneRenderingBVH& tree, const Array<BoundingSphere>& bounds, const BoundingFrustum* frustums, int32 frustumsCount, Array<int32>& visible)
+    {
+        Array<SceneRenderingBVH::CullNode> subtrees;
+        tree.CullSubtrees(frustums, frustumsCount, Vector3::Zero, 32, subtrees);
+        CullResult result = { &visible, &bounds, frustums, frustumsCount };
+        for (const auto& subtree : subtrees)
+            tree.Cull(subtree, frustums, frustumsCount, Vector3::Zero, result);
+    }
+
+    void CullSpheres(const FrustumCulling::Spheres& spheres, int32 count, const Vector3& origin, const Float4* planes, int32 frustumsCount, uint32 layerMask, Array<int32>& visible)
+    {
+        for (int32 start = 0; start < count; start += FrustumCulling::ChunkSize)
+        {
+            uint64 mask = FrustumCulling::Cull(spheres, start, origin, planes, frustumsCount, layerMask);
+            while (mask != 0)
+            {
+                visible.Add(start + (int32)Utilities::LowestSetBit64(mask));
+                mask &= mask - 1;
+            }
+        }
+    }
+}
+
+TEST_CASE("SceneRendering")
+{
+    SECTION("Test BVH")
+    {
+        // Build tree and randomly modify it
+        RandomStream rand(100);
+        Array<BoundingSphere> bounds;
+        Array<int32> leaves;
+        SceneRenderingBVH tree;
+        for (int32 i = 0; i < 2000; i++)
+        {
+            bounds.Add(RandomSphere(rand, 5000.0f));
+            leaves.Add(tree.Add(bounds[i], i));
+        }
+        for (int32 i = 0; i < 500; i++)
+        {
+            const int32 index = rand.RandRange(0, bounds.Count() - 1);
+            bounds[index] = RandomSphere(rand, 5000.0f);
+            tree.Update(leaves[index], bounds[index]);
+        }
+        for (int32 i = 0; i < 2000; i += 3)
+        {
+            tree.Remove(leaves[i]);
+            leaves[i] = -1;
+        }
+        CHECK(tree.GetLeavesCount() == 2000 - 667);
+        CHECK(tree.GetHeight() < 32);
+
+        // Compare culling results with the linear scan
+        BoundingFrustum frustums[3];
+        frustums[0] = CreateFrustum(Vector3(2500, 50, -100), Vector3::Forward, 3000.0f);
+        frustums[1] = CreateFrustum(Vector3(0, 50, 0), Vector3(1, 0, 1).GetNormalized(), 2000.0f);
+        frustums[2] = CreateFrustum(Vector3(5000, 500, 5000), Vector3(-1, -0.2f, -1).GetNormalized(), 10000.0f);
+        for (int32 frustumsCount = 1; frustumsCount <= ARRAY_COUNT(frustums); frustumsCount++)
+        {
+            Array<int32> expected, visible;
+            for (int32 i = 0; i < bounds.Count(); i++)
+            {
+                if (leaves[i] != -1 && FrustumsListCull(bounds[i], frustums, frustumsCount))
+                    expected.Add(i);
+            }
+            CullTree(tree, bounds, frustums, frustumsCount, visible);
+            Sorting::QuickSort(visible);
+            CHECK(expected.Count() != 0);
+            CHECK(visible == expected);
+        }
+
+        tree.Clear();
+        CHECK(tree.GetLeavesCount() == 0);
+        CHECK(tree.GetRoot() == -1);
+    }
+
+    SECTION("Test Frustum Culling")
+    {
+        // Build spheres with different layers (count not aligned to the chunk size)
+        constexpr int32 count = 1000;
+        RandomStream rand(100);
+        Array<BoundingSphere> bounds;
+        FrustumCulling::Spheres spheres;
+        spheres.Resize(count);
+        CHECK(spheres.Count() == 1024);
+        for (int32 i = 0; i < count; i++)
+        {
+            bounds.Add(RandomSphere(rand, 5000.0f));
+            spheres.Set(i, bounds[i], 1 << (i % 3), i == 10);
+        }
+
+        // Compare culling results with the scalar test (including view origin offset)
+        BoundingFrustum frustums[3];
+        frustums[0] = CreateFrustum(Vector3(2500, 50, -100), Vector3::Forward, 3000.0f);
+        frustums[1] = CreateFrustum(Vector3(0, 50, 0), Vector3(1, 0, 1).GetNormalized(), 2000.0f);
+        frustums[2] = CreateFrustum(Vector3(5000, 500, 5000), Vector3(-1, -0.2f, -1).GetNormalized(), 10000.0f);
+        const Vector3 origin(1000, 0, 2000);
+        Float4 planes[ARRAY_COUNT(frustums) * 6];
+        for (int32 frustumsCount = 1; frustumsCount <= ARRAY_COUNT(frustums); frustumsCount++)
+        {
+            for (const uint32 layerMask : { MAX_uint32, 1u | 4u })
+            {
+                for (const Vector3& viewOrigin : { Vector3::Zero, origin })
+                {
+                    Array<int32> expected, visible;
+                    for (int32 i = 0; i < count; i++)
+                    {
+                        BoundingSphere sphere = bounds[i];
+                        sphere.Center -= viewOrigin;
+                        if ((layerMask & (1 << (i % 3))) && (i == 10 || FrustumsListCull(sphere, frustums, frustumsCount)))
+                            expected.Add(i);
+                    }
+                    FrustumCulling::GetPlanes(frustums, frustumsCount, planes);
+                    CullSpheres(spheres, spheres.Count(), viewOrigin, planes, frustumsCount, layerMask, visible);
+                    CHECK(expected.Count() != 0);
+                    CHECK(visible == expected);
+                }
+            }
+        }
+    }
+
+    SECTION("Test Frustum Culling Large Coordinates")
+    {
+        // Place the small spheres far from the world origin, right next to the frustum planes, so float centers would flip the results
+#if USE_LARGE_WORLDS
+        const Vector3 origin(1000000000.0, 0.0, -1000000000.0);
+#else
+        const Vector3 origin(100000.0f, 0.0f, -100000.0f);
+#endif
+        const BoundingFrustum frustum = CreateFrustum(Vector3::Zero, Vector3::Forward, 1000.0f);
+        Array<BoundingSphere> bounds;
+        for (int32 i = 0; i < 50; i++)
+        {
+            const float offset = 1.0f + (float)(i % 5) * 0.1f;
+            const float x = (float)(i - 25) * 0.5f;
+            bounds.Add(BoundingSphere(origin + Vector3(x, 0, 1000.0f + offset), 0.5f)); // Behind the far plane
+            bounds.Add(BoundingSphere(origin + Vector3(x, 0, 1000.0f - offset), 0.5f)); // Before the far plane
+            bounds.Add(BoundingSphere(origin + Vector3(0, x * 0.1f, 10.0f - offset), 0.5f)); // Before the near plane
+            bounds.Add(BoundingSphere(origin + Vector3(0, x * 0.1f, 10.0f + offset), 0.5f)); // Behind the near plane
+        }
+        FrustumCulling::Spheres spheres;
+        spheres.Resize(bounds.Count());
+        for (int32 i = 0; i < bounds.Count(); i++)
+            spheres.Set(i, bounds[i], 1);
+
+        Array<int32> expected, visible;
+        for (int32 i = 0; i < bounds.Count(); i++)
+        {
+            BoundingSphere sphere = bounds[i];
+            sphere.Center -= origin;
+            if (frustum.Intersects(sphere))
+                expected.Add(i);
+        }
+        Float4 planes[6];
+        FrustumCulling::GetPlanes(&frustum, 1, planes);
+        CullSpheres(spheres, spheres.Count(), origin, planes, 1, MAX_uint32, visible);
+        CHECK(expected.Count() == bounds.Count() / 2);
+        CHECK(visible == expected);
+    }
+}
+
+TEST_CASE("SceneRendering Benchmark", "[.][benchmark]")
+{
+    SECTION("Culling")
+    {
+        // Compare the culling tree against the linear scan for a big scene with multiple views (eg. shadow cascades)
+        constexpr int32 count = 200000;
+        RandomStream rand(100);
+        Array<BoundingSphere> bounds;
+        Array<int32> leaves;
+        bounds.Resize(count);
+        leaves.Resize(count);
+        SceneRenderingBVH tree;
+        Stopwatch buildStopwatch;
+        for (int32 i = 0; i < count; i++)
+        {
+            bounds[i] = RandomSphere(rand, 200000.0f);
+            leaves[i] = tree.Add(bounds[i], i);
+        }
+        buildStopwatch.Stop();
+        LOG(Info, "Culling tree build: {0} ms, height: {1}", buildStopwatch.GetTotalMilliseconds(), tree.GetHeight());
+
+        BoundingFrustum frustums[5];
+        frustums[0] = CreateFrustum(Vector3(100000, 200, 0), Vector3::Forward, 30000.0f);
+        for (int32 i = 1; i < ARRAY_COUNT(frustums); i++)
+            frustums[i] = CreateFrustum(Vector3(100000, 200, 0), Vector3::Forward, 2000.0f * (float)(i * i));
+        for (int32 frustumsCount : { 1, (int32)ARRAY_COUNT(frustums) })
+        {
+            Array<int32> visible;
+            Stopwatch stopwatch;
+            for (int32 i = 0; i < count; i++)
+            {
+                if (FrustumsListCull(bounds[i], frustums, frustumsCount))
+                    visible.Add(i);
+            }
+            stopwatch.Stop();
+            const float linearTime = stopwatch.GetTotalMilliseconds();
+            const int32 linearVisible = visible.Count();
+
+            visible.Clear();
+            stopwatch.Start();
+            CullTree(tree, bounds, frustums, frustumsCount, visible);
+            stopwatch.Stop();
+            const float treeTime = stopwatch.GetTotalMilliseconds();
+            CHECK(visible.Count() == linearVisible);
+            LOG(Info, "Frustums: {0}, visible: {1}, linear scan: {2} ms, tree: {3} ms", frustumsCount, linearVisible, linearTime, treeTime);
+        }
+
+        // Measure the cost of moving objects
+        Stopwatch updateStopwatch;
+        for (int32 i = 0; i < count; i += 10)
+        {
+            bounds[i].Center += Vector3(rand.GetFraction() * 100.0f, 0.0f, rand.GetFraction() * 100.0f);
+            tree.Update(leaves[i], bounds[i]);
+        }
+        updateStopwatch.Stop();
+        LOG(Info, "Culling tree update of {0} objects: {1} ms", count / 10, updateStopwatch.GetTotalMilliseconds());
+    }
+
+    SECTION("Frustum Culling")
+    {
+        // Compare the vectorized culling against the scalar test for many objects in view (eg. dense city or forest)
+        constexpr int32 count = 200000;
+        RandomStream rand(100);
+        Array<BoundingSphere> bounds;
+        FrustumCulling::Spheres spheres;
+        bounds.Resize(count);
+        spheres.Resize(count);
+        for (int32 i = 0; i < count; i++)
+        {
+            bounds[i] = RandomSphere(rand, 20000.0f);
+            spheres.Set(i, bounds[i], 1);
+        }
+
+        BoundingFrustum frustums[5];
+        frustums[0] = CreateFrustum(Vector3(10000, 200, 0), Vector3::Forward, 20000.0f);
+        for (int32 i = 1; i < ARRAY_COUNT(frustums); i++)
+            frustums[i] = CreateFrustum(Vector3(10000, 200, 0), Vector3::Forward, 2000.0f * (float)(i * i));
+        Float4 planes[ARRAY_COUNT(frustums) * 6];
+        for (int32 frustumsCount : { 1, (int32)ARRAY_COUNT(frustums) })
+        {
+            Array<int32> visible;
+            visible.EnsureCapacity(count);
+            Stopwatch stopwatch;
+            for (int32 i = 0; i < count; i++)
+            {
+                if (FrustumsListCull(bounds[i], frustums, frustumsCount))
+                    visible.Add(i);
+            }
+            stopwatch.Stop();
+            const float scalarTime = stopwatch.GetTotalMilliseconds();
+            const int32 scalarVisible = visible.Count();
+
+            visible.Clear();
+            stopwatch.Start();
+            FrustumCulling::GetPlanes(frustums, frustumsCount, planes);
+            CullSpheres(spheres, count, Vector3::Zero, planes, frustumsCount, MAX_uint32, visible);
+            stopwatch.Stop();
+            const float simdTime = stopwatch.GetTotalMilliseconds();
+            CHECK(visible.Count() == scalarVisible);
+            LOG(Info, "Frustums: {0}, visible: {1}, scalar: {2} ms, vectorized: {3} ms", frustumsCount, scalarVisible, scalarTime, simdTime);
+        }
+    }
+}
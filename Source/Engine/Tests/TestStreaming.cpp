@@ -0,0 +1,166 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#include "Engine/Streaming/StreamableResource.h"
+#include "Engine/Streaming/StreamingBudget.h"
+#include "Engine/Streaming/StreamingGroup.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    class TestStreamingHandler : public IStreamingHandler
+    {
+    public:
+        float CalculateTargetQuality(StreamableResource* resource, double currentTime) override
+        {
+            return 1.0f;
+        }
+
+        int32 CalculateResidency(StreamableResource* resource, float quality) override
+        {
+            return (int32)(quality * (float)resource->GetMaxResidency());
+        }
+
+        int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override
+        {
+            return targetResidency;
+        }
+    };
+
+    // Resource with mip-like memory usage (each residency level doubles the size).
+    class TestStreamableResource : public StreamableResource
+    {
+    public:
+        TestStreamableResource(StreamingGroup* group)
+            : StreamableResource(group)
+        {
+        }
+
+        int32 GetMaxResidency() const override
+        {
+            return 4;
+        }
+
+        int32 GetCurrentResidency() const override
+        {
+            return 4;
+        }
+
+        int32 GetAllocatedResidency() const override
+        {
+            return 4;
+        }
+
+        uint64 GetResidencyMemoryUsage(int32 residency) const override
+        {
+            return (1ull << residency) - 1;
+        }
+
+        bool CanBeUpdated() const override
+        {
+            return true;
+        }
+
+        Task* UpdateAllocation(int32 residency) override
+        {
+            return nullptr;
+        }
+
+        Task* CreateStreamingTask(int32 residency) override
+        {
+            return nullptr;
+        }
+
+        void CancelStreamingTasks() override
+        {
+        }
+    };
+
+    StreamingBudget::Item CreateItem(StreamableResource* resource, int32 groupIndex, float priority, int32 minResidency = 0)
+    {
+        StreamingBudget::Item item;
+        item.Resource = resource;
+        item.GroupIndex = groupIndex;
+        item.QualityResidency = item.Residency = resource->GetMaxResidency();
+        item.MinResidency = minResidency;
+        item.QualityMemory = item.Memory = resource->GetResidencyMemoryUsage(item.Residency);
+        item.Priority = priority;
+        return item;
+    }
+}
+
+TEST_CASE("Streaming")
+{
+    TestStreamingHandler handler;
+    StreamingGroup group(StreamingGroup::Type::Custom, &handler);
+    TestStreamableResource a(&group), b(&group), c(&group);
+
+    SECTION("Test Memory Budget")
+    {
+        // Fits into the budget
+        Array<StreamingBudget::Item> items;
+        items.Add(CreateItem(&a, 0, 1.0f));
+        items.Add(CreateItem(&b, 0, 2.5f));
+        items.Add(CreateItem(&c, 0, 10.0f));
+        CHECK(StreamingBudget::Apply(items, -1, 45, 45) == 45);
+        CHECK(items[0].Residency == 4);
+        CHECK(items[1].Residency == 4);
+        CHECK(items[2].Residency == 4);
+
+        // Over the budget
+        CHECK(StreamingBudget::Apply(items, -1, 45, 30) == 25);
+        CHECK(items[0].Residency == 2);
+        CHECK(items[0].Memory == 3);
+        CHECK(items[1].Residency == 3);
+        CHECK(items[1].Memory == 7);
+        CHECK(items[2].Residency == 4);
+        CHECK(items[2].Memory == 15);
+
+        // Budget that cannot be reached stops at the lowest residency
+        items.Clear();
+        items.Add(CreateItem(&a, 0, 1.0f, 1));
+        items.Add(CreateItem(&b, 0, 2.5f, 2));
+        items.Add(CreateItem(&c, 0, 10.0f, 4));
+        CHECK(StreamingBudget::Apply(items, -1, 45, 0) == 1 + 3 + 15);
+        CHECK(items[0].Residency == 1);
+        CHECK(items[1].Residency == 2);
+        CHECK(items[2].Residency == 4);
+
+        // Group budget affects only that group
+        items.Clear();
+        items.Add(CreateItem(&a, 0, 1.0f));
+        items.Add(CreateItem(&b, 1, 2.5f));
+        items.Add(CreateItem(&c, 1, 6.0f));
+        CHECK(StreamingBudget::Apply(items, 1, 30, 15) == 10);
+        CHECK(items[0].Residency == 4);
+        CHECK(items[1].Residency == 2);
+        CHECK(items[2].Residency == 3);
+    }
+
+    SECTION("Test Eviction Order")
+    {
+        // Lower budget step by step and check that levels are removed from the least important resource first, while each next level removed from the same resource weighs more
+        Array<StreamingBudget::Item> items;
+        items.Add(CreateItem(&a, 0, 1.0f));
+        items.Add(CreateItem(&b, 0, 3.5f));
+        items.Add(CreateItem(&c, 0, 5.0f));
+        const int32 expected[][3] =
+        {
+            { 3, 4, 4 }, // a (key 1)
+            { 2, 4, 4 }, // a (key 2)
+            { 1, 4, 4 }, // a (key 3)
+            { 1, 3, 4 }, // b (key 3.5)
+            { 0, 3, 4 }, // a (key 4)
+            { 0, 3, 3 }, // c (key 5)
+            { 0, 2, 3 }, // b (key 7)
+            { 0, 2, 2 }, // c (key 10)
+        };
+        uint64 memory = 45;
+        for (int32 step = 0; step < ARRAY_COUNT(expected); step++)
+        {
+            memory = StreamingBudget::Apply(items, -1, memory, memory - 1);
+            CHECK(items[0].Residency == expected[step][0]);
+            CHECK(items[1].Residency == expected[step][1]);
+            CHECK(items[2].Residency == expected[step][2]);
+        }
+    }
+}
@@ -21,6 +21,8 @@ public override void Setup(BuildOptions options)
         base.Setup(options);
 
         options.PrivateDependencies.Add("ModelTool");
+        if (Physics.WithPhysX)
+            options.PrivateDependencies.Add("PhysX");
     }
 
     /// <inheritdoc />
@@ -0,0 +1,130 @@
+// Copyright (c) Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Platform/Platform.h"
+
+/// <summary>
+/// The priority class of the job (or thread pool task). Threads pick the jobs from the higher classes first.
+/// </summary>
+API_ENUM() enum class JobPriority : byte
+{
+    /// <summary>
+    /// The latency-critical work that current frame depends on (eg. culling, animation).
+    /// </summary>
+    FrameCritical = 0,
+
+    /// <summary>
+    /// The default priority.
+    /// </summary>
+    Normal = 1,
+
+    /// <summary>
+    /// The low-priority work that is not time-critical (eg. navmesh building). Yields to the frame work when frame deadline is near.
+    /// </summary>
+    Background = 2,
+
+    API_ENUM(Attributes="HideInEditor")
+    MAX
+};
+
+/// <summary>
+/// The statistics of the jobs queue of a single priority class.
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API JobPriorityStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(JobPriorityStats);
+
+    /// <summary>
+    /// The amount of queued jobs that have not been started yet.
+    /// </summary>
+    API_FIELD() int32 QueueDepth;
+
+    /// <summary>
+    /// The amount of jobs started (since the last stats reset).
+    /// </summary>
+    API_FIELD() int32 Started;
+
+    /// <summary>
+    /// The average time between queueing and starting the job (in milliseconds, since the last stats reset).
+    /// </summary>
+    API_FIELD() float LatencyAvgMs;
+
+    /// <summary>
+    /// The maximum time between queueing and starting the job (in milliseconds, since the last stats reset).
+    /// </summary>
+    API_FIELD() float LatencyMaxMs;
+};
+
+/// <summary>
+/// The statistics of the jobs queues for all priority classes.
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API JobQueueStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(JobQueueStats);
+
+    /// <summary>
+    /// The frame-critical jobs stats.
+    /// </summary>
+    API_FIELD() JobPriorityStats FrameCritical;
+
+    /// <summary>
+    /// The normal jobs stats.
+    /// </summary>
+    API_FIELD() JobPriorityStats Normal;
+
+    /// <summary>
+    /// The background jobs stats.
+    /// </summary>
+    API_FIELD() JobPriorityStats Background;
+};
+
+/// <summary>
+/// Thread-safe counters used to gather the jobs queue statistics of a single priority class.
+/// </summary>
+struct JobPriorityCounters
+{
+    volatile int64 Queued = 0;
+    volatile int64 Started = 0;
+    volatile int64 LatencySum = 0;
+    volatile int64 LatencyMax = 0;
+
+    FORCE_INLINE void OnQueued()
+    {
+        Platform::InterlockedIncrement(&Queued);
+    }
+
+    void OnStarted(double queueTime)
+    {
+        const int64 latency = (int64)((Platform::GetTimeSeconds() - queueTime) * 1000000.0); // In microseconds
+        Platform::InterlockedDecrement(&Queued);
+        Platform::InterlockedIncrement(&Started);
+        Platform::InterlockedAdd(&LatencySum, latency);
+        int64 latencyMax = Platform::AtomicRead(&LatencyMax);
+        while (latency > latencyMax && Platform::InterlockedCompareExchange(&LatencyMax, latency, latencyMax) != latencyMax)
+            latencyMax = Platform::AtomicRead(&LatencyMax);
+    }
+
+    void Get(JobPriorityStats& result, bool reset)
+    {
+        const int64 started = Platform::AtomicRead(&Started);
+        result.QueueDepth = (int32)Platform::AtomicRead(&Queued);
+        result.Started = (int32)started;
+        result.LatencyAvgMs = started > 0 ? (float)((double)Platform::AtomicRead(&LatencySum) / (double)started / 1000.0) : 0.0f;
+        result.LatencyMaxMs = (float)((double)Platform::AtomicRead(&LatencyMax) / 1000.0);
+        if (reset)
+        {
+            Platform::AtomicStore(&Started, 0);
+            Platform::AtomicStore(&LatencySum, 0);
+            Platform::AtomicStore(&LatencyMax, 0);
+        }
+    }
+
+    static void Get(JobPriorityCounters counters[(int32)JobPriority::MAX], JobQueueStats& result, bool reset)
+    {
+        counters[(int32)JobPriority::FrameCritical].Get(result.FrameCritical, reset);
+        counters[(int32)JobPriority::Normal].Get(result.Normal, reset);
+        counters[(int32)JobPriority::Background].Get(result.Background, reset);
+    }
+};
@@ -2,10 +2,12 @@
 
 #include "JobSystem.h"
 #include "IRunnable.h"
+#include "ConcurrentQueue.h"
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/Thread.h"
 #include "Engine/Platform/ConditionVariable.h"
 #include "Engine/Core/Types/Span.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Profiler/ProfilerMemory.h"
@@ -16,6 +18,14 @@
 
 #define JOB_SYSTEM_ENABLED (PLATFORM_THREADS_LIMIT > 1)
 
+// Job contexts are allocated in chunks (on demand) up to the limit. Label holds the context index in the lowest bits.
+#define JOB_CONTEXTS_CHUNK 256
+#define JOB_CONTEXTS_MAX_BITS 16
+#define JOB_CONTEXTS_MAX (1 << JOB_CONTEXTS_MAX_BITS)
+
+// The time window (in seconds) before the frame deadline during which background jobs are paused to let the frame work finish.
+#define JOB_FRAME_DEADLINE_MARGIN 0.002
+
 #if JOB_SYSTEM_ENABLED
 
 class JobSystemService : public EngineService
@@ -34,24 +44,122 @@ class JobSystemService : public EngineService
 // Holds a single job dispatch data
 struct alignas(int64) JobContext
 {
-    // The next index of the job to process updated when picking a job by the thread.
-    volatile int64 JobIndex = 0;
     // The number of jobs left to process updated after job completion by the thread.
     volatile int64 JobsLeft = 0;
     // The unique label of this job used to identify it. Set to -1 when job is done.
     volatile int64 JobLabel = 0;
-    // Utility atomic counter used to indicate that any job is waiting for this one to finish. Then Dependants can be accessed within thread-safe JobsLocker.
-    volatile int64 DependantsCount = 0;
-    // The number of dependency jobs left to be finished before starting this job.
+    // The number of dependency jobs left to be finished before starting this job (plus one guard reference held by the dispatching thread).
     volatile int64 DependenciesLeft = 0;
+    // The index of this context in the contexts pool.
+    int32 Index = 0;
     // The total number of jobs to process (in this context).
     int32 JobsCount = 0;
+    // The maximum amount of job indices executed in a single batch by the thread (larger ranges are split to allow stealing).
+    int32 BatchSize = 1;
+    // The priority class of the job.
+    JobPriority Priority = JobPriority::Normal;
+    // Set to 1 when the first job has been started (used for the queue latency stats).
+    volatile int64 Started = 0;
+    // The time when job has been queued for the execution (in seconds).
+    double QueueTime = 0.0;
     // The job function to execute.
     Function<void(int32)> Job;
-    // List of dependant jobs to signal when this job is done.
+    // List of dependant jobs to signal when this job is done. Accessed within thread-safe JobsLocker.
     Array<int64> Dependants;
 };
 
+// Holds a range of job indices [Start; End) to execute within a single job context
+struct JobRange
+{
+    JobContext* Context;
+    int32 Start;
+    int32 End;
+};
+
+// Lock-free work-stealing double-ended queue (Chase-Lev). Owner thread pushes and pops at the bottom, other threads steal from the top.
+struct JobQueue
+{
+    static constexpr int64 Capacity = 1024;
+    static constexpr int64 Mask = Capacity - 1;
+
+    volatile int64 Top = 0;
+    volatile int64 Bottom = 0;
+    JobRange Items[Capacity];
+
+    // Adds the item at the bottom of the queue. Can be called only by the owner thread. Returns false if queue is full.
+    bool Push(const JobRange& item)
+    {
+        const int64 bottom = Platform::AtomicRead(&Bottom);
+        const int64 top = Platform::AtomicRead(&Top);
+        if (bottom - top >= Capacity)
+            return false;
+        Items[bottom & Mask] = item;
+        Platform::AtomicStore(&Bottom, bottom + 1);
+        return true;
+    }
+
+    // Removes the item from the bottom of the queue. Can be called only by the owner thread.
+    bool Pop(JobRange& item)
+    {
+        const int64 bottom = Platform::AtomicRead(&Bottom) - 1;
+        Platform::AtomicStore(&Bottom, bottom);
+        const int64 top = Platform::AtomicRead(&Top);
+        if (top > bottom)
+        {
+            // Empty
+            Platform::AtomicStore(&Bottom, bottom + 1);
+            return false;
+        }
+        item = Items[bottom & Mask];
+        if (top != bottom)
+            return true;
+
+        // Last item so race against the thieves
+        const bool result = Platform::InterlockedCompareExchange(&Top, top + 1, top) == top;
+        Platform::AtomicStore(&Bottom, bottom + 1);
+        return result;
+    }
+
+    // Removes the item from the top of the queue. Can be called from any thread.
+    bool Steal(JobRange& item)
+    {
+        const int64 top = Platform::AtomicRead(&Top);
+        const int64 bottom = Platform::AtomicRead(&Bottom);
+        if (top >= bottom)
+            return false;
+
+        // Item copy might be torn if owner wrapped around the buffer meanwhile but then exchange fails and item is discarded
+        item = Items[top & Mask];
+        return Platform::InterlockedCompareExchange(&Top, top + 1, top) == top;
+    }
+
+    // Gets the context of the item at the top of the queue (the next one to be stolen). Result is approximate as queue can be modified concurrently.
+    const JobContext* PeekContext() const
+    {
+        const int64 top = Platform::AtomicRead(&Top);
+        if (top >= Platform::AtomicRead(&Bottom))
+            return nullptr;
+        return Items[top & Mask].Context;
+    }
+
+    bool IsEmpty() const
+    {
+        return Platform::AtomicRead(&Bottom) - Platform::AtomicRead(&Top) <= 0;
+    }
+};
+
+// Holds a single job system worker thread data
+struct alignas(PLATFORM_CACHE_LINE_SIZE) JobSystemWorker
+{
+    // Per-priority queues of the jobs.
+    JobQueue Queues[(int32)JobPriority::MAX];
+    // Set to 1 when thread is sleeping and waits for a signal (waker flips it back to 0).
+    volatile int64 Sleeping = 0;
+    uint32 RandomSeed = 0;
+    CriticalSection SleepMutex;
+    ConditionVariable SleepSignal;
+};
+
 class JobSystemThread : public IRunnable
 {
 public:
@@ -76,38 +184,72 @@ namespace
 {
     JobSystemService JobSystemInstance;
     Thread* Threads[(PLATFORM_THREADS_LIMIT + 1) / 2] = {};
+    JobSystemWorker* Workers = nullptr;
     int32 ThreadsCount = 0;
     bool JobStartingOnDispatch = true;
     volatile int64 ExitFlag = 0;
     volatile int64 JobLabel = 0;
-    volatile int64 JobEndLabel = 0;
-    volatile int64 JobStartLabel = 0;
     volatile int64 JobContextsCount = 0;
-    uint32 JobContextsSize = 0;
-    uint32 JobContextsMask = 0;
-    JobContext* JobContexts = nullptr;
-    ConditionVariable JobsSignal;
-    CriticalSection JobsMutex;
+    volatile int64 JobContextsPeak = 0;
+    volatile int64 JobContextsCapacity = 0;
+    volatile int64 JobContextsOverflows = 0;
+    volatile int64 SleepingCount = 0;
+    volatile int64 WakeIndex = 0;
+    volatile int64 BackgroundWaiters = 0;
+    double FrameDeadline = 0.0;
+    JobPriorityCounters JobCounters[(int32)JobPriority::MAX];
+    JobContext* JobContextsChunks[JOB_CONTEXTS_MAX / JOB_CONTEXTS_CHUNK] = {};
+    ConcurrentQueue<int32> JobContextsFree;
+    CriticalSection JobContextsLocker;
+    ConcurrentQueue<JobRange> GlobalQueues[(int32)JobPriority::MAX];
     ConditionVariable WaitSignal;
     CriticalSection WaitMutex;
     CriticalSection JobsLocker;
-#define GET_CONTEXT_INDEX(label) (uint32)((label) & (int64)JobContextsMask)
+    THREADLOCAL JobSystemWorker* ThisWorker = nullptr;
+#define GET_CONTEXT(label) JobContextsChunks[(int32)((label) & (JOB_CONTEXTS_MAX - 1)) / JOB_CONTEXTS_CHUNK][(int32)((label) & (JOB_CONTEXTS_MAX - 1)) % JOB_CONTEXTS_CHUNK]
+}
+
+// Allocates a new chunk of job contexts and adds them to the free list. Called within JobContextsLocker. Returns false if limit has been reached.
+bool AllocateContextsChunk()
+{
+    const int32 chunkIndex = (int32)(JobContextsCapacity / JOB_CONTEXTS_CHUNK);
+    if (chunkIndex >= ARRAY_COUNT(JobContextsChunks))
+        return false;
+    PROFILE_MEM(EngineThreading);
+    auto chunk = (JobContext*)Platform::Allocate(JOB_CONTEXTS_CHUNK * sizeof(JobContext), alignof(JobContext));
+    Memory::ConstructItems(chunk, JOB_CONTEXTS_CHUNK);
+    int32 indices[JOB_CONTEXTS_CHUNK];
+    for (int32 i = 0; i < JOB_CONTEXTS_CHUNK; i++)
+    {
+        const int32 index = chunkIndex * JOB_CONTEXTS_CHUNK + i;
+        chunk[i].Index = index;
+        indices[i] = index;
+    }
+    JobContextsChunks[chunkIndex] = chunk;
+    Platform::MemoryBarrier();
+    JobContextsFree.enqueue_bulk(indices, JOB_CONTEXTS_CHUNK);
+    Platform::AtomicStore(&JobContextsCapacity, JobContextsCapacity + JOB_CONTEXTS_CHUNK);
+    return true;
 }
 
 bool JobSystemService::Init()
 {
     PROFILE_MEM(EngineThreading);
 
-    // Initialize job context storage (fixed-size ring buffer for active jobs tracking)
-    JobContextsSize = 256;
-    JobContextsMask = JobContextsSize - 1;
-    JobContexts = (JobContext*)Platform::Allocate(JobContextsSize * sizeof(JobContext), alignof(JobContext));
-    Memory::ConstructItems(JobContexts, (int32)JobContextsSize);
+    // Initialize job context storage (pool of contexts for active jobs tracking, grows when needed)
+    JobContextsLocker.Lock();
+    AllocateContextsChunk();
+    JobContextsLocker.Unlock();
 
-    // Spawn threads
+    // Initialize per-thread work queues
     ThreadsCount = Math::Min<int32>(Platform::GetCPUInfo().LogicalProcessorCount, ARRAY_COUNT(Threads));
+    Workers = (JobSystemWorker*)Platform::Allocate(ThreadsCount * sizeof(JobSystemWorker), alignof(JobSystemWorker));
+    Memory::ConstructItems(Workers, ThreadsCount);
+
+    // Spawn threads
     for (int32 i = 0; i < ThreadsCount; i++)
     {
+        Workers[i].RandomSeed = 0x9E3779B9u * (uint32)(i + 1);
         auto runnable = New<JobSystemThread>();
         runnable->Index = (uint64)i;
         auto thread = Thread::Create(runnable, String::Format(TEXT("Job System {0}"), i), ThreadPriority::AboveNormal);
@@ -119,16 +261,28 @@ bool JobSystemService::Init()
     return false;
 }
 
+void WakeAllThreads()
+{
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        JobSystemWorker& worker = Workers[i];
+        Platform::AtomicStore(&worker.Sleeping, 0);
+        worker.SleepMutex.Lock();
+        worker.SleepSignal.NotifyOne();
+        worker.SleepMutex.Unlock();
+    }
+}
+
 void JobSystemService::BeforeExit()
 {
     Platform::AtomicStore(&ExitFlag, 1);
-    JobsSignal.NotifyAll();
+    WakeAllThreads();
 }
 
 void JobSystemService::Dispose()
 {
     Platform::AtomicStore(&ExitFlag, 1);
-    JobsSignal.NotifyAll();
+    WakeAllThreads();
     Platform::Sleep(1);
 
     for (int32 i = 0; i < ThreadsCount; i++)
@@ -141,9 +295,219 @@ void JobSystemService::Dispose()
         }
     }
 
-    Memory::DestructItems(JobContexts, (int32)JobContextsSize);
-    Platform::Free(JobContexts);
-    JobContexts = nullptr;
+    Memory::DestructItems(Workers, ThreadsCount);
+    Platform::Free(Workers);
+    Workers = nullptr;
+    for (JobContext*& chunk : JobContextsChunks)
+    {
+        if (chunk)
+        {
+            Memory::DestructItems(chunk, JOB_CONTEXTS_CHUNK);
+            Platform::Free(chunk);
+            chunk = nullptr;
+        }
+    }
+    int32 index;
+    while (JobContextsFree.try_dequeue(index))
+    {
+    }
+    JobContextsCapacity = 0;
+}
+
+// Wakes up a single sleeping worker thread (if any) to pick up the queued work.
+void WakeOneThread()
+{
+    if (Platform::AtomicRead(&SleepingCount) <= 0)
+        return;
+    const int32 startIndex = (int32)((uint64)Platform::InterlockedIncrement(&WakeIndex) % (uint64)ThreadsCount);
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        JobSystemWorker& worker = Workers[(startIndex + i) % ThreadsCount];
+        if (Platform::InterlockedCompareExchange(&worker.Sleeping, 0, 1) == 1)
+        {
+            Platform::InterlockedDecrement(&SleepingCount);
+            worker.SleepMutex.Lock();
+            worker.SleepSignal.NotifyOne();
+            worker.SleepMutex.Unlock();
+            return;
+        }
+    }
+}
+
+bool IsFrameDeadlineNear()
+{
+    const double deadline = FrameDeadline;
+    if (deadline <= 0.0)
+        return false;
+    const double time = Platform::GetTimeSeconds();
+    return time >= deadline - JOB_FRAME_DEADLINE_MARGIN && time < deadline;
+}
+
+// Checks if background jobs can be executed now (they are paused near the frame deadline unless someone waits for them).
+bool CanRunBackgroundJobs()
+{
+    return Platform::AtomicRead(&BackgroundWaiters) > 0 || !IsFrameDeadlineNear();
+}
+
+bool HasQueuedJobs(JobPriority maxPriority = JobPriority::Background)
+{
+    for (int32 priority = 0; priority <= (int32)maxPriority; priority++)
+    {
+        if (GlobalQueues[priority].Count() > 0)
+            return true;
+        for (int32 i = 0; i < ThreadsCount; i++)
+        {
+            if (!Workers[i].Queues[priority].IsEmpty())
+                return true;
+        }
+    }
+    return false;
+}
+
+// Adds the jobs range to be executed (to the local thread queue when called from the job system thread, otherwise to the global queue).
+void EnqueueJobs(const JobRange& range, bool wakeup)
+{
+    JobSystemWorker* worker = ThisWorker;
+    const int32 priority = (int32)range.Context->Priority;
+    if (!worker || !worker->Queues[priority].Push(range))
+        GlobalQueues[priority].Add(range);
+    if (wakeup)
+    {
+        // Ensure queue write is visible before checking for sleeping threads (paired with a barrier in worker going to sleep)
+        Platform::MemoryBarrier();
+        WakeOneThread();
+    }
+}
+
+// Starts the execution of all jobs from the context (once all dependencies are done).
+void StartJobs(JobContext& context, bool wakeup)
+{
+    context.QueueTime = Platform::GetTimeSeconds();
+    JobCounters[(int32)context.Priority].OnQueued();
+    EnqueueJobs({ &context, 0, context.JobsCount }, wakeup);
+}
+
+bool StealJobs(JobSystemWorker& worker, int32 priority, JobRange& range, const JobContext* preferred)
+{
+    // Pick a random victim (xorshift) and try all other threads from there
+    uint32 seed = worker.RandomSeed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    worker.RandomSeed = seed;
+    const int32 startIndex = (int32)(seed % (uint32)ThreadsCount);
+    if (preferred)
+    {
+        // Try to steal jobs from the specific context first (eg. when waiting for it to finish)
+        for (int32 i = 0; i < ThreadsCount; i++)
+        {
+            JobSystemWorker& victim = Workers[(startIndex + i) % ThreadsCount];
+            if (&victim != &worker && victim.Queues[priority].PeekContext() == preferred && victim.Queues[priority].Steal(range))
+                return true;
+        }
+    }
+    for (int32 i = 0; i < ThreadsCount; i++)
+    {
+        JobSystemWorker& victim = Workers[(startIndex + i) % ThreadsCount];
+        if (&victim != &worker && victim.Queues[priority].Steal(range))
+            return true;
+    }
+    return false;
+}
+
+bool PickJobs(JobSystemWorker& worker, int32 priority, JobRange& range, const JobContext* preferred)
+{
+    return worker.Queues[priority].Pop(range) || StealJobs(worker, priority, range, preferred) || GlobalQueues[priority].try_dequeue(range);
+}
+
+// Picks the jobs to execute by the job system thread (from local queue first, then global queue and stealing from other threads). Higher priority classes go first.
+bool PickJobs(JobSystemWorker& worker, JobRange& range, const JobContext* preferred = nullptr)
+{
+    if (preferred && PickJobs(worker, (int32)preferred->Priority, range, preferred))
+        return true;
+    const int32 maxPriority = CanRunBackgroundJobs() ? (int32)JobPriority::Background : (int32)JobPriority::Normal;
+    for (int32 priority = 0; priority <= maxPriority; priority++)
+    {
+        if (PickJobs(worker, priority, range, preferred))
+            return true;
+    }
+    return false;
+}
+
+void OnJobsDone(JobContext& context, int32 count)
+{
+    // Move forward with the job queue
+    if (Platform::InterlockedAdd(&context.JobsLeft, -count) - count > 0)
+        return;
+
+    // Mark job as done and pick dependant jobs (within lock to synchronize with jobs dispatched with dependencies)
+    Array<int64, InlinedAllocation<16>> dependants;
+    JobsLocker.Lock();
+    Platform::AtomicStore(&context.JobLabel, -1);
+    dependants.Add(context.Dependants);
+    context.Dependants.Clear();
+    JobsLocker.Unlock();
+
+    // Update dependant jobs
+    for (int64 dependant : dependants)
+    {
+        JobContext& dependantContext = GET_CONTEXT(dependant);
+        if (Platform::AtomicRead(&dependantContext.JobLabel) == dependant && Platform::InterlockedDecrement(&dependantContext.DependenciesLeft) == 0)
+        {
+            // All dependencies are done so start the job
+            StartJobs(dependantContext, true);
+        }
+    }
+
+    // Cleanup completed context and return it to the pool
+    context.Job.Unbind();
+    JobContextsFree.enqueue(context.Index);
+    Platform::InterlockedDecrement(&JobContextsCount);
+
+    // Wakeup any thread waiting for the jobs to complete
+    WaitSignal.NotifyAll();
+}
+
+void ExecuteJobs(JobSystemWorker* worker, JobRange range)
+{
+    JobContext& context = *range.Context;
+    JobQueue& queue = worker->Queues[(int32)context.Priority];
+    if (Platform::AtomicRead(&context.Started) == 0 && Platform::InterlockedCompareExchange(&context.Started, 1, 0) == 0)
+        JobCounters[(int32)context.Priority].OnStarted(context.QueueTime);
+
+    // Split large ranges and put the remaining part into the local queue to be picked up (or stolen by other threads)
+    while (range.End - range.Start > context.BatchSize)
+    {
+        const int32 middle = range.Start + (range.End - range.Start) / 2;
+        if (!queue.Push({ &context, middle, range.End }))
+            break;
+        Platform::MemoryBarrier();
+        WakeOneThread();
+        range.End = middle;
+    }
+
+    // Run jobs
+    int32 jobIndex = range.Start;
+    if (context.Priority == JobPriority::Background)
+    {
+        // Yield to the higher priority jobs (or frame deadline) between items by putting the remaining part back into the queue
+        while (jobIndex < range.End)
+        {
+            context.Job(jobIndex++);
+            if (jobIndex < range.End && (!CanRunBackgroundJobs() || HasQueuedJobs(JobPriority::Normal)) && queue.Push({ &context, jobIndex, range.End }))
+            {
+                range.End = jobIndex;
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (; jobIndex < range.End; jobIndex++)
+            context.Job(jobIndex);
+    }
+
+    OnJobsDone(context, range.End - range.Start);
 }
 
 int32 JobSystemThread::Run()
@@ -151,57 +515,15 @@ int32 JobSystemThread::Run()
     // Pin thread to the physical core
     Platform::SetThreadAffinityMask(1ull << Index);
 
+    JobSystemWorker& worker = Workers[Index];
+    ThisWorker = &worker;
     bool attachCSharpThread = true;
     MONO_THREAD_INFO_TYPE* monoThreadInfo = nullptr;
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
         // Try to get a job
-        int32 jobIndex;
-        JobContext* jobContext = nullptr;
-        {
-            int64 jobOffset = 0;
-        RETRY:
-            int64 jobStartLabel = Platform::AtomicRead(&JobStartLabel) + jobOffset;
-            int64 jobEndLabel = Platform::AtomicRead(&JobEndLabel);
-            if (jobStartLabel <= jobEndLabel && jobEndLabel > 0)
-            {
-                jobContext = &JobContexts[GET_CONTEXT_INDEX(jobStartLabel)];
-                if (Platform::AtomicRead(&jobContext->DependenciesLeft) > 0)
-                {
-                    // This job still waits for dependency so skip it for now and try the next one
-                    jobOffset++;
-                    jobContext = nullptr;
-                    goto RETRY;
-                }
-
-                // Move forward with index for a job
-                jobIndex = (int32)(Platform::InterlockedIncrement(&jobContext->JobIndex) - 1);
-                if (jobIndex < jobContext->JobsCount)
-                {
-                    // Index is valid
-                }
-                else if (jobStartLabel < jobEndLabel && jobOffset == 0)
-                {
-                    // No more jobs inside this context, move to the next one
-                    Platform::InterlockedCompareExchange(&JobStartLabel, jobStartLabel + 1, jobStartLabel);
-                    jobContext = nullptr;
-                    goto RETRY;
-                }
-                else
-                {
-                    // No more jobs
-                    jobContext = nullptr;
-                    if (jobStartLabel < jobEndLabel)
-                    {
-                        // Try with a different one before going to sleep
-                        jobOffset++;
-                        goto RETRY;
-                    }
-                }
-            }
-        }
-
-        if (jobContext)
+        JobRange range;
+        if (PickJobs(worker, range))
         {
 #if USE_CSHARP
             // Ensure to have C# thread attached to this thead (late init due to MCore being initialized after Job System)
@@ -213,179 +535,168 @@ int32 JobSystemThread::Run()
             }
 #endif
 
-            // Run job
-            jobContext->Job(jobIndex);
-
-            // Move forward with the job queue
-            if (Platform::InterlockedDecrement(&jobContext->JobsLeft) <= 0)
-            {
-                // Mark job as done before processing dependants
-                Platform::AtomicStore(&jobContext->JobLabel, -1);
-
-                // Check if any other job waits on this one
-                if (Platform::AtomicRead(&jobContext->DependantsCount) != 0)
-                {
-                    // Update dependant jobs
-                    JobsLocker.Lock();
-                    for (int64 dependant : jobContext->Dependants)
-                    {
-                        JobContext& dependantContext = JobContexts[GET_CONTEXT_INDEX(dependant)];
-                        if (dependantContext.JobLabel == dependant)
-                            Platform::InterlockedDecrement(&dependantContext.DependenciesLeft);
-                    }
-                    JobsLocker.Unlock();
-                }
-
-                // Cleanup completed context
-                jobContext->Job.Unbind();
-                jobContext->Dependants.Clear();
-                Platform::AtomicStore(&jobContext->DependantsCount, 0);
-                Platform::AtomicStore(&jobContext->DependenciesLeft, -999); // Mark to indicate deleted context
-                Platform::AtomicStore(&jobContext->JobLabel, -1);
-                Platform::InterlockedDecrement(&JobContextsCount);
-
-                // Wakeup any thread waiting for the jobs to complete
-                WaitSignal.NotifyAll();
-            }
+            ExecuteJobs(&worker, range);
         }
         else
         {
             // Wait for signal
             MONO_ENTER_GC_SAFE_WITH_INFO(monoThreadInfo);
-            JobsMutex.Lock();
-            JobsSignal.Wait(JobsMutex);
-            JobsMutex.Unlock();
+            worker.SleepMutex.Lock();
+            Platform::AtomicStore(&worker.Sleeping, 1);
+            Platform::InterlockedIncrement(&SleepingCount);
+            Platform::MemoryBarrier();
+            const bool canRunBackground = CanRunBackgroundJobs();
+            if (HasQueuedJobs(canRunBackground ? JobPriority::Background : JobPriority::Normal) || Platform::AtomicRead(&ExitFlag) != 0)
+            {
+                // Work arrived meanwhile so cancel sleeping (unless other thread already woken this one)
+                if (Platform::InterlockedCompareExchange(&worker.Sleeping, 0, 1) == 1)
+                    Platform::InterlockedDecrement(&SleepingCount);
+            }
+            else if (!canRunBackground && HasQueuedJobs())
+            {
+                // Only background jobs are left but they are paused until the frame deadline so sleep until then (unless woken earlier)
+                const double timeLeft = FrameDeadline - Platform::GetTimeSeconds();
+                worker.SleepSignal.Wait(worker.SleepMutex, (int32)Math::Clamp(timeLeft * 1000.0, 1.0, JOB_FRAME_DEADLINE_MARGIN * 1000.0));
+                if (Platform::InterlockedCompareExchange(&worker.Sleeping, 0, 1) == 1)
+                    Platform::InterlockedDecrement(&SleepingCount);
+            }
+            while (Platform::AtomicRead(&worker.Sleeping) != 0 && Platform::AtomicRead(&ExitFlag) == 0)
+                worker.SleepSignal.Wait(worker.SleepMutex);
+            worker.SleepMutex.Unlock();
             MONO_EXIT_GC_SAFE_WITH_INFO;
         }
     }
+    ThisWorker = nullptr;
     return 0;
 }
 
-#endif
-
-void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
+// Executes a single pending job when called from the job system thread (to keep it busy when waiting for other jobs).
+bool HelpWithJobs(const JobContext* preferred = nullptr)
 {
-#if JOB_SYSTEM_ENABLED
-    // TODO: disable async if called on job thread? or maybe Wait should handle waiting in job thread to do the processing?
-    if (jobCount > 1)
+    JobSystemWorker* worker = ThisWorker;
+    JobRange range;
+    if (worker && PickJobs(*worker, range, preferred))
     {
-        // Async
-        const int64 label = Dispatch(job, jobCount);
-        Wait(label);
-    }
-    else
-#endif
-    {
-        // Sync
-        for (int32 i = 0; i < jobCount; i++)
-            job(i);
+        ExecuteJobs(worker, range);
+        return true;
     }
+    return false;
 }
 
-int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
+// Registers the non-job thread waiting for the background jobs so they won't be paused by the frame deadline (and wakes up any paused threads).
+void BeginBackgroundWait()
 {
-    if (jobCount <= 0)
-        return 0;
-    PROFILE_CPU();
-#if JOB_SYSTEM_ENABLED
-    while (Platform::InterlockedIncrement(&JobContextsCount) >= JobContextsSize)
+    Platform::InterlockedIncrement(&BackgroundWaiters);
+    if (HasQueuedJobs())
     {
-        // Too many jobs in flight, wait for some to complete to free up contexts
-        PROFILE_CPU_NAMED("JOB SYSTEM OVERFLOW");
-        ZoneColor(TracyWaitZoneColor);
-        Platform::InterlockedDecrement(&JobContextsCount);
-        Platform::Sleep(1);
+        for (int32 i = 0; i < ThreadsCount; i++)
+            WakeOneThread();
     }
-
-    // Get a new label
-    const int64 label = Platform::InterlockedIncrement(&JobLabel);
-
-    // Build job
-    JobContext& context = JobContexts[GET_CONTEXT_INDEX(label)];
-    context.Job = job;
-    context.JobIndex = 0;
-    context.JobsLeft = jobCount;
-    context.JobLabel = label;
-    context.DependantsCount = 0;
-    context.DependenciesLeft = 0;
-    context.JobsCount = jobCount;
-    context.Dependants.Clear();
-
-    // Move the job queue forward
-    Platform::InterlockedIncrement(&JobEndLabel);
-
-    if (JobStartingOnDispatch)
-    {
-        if (jobCount == 1)
-            JobsSignal.NotifyOne();
-        else
-            JobsSignal.NotifyAll();
-    }
-
-    return label;
-#else
-    for (int32 i = 0; i < jobCount; i++)
-        job(i);
-    return 0;
-#endif
 }
 
-int64 JobSystem::Dispatch(const Function<void(int32)>& job, Span<int64> dependencies, int32 jobCount)
+int64 DispatchJob(const Function<void(int32)>& job, Span<int64> dependencies, int32 jobCount, JobPriority priority)
 {
-    if (jobCount <= 0)
-        return 0;
-    PROFILE_CPU();
-    PROFILE_MEM(EngineThreading);
-#if JOB_SYSTEM_ENABLED
-    while (Platform::InterlockedIncrement(&JobContextsCount) >= JobContextsSize)
+    // Get a free context (grow the pool if all contexts are in use)
+    int32 index;
+    while (!JobContextsFree.try_dequeue(index))
     {
+        JobContextsLocker.Lock();
+        const bool allocated = JobContextsFree.try_dequeue(index) || (AllocateContextsChunk() && JobContextsFree.try_dequeue(index));
+        JobContextsLocker.Unlock();
+        if (allocated)
+            break;
+
         // Too many jobs in flight, wait for some to complete to free up contexts
         PROFILE_CPU_NAMED("JOB SYSTEM OVERFLOW");
         ZoneColor(TracyWaitZoneColor);
-        Platform::InterlockedDecrement(&JobContextsCount);
-        Platform::Sleep(1);
+        Platform::InterlockedIncrement(&JobContextsOverflows);
+        if (!HelpWithJobs())
+            Platform::Yield();
     }
+    const int64 contextsCount = Platform::InterlockedIncrement(&JobContextsCount);
+    int64 contextsPeak = Platform::AtomicRead(&JobContextsPeak);
+    while (contextsCount > contextsPeak && Platform::InterlockedCompareExchange(&JobContextsPeak, contextsCount, contextsPeak) != contextsPeak)
+        contextsPeak = Platform::AtomicRead(&JobContextsPeak);
 
-    // Get a new label
-    const int64 label = Platform::InterlockedIncrement(&JobLabel);
+    // Get a new label (unique sequence number combined with the context index)
+    const int64 label = (Platform::InterlockedIncrement(&JobLabel) << JOB_CONTEXTS_MAX_BITS) | index;
 
     // Build job
-    JobContext& context = JobContexts[GET_CONTEXT_INDEX(label)];
+    JobContext& context = GET_CONTEXT(index);
     context.Job = job;
-    context.JobIndex = 0;
     context.JobsLeft = jobCount;
-    context.JobLabel = label;
-    context.DependantsCount = 0;
-    context.DependenciesLeft = 0;
     context.JobsCount = jobCount;
+    context.BatchSize = Math::Max(jobCount / (ThreadsCount * 8), 1);
+    context.Priority = priority;
+    context.Started = 0;
+    context.DependenciesLeft = 1; // Guard to prevent starting the job before all dependencies are registered
     context.Dependants.Clear();
+    Platform::AtomicStore(&context.JobLabel, label);
+    if (dependencies.Length() != 0)
     {
         JobsLocker.Lock();
         for (int64 dependency : dependencies)
         {
-            JobContext& dependencyContext = JobContexts[GET_CONTEXT_INDEX(dependency)];
+            JobContext& dependencyContext = GET_CONTEXT(dependency);
             if (Platform::AtomicRead(&dependencyContext.JobLabel) == dependency)
             {
-                Platform::InterlockedIncrement(&dependencyContext.DependantsCount);
                 dependencyContext.Dependants.Add(label);
-                context.DependenciesLeft++;
+                Platform::InterlockedIncrement(&context.DependenciesLeft);
             }
         }
         JobsLocker.Unlock();
     }
 
-    // Move the job queue forward
-    Platform::InterlockedIncrement(&JobEndLabel);
+    // Start the job if there are no dependencies left
+    if (Platform::InterlockedDecrement(&context.DependenciesLeft) == 0)
+        StartJobs(context, JobStartingOnDispatch);
+
+    return label;
+}
+
+#endif
 
-    if (context.DependenciesLeft == 0 && JobStartingOnDispatch)
+void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount, JobPriority priority)
+{
+#if JOB_SYSTEM_ENABLED
+    // Wait executes other jobs when called from the job thread so nested execution won't block the thread
+    if (jobCount > 1)
     {
-        if (jobCount == 1)
-            JobsSignal.NotifyOne();
-        else
-            JobsSignal.NotifyAll();
+        // Async
+        const int64 label = Dispatch(job, jobCount, priority);
+        Wait(label);
+    }
+    else
+#endif
+    {
+        // Sync
+        for (int32 i = 0; i < jobCount; i++)
+            job(i);
     }
+}
 
-    return label;
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount, JobPriority priority)
+{
+    if (jobCount <= 0)
+        return 0;
+    PROFILE_CPU();
+#if JOB_SYSTEM_ENABLED
+    return DispatchJob(job, Span<int64>(), jobCount, priority);
+#else
+    for (int32 i = 0; i < jobCount; i++)
+        job(i);
+    return 0;
+#endif
+}
+
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, Span<int64> dependencies, int32 jobCount, JobPriority priority)
+{
+    if (jobCount <= 0)
+        return 0;
+    PROFILE_CPU();
+    PROFILE_MEM(EngineThreading);
+#if JOB_SYSTEM_ENABLED
+    return DispatchJob(job, dependencies, jobCount, priority);
 #else
     for (int32 i = 0; i < jobCount; i++)
         job(i);
@@ -399,8 +710,14 @@ void JobSystem::Wait()
     PROFILE_CPU();
     ZoneColor(TracyWaitZoneColor);
 
+    // Waiting for all jobs from within the job would never finish (calling job is in flight until it returns), use Wait with the label instead
+    CHECK(ThisWorker == nullptr);
+
     int64 numJobs = Platform::AtomicRead(&JobContextsCount);
-    while (numJobs > 0)
+    if (numJobs <= 0)
+        return;
+    BeginBackgroundWait();
+    while (numJobs > 0 && Platform::AtomicRead(&ExitFlag) == 0)
     {
         WaitMutex.Lock();
         WaitSignal.Wait(WaitMutex, 1);
@@ -408,6 +725,7 @@ void JobSystem::Wait()
 
         numJobs = Platform::AtomicRead(&JobContextsCount);
     }
+    Platform::InterlockedDecrement(&BackgroundWaiters);
 #endif
 }
 
@@ -417,23 +735,45 @@ void JobSystem::Wait(int64 label)
     PROFILE_CPU();
     ZoneColor(TracyWaitZoneColor);
 
+    const JobContext& context = GET_CONTEXT(label);
+    const bool backgroundWait = ThisWorker == nullptr && context.Priority == JobPriority::Background;
+    if (backgroundWait)
+        BeginBackgroundWait();
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
-        const JobContext& context = JobContexts[GET_CONTEXT_INDEX(label)];
         const bool finished = Platform::AtomicRead(&context.JobLabel) != label || Platform::AtomicRead(&context.JobsLeft) <= 0;
 
         // Skip if context has been already executed (last job removes it)
         if (finished)
             break;
 
+        // Help with the jobs execution when waiting on the job system thread (eg. nested dispatch from within the other job)
+        if (HelpWithJobs(&context))
+            continue;
+
         // Wait on signal until input label is not yet done
         WaitMutex.Lock();
         WaitSignal.Wait(WaitMutex, 1);
         WaitMutex.Unlock();
-
-        // Wake up any thread to prevent stalling in highly multi-threaded environment
-        JobsSignal.NotifyOne();
     }
+    if (backgroundWait)
+        Platform::InterlockedDecrement(&BackgroundWaiters);
+#endif
+}
+
+void JobSystem::SetFrameDeadline(double time)
+{
+#if JOB_SYSTEM_ENABLED
+    FrameDeadline = time;
+#endif
+}
+
+bool JobSystem::IsFrameDeadlineNear()
+{
+#if JOB_SYSTEM_ENABLED
+    return ::IsFrameDeadlineNear();
+#else
+    return false;
 #endif
 }
 
@@ -441,10 +781,11 @@ void JobSystem::SetJobStartingOnDispatch(bool value)
 {
 #if JOB_SYSTEM_ENABLED
     JobStartingOnDispatch = value;
-    if (value && (Platform::AtomicRead(&JobEndLabel) - Platform::AtomicRead(&JobStartLabel)) > 0)
+    if (value && HasQueuedJobs())
     {
         // Wake up threads to start processing jobs that may be already in the queue
-        JobsSignal.NotifyAll();
+        for (int32 i = 0; i < ThreadsCount; i++)
+            WakeOneThread();
     }
 #endif
 }
@@ -457,3 +798,20 @@ int32 JobSystem::GetThreadsCount()
     return 0;
 #endif
 }
+
+JobSystemStats JobSystem::GetStats(bool resetPeak)
+{
+    JobSystemStats result;
+#if JOB_SYSTEM_ENABLED
+    result.ContextsInFlight = (int32)Platform::AtomicRead(&JobContextsCount);
+    result.ContextsPeak = (int32)Platform::AtomicRead(&JobContextsPeak);
+    result.ContextsCapacity = (int32)Platform::AtomicRead(&JobContextsCapacity);
+    result.OverflowWaits = Platform::AtomicRead(&JobContextsOverflows);
+    JobPriorityCounters::Get(JobCounters, result.Queues, resetPeak);
+    if (resetPeak)
+        Platform::AtomicStore(&JobContextsPeak, result.ContextsInFlight);
+#else
+    Platform::MemoryClear(&result, sizeof(result));
+#endif
+    return result;
+}
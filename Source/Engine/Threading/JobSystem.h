@@ -3,10 +3,44 @@
 #pragma once
 
 #include "Engine/Core/Delegate.h"
+#include "JobPriority.h"
 
 template<typename T>
 class Span;
 
+/// <summary>
+/// The Job System runtime statistics.
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API JobSystemStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(JobSystemStats);
+
+    /// <summary>
+    /// The amount of job dispatches that are currently in flight (queued, executing or waiting for dependencies).
+    /// </summary>
+    API_FIELD() int32 ContextsInFlight;
+
+    /// <summary>
+    /// The peak amount of job dispatches in flight (since the last peak reset).
+    /// </summary>
+    API_FIELD() int32 ContextsPeak;
+
+    /// <summary>
+    /// The amount of allocated job contexts (pool grows on demand).
+    /// </summary>
+    API_FIELD() int32 ContextsCapacity;
+
+    /// <summary>
+    /// The total amount of waits in Dispatch due to the job contexts limit being reached.
+    /// </summary>
+    API_FIELD() int64 OverflowWaits;
+
+    /// <summary>
+    /// The jobs queues statistics (per priority class).
+    /// </summary>
+    API_FIELD() JobQueueStats Queues;
+};
+
 /// <summary>
 /// Lightweight multi-threaded jobs execution scheduler. Uses a pool of threads and supports work-stealing concept.
 /// </summary>
@@ -19,15 +53,17 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// </summary>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
-    API_FUNCTION() static void Execute(const Function<void(int32)>& job, int32 jobCount = 1);
+    /// <param name="priority">The job priority class.</param>
+    API_FUNCTION() static void Execute(const Function<void(int32)>& job, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
 
     /// <summary>
     /// Dispatches the job for the execution.
     /// </summary>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The job priority class.</param>
     /// <returns>The label identifying this dispatch. Can be used to wait for the execution end.</returns>
-    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1);
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
 
     /// <summary>
     /// Dispatches the job for the execution after all of dependant jobs will complete.
@@ -35,12 +71,14 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="dependencies">The list of dependant jobs that need to complete in order to start executing this job.</param>
     /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The job priority class.</param>
     /// <returns>The label identifying this dispatch. Can be used to wait for the execution end.</returns>
-    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, Span<int64> dependencies, int32 jobCount = 1);
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, Span<int64> dependencies, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
 
     /// <summary>
     /// Waits for all dispatched jobs to finish.
     /// </summary>
+    /// <remarks>Cannot be called from within the job (on the job system thread), use Wait with the dispatch label instead.</remarks>
     API_FUNCTION() static void Wait();
 
     /// <summary>
@@ -49,6 +87,17 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// <param name="label">The label.</param>
     API_FUNCTION() static void Wait(int64 label);
 
+    /// <summary>
+    /// Sets the time of the current frame end (in seconds, see Platform::GetTimeSeconds). Background jobs are paused shortly before the deadline to let the frame-critical work finish on time. Use 0 to disable it.
+    /// </summary>
+    /// <param name="time">The deadline time.</param>
+    static void SetFrameDeadline(double time);
+
+    /// <summary>
+    /// Checks if the current frame deadline is near (background jobs are paused).
+    /// </summary>
+    API_PROPERTY() static bool IsFrameDeadlineNear();
+
     /// <summary>
     /// Sets whether automatically start jobs execution on Dispatch. If disabled jobs won't be executed until it gets re-enabled. Can be used to optimize execution of multiple dispatches that should overlap.
     /// </summary>
@@ -58,4 +107,11 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// Gets the amount of job system threads.
     /// </summary>
     API_PROPERTY() static int32 GetThreadsCount();
+
+    /// <summary>
+    /// Gets the job system runtime statistics.
+    /// </summary>
+    /// <param name="resetPeak">If true, the peak counters will be reset after reading (eg. to track per-frame peaks).</param>
+    /// <returns>The statistics.</returns>
+    API_FUNCTION() static JobSystemStats GetStats(bool resetPeak = false);
 };
@@ -137,9 +137,9 @@ void TaskGraph::Execute()
         system->PostExecute(this);
 }
 
-void TaskGraph::DispatchJob(const Function<void(int32)>& job, int32 jobCount)
+void TaskGraph::DispatchJob(const Function<void(int32)>& job, int32 jobCount, JobPriority priority)
 {
     ASSERT(_currentSystem);
-    const int64 label = JobSystem::Dispatch(job, jobCount);
+    const int64 label = JobSystem::Dispatch(job, jobCount, priority);
     _labels.Add(label);
 }
@@ -4,6 +4,7 @@
 
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Core/Collections/Array.h"
+#include "JobPriority.h"
 
 class TaskGraph;
 
@@ -100,5 +101,6 @@ DECLARE_SCRIPTING_TYPE(TaskGraph);
     /// <remarks>Call only from system's Execute method to properly schedule job.</remarks>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
-    API_FUNCTION() void DispatchJob(const Function<void(int32)>& job, int32 jobCount = 1);
+    /// <param name="priority">The job priority class.</param>
+    API_FUNCTION() void DispatchJob(const Function<void(int32)>& job, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Templates.h"
 #include "Engine/Platform/Platform.h"
 
 #define THREAD_LOCAL_USE_DYNAMIC_BUCKETS (PLATFORM_DESKTOP)
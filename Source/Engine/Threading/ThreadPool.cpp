@@ -4,6 +4,7 @@
 #include "IRunnable.h"
 #include "Threading.h"
 #include "ThreadPoolTask.h"
+#include "JobSystem.h"
 #include "ConcurrentTaskQueue.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
@@ -33,7 +34,8 @@ namespace ThreadPoolImpl
 {
     volatile intptr ExitFlag = 0;
     Array<Thread*> Threads;
-    ConcurrentTaskQueue<ThreadPoolTask> Jobs; // Hello Steve!
+    ConcurrentTaskQueue<ThreadPoolTask> Jobs[(int32)JobPriority::MAX]; // Hello Steve!
+    JobPriorityCounters Counters[(int32)JobPriority::MAX];
     ConditionVariable JobsSignal;
     CriticalSection JobsMutex;
 #ifdef THREAD_POOL_AFFINITY_MASK
@@ -44,7 +46,9 @@ namespace ThreadPoolImpl
 void ThreadPoolTask::Enqueue()
 {
     PROFILE_MEM(EngineThreading);
-    ThreadPoolImpl::Jobs.Add(this);
+    _queueTime = Platform::GetTimeSeconds();
+    ThreadPoolImpl::Counters[(int32)Priority].OnQueued();
+    ThreadPoolImpl::Jobs[(int32)Priority].Add(this);
     ThreadPoolImpl::JobsSignal.NotifyOne();
 }
 
@@ -125,9 +129,18 @@ int32 ThreadPool::ThreadProc()
     // Work until end
     while (Platform::AtomicRead(&ThreadPoolImpl::ExitFlag) == 0)
     {
-        // Try to get a job
-        if (ThreadPoolImpl::Jobs.try_dequeue(task))
+        // Try to get a job (higher priority first, background tasks are held when frame deadline is near)
+        const bool canRunBackground = !JobSystem::IsFrameDeadlineNear();
+        const int32 maxPriority = canRunBackground ? (int32)JobPriority::Background : (int32)JobPriority::Normal;
+        int32 priority = 0;
+        for (; priority <= maxPriority; priority++)
         {
+            if (ThreadPoolImpl::Jobs[priority].try_dequeue(task))
+                break;
+        }
+        if (priority <= maxPriority)
+        {
+            ThreadPoolImpl::Counters[priority].OnStarted(task->_queueTime);
             task->Execute();
             MONO_THREAD_INFO_GET(monoThreadInfo);
         }
@@ -135,7 +148,10 @@ int32 ThreadPool::ThreadProc()
         {
             MONO_ENTER_GC_SAFE_WITH_INFO(monoThreadInfo);
             ThreadPoolImpl::JobsMutex.Lock();
-            ThreadPoolImpl::JobsSignal.Wait(ThreadPoolImpl::JobsMutex);
+            if (canRunBackground)
+                ThreadPoolImpl::JobsSignal.Wait(ThreadPoolImpl::JobsMutex);
+            else
+                ThreadPoolImpl::JobsSignal.Wait(ThreadPoolImpl::JobsMutex, 1);
             ThreadPoolImpl::JobsMutex.Unlock();
             MONO_EXIT_GC_SAFE_WITH_INFO;
         }
@@ -144,8 +160,18 @@ int32 ThreadPool::ThreadProc()
     return 0;
 }
 
+void ThreadPool::GetStats(JobQueueStats& result, bool reset)
+{
+    JobPriorityCounters::Get(ThreadPoolImpl::Counters, result, reset);
+}
+
 #else
 
+void ThreadPool::GetStats(JobQueueStats& result, bool reset)
+{
+    Platform::MemoryClear(&result, sizeof(result));
+}
+
 void ThreadPoolTask::Enqueue()
 {
     // Run task on the main thread (fallback when no threading is supported)
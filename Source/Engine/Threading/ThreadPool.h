@@ -4,6 +4,8 @@
 
 #include "Engine/Core/Types/BaseTypes.h"
 
+struct JobQueueStats;
+
 // Enables pinning thread pool to the logical CPU cores with affinity mask
 //#define THREAD_POOL_AFFINITY_MASK(thread) (1 << (thread + 1))
 
@@ -14,6 +16,15 @@ class ThreadPool
 {
     friend class ThreadPoolTask;
     friend class ThreadPoolService;
+public:
+
+    /// <summary>
+    /// Gets the thread pool tasks queues statistics (per priority class).
+    /// </summary>
+    /// <param name="result">The result statistics.</param>
+    /// <param name="reset">If true, the counters will be reset after reading (eg. to track per-frame stats).</param>
+    static void GetStats(JobQueueStats& result, bool reset = false);
+
 private:
 
     static int32 ThreadProc();
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Task.h"
+#include "JobPriority.h"
 
 class ThreadPool;
 
@@ -16,6 +17,8 @@ class ThreadPoolTask : public Task
 
 protected:
 
+    double _queueTime = 0.0;
+
     /// <summary>
     /// Initializes a new instance of the <see cref="ThreadPoolTask"/> class.
     /// </summary>
@@ -24,6 +27,13 @@ class ThreadPoolTask : public Task
     {
     }
 
+public:
+
+    /// <summary>
+    /// The priority class of the task. Thread pool picks the higher priority tasks first and holds the background tasks when the frame deadline is near. Set it before starting the task.
+    /// </summary>
+    JobPriority Priority = JobPriority::Normal;
+
 public:
 
     // [Task]
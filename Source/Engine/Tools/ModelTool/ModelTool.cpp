@@ -578,6 +578,8 @@ void ModelTool::Options::Serialize(SerializeStream& stream, const void* otherObj
     SERIALIZE(SamplingRate);
     SERIALIZE(SkipEmptyCurves);
     SERIALIZE(OptimizeKeyframes);
+    SERIALIZE(CompressAnimation);
+    SERIALIZE(CompressionMaxError);
     SERIALIZE(ImportScaleTracks);
     SERIALIZE(RootMotion);
     SERIALIZE(RootMotionFlags);
@@ -639,6 +641,8 @@ void ModelTool::Options::Deserialize(DeserializeStream& stream, ISerializeModifi
     DESERIALIZE(SamplingRate);
     DESERIALIZE(SkipEmptyCurves);
     DESERIALIZE(OptimizeKeyframes);
+    DESERIALIZE(CompressAnimation);
+    DESERIALIZE(CompressionMaxError);
     DESERIALIZE(ImportScaleTracks);
     DESERIALIZE(RootMotion);
     DESERIALIZE(RootMotionFlags);
@@ -1027,8 +1031,8 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
         break;
     case ModelType::Animation:
         options.ImportTypes = ImportDataTypes::Animations;
-        if (options.RootMotion == RootMotionMode::ExtractCenterOfMass)
-            options.ImportTypes |= ImportDataTypes::Skeleton;
+        if (options.RootMotion == RootMotionMode::ExtractCenterOfMass || options.CompressAnimation)
+            options.ImportTypes |= ImportDataTypes::Skeleton; // Compression uses the nodes default pose and length
         break;
     case ModelType::Prefab:
         options.ImportTypes = ImportDataTypes::Geometry | ImportDataTypes::Nodes | ImportDataTypes::Skeleton | ImportDataTypes::Animations;
@@ -1665,6 +1669,21 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
     }
     if (EnumHasAnyFlags(options.ImportTypes, ImportDataTypes::Animations))
     {
+        // Calculate the skeleton nodes length (distance to the farthest child node) for the animation compression error measuring
+        Array<float> nodesLength;
+        if (options.CompressAnimation)
+        {
+            const auto& nodesPose = data.Skeleton.GetNodesPose();
+            nodesLength.Resize(data.Skeleton.Nodes.Count());
+            nodesLength.SetAll(0.0f);
+            for (int32 nodeIndex = 0; nodeIndex < data.Skeleton.Nodes.Count(); nodeIndex++)
+            {
+                const Float3 position = nodesPose[nodeIndex].GetTranslation();
+                for (int32 parentIndex = data.Skeleton.Nodes[nodeIndex].ParentIndex; parentIndex != -1; parentIndex = data.Skeleton.Nodes[parentIndex].ParentIndex)
+                    nodesLength[parentIndex] = Math::Max(nodesLength[parentIndex], Float3::Distance(position, nodesPose[parentIndex].GetTranslation()));
+            }
+        }
+
         for (auto& animation : data.Animations)
         {
             // Trim the animation keyframes range if need to
@@ -1845,6 +1864,28 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
                 const int32 after = animation.GetKeyframesCount();
                 LOG(Info, "Optimized {0} animation keyframe(s). Before: {1}, after: {2}, Ratio: {3}%", before - after, before, after, Utilities::RoundTo2DecimalPlaces((float)after / before));
             }
+
+            // Compress the animation
+            if (options.CompressAnimation)
+            {
+                Array<AnimationCompressionNode> nodes;
+                nodes.Resize(animation.Channels.Count());
+                for (int32 i = 0; i < animation.Channels.Count(); i++)
+                {
+                    const int32 nodeIndex = data.Skeleton.FindNode(animation.Channels[i].NodeName);
+                    if (nodeIndex == -1)
+                        continue;
+                    auto& node = nodes[i];
+                    node.DefaultPose = data.Skeleton.Nodes[nodeIndex].LocalTransform;
+                    node.Length = nodesLength[nodeIndex];
+                    node.IsValid = true;
+                }
+                AnimationCompressionStats stats;
+                animation.Compress(options.CompressionMaxError, ToSpan(nodes), stats);
+                LOG(Info, "Compressed animation '{0}'. Memory: {1} -> {2}, Ratio: {3}%, keyframes: {4} -> {5}, stripped tracks: {6}, constant tracks: {7}, max error: position {8}, rotation {9} deg, scale {10}",
+                    animation.Name, Utilities::BytesToText(stats.MemoryBefore), Utilities::BytesToText(stats.MemoryAfter), Utilities::RoundTo2DecimalPlaces((float)stats.MemoryAfter / stats.MemoryBefore * 100.0f),
+                    stats.KeyframesBefore, stats.KeyframesAfter, stats.StrippedTracks, stats.ConstantTracks, stats.MaxPositionError, stats.MaxRotationError, stats.MaxScaleError);
+            }
         }
     }
 
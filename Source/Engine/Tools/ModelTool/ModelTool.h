@@ -277,6 +277,12 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API ModelTool
         // The imported animation channels will be optimized to remove redundant keyframes.
         API_FIELD(Attributes="EditorOrder(1050), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation))")
         bool OptimizeKeyframes = true;
+        // The imported animation channels will be compressed (quantized keyframes, stripped constant tracks). Reduces memory usage of the animation at cost of a small precision loss.
+        API_FIELD(Attributes="EditorOrder(1051), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation))")
+        bool CompressAnimation = false;
+        // The maximum allowed error of the compressed animation (in units). Measured at the skeleton nodes positions (including rotation and scale error that moves the child nodes).
+        API_FIELD(Attributes="EditorOrder(1052), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation)), Limit(0.0001f, 100.0f, 0.001f)")
+        float CompressionMaxError = 0.01f;
         // If checked, the importer will import scale animation tracks (otherwise scale animation will be ignored).
         API_FIELD(Attributes="EditorOrder(1055), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation))")
         bool ImportScaleTracks = false;
@@ -198,6 +198,12 @@ struct dtCrowdAgentDebugInfo
 	dtObstacleAvoidanceDebugData* vod;
 };
 
+/// The callback used by the crowd to execute the per-agent update phases in parallel.
+/// Has to call job(data, index) for every index in range [0, count) (in any order and on any thread)
+/// and return after all of them have completed.
+/// @ingroup crowd
+typedef void (*dtCrowdParallelFor)(void (*job)(void* data, int index), void* data, int count, void* userData);
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
@@ -227,6 +233,29 @@ class dtCrowd
 
 	dtNavMeshQuery* m_navquery;
 
+	dtCrowdParallelFor m_parallelFor;
+	void* m_parallelForUserData;
+	int m_maxJobs;
+	dtNavMeshQuery** m_jobNavQueries;
+	dtObstacleAvoidanceQuery** m_jobObstacleQueries;
+	int* m_jobVelocitySampleCounts;
+
+	struct UpdateContext
+	{
+		dtCrowd* crowd;
+		int phase;
+		dtCrowdAgent** agents;
+		int nagents;
+		int njobs;
+		float dt;
+		dtCrowdAgentDebugInfo* debug;
+	};
+
+	static void updatePhaseJob(void* data, int index);
+	void runUpdatePhase(UpdateContext& context, const int phase);
+	int updatePhase(const UpdateContext& context, const int job, const int begin, const int end);
+	void purgeJobs();
+
 	void updateTopologyOptimization(dtCrowdAgent** agents, const int nagents, const float dt);
 	void updateMoveRequest(const float dt);
 	void checkPathValidity(dtCrowdAgent** agents, const int nagents, const float dt);
@@ -247,6 +276,15 @@ class dtCrowd
 	///  @param[in]		nav				The navigation mesh to use for planning.
 	/// @return True if the initialization succeeded.
 	bool init(const int maxAgents, const float maxAgentRadius, dtNavMesh* nav);
+
+	/// Enables the parallel execution of the per-agent update phases (neighbours gathering, steering, 
+	/// obstacle avoidance, integration and collisions). Results are the same as for the serial update.
+	/// Has to be called after init.
+	///  @param[in]		func			The parallel execution callback. Use null to disable it.
+	///  @param[in]		userData		The custom data passed to the callback.
+	///  @param[in]		maxJobs			The maximum amount of jobs used by a single phase (eg. threads count). [Limit: >= 1]
+	/// @return True if the setup succeeded.
+	bool setParallelFor(dtCrowdParallelFor func, void* userData, const int maxJobs);
 	
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]